@@ -0,0 +1,107 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <vector>         // std :: vector
+#include <batch_scorer.h> // batch_scorer
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t K = argc > 1 ? std :: stoi(argv[1]) : 1000;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (123);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  std :: cout << "Batch evaluation benchmark (K = " << K << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "n_lbl"
+              << std :: setw(16) << "single (ms)"
+              << std :: setw(16) << "batch (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t n_lbl : {10, 100, 1000, 10000})
+  {
+    std :: vector < int32_t > lbl_true (n_lbl);
+    std :: vector < int32_t > lbl_pred (static_cast < int64_t >(n_lbl) * K);
+
+    for (auto & x : lbl_true)
+      x = dist(engine);
+
+    for (auto & x : lbl_pred)
+      x = dist(engine);
+
+    // the first labels cover all the classes
+    for (int32_t k = 0; k < K; ++k)
+      for (int32_t i = 0; i < Nclass; ++i)
+        lbl_true[i] = lbl_pred[static_cast < int64_t >(k) * n_lbl + i] = i;
+
+    scorer score;
+    batch_scorer batch;
+
+    // one evaluation after the other, each one parallelized over the statistics
+    const double t_single = timeit([&]
+    {
+      for (int32_t k = 0; k < K; ++k)
+      {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        score.compute_score(lbl_true.data(), lbl_pred.data() + static_cast < int64_t >(k) * n_lbl, n_lbl, n_lbl);
+      }
+    });
+
+    const double t_batch = timeit([&]{ batch.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, K); });
+
+    std :: cout << std :: setw(10) << n_lbl
+                << std :: setw(16) << std :: fixed << std :: setprecision(2) << t_single
+                << std :: setw(16) << t_batch
+                << std :: setw(11) << t_single / t_batch << "x"
+                << std :: endl;
+  }
+
+  return 0;
+}
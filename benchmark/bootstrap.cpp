@@ -0,0 +1,87 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <vector>         // std :: vector
+#include <bootstrap.h>    // bootstrap
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_reps = argc > 1 ? std :: stoi(argv[1]) : 1000;
+
+  std :: mt19937 engine (123);
+
+  std :: cout << "Bootstrap benchmark (n_reps = " << n_reps << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(20) << "selected (ms)"
+              << std :: setw(20) << "all stats (ms)"
+              << std :: endl;
+
+  for (const int32_t Nclass : {2, 3, 10, 50})
+  {
+    std :: uniform_int_distribution < count_t > dist (0, 1000);
+
+    std :: vector < count_t > confusion_matrix (Nclass * Nclass);
+
+    for (auto & x : confusion_matrix)
+      x = dist(engine);
+
+    bootstrap selected (n_reps);
+    selected.select({"overall_accuracy", "overall_kappa", "F1_SCORE"});
+
+    bootstrap all (n_reps);
+
+    const double t_selected = timeit([&]{ selected.compute(confusion_matrix.data(), Nclass); });
+    const double t_all = timeit([&]{ all.compute(confusion_matrix.data(), Nclass); });
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(20) << std :: fixed << std :: setprecision(2) << t_selected
+                << std :: setw(20) << t_all
+                << std :: endl;
+  }
+
+  return 0;
+}
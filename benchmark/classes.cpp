@@ -0,0 +1,124 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <set>            // std :: set
+#include <common_stats.h> // get_classes
+
+/**
+* @brief Reference implementation of the classes with std :: set and set_union.
+*
+* @details This is the original discovery path, i.e O(n_lbl log Nclass) with a node allocation for each class.
+*
+*/
+std :: vector < float > set_classes (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+{
+  std :: set < int32_t > u1 (lbl_true, lbl_true + n_lbl);
+  std :: set < int32_t > u2 (lbl_pred, lbl_pred + n_lbl);
+
+  std :: vector < float > classes (u1.size() + u2.size());
+  auto it = std :: set_union(u1.begin(), u1.end(),
+                             u2.begin(), u2.end(),
+                             classes.begin());
+  classes.resize(it - classes.begin());
+
+  return classes;
+}
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_lbl = argc > 1 ? std :: stoi(argv[1]) : 1 << 24;
+
+  std :: mt19937 engine (123);
+
+  std :: cout << "Classes benchmark (n_lbl = " << n_lbl << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(10) << "range"
+              << std :: setw(16) << "set (ms)"
+              << std :: setw(16) << "unique (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {2, 10, 1000, 100000})
+  {
+    // compact labels use the bitmap while spaced labels use the hash set
+    for (const int32_t stride : {1, 20011})
+    {
+      std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+      std :: vector < int32_t > lbl_true (n_lbl);
+      std :: vector < int32_t > lbl_pred (n_lbl);
+
+      for (int32_t i = 0; i < n_lbl; ++i)
+      {
+        lbl_true[i] = dist(engine) * stride - Nclass / 2 * stride;
+        lbl_pred[i] = dist(engine) * stride - Nclass / 2 * stride;
+      }
+
+      std :: vector < float > cls_set;
+      std :: vector < float > cls_unique;
+
+      const double t_set    = timeit([&]{ cls_set = set_classes(lbl_true.data(), lbl_pred.data(), n_lbl); });
+      const double t_unique = timeit([&]{ cls_unique = get_classes(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl); });
+
+      if ( cls_set != cls_unique )
+      {
+        std :: cerr << "Mismatch between the classes (Nclass = " << Nclass << ")" << std :: endl;
+        return 1;
+      }
+
+      std :: cout << std :: setw(10) << Nclass
+                  << std :: setw(10) << (stride == 1 ? "compact" : "sparse")
+                  << std :: setw(16) << std :: fixed << std :: setprecision(2) << t_set
+                  << std :: setw(16) << t_unique
+                  << std :: setw(11) << t_set / t_unique << "x"
+                  << std :: endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <common_stats.h> // get_classes, get_confusion_matrix
+
+/**
+* @brief Reference implementation of the confusion matrix with linear search of the labels.
+*
+* @details This is the original accumulation path, i.e O(n_lbl * Nclass).
+*
+*/
+std :: unique_ptr < float[] > linear_confusion_matrix (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl, const float * classes, const int32_t & Nclass)
+{
+  std :: unique_ptr < float[] > confusion_matrix (new float[Nclass * Nclass]);
+
+  std :: fill_n(confusion_matrix.get(), Nclass * Nclass, 0.f);
+
+  auto start = classes,
+       end   = classes + Nclass;
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    const int32_t i1 = std :: distance(start, std :: find(start, end, lbl_true[i]));
+    const int32_t i2 = std :: distance(start, std :: find(start, end, lbl_pred[i]));
+    ++ confusion_matrix[i1 * Nclass + i2];
+  }
+
+  return confusion_matrix;
+}
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_lbl = argc > 1 ? std :: stoi(argv[1]) : 1000000;
+
+  std :: mt19937 engine (123);
+
+  std :: cout << "Confusion matrix benchmark (n_lbl = " << n_lbl << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(10) << "layout"
+              << std :: setw(16) << "linear (ms)"
+              << std :: setw(16) << "lookup (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {2, 10, 100, 1000, 10000})
+  {
+    // compact labels use the dense table while spaced labels use the hash table
+    for (const int32_t stride : {1, 613})
+    {
+      std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+      std :: vector < int32_t > lbl_true (n_lbl);
+      std :: vector < int32_t > lbl_pred (n_lbl);
+
+      for (int32_t i = 0; i < Nclass; ++i)
+        lbl_true[i] = lbl_pred[i] = i * stride;
+
+      for (int32_t i = Nclass; i < n_lbl; ++i)
+      {
+        lbl_true[i] = dist(engine) * stride;
+        lbl_pred[i] = dist(engine) * stride;
+      }
+
+      const auto classes = get_classes(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+      std :: unique_ptr < float[] > cm_linear;
+      std :: unique_ptr < count_t[] > cm_lookup (new count_t[Nclass * Nclass]);
+
+      const double t_linear = timeit([&]{ cm_linear = linear_confusion_matrix(lbl_true.data(), lbl_pred.data(), n_lbl, classes.data(), Nclass); });
+      const double t_lookup = timeit([&]{ get_confusion_matrix(lbl_true.data(), lbl_pred.data(), n_lbl, classes.data(), Nclass, cm_lookup.get()); });
+
+      if ( !std :: equal(cm_linear.get(), cm_linear.get() + Nclass * Nclass, cm_lookup.get()) )
+      {
+        std :: cerr << "Mismatch between the confusion matrices (Nclass = " << Nclass << ")" << std :: endl;
+        return 1;
+      }
+
+      std :: cout << std :: setw(10) << Nclass
+                  << std :: setw(10) << (label_map(classes.data(), Nclass).dense() ? "dense" : "hash")
+                  << std :: setw(16) << std :: fixed << std :: setprecision(2) << t_linear
+                  << std :: setw(16) << t_lookup
+                  << std :: setw(11) << t_linear / t_lookup << "x"
+                  << std :: endl;
+    }
+  }
+
+  return 0;
+}
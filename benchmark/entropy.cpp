@@ -0,0 +1,144 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <vector>         // std :: vector
+#include <common_stats.h> // get_marginals
+#include <class_stats.h>  // get_CEN, get_MCEN
+
+/**
+* @brief Reference implementation of CEN and MCEN with the O(Nclass^3) nested loops.
+*
+* @details This is the original evaluation path: the normalization of the class
+* is recomputed (a full loop over its row and column) for each other class.
+*
+*/
+void nested_entropy (const count_t * confusion_matrix, const int32_t & Nclass, float * CEN, float * MCEN)
+{
+  for (int32_t i = 0; i < Nclass; ++i)
+  {
+    CEN[i] = 0.f;
+    MCEN[i] = 0.f;
+
+    for (int32_t j = 0; j < Nclass; ++j)
+    {
+      if (j != i)
+      {
+        float CEN_misclassification_calc = 0.f;
+
+        for (int32_t k = 0; k < Nclass; ++k)
+          CEN_misclassification_calc += confusion_matrix[i * Nclass + k] + confusion_matrix[ k * Nclass + i];
+
+        const float MCEN_misclassification_calc = CEN_misclassification_calc - confusion_matrix[i * Nclass + i];
+
+        const float P_j_k = confusion_matrix[i * Nclass + j] / (CEN_misclassification_calc + epsil);
+        const float P_k_j = confusion_matrix[j * Nclass + i] / (CEN_misclassification_calc + epsil);
+        const float M_j_k = confusion_matrix[i * Nclass + j] / (MCEN_misclassification_calc + epsil);
+        const float M_k_j = confusion_matrix[j * Nclass + i] / (MCEN_misclassification_calc + epsil);
+
+        CEN[i] += P_j_k != 0.f ? P_j_k * (std :: log(P_j_k) / std :: log(2 * (Nclass - 1))) : 0.f;
+        CEN[i] += P_k_j != 0.f ? P_k_j * (std :: log(P_k_j) / std :: log(2 * (Nclass - 1))) : 0.f;
+        MCEN[i] += M_j_k != 0.f ? M_j_k * (std :: log(M_j_k) / std :: log(2 * (Nclass - 1))) : 0.f;
+        MCEN[i] += M_k_j != 0.f ? M_k_j * (std :: log(M_k_j) / std :: log(2 * (Nclass - 1))) : 0.f;
+      }
+    }
+
+    CEN[i] = -CEN[i];
+    MCEN[i] = -MCEN[i];
+  }
+}
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main ()
+{
+  std :: mt19937 engine (123);
+
+  std :: cout << "Confusion entropy benchmark (CEN and MCEN of a random confusion matrix)" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(16) << "nested (ms)"
+              << std :: setw(18) << "marginals (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {10, 100, 250, 500, 1000})
+  {
+    std :: uniform_int_distribution < count_t > dist (0, 100);
+
+    std :: vector < count_t > confusion_matrix (static_cast < std :: size_t >(Nclass) * Nclass);
+    for (auto & cell : confusion_matrix)
+      cell = dist(engine);
+
+    std :: vector < float > ref (2 * Nclass);
+    std :: vector < real_t > out (2 * Nclass);
+    std :: vector < count_t > marginals (3 * Nclass);
+
+    const double t_nested = timeit([&]
+    {
+      nested_entropy(confusion_matrix.data(), Nclass, ref.data(), ref.data() + Nclass);
+    });
+
+    const double t_marginals = timeit([&]
+    {
+      get_marginals(confusion_matrix.data(), Nclass, marginals.data());
+      get_CEN(confusion_matrix.data(), marginals.data(), Nclass, out.data());
+      get_MCEN(confusion_matrix.data(), marginals.data(), Nclass, out.data() + Nclass);
+    });
+
+    for (int32_t i = 0; i < 2 * Nclass; ++i)
+      if ( std :: abs(ref[i] - out[i]) > 1e-4f * (1.f + std :: abs(ref[i])) )
+      {
+        std :: cerr << "Mismatch between the entropies (Nclass = " << Nclass << ")" << std :: endl;
+        return 1;
+      }
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(16) << std :: fixed << std :: setprecision(2) << t_nested
+                << std :: setw(18) << t_marginals
+                << std :: setw(11) << t_nested / t_marginals << "x"
+                << std :: endl;
+  }
+
+  return 0;
+}
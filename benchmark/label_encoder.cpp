@@ -0,0 +1,158 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <chrono>          // std :: chrono
+#include <random>          // std :: mt19937
+#include <iostream>        // std :: cout
+#include <iomanip>         // std :: setw
+#include <string>          // std :: stoi
+#include <cstring>         // std :: memcmp
+#include <label_encoder.h> // label_encoder
+
+/**
+* @brief Reference sort-based encoding of two label arrays (as np.unique with return_inverse).
+*
+* @details The labels of both arrays are sorted, i.e O(n_lbl log n_lbl).
+*
+*/
+template < typename Less >
+int32_t sort_encoding (const int32_t & n_lbl, int32_t * code_true, int32_t * code_pred, Less && less)
+{
+  std :: vector < int64_t > order (2 * static_cast < int64_t >(n_lbl));
+  std :: iota(order.begin(), order.end(), 0);
+  std :: stable_sort(order.begin(), order.end(), less);
+
+  int32_t Nclass = 0;
+  for (std :: size_t k = 0; k < order.size(); ++k)
+  {
+    if ( k > 0 && less(order[k - 1], order[k]) )
+      ++ Nclass;
+
+    const int64_t p = order[k];
+    (p < n_lbl ? code_true[p] : code_pred[p - n_lbl]) = Nclass;
+  }
+
+  return Nclass + 1;
+}
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_lbl = argc > 1 ? std :: stoi(argv[1]) : 2000000;
+  constexpr int32_t width = 16;
+
+  std :: mt19937 engine (123);
+
+  std :: vector < int32_t > code_true (n_lbl);
+  std :: vector < int32_t > code_pred (n_lbl);
+  std :: vector < int32_t > ref_true (n_lbl);
+  std :: vector < int32_t > ref_pred (n_lbl);
+
+  label_encoder encoder;
+
+  std :: cout << "Label encoder benchmark (n_lbl = " << n_lbl << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(10) << "labels"
+              << std :: setw(16) << "sort (ms)"
+              << std :: setw(16) << "hash (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {10, 1000, 100000})
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+    std :: vector < int32_t > lbl_true (n_lbl);
+    std :: vector < int32_t > lbl_pred (n_lbl);
+
+    // fixed-width strings of the same labels (as numpy arrays of dtype S16)
+    std :: vector < uint8_t > str_true (static_cast < std :: size_t >(n_lbl) * width, 0);
+    std :: vector < uint8_t > str_pred (static_cast < std :: size_t >(n_lbl) * width, 0);
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      lbl_true[i] = dist(engine) * 613;
+      lbl_pred[i] = dist(engine) * 613;
+
+      const std :: string t = "class_" + std :: to_string(lbl_true[i]);
+      const std :: string p = "class_" + std :: to_string(lbl_pred[i]);
+      std :: copy(t.begin(), t.end(), str_true.begin() + i * width);
+      std :: copy(p.begin(), p.end(), str_pred.begin() + i * width);
+    }
+
+    auto int_label = [&] (const int64_t & p) { return p < n_lbl ? lbl_true[p] : lbl_pred[p - n_lbl]; };
+    auto str_label = [&] (const int64_t & p) { return p < n_lbl ? &str_true[p * width] : &str_pred[(p - n_lbl) * width]; };
+
+    const double t_int_sort = timeit([&]{ sort_encoding(n_lbl, ref_true.data(), ref_pred.data(), [&] (const int64_t & a, const int64_t & b) { return int_label(a) < int_label(b); }); });
+    const double t_int_hash = timeit([&]{ encoder.encode(lbl_true.data(), lbl_pred.data(), n_lbl, code_true.data(), code_pred.data()); });
+
+    if ( ref_true != code_true || ref_pred != code_pred )
+    {
+      std :: cerr << "Mismatch between the integer encodings (Nclass = " << Nclass << ")" << std :: endl;
+      return 1;
+    }
+
+    const double t_str_sort = timeit([&]{ sort_encoding(n_lbl, ref_true.data(), ref_pred.data(), [&] (const int64_t & a, const int64_t & b) { return std :: memcmp(str_label(a), str_label(b), width) < 0; }); });
+    const double t_str_hash = timeit([&]{ encoder.encode_fixed(str_true.data(), width, str_pred.data(), width, n_lbl, code_true.data(), code_pred.data()); });
+
+    if ( ref_true != code_true || ref_pred != code_pred )
+    {
+      std :: cerr << "Mismatch between the string encodings (Nclass = " << Nclass << ")" << std :: endl;
+      return 1;
+    }
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(10) << "int32"
+                << std :: setw(16) << std :: fixed << std :: setprecision(2) << t_int_sort
+                << std :: setw(16) << t_int_hash
+                << std :: setw(11) << t_int_sort / t_int_hash << "x"
+                << std :: endl;
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(10) << "S16"
+                << std :: setw(16) << t_str_sort
+                << std :: setw(16) << t_str_hash
+                << std :: setw(11) << t_str_sort / t_str_hash << "x"
+                << std :: endl;
+  }
+
+  return 0;
+}
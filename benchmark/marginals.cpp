@@ -0,0 +1,141 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <vector>         // std :: vector
+#include <common_stats.h> // get_marginals, get_TP, get_FN, get_FP, get_TN
+
+/**
+* @brief Reference implementation of TP, FN, FP and TN with a separate pass over the confusion matrix for each counter.
+*
+* @details This is the original evaluation path: FN walks the rows, FP walks
+* the columns and TN needs the row sums of the whole matrix.
+*
+*/
+void passes (const count_t * confusion_matrix, const int32_t & Nclass, count_t * TP, count_t * FN, count_t * FP, count_t * TN)
+{
+  for (int32_t i = 0; i < Nclass; ++i)
+    TP[i] = confusion_matrix[i * Nclass + i];
+
+  for (int32_t i = 0; i < Nclass; ++i)
+  {
+    const int32_t N = i * Nclass;
+    FN[i] = std :: accumulate(confusion_matrix + N, confusion_matrix + N + i, count_t(0)) +
+            std :: accumulate(confusion_matrix + N + i + 1, confusion_matrix + N + Nclass, count_t(0));
+  }
+
+  std :: fill_n(FP, Nclass, count_t(0));
+  for (int32_t i = 0; i < Nclass; ++i)
+    for (int32_t j = 0; j < Nclass; ++j)
+      FP[j] += (i != j) ? confusion_matrix[i * Nclass + j] : count_t(0);
+
+  count_t total = 0;
+  for (int32_t i = 0; i < Nclass * Nclass; ++i)
+    total += confusion_matrix[i];
+
+  for (int32_t i = 0; i < Nclass; ++i)
+    TN[i] = total - FN[i] - FP[i] - TP[i];
+}
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main ()
+{
+  std :: mt19937 engine (123);
+
+  std :: cout << "Marginals benchmark (TP, FN, FP and TN of a random confusion matrix)" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(16) << "passes (us)"
+              << std :: setw(18) << "marginals (us)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {10, 100, 1000, 4000, 8000})
+  {
+    std :: uniform_int_distribution < count_t > dist (0, 100);
+
+    std :: vector < count_t > confusion_matrix (static_cast < std :: size_t >(Nclass) * Nclass);
+    for (auto & cell : confusion_matrix)
+      cell = dist(engine);
+
+    std :: vector < count_t > ref (4 * Nclass);
+    std :: vector < count_t > out (4 * Nclass);
+    std :: vector < count_t > marginals (3 * Nclass);
+
+    // repeat the small cases to get a measurable time
+    const int32_t reps = std :: max(1, 10000000 / (Nclass * Nclass));
+
+    const double t_passes = timeit([&]
+    {
+      for (int32_t r = 0; r < reps; ++r)
+        passes(confusion_matrix.data(), Nclass, ref.data(), ref.data() + Nclass, ref.data() + 2 * Nclass, ref.data() + 3 * Nclass);
+    });
+
+    const double t_marginals = timeit([&]
+    {
+      for (int32_t r = 0; r < reps; ++r)
+      {
+        get_marginals(confusion_matrix.data(), Nclass, marginals.data());
+        get_TP(marginals.data(), Nclass, out.data());
+        get_FN(marginals.data(), Nclass, out.data() + Nclass);
+        get_FP(marginals.data(), Nclass, out.data() + 2 * Nclass);
+        get_TN(marginals.data(), Nclass, out.data() + 3 * Nclass);
+      }
+    });
+
+    if ( ref != out )
+    {
+      std :: cerr << "Mismatch between the counters (Nclass = " << Nclass << ")" << std :: endl;
+      return 1;
+    }
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(16) << std :: fixed << std :: setprecision(2) << 1e3 * t_passes / reps
+                << std :: setw(18) << 1e3 * t_marginals / reps
+                << std :: setw(11) << t_passes / t_marginals << "x"
+                << std :: endl;
+  }
+
+  return 0;
+}
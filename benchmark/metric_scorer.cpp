@@ -0,0 +1,121 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <chrono>          // std :: chrono
+#include <random>          // std :: mt19937
+#include <iostream>        // std :: cout
+#include <iomanip>         // std :: setw
+#include <string>          // std :: stoi
+#include <vector>          // std :: vector
+#include <scorer.h>        // scorer
+#include <metric_scorer.h> // metric_scorer
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_lbl = argc > 1 ? std :: stoi(argv[1]) : 1000;
+  constexpr int32_t n_reps = 2000;
+
+  std :: mt19937 engine (123);
+
+  std :: cout << "Metric scorer benchmark (F1_SCORE, MCC, overall_kappa, overall_MCC; n_lbl = " << n_lbl << ", " << n_reps << " evaluations)" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(16) << "scorer (us)"
+              << std :: setw(16) << "select (us)"
+              << std :: setw(16) << "metric (us)"
+              << std :: setw(16) << "scorer (KB)"
+              << std :: setw(16) << "metric (KB)"
+              << std :: endl;
+
+  for (const int32_t Nclass : {2, 10, 100})
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+    std :: vector < int32_t > lbl_true (n_lbl);
+    std :: vector < int32_t > lbl_pred (n_lbl);
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      lbl_true[i] = i < Nclass ? i : dist(engine);
+      lbl_pred[i] = dist(engine);
+    }
+
+    scorer full;
+    scorer lazy;
+    lazy.select({"F1_SCORE", "MCC", "overall_kappa", "overall_MCC"});
+    metric_scorer < metrics :: F1_SCORE, metrics :: MCC, metrics :: overall_kappa, metrics :: overall_MCC > score;
+
+    const double t_full = timeit([&]
+    {
+      for (int32_t r = 0; r < n_reps; ++r)
+        full.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+    });
+
+    const double t_lazy = timeit([&]
+    {
+      for (int32_t r = 0; r < n_reps; ++r)
+        lazy.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+    });
+
+    const double t_metric = timeit([&]
+    {
+      for (int32_t r = 0; r < n_reps; ++r)
+        score.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+    });
+
+    if ( score.at < metrics :: overall_MCC >() != full.overall_MCC )
+    {
+      std :: cerr << "Mismatch between the scores (Nclass = " << Nclass << ")" << std :: endl;
+      return 1;
+    }
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(16) << std :: fixed << std :: setprecision(2) << 1e3 * t_full / n_reps
+                << std :: setw(16) << 1e3 * t_lazy / n_reps
+                << std :: setw(16) << 1e3 * t_metric / n_reps
+                << std :: setw(16) << (full.arena.size() + full.workspace.size()) / 1024.
+                << std :: setw(16) << (score.arena.size() + score.workspace.size()) / 1024.
+                << std :: endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <common_stats.h> // get_classes, get_confusion_matrix
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_lbl = argc > 1 ? std :: stoi(argv[1]) : 1 << 24;
+
+#ifndef _OPENMP
+  std :: cerr << "WARNING! OpenMP support is disabled: the benchmark runs with a single thread" << std :: endl;
+  const int32_t max_threads = 1;
+#else
+  const int32_t max_threads = omp_get_max_threads();
+#endif
+
+  std :: mt19937 engine (123);
+
+  std :: cout << "Parallel confusion matrix benchmark (n_lbl = " << n_lbl << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(10) << "threads"
+              << std :: setw(16) << "time (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {4, 100, 1000, 5000})
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+    std :: vector < int32_t > lbl_true (n_lbl);
+    std :: vector < int32_t > lbl_pred (n_lbl);
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      lbl_true[i] = dist(engine);
+      lbl_pred[i] = dist(engine);
+    }
+
+    const auto classes = get_classes(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+    double t_serial = 0.;
+
+    for (int32_t nth = 1; nth <= max_threads; nth *= 2)
+    {
+#ifdef _OPENMP
+      omp_set_num_threads(nth);
+#endif
+
+      std :: unique_ptr < count_t[] > cm (new count_t[Nclass * Nclass]);
+      const double t = timeit([&]{ get_confusion_matrix(lbl_true.data(), lbl_pred.data(), n_lbl, classes.data(), Nclass, cm.get()); });
+
+      if ( nth == 1 )
+        t_serial = t;
+
+      std :: cout << std :: setw(10) << Nclass
+                  << std :: setw(10) << nth
+                  << std :: setw(16) << std :: fixed << std :: setprecision(2) << t
+                  << std :: setw(11) << t_serial / t << "x"
+                  << std :: endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>             // std :: chrono
+#include <random>             // std :: mt19937
+#include <iostream>           // std :: cout
+#include <iomanip>            // std :: setw
+#include <string>             // std :: stoi
+#include <vector>             // std :: vector
+#include <permutation_test.h> // permutation_test
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+/**
+* @brief Reference implementation of the permutation test which swaps the labels
+* and scores the permuted arrays from scratch.
+*
+* @details This is the path of a Python loop over the permutations, i.e O(n_perm * n_lbl).
+*
+*/
+double naive_permutation_test (const std :: vector < int32_t > & lbl_true, const std :: vector < int32_t > & lbl_pred_a, const std :: vector < int32_t > & lbl_pred_b, const int32_t & n_perm)
+{
+  const int32_t n_lbl = static_cast < int32_t >(lbl_true.size());
+
+  std :: mt19937 engine (42);
+  std :: bernoulli_distribution coin (.5);
+
+  std :: vector < int32_t > perm_a (n_lbl);
+  std :: vector < int32_t > perm_b (n_lbl);
+
+  scorer score_a;
+  scorer score_b;
+  score_a.select({"overall_accuracy"});
+  score_b.select({"overall_accuracy"});
+
+  score_a.compute_score(lbl_true.data(), lbl_pred_a.data(), n_lbl, n_lbl);
+  score_b.compute_score(lbl_true.data(), lbl_pred_b.data(), n_lbl, n_lbl);
+
+  const double observed = std :: abs(score_b.overall_accuracy - score_a.overall_accuracy);
+
+  int32_t extreme = 0;
+
+  for (int32_t r = 0; r < n_perm; ++r)
+  {
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      const bool swap = coin(engine);
+      perm_a[i] = swap ? lbl_pred_b[i] : lbl_pred_a[i];
+      perm_b[i] = swap ? lbl_pred_a[i] : lbl_pred_b[i];
+    }
+
+    score_a.compute_score(lbl_true.data(), perm_a.data(), n_lbl, n_lbl);
+    score_b.compute_score(lbl_true.data(), perm_b.data(), n_lbl, n_lbl);
+
+    extreme += std :: abs(score_b.overall_accuracy - score_a.overall_accuracy) >= observed;
+  }
+
+  return static_cast < double >(extreme + 1) / (n_perm + 1);
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_perm = argc > 1 ? std :: stoi(argv[1]) : 1000;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (123);
+  std :: uniform_int_distribution < int32_t > label (0, Nclass - 1);
+  std :: uniform_real_distribution < float > noise (0.f, 1.f);
+
+  std :: cout << "Permutation test benchmark (n_perm = " << n_perm << ", Nclass = " << Nclass << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "n_lbl"
+              << std :: setw(16) << "naive (ms)"
+              << std :: setw(20) << "incremental (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t n_lbl : {1000, 10000, 100000})
+  {
+    std :: vector < int32_t > lbl_true (n_lbl);
+    std :: vector < int32_t > lbl_pred_a (n_lbl);
+    std :: vector < int32_t > lbl_pred_b (n_lbl);
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      lbl_true[i] = label(engine);
+      lbl_pred_a[i] = noise(engine) < .8f ? lbl_true[i] : label(engine);
+      lbl_pred_b[i] = noise(engine) < .7f ? lbl_true[i] : label(engine);
+    }
+
+    permutation_test test (n_perm);
+    test.select({"overall_accuracy"});
+
+    const double t_naive = timeit([&]{ naive_permutation_test(lbl_true, lbl_pred_a, lbl_pred_b, n_perm); });
+    const double t_incremental = timeit([&]{ test.compute(lbl_true.data(), lbl_pred_a.data(), lbl_pred_b.data(), n_lbl); });
+
+    std :: cout << std :: setw(10) << n_lbl
+                << std :: setw(16) << std :: fixed << std :: setprecision(2) << t_naive
+                << std :: setw(20) << t_incremental
+                << std :: setw(11) << t_naive / t_incremental << "x"
+                << std :: endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <vector>         // std :: vector
+#include <scorer.h>       // scorer
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+/**
+* @brief Time (in ms) of the statistics evaluated by all the threads of a parallel region.
+*
+* @details As in the usage of compute_score the scheduler is called by the whole team.
+*
+*/
+template < typename Schedule >
+double timeit_stats (scorer & score, const int32_t & repeats, Schedule && schedule)
+{
+  return timeit([&]
+  {
+    for (int32_t r = 0; r < repeats; ++r)
+    {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      schedule(score);
+    }
+  }) / repeats;
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t repeats = argc > 1 ? std :: stoi(argv[1]) : 10;
+
+#ifndef __omp_depend__
+  std :: cerr << "WARNING! OpenMP >= 4.0 is not available: the task graph is evaluated serially" << std :: endl;
+#endif
+
+  std :: mt19937 engine (123);
+
+  std :: cout << "Statistics schedule benchmark (repeats = " << repeats << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(16) << "layers (ms)"
+              << std :: setw(16) << "tasks (ms)"
+              << std :: setw(12) << "speedup"
+              << std :: endl;
+
+  for (const int32_t Nclass : {2, 3, 10, 100, 300})
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, 100);
+
+    std :: vector < int32_t > confusion_matrix (Nclass * Nclass);
+
+    for (auto & x : confusion_matrix)
+      x = dist(engine);
+
+    scorer score;
+    score.compute_from_confusion_matrix(confusion_matrix.data(), Nclass);
+
+    const double t_layers = timeit_stats(score, repeats, [] (scorer & s) { s.compute_stats_layers(); });
+    const double t_tasks  = timeit_stats(score, repeats, [] (scorer & s) { s.compute_stats_tasks(); });
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(16) << std :: fixed << std :: setprecision(3) << t_layers
+                << std :: setw(16) << t_tasks
+                << std :: setw(11) << t_layers / t_tasks << "x"
+                << std :: endl;
+  }
+
+  return 0;
+}
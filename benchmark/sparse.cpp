@@ -0,0 +1,107 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <string>         // std :: stoi
+#include <vector>         // std :: vector
+#include <scorer.h>       // scorer
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t n_lbl = argc > 1 ? std :: stoi(argv[1]) : 1000000;
+
+  std :: mt19937 engine (123);
+  std :: uniform_real_distribution < float > noise (0.f, 1.f);
+
+  std :: cout << "Sparse confusion matrix benchmark (n_lbl = " << n_lbl << ", 90% of correct predictions)" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(12) << "nnz"
+              << std :: setw(16) << "dense (ms)"
+              << std :: setw(16) << "sparse (ms)"
+              << std :: setw(16) << "dense (MB)"
+              << std :: setw(16) << "sparse (MB)"
+              << std :: endl;
+
+  for (const int32_t Nclass : {100, 1000, 10000, 100000})
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+    std :: vector < int32_t > lbl_true (n_lbl);
+    std :: vector < int32_t > lbl_pred (n_lbl);
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      lbl_true[i] = i < Nclass ? i : dist(engine);
+      lbl_pred[i] = noise(engine) < .9f ? lbl_true[i] : dist(engine);
+    }
+
+    scorer sparse;
+    const double t_sparse = timeit([&]{ sparse.compute_sparse(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl); });
+
+    const double mb_dense = static_cast < double >(Nclass) * Nclass * sizeof(count_t) / (1 << 20);
+    const double mb_sparse = static_cast < double >(sparse.sparse.nnz()) * (sizeof(int32_t) + sizeof(count_t)) / (1 << 20);
+
+    std :: cout << std :: setw(10) << Nclass
+                << std :: setw(12) << sparse.sparse.nnz()
+                << std :: fixed << std :: setprecision(2);
+
+    // the dense evaluation is skipped when the matrix does not fit a reasonable memory
+    if ( Nclass <= 1000 )
+    {
+      scorer dense;
+      const double t_dense = timeit([&]{ dense.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl); });
+      std :: cout << std :: setw(16) << t_dense;
+    }
+    else
+      std :: cout << std :: setw(16) << "-";
+
+    std :: cout << std :: setw(16) << t_sparse
+                << std :: setw(16) << mb_dense
+                << std :: setw(16) << mb_sparse
+                << std :: endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+import time
+import argparse
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+from scorer.lib.scorer import _scorer
+
+__author__  = ['Nico Curti']
+__email__   = ['nico.curti2@unibo.it']
+
+# The evaluations release the GIL, so a pool of Python threads can score many
+# models in parallel with a single _scorer object.
+# Run it with OMP_NUM_THREADS=1 to measure only the scaling of the Python threads.
+
+def parse_args ():
+
+  description = 'Scaling of the Python thread pools over many small evaluations'
+
+  parser = argparse.ArgumentParser(description=description)
+  parser.add_argument('--n_lbl', dest='n_lbl', required=False, type=int, default=100000, help='Number of labels of each evaluation')
+  parser.add_argument('--Nclass', dest='Nclass', required=False, type=int, default=100, help='Number of classes')
+  parser.add_argument('--n_eval', dest='n_eval', required=False, type=int, default=64, help='Number of evaluations')
+
+  args = parser.parse_args()
+
+  return args
+
+
+if __name__ == '__main__':
+
+  args = parse_args()
+
+  rng = np.random.default_rng(123)
+
+  y_true = rng.integers(0, args.Nclass, size=(args.n_lbl, ), dtype=np.int32)
+  y_pred = [np.where(rng.uniform(size=(args.n_lbl, )) < .8, y_true,
+                     rng.integers(0, args.Nclass, size=(args.n_lbl, ), dtype=np.int32)).astype(np.int32)
+            for _ in range(args.n_eval)]
+
+  scorer = _scorer()
+
+  def evaluate (y_pred):
+    return scorer.evaluate(y_true, y_pred, args.n_lbl)['Overall ACC']
+
+  reference = [evaluate(y) for y in y_pred]
+
+  # the scaling is bounded by the CPUs of the process, not by the size of the pool
+  n_cpu = len(os.sched_getaffinity(0)) if hasattr(os, 'sched_getaffinity') else os.cpu_count()
+
+  print('Thread pool benchmark (n_lbl = {0}, Nclass = {1}, n_eval = {2}, CPUs = {3})\n'.format(args.n_lbl, args.Nclass, args.n_eval, n_cpu))
+
+  if n_cpu == 1:
+    print('Warning: a single CPU is available, so the thread pools cannot run faster than the serial loop\n')
+  print('{:>10}{:>16}{:>12}'.format('threads', 'time (ms)', 'speedup'))
+
+  serial = None
+
+  for n_threads in (1, 2, 4, 8):
+
+    with ThreadPoolExecutor(max_workers=n_threads) as pool:
+      tic = time.perf_counter()
+      results = list(pool.map(evaluate, y_pred))
+      elapsed = (time.perf_counter() - tic) * 1e3
+
+    if results != reference:
+      raise RuntimeError('Mismatch between the threaded and the serial results')
+
+    serial = serial or elapsed
+    print('{:>10}{:>16.2f}{:>11.2f}x'.format(n_threads, elapsed, serial / elapsed))
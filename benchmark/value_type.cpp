@@ -0,0 +1,136 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <chrono>         // std :: chrono
+#include <random>         // std :: mt19937
+#include <iostream>       // std :: cout
+#include <iomanip>        // std :: setw
+#include <vector>         // std :: vector
+#include <cmath>          // std :: abs
+#include <scorer.h>       // scorer
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+/**
+* @brief Reference Chi-Squared of the confusion matrix in extended precision.
+*
+*/
+long double chi_square_reference (const std :: vector < count_t > & confusion_matrix, const int32_t & Nclass)
+{
+  std :: vector < long double > rows (Nclass, 0.L);
+  std :: vector < long double > cols (Nclass, 0.L);
+  long double pop = 0.L;
+
+  for (int32_t i = 0; i < Nclass; ++i)
+    for (int32_t j = 0; j < Nclass; ++j)
+    {
+      rows[i] += confusion_matrix[i * Nclass + j];
+      cols[j] += confusion_matrix[i * Nclass + j];
+      pop += confusion_matrix[i * Nclass + j];
+    }
+
+  long double res = 0.L;
+  for (int32_t i = 0; i < Nclass; ++i)
+    for (int32_t j = 0; j < Nclass; ++j)
+    {
+      const long double expected = rows[i] * cols[j] / pop;
+      const long double cf = confusion_matrix[i * Nclass + j] - expected;
+      res += cf * cf / expected;
+    }
+
+  return res;
+}
+
+
+int main ()
+{
+  std :: mt19937 engine (123);
+
+  // the same benchmark must be run with a build with the DOUBLE option to compare the two value types
+  std :: cout << "Value type benchmark (real_t = " << (sizeof(real_t) == sizeof(double) ? "double" : "float") << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "Nclass"
+              << std :: setw(14) << "POP"
+              << std :: setw(16) << "scores (ms)"
+              << std :: setw(20) << "class stats (M/s)"
+              << std :: setw(22) << "chi-square rel. err"
+              << std :: endl;
+
+  for (const int32_t Nclass : {10, 100, 1000})
+  {
+    for (const count_t scale : {count_t(100), count_t(10000000)})
+    {
+      // random confusion matrix with a dominant diagonal
+      std :: uniform_int_distribution < count_t > dist (0, scale);
+
+      std :: vector < count_t > confusion_matrix (static_cast < std :: size_t >(Nclass) * Nclass);
+      for (int32_t i = 0; i < Nclass; ++i)
+        for (int32_t j = 0; j < Nclass; ++j)
+          confusion_matrix[i * Nclass + j] = dist(engine) + (i == j ? 4 * scale : 0);
+
+      scorer score;
+      score.compute_from_confusion_matrix(confusion_matrix.data(), Nclass);
+
+      // repeat the small cases to get a measurable time
+      const int32_t reps = std :: max(1, 1000000 / (Nclass * Nclass));
+
+      const double t_score = timeit([&]
+      {
+        for (int32_t r = 0; r < reps; ++r)
+          score.compute_from_confusion_matrix(confusion_matrix.data(), Nclass);
+      }) / reps;
+
+      int32_t class_stats = 0;
+      for (int32_t k = 0; k < scorer :: n_stats; ++k)
+        class_stats += score.stat_size(k) == Nclass;
+
+      const long double reference = chi_square_reference(confusion_matrix, Nclass);
+
+      std :: cout << std :: setw(10) << Nclass
+                  << std :: setw(14) << score.POP[0]
+                  << std :: setw(16) << std :: fixed << std :: setprecision(3) << t_score
+                  << std :: setw(20) << std :: setprecision(1) << class_stats * 1e-3 * Nclass / t_score
+                  << std :: setw(22) << std :: scientific << std :: setprecision(2) << static_cast < double >(std :: abs((score.chi_square - reference) / reference))
+                  << std :: defaultfloat
+                  << std :: endl;
+    }
+  }
+
+  return 0;
+}
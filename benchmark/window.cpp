@@ -0,0 +1,123 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#include <chrono>                // std :: chrono
+#include <random>                // std :: mt19937
+#include <iostream>              // std :: cout
+#include <iomanip>               // std :: setw
+#include <string>                // std :: stoi
+#include <vector>                // std :: vector
+#include <scorer.h>              // scorer
+#include <window_accumulator.h>  // window_accumulator
+#include <decayed_accumulator.h> // decayed_accumulator
+
+/**
+* @brief Time (in ms) of the given function.
+*
+*/
+template < typename Func >
+double timeit (Func && func)
+{
+  auto start = std :: chrono :: high_resolution_clock :: now();
+  func();
+  auto stop = std :: chrono :: high_resolution_clock :: now();
+  return std :: chrono :: duration < double, std :: milli >(stop - start).count();
+}
+
+
+int main (int argc, char ** argv)
+{
+  const int32_t capacity = argc > 1 ? std :: stoi(argv[1]) : 100000;
+  constexpr int32_t n_lbl = 2000000;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (123);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = dist(engine);
+    lbl_pred[i] = dist(engine);
+  }
+
+  std :: cout << "Sliding window benchmark (window = " << capacity << ", events = " << n_lbl << ")" << std :: endl << std :: endl;
+  std :: cout << std :: setw(10) << "tick"
+              << std :: setw(20) << "recompute (ev/s)"
+              << std :: setw(20) << "window (ev/s)"
+              << std :: setw(20) << "decayed (ev/s)"
+              << std :: endl;
+
+  // a tick is a batch of events followed by a read of the scores
+  for (const int32_t tick : {100, 1000, 10000})
+  {
+    scorer score;
+    weighted_scorer weighted;
+
+    // the recomputation of the full window is measured on the first ticks only
+    const int32_t n_recompute = std :: min(n_lbl - capacity, 100 * tick);
+
+    const double t_recompute = timeit([&]
+    {
+      for (int32_t end = capacity + tick; end <= capacity + n_recompute; end += tick)
+        score.compute_score(lbl_true.data() + end - capacity, lbl_pred.data() + end - capacity, capacity, capacity);
+    });
+
+    window_accumulator window (capacity);
+
+    const double t_window = timeit([&]
+    {
+      for (int32_t begin = 0; begin + tick <= n_lbl; begin += tick)
+      {
+        window.update(lbl_true.data() + begin, lbl_pred.data() + begin, tick);
+        window.finalize(score);
+      }
+    });
+
+    decayed_accumulator decayed (1. - 1. / capacity);
+
+    const double t_decayed = timeit([&]
+    {
+      for (int32_t begin = 0; begin + tick <= n_lbl; begin += tick)
+      {
+        decayed.update(lbl_true.data() + begin, lbl_pred.data() + begin, tick);
+        decayed.finalize(weighted);
+      }
+    });
+
+    std :: cout << std :: setw(10) << tick
+                << std :: setw(20) << std :: fixed << std :: setprecision(0) << n_recompute / t_recompute * 1e3
+                << std :: setw(20) << n_lbl / t_window * 1e3
+                << std :: setw(20) << n_lbl / t_decayed * 1e3
+                << std :: endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,224 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __batch_scorer_h__
+#define __batch_scorer_h__
+
+#include <memory>           // std :: unique_ptr
+#include <vector>           // std :: vector
+#include <string>           // std :: string
+#include <cstdint>          // int32_t
+
+#include <scorer.h>         // scorer
+#include <parallel_utils.h> // parallel_chunks, serial_team
+
+/**
+* @class batch_scorer
+* @brief Evaluation of many pairs of (true, predicted) label arrays in a single call.
+*
+* @details With small label arrays (e.g. hyperparameter search or bootstrap) the cost
+* of compute_score is dominated by the scheduling of the statistics, so the batch is
+* parallelized across the evaluations: each evaluation is computed by a single thread
+* into its own scorer. The scorers (and their arenas) are kept between the calls, so
+* the following batches of the same size do not allocate new memory.
+*
+*/
+class batch_scorer
+{
+
+  std :: vector < std :: unique_ptr < scorer > > scores; ///< result of each evaluation
+
+  std :: vector < std :: string > metrics; ///< statistics selected for the evaluations (see select)
+  std :: vector < int32_t > classes;       ///< fixed classes of the evaluations (see set_classes)
+
+  std :: vector < const int32_t * > true_view; ///< true labels of each evaluation (column layout)
+  std :: vector < const int32_t * > pred_view; ///< predicted labels of each evaluation (column layout)
+  std :: vector < int32_t > sizes;             ///< number of labels of each evaluation (column layout)
+
+  int32_t K; ///< number of evaluations of the last batch
+
+public:
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  batch_scorer () : K (0)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~batch_scorer () = default;
+
+  /**
+  * @brief Select the statistics to evaluate for all the evaluations (see scorer :: select).
+  *
+  * @param metrics names of the statistics (an empty list selects all of them)
+  *
+  * @return False if some name is not a statistic (the selection is not modified).
+  */
+  bool select (const std :: vector < std :: string > & metrics)
+  {
+    scorer probe;
+
+    if ( !probe.select(metrics) )
+      return false;
+
+    this->metrics = metrics;
+
+    for (auto & score : this->scores)
+      score->select(metrics);
+
+    return true;
+  }
+
+  /**
+  * @brief Fix the set of classes of all the evaluations (see scorer :: set_classes).
+  *
+  * @param classes array of classes
+  * @param Nclass size of classes array (0 restores the detection of the classes from the labels)
+  *
+  */
+  void set_classes (const int32_t * classes, const int32_t & Nclass)
+  {
+    this->classes.assign(classes, classes + Nclass);
+
+    for (auto & score : this->scores)
+      score->set_classes(classes, Nclass);
+  }
+
+  /**
+  * @brief Compute the scores of K pairs of label arrays.
+  *
+  * @details As scorer :: compute_score the function can be called by all the
+  * threads of a parallel region: the evaluations are distributed over the team.
+  * Outside a parallel region a new one is opened.
+  *
+  * @param lbl_true array of K pointers to the true labels
+  * @param lbl_pred array of K pointers to the predicted labels
+  * @param n_lbl array of K sizes of the label arrays
+  * @param K number of evaluations
+  *
+  */
+  void compute_score (const int32_t * const * lbl_true, const int32_t * const * lbl_pred, const int32_t * n_lbl, const int32_t & K)
+  {
+#ifdef _OPENMP
+#pragma omp single
+#endif
+    {
+      this->resize(K);
+
+      const int32_t nchunks = num_chunks(K, 1);
+
+      parallel_chunks(nchunks, [&] (const int32_t & c)
+      {
+        const int64_t end = chunk_begin(K, c + 1, nchunks);
+
+        for (int64_t k = chunk_begin(K, c, nchunks); k < end; ++k)
+          serial_team([&] { this->scores[k]->compute_score(lbl_true[k], lbl_pred[k], n_lbl[k], n_lbl[k]); });
+      });
+    }
+  }
+
+  /**
+  * @brief Compute the scores of K predictions of the same true labels.
+  *
+  * @param lbl_true array of true labels (n_lbl)
+  * @param lbl_pred predicted labels as ravel matrix (K, n_lbl), i.e. one prediction after the other
+  * @param n_lbl number of labels
+  * @param K number of predictions
+  *
+  */
+  void compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl, const int32_t & K)
+  {
+#ifdef _OPENMP
+#pragma omp single
+#endif
+    {
+      this->true_view.assign(K, lbl_true);
+      this->pred_view.resize(K);
+      this->sizes.assign(K, n_lbl);
+
+      for (int32_t k = 0; k < K; ++k)
+        this->pred_view[k] = lbl_pred + static_cast < int64_t >(k) * n_lbl;
+    }
+
+    this->compute_score(this->true_view.data(), this->pred_view.data(), this->sizes.data(), K);
+  }
+
+  /**
+  * @brief Number of evaluations of the last batch.
+  *
+  */
+  int32_t size () const
+  {
+    return this->K;
+  }
+
+  /**
+  * @brief Scores of the k-th evaluation of the last batch.
+  *
+  * @param k index of the evaluation
+  *
+  */
+  scorer & operator[] (const int32_t & k)
+  {
+    return *this->scores[k];
+  }
+
+private:
+
+  /**
+  * @brief Set the number of evaluations, creating the missing scorers.
+  *
+  * @param K number of evaluations
+  *
+  */
+  void resize (const int32_t & K)
+  {
+    while ( static_cast < int32_t >(this->scores.size()) < K )
+    {
+      std :: unique_ptr < scorer > score (new scorer());
+
+      score->select(this->metrics);
+
+      if ( !this->classes.empty() )
+        score->set_classes(this->classes.data(), static_cast < int32_t >(this->classes.size()));
+
+      this->scores.push_back(std :: move(score));
+    }
+
+    this->K = K;
+  }
+
+};
+
+#endif // __batch_scorer_h__
@@ -0,0 +1,298 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __bootstrap_h__
+#define __bootstrap_h__
+
+#include <memory>           // std :: unique_ptr
+#include <vector>           // std :: vector
+#include <string>           // std :: string
+#include <random>           // std :: mt19937_64
+#include <algorithm>        // std :: sort
+#include <cmath>            // std :: isnan
+#include <limits>           // std :: numeric_limits
+#include <cstdint>          // int32_t
+
+#include <scorer.h>         // scorer
+#include <stat_selection.h> // stat_selection
+#include <parallel_utils.h> // parallel_chunks, serial_team, replicate_seed
+
+/**
+* @class bootstrap
+* @brief Bootstrap confidence intervals of the statistics evaluated on a confusion matrix.
+*
+* @details Each replicate resamples the confusion matrix row by row: the counts of
+* the i-th row are a multinomial draw with the size of the row (number of samples of
+* the i-th true class) and probabilities given by the observed counts. So the cost of
+* a replicate depends only on the number of classes, not on the number of samples.
+* The statistics of each replicate are evaluated by compute_from_confusion_matrix and
+* the intervals are given by the percentiles of the replicates.
+* Each replicate draws from its own random engine (see replicate_seed).
+*
+*/
+class bootstrap
+{
+
+  std :: vector < std :: unique_ptr < scorer > > workers; ///< scorer of each chunk of replicates
+
+  stat_selection stats; ///< statistics to resample
+
+  std :: vector < double > samples;    ///< values of the replicates as matrix (n_values, n_reps)
+  std :: vector < count_t > resampled; ///< resampled confusion matrices of each chunk
+
+  std :: vector < real_t > lower; ///< lower bounds of the intervals
+  std :: vector < real_t > upper; ///< upper bounds of the intervals
+
+  int32_t n_reps; ///< number of replicates
+  uint64_t seed;  ///< seed of the random engines
+
+public:
+
+  /**
+  * @brief Construct the bootstrap engine.
+  *
+  * @param n_reps number of replicates
+  * @param seed seed of the random engines
+  *
+  */
+  bootstrap (const int32_t & n_reps = 1000, const uint64_t & seed = 42) : n_reps (n_reps), seed (seed)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~bootstrap () = default;
+
+  /**
+  * @brief Select the statistics to resample.
+  *
+  * @details Only the selected statistics (and their dependencies) are evaluated by
+  * the replicates. An empty list selects all the class and overall statistics.
+  *
+  * @param metrics names of the statistics (as the members of scorer, e.g. ACC or overall_accuracy)
+  *
+  * @return False if some name is not a score (the selection is not modified).
+  */
+  bool select (const std :: vector < std :: string > & metrics)
+  {
+    return this->stats.select(metrics);
+  }
+
+  /**
+  * @brief Compute the bootstrap intervals of the selected statistics.
+  *
+  * @details As scorer :: compute_score the function can be called by all the
+  * threads of a parallel region: the replicates are distributed over the team.
+  * Outside a parallel region a new one is opened.
+  *
+  * @param confusion_matrix confusion matrix as ravel array (Nclass * Nclass) with true labels along the rows
+  * @param Nclass number of classes
+  * @param classes array of classes in the order of the rows (if nullptr the classes are 0, ..., Nclass - 1)
+  * @param alpha significance level, i.e. the intervals cover the (1 - alpha) of the replicates
+  *
+  */
+  void compute (const count_t * confusion_matrix, const int32_t & Nclass, const float * classes = nullptr, const float & alpha = .05f)
+  {
+#ifdef _OPENMP
+#pragma omp single
+#endif
+    {
+      const int64_t Ncell = static_cast < int64_t >(Nclass) * Nclass;
+
+      this->stats.layout(Nclass);
+
+      const int32_t n_values = this->stats.values();
+      const int32_t nchunks = num_chunks(this->n_reps, 1);
+
+      while ( static_cast < int32_t >(this->workers.size()) < nchunks )
+        this->workers.emplace_back(new scorer());
+
+      this->samples.resize(static_cast < std :: size_t >(n_values) * this->n_reps);
+      this->resampled.resize(Ncell * nchunks);
+
+      parallel_chunks(nchunks, [&] (const int32_t & c)
+      {
+        scorer & score = *this->workers[c];
+        count_t * cm = this->resampled.data() + Ncell * c;
+
+        score.select(this->stats.names());
+
+        const int64_t end = chunk_begin(this->n_reps, c + 1, nchunks);
+
+        for (int64_t r = chunk_begin(this->n_reps, c, nchunks); r < end; ++r)
+        {
+          this->resample(confusion_matrix, Nclass, r, cm);
+
+          serial_team([&] { score.compute_from_confusion_matrix(cm, Nclass, classes); });
+
+          this->stats.extract(score, this->samples.data() + r, this->n_reps);
+        }
+      });
+
+      this->lower.resize(n_values);
+      this->upper.resize(n_values);
+
+      const int32_t vchunks = num_chunks(n_values, 16);
+
+      parallel_chunks(vchunks, [&] (const int32_t & c)
+      {
+        const int64_t end = chunk_begin(n_values, c + 1, vchunks);
+
+        for (int64_t v = chunk_begin(n_values, c, vchunks); v < end; ++v)
+          this->percentiles(this->samples.data() + v * this->n_reps, alpha, this->lower[v], this->upper[v]);
+      });
+    }
+  }
+
+  /**
+  * @brief Lower bounds of the interval of a statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return Pointer to the bounds (Nclass values for the class statistics, 1 for the overall ones)
+  * or nullptr if the statistic was not resampled.
+  */
+  const real_t * ci_down (const std :: string & name) const
+  {
+    const int32_t v = this->stats.find(name);
+    return v < 0 ? nullptr : this->lower.data() + v;
+  }
+
+  /**
+  * @brief Upper bounds of the interval of a statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return Pointer to the bounds (Nclass values for the class statistics, 1 for the overall ones)
+  * or nullptr if the statistic was not resampled.
+  */
+  const real_t * ci_up (const std :: string & name) const
+  {
+    const int32_t v = this->stats.find(name);
+    return v < 0 ? nullptr : this->upper.data() + v;
+  }
+
+  /**
+  * @brief Number of values of a resampled statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return The number of values (0 if the statistic was not resampled).
+  */
+  int32_t size (const std :: string & name) const
+  {
+    return this->stats.size(name);
+  }
+
+private:
+
+  /**
+  * @brief Multinomial resampling of each row of the confusion matrix.
+  *
+  * @details The multinomial draw is performed as a sequence of binomial draws
+  * over the remaining samples of the row.
+  *
+  * @param confusion_matrix observed confusion matrix
+  * @param Nclass number of classes
+  * @param r index of the replicate
+  * @param cm resampled confusion matrix
+  *
+  */
+  void resample (const count_t * confusion_matrix, const int32_t & Nclass, const int64_t & r, count_t * cm) const
+  {
+    std :: mt19937_64 engine (replicate_seed(this->seed, r));
+
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      const count_t * row = confusion_matrix + static_cast < int64_t >(i) * Nclass;
+      count_t * out = cm + static_cast < int64_t >(i) * Nclass;
+
+      count_t rest = 0;
+      for (int32_t j = 0; j < Nclass; ++j)
+        rest += row[j];
+
+      count_t remaining = rest;
+
+      for (int32_t j = 0; j < Nclass; ++j)
+      {
+        if ( remaining == 0 || row[j] == rest )
+        {
+          out[j] = remaining;
+          remaining = 0;
+        }
+        else
+        {
+          std :: binomial_distribution < int64_t > draw (static_cast < int64_t >(remaining), static_cast < double >(row[j]) / rest);
+          out[j] = static_cast < count_t >(draw(engine));
+          remaining -= out[j];
+        }
+
+        rest -= row[j];
+      }
+    }
+  }
+
+  /**
+  * @brief Percentile interval of the replicates (linear interpolation, NaN values are discarded).
+  *
+  * @param values values of the replicates (they are sorted in place)
+  * @param alpha significance level
+  * @param lower lower bound
+  * @param upper upper bound
+  *
+  */
+  void percentiles (double * values, const float & alpha, real_t & lower, real_t & upper) const
+  {
+    double * end = std :: remove_if(values, values + this->n_reps, [] (const double & x) { return std :: isnan(x); });
+    const int64_t n = std :: distance(values, end);
+
+    if ( n == 0 )
+    {
+      lower = upper = std :: numeric_limits < real_t > :: quiet_NaN();
+      return;
+    }
+
+    std :: sort(values, end);
+
+    auto quantile = [&] (const double & q)
+    {
+      const double pos = q * (n - 1);
+      const int64_t lo = static_cast < int64_t >(pos);
+      const int64_t hi = std :: min(lo + 1, n - 1);
+      return static_cast < real_t >(values[lo] + (pos - lo) * (values[hi] - values[lo]));
+    };
+
+    lower = quantile(.5 * alpha);
+    upper = quantile(1. - .5 * alpha);
+  }
+
+};
+
+#endif // __bootstrap_h__
@@ -42,25 +42,26 @@
 * @param TP array of true positives
 * @param FP array of false positives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the number of positives outcomes for each class.
+* @param TOP output array of the number of positives outcomes for each class.
 */
 struct // TOP(Test outcome positive)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const int32_t & Nclass, count_type * TOP)
   {
-    std :: unique_ptr < float[] > TOP (new float[Nclass]);
-    std :: transform(TP, TP + Nclass, FP, TOP.get(),
-                     [](const float & tp, const float & fp)
-                     {
-                        return tp + fp;
-                     });
-    return TOP;
+    for (int32_t i = 0; i < Nclass; ++i)
+      TOP[i] = (*this)(TP[i], FP[i]);
+  }
+
+  template < typename count_type >
+  count_type operator() (const count_type & TP, const count_type & FP) const
+  {
+    return TP + FP;
   }
   /// @endcond
 
-} get_TOP;
+} get_TOP __unused;
 
 /**
 * @brief Number of negative outcomes.
@@ -73,24 +74,25 @@ struct // TOP(Test outcome positive)
 * @param TN array of true negatives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the number of negative outcomes for each class.
+* @param TON output array of the number of negative outcomes for each class.
 */
 struct // TON(Test outcome negative)
 {
   /// @cond DEF
-  auto operator() (const float * TN, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TN, const count_type * FN, const int32_t & Nclass, count_type * TON)
   {
-    std :: unique_ptr < float[] > TON (new float[Nclass]);
-    std :: transform(TN, TN + Nclass, FN, TON.get(),
-                     [](const float & tn, const float & fn)
-                     {
-                        return tn + fn;
-                     });
-    return TON;
+    for (int32_t i = 0; i < Nclass; ++i)
+      TON[i] = (*this)(TN[i], FN[i]);
+  }
+
+  template < typename count_type >
+  count_type operator() (const count_type & TN, const count_type & FN) const
+  {
+    return TN + FN;
   }
   /// @endcond
-} get_TON;
+} get_TON __unused;
 
 /**
 * @brief True positive rates
@@ -107,24 +109,24 @@ struct // TON(Test outcome negative)
 * @param TP array of true positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the true positive rate outcomes for each class.
+* @param TPR output array of the true positive rate outcomes for each class.
 */
 struct // TPR(Sensitivity / recall / hit rate / true positive rate)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FN, const int32_t & Nclass, real_t * TPR)
   {
-    std :: unique_ptr < float[] > TPR (new float[Nclass]);
-    std :: transform(TP, TP + Nclass, FN, TPR.get(),
-                     [](const float & i1, const float & i2)
-                     {
-                        return i1 / (i1 + i2 + epsil);
-                     });
-    return TPR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      TPR[i] = (*this)(TP[i], FN[i]);
+  }
+
+  real_t operator() (const real_t & TP, const real_t & FN) const
+  {
+    return TP / (TP + FN + epsil);
   }
   /// @endcond
-} get_TPR;
+} get_TPR __unused;
 
 /**
 * @brief True negative rates
@@ -141,24 +143,24 @@ struct // TPR(Sensitivity / recall / hit rate / true positive rate)
 * @param TN array of true negatives
 * @param FP array of false positives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the true negative rate outcomes for each class.
+* @param TNR output array of the true negative rate outcomes for each class.
 */
 struct // TNR(Specificity or true negative rate)
 {
   /// @cond DEF
-  auto operator() (const float * TN, const float * FP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TN, const count_type * FP, const int32_t & Nclass, real_t * TNR)
   {
-    std :: unique_ptr < float[] > TNR (new float[Nclass]);
-    std :: transform(TN, TN + Nclass, FP, TNR.get(),
-                     [](const float & i1, const float & i2)
-                     {
-                        return i1 / (i1 + i2 + epsil);
-                     });
-    return TNR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      TNR[i] = (*this)(TN[i], FP[i]);
+  }
+
+  real_t operator() (const real_t & TN, const real_t & FP) const
+  {
+    return TN / (TN + FP + epsil);
   }
   /// @endcond
-} get_TNR;
+} get_TNR __unused;
 
 /**
 * @brief Positive predictive value
@@ -173,24 +175,24 @@ struct // TNR(Specificity or true negative rate)
 * @param TP array of true positives
 * @param FP array of false positives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the positive predicted values for each class.
+* @param PPV output array of the positive predicted values for each class.
 */
 struct // PPV(Precision or positive predictive value)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const int32_t & Nclass, real_t * PPV)
   {
-    std :: unique_ptr < float[] > PPV (new float[Nclass]);
-    std :: transform(TP, TP + Nclass, FP, PPV.get(),
-                     [](const float & i1, const float & i2)
-                     {
-                        return i1 / (i1 + i2 + epsil);
-                     });
-    return PPV;
+    for (int32_t i = 0; i < Nclass; ++i)
+      PPV[i] = (*this)(TP[i], FP[i]);
+  }
+
+  real_t operator() (const real_t & TP, const real_t & FP) const
+  {
+    return TP / (TP + FP + epsil);
   }
   /// @endcond
-} get_PPV;
+} get_PPV __unused;
 
 /**
 * @brief Negative predictive value
@@ -205,24 +207,24 @@ struct // PPV(Precision or positive predictive value)
 * @param TP array of true negatives
 * @param FP array of false negatives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the negative predicted values for each class.
+* @param NPV output array of the negative predicted values for each class.
 */
 struct // NPV(Negative predictive value)
 {
   /// @cond DEF
-  auto operator() (const float * TN, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TN, const count_type * FN, const int32_t & Nclass, real_t * NPV)
   {
-    std :: unique_ptr < float[] > NPV (new float[Nclass]);
-    std :: transform(TN, TN + Nclass, FN, NPV.get(),
-                     [](const float & i1, const float & i2)
-                     {
-                        return i1 / (i1 + i2 + epsil);
-                     });
-    return NPV;
+    for (int32_t i = 0; i < Nclass; ++i)
+      NPV[i] = (*this)(TN[i], FN[i]);
+  }
+
+  real_t operator() (const real_t & TN, const real_t & FN) const
+  {
+    return TN / (TN + FN + epsil);
   }
   /// @endcond
-} get_NPV;
+} get_NPV __unused;
 
 /**
 * @brief False negative rate
@@ -237,24 +239,23 @@ struct // NPV(Negative predictive value)
 *
 * @param TPR array of true positive rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the false negative rates for each class.
+* @param FNR output array of the false negative rates for each class.
 */
 struct // FNR(Miss rate or false negative rate)
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * TPR, const int32_t & Nclass, real_t * FNR)
   {
-    std :: unique_ptr < float[] > FNR (new float[Nclass]);
-    std :: transform(TPR, TPR + Nclass, FNR.get(),
-                     [](const float & item)
-                     {
-                        return 1.f - item;
-                     });
-    return FNR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      FNR[i] = (*this)(TPR[i]);
+  }
+
+  real_t operator() (const real_t & TPR) const
+  {
+    return 1.f - TPR;
   }
   /// @endcond
-} get_FNR;
+} get_FNR __unused;
 
 /**
 * @brief False positive rate
@@ -271,24 +272,23 @@ struct // FNR(Miss rate or false negative rate)
 *
 * @param TNR array of true negative rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the false positive rates for each class.
+* @param FPR output array of the false positive rates for each class.
 */
 struct // FPR(Fall-out or false positive rate)
 {
   /// @cond DEF
-  auto operator() (const float * TNR, const int32_t & Nclass)
+  auto operator() (const real_t * TNR, const int32_t & Nclass, real_t * FPR)
   {
-    std :: unique_ptr < float[] > FPR (new float[Nclass]);
-    std :: transform(TNR, TNR + Nclass, FPR.get(),
-                     [](const float & item)
-                     {
-                        return 1.f - item;
-                     });
-    return FPR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      FPR[i] = (*this)(TNR[i]);
+  }
+
+  real_t operator() (const real_t & TNR) const
+  {
+    return 1.f - TNR;
   }
   /// @endcond
-} get_FPR;
+} get_FPR __unused;
 
 /**
 * @brief False discovery rate
@@ -305,24 +305,23 @@ struct // FPR(Fall-out or false positive rate)
 *
 * @param PPV array of positive predictive values
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the false discovery rates for each class.
+* @param FDR output array of the false discovery rates for each class.
 */
 struct // FDR(False discovery rate)
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const int32_t & Nclass, real_t * FDR)
   {
-    std :: unique_ptr < float[] > FDR (new float[Nclass]);
-    std :: transform(PPV, PPV + Nclass, FDR.get(),
-                     [](const float & item)
-                     {
-                        return 1.f - item;
-                     });
-    return FDR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      FDR[i] = (*this)(PPV[i]);
+  }
+
+  real_t operator() (const real_t & PPV) const
+  {
+    return 1.f - PPV;
   }
   /// @endcond
-} get_FDR;
+} get_FDR __unused;
 
 /**
 * @brief False omission rate
@@ -338,24 +337,23 @@ struct // FDR(False discovery rate)
 *
 * @param NPV array of negative predictive values
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the false omission rates for each class.
+* @param FOR output array of the false omission rates for each class.
 */
 struct // FOR(False omission rate)
 {
   /// @cond DEF
-  auto operator() (const float * NPV, const int32_t & Nclass)
+  auto operator() (const real_t * NPV, const int32_t & Nclass, real_t * FOR)
   {
-    std :: unique_ptr < float[] > FOR (new float[Nclass]);
-    std :: transform(NPV, NPV + Nclass, FOR.get(),
-                     [](const float & item)
-                     {
-                        return 1.f - item;
-                     });
-    return FOR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      FOR[i] = (*this)(NPV[i]);
+  }
+
+  real_t operator() (const real_t & NPV) const
+  {
+    return 1.f - NPV;
   }
   /// @endcond
-} get_FOR;
+} get_FOR __unused;
 
 /**
 * @brief Accuracy
@@ -372,21 +370,25 @@ struct // FOR(False omission rate)
 * @param FN array of false negative
 * @param TN array of true negatives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of accuracies for each class.
+* @param ACC output array of accuracies for each class.
 */
 struct // ACC(Accuracy)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const float * FN, const float * TN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const count_type * FN, const count_type * TN, const int32_t & Nclass, real_t * ACC)
   {
-    std :: unique_ptr < float[] > ACC (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      ACC[i] = ( TP[i] + TN[i] ) / (TP[i] + TN[i] + FN[i] + FP[i] + epsil);
-    return ACC;
+      ACC[i] = (*this)(TP[i], FP[i], FN[i], TN[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & FP, const count_type & FN, const count_type & TN) const
+  {
+    return ( TP + TN ) / (TP + TN + FN + FP + epsil);
   }
   /// @endcond
-} get_ACC;
+} get_ACC __unused;
 
 /**
 * @brief Fbeta-score
@@ -408,21 +410,25 @@ struct // ACC(Accuracy)
 * @param FP array of false positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of F1 scores for each class.
+* @param F1_SCORE output array of F1 scores for each class.
 */
 struct // F1(F1 score - harmonic mean of precision and sensitivity)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const count_type * FN, const int32_t & Nclass, real_t * F1_SCORE)
   {
-    std :: unique_ptr < float[] > F1_SCORE (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      F1_SCORE[i] = (2.f * TP[i]) / (2.f * TP[i] + FP[i] + FN[i] + epsil);
-    return F1_SCORE;
+      F1_SCORE[i] = (*this)(TP[i], FP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & FP, const count_type & FN) const
+  {
+    return (2.f * TP) / (2.f * TP + FP + FN + epsil);
   }
   /// @endcond
-} get_F1_SCORE;
+} get_F1_SCORE __unused;
 
 /**
 * @brief Fbeta-score
@@ -444,21 +450,25 @@ struct // F1(F1 score - harmonic mean of precision and sensitivity)
 * @param FP array of false positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of F1 scores for each class.
+* @param F05_SCORE output array of F1 scores for each class.
 */
 struct // F0.5(F0.5 score)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const count_type * FN, const int32_t & Nclass, real_t * F05_SCORE)
   {
-    std :: unique_ptr < float[] > F05_SCORE (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      F05_SCORE[i] = (1.25f * TP[i]) / (1.25f * TP[i] + FP[i] + .25f * FN[i] + epsil);
-    return F05_SCORE;
+      F05_SCORE[i] = (*this)(TP[i], FP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & FP, const count_type & FN) const
+  {
+    return (1.25f * TP) / (1.25f * TP + FP + .25f * FN + epsil);
   }
   /// @endcond
-} get_F05_SCORE;
+} get_F05_SCORE __unused;
 
 /**
 * @brief Fbeta-score
@@ -480,21 +490,25 @@ struct // F0.5(F0.5 score)
 * @param FP array of false positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of F1 scores for each class.
+* @param F2_SCORE output array of F1 scores for each class.
 */
 struct // F2(F2 score)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const count_type * FN, const int32_t & Nclass, real_t * F2_SCORE)
   {
-    std :: unique_ptr < float[] > F2_SCORE (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      F2_SCORE[i] = (5.f * TP[i]) / (5.f * TP[i] + FP[i] + 4.f * FN[i] + epsil);
-    return F2_SCORE;
+      F2_SCORE[i] = (*this)(TP[i], FP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & FP, const count_type & FN) const
+  {
+    return (5.f * TP) / (5.f * TP + FP + 4.f * FN + epsil);
   }
   /// @endcond
-} get_F2_SCORE;
+} get_F2_SCORE __unused;
 
 /**
 * @brief Matthews correlation coefficient
@@ -518,24 +532,33 @@ struct // F2(F2 score)
 * @param FP array of false positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of MCC scores for each class.
+* @param MCC output array of MCC scores for each class.
 */
 struct // MCC(Matthews correlation coefficient)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TN, const float * FP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TN, const count_type * FP, const count_type * FN, const int32_t & Nclass, real_t * MCC)
   {
-    std :: unique_ptr < float[] > MCC (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      MCC[i] = (TP[i] * TN[i] - FP[i] * FN[i]) / (std :: sqrt( (TP[i] + FP[i]) *
-                                                               (TP[i] + FN[i]) *
-                                                               (TN[i] + FP[i]) *
-                                                               (TN[i] + FN[i]) ) + epsil);
-    return MCC;
+      MCC[i] = (*this)(TP[i], TN[i], FP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & TN, const count_type & FP, const count_type & FN) const
+  {
+    const real_t tp = TP;
+    const real_t tn = TN;
+    const real_t fp = FP;
+    const real_t fn = FN;
+
+    return (tp * tn - fp * fn) / (std :: sqrt( (tp + fp) *
+                                  (tp + fn) *
+                                  (tn + fp) *
+                                  (tn + fn) ) + epsil);
   }
   /// @endcond
-} get_MCC;
+} get_MCC __unused;
 
 /**
 * @brief Bookmaker informedness
@@ -552,24 +575,23 @@ struct // MCC(Matthews correlation coefficient)
 * @param TPR array of true positive rates
 * @param TNR array of true negative rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of BM scores for each class.
+* @param BM output array of BM scores for each class.
 */
 struct // BM(Informedness or bookmaker informedness)
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const float * TNR, const int32_t & Nclass)
+  auto operator() (const real_t * TPR, const real_t * TNR, const int32_t & Nclass, real_t * BM)
   {
-    std :: unique_ptr < float[] > BM (new float[Nclass]);
-    std :: transform(TPR, TPR + Nclass, TNR, BM.get(),
-                     [](const float & tp, const float & tn)
-                     {
-                        return tp + tn - 1.f;
-                     });
-    return BM;
+    for (int32_t i = 0; i < Nclass; ++i)
+      BM[i] = (*this)(TPR[i], TNR[i]);
+  }
+
+  real_t operator() (const real_t & TPR, const real_t & TNR) const
+  {
+    return TPR + TNR - 1.f;
   }
   /// @endcond
-} get_BM;
+} get_BM __unused;
 
 /**
 * @brief Markedness
@@ -585,24 +607,23 @@ struct // BM(Informedness or bookmaker informedness)
 * @param PPV array of positive predictive values
 * @param NPV array of negative predictive values
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of MK scores for each class.
+* @param MK output array of MK scores for each class.
 */
 struct // MK(Markedness)
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const float * NPV, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const real_t * NPV, const int32_t & Nclass, real_t * MK)
   {
-    std :: unique_ptr < float[] > MK (new float[Nclass]);
-    std :: transform(PPV, PPV + Nclass, NPV, MK.get(),
-                     [](const float & tp, const float & tn)
-                     {
-                        return tp + tn - 1.f;
-                     });
-    return MK;
+    for (int32_t i = 0; i < Nclass; ++i)
+      MK[i] = (*this)(PPV[i], NPV[i]);
+  }
+
+  real_t operator() (const real_t & PPV, const real_t & NPV) const
+  {
+    return PPV + NPV - 1.f;
   }
   /// @endcond
-} get_MK;
+} get_MK __unused;
 
 /**
 * @brief Individual classification success index
@@ -621,24 +642,23 @@ struct // MK(Markedness)
 * @param PPV array of positive predictive values
 * @param TPR array of true positive rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of ICSI for each class.
+* @param ICSI output array of ICSI for each class.
 */
 struct // ICSI(Individual classification success index)
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const real_t * TPR, const int32_t & Nclass, real_t * ICSI)
   {
-    std :: unique_ptr < float[] > ICSI (new float[Nclass]);
-    std :: transform(PPV, PPV + Nclass, TPR, ICSI.get(),
-                     [](const float & tp, const float & tn)
-                     {
-                        return tp + tn - 1.f;
-                     });
-    return ICSI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      ICSI[i] = (*this)(PPV[i], TPR[i]);
+  }
+
+  real_t operator() (const real_t & PPV, const real_t & TPR) const
+  {
+    return PPV + TPR - 1.f;
   }
   /// @endcond
-} get_ICSI;
+} get_ICSI __unused;
 
 /**
 * @brief Positive likelihood ratio
@@ -656,24 +676,23 @@ struct // ICSI(Individual classification success index)
 * @param TPR array of true positive rates
 * @param FPR array of false positive rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of TPR for each class.
+* @param PLR output array of TPR for each class.
 */
 struct // PLR(Positive likelihood ratio)
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const float * FPR, const int32_t & Nclass)
+  auto operator() (const real_t * TPR, const real_t * FPR, const int32_t & Nclass, real_t * PLR)
   {
-    std :: unique_ptr < float[] > PLR (new float[Nclass]);
-    std :: transform(TPR, TPR + Nclass, FPR, PLR.get(),
-                     [](const float & tp, const float & tn)
-                     {
-                        return tp / (tn + epsil);
-                     });
-    return PLR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      PLR[i] = (*this)(TPR[i], FPR[i]);
+  }
+
+  real_t operator() (const real_t & TPR, const real_t & FPR) const
+  {
+    return TPR / (FPR + epsil);
   }
   /// @endcond
-} get_PLR;
+} get_PLR __unused;
 
 /**
 * @brief Negative likelihood ratio
@@ -691,24 +710,23 @@ struct // PLR(Positive likelihood ratio)
 * @param FNR array of false negative rates
 * @param TNR array of true negative rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of NLR for each class.
+* @param NLR output array of NLR for each class.
 */
 struct // NLR(Negative likelihood ratio)
 {
   /// @cond DEF
-  auto operator() (const float * FNR, const float * TNR, const int32_t & Nclass)
+  auto operator() (const real_t * FNR, const real_t * TNR, const int32_t & Nclass, real_t * NLR)
   {
-    std :: unique_ptr < float[] > NLR (new float[Nclass]);
-    std :: transform(FNR, FNR + Nclass, TNR, NLR.get(),
-                     [](const float & tp, const float & tn)
-                     {
-                        return tp / (tn + epsil);
-                     });
-    return NLR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      NLR[i] = (*this)(FNR[i], TNR[i]);
+  }
+
+  real_t operator() (const real_t & FNR, const real_t & TNR) const
+  {
+    return FNR / (TNR + epsil);
   }
   /// @endcond
-} get_NLR;
+} get_NLR __unused;
 
 /**
 * @brief Diagnostic odds ratio
@@ -725,24 +743,23 @@ struct // NLR(Negative likelihood ratio)
 * @param PLR array of positive likelihood ratio values.
 * @param NLR array of negative likelihood ratio values.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of DOR scores for each class.
+* @param DOR output array of DOR scores for each class.
 */
 struct // DOR(Diagnostic odds ratio)
 {
   /// @cond DEF
-  auto operator() (const float * PLR, const float * NLR, const int32_t & Nclass)
+  auto operator() (const real_t * PLR, const real_t * NLR, const int32_t & Nclass, real_t * DOR)
   {
-    std :: unique_ptr < float[] > DOR (new float[Nclass]);
-    std :: transform(PLR, PLR + Nclass, NLR, DOR.get(),
-                     [](const float & tp, const float & tn)
-                     {
-                        return tp / (tn + epsil);
-                     });
-    return DOR;
+    for (int32_t i = 0; i < Nclass; ++i)
+      DOR[i] = (*this)(PLR[i], NLR[i]);
+  }
+
+  real_t operator() (const real_t & PLR, const real_t & NLR) const
+  {
+    return PLR / (NLR + epsil);
   }
   /// @endcond
-} get_DOR;
+} get_DOR __unused;
 
 /**
 * @brief Prevalence
@@ -758,24 +775,24 @@ struct // DOR(Diagnostic odds ratio)
 * @param P array of the number of positive samples for each class.
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of PRE scores for each class.
+* @param PRE output array of PRE scores for each class.
 */
 struct // PRE(Prevalence)
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * POP, const int32_t & Nclass, real_t * PRE)
   {
-    std :: unique_ptr < float[] > PRE (new float[Nclass]);
-    std :: transform(P, P + Nclass, POP, PRE.get(),
-                     [](const float & p, const float & pop)
-                     {
-                        return p / (pop + epsil);
-                     });
-    return PRE;
+    for (int32_t i = 0; i < Nclass; ++i)
+      PRE[i] = (*this)(P[i], POP[i]);
+  }
+
+  real_t operator() (const real_t & P, const real_t & POP) const
+  {
+    return P / (POP + epsil);
   }
   /// @endcond
-} get_PRE;
+} get_PRE __unused;
 
 /**
 * @brief G-measure
@@ -790,24 +807,23 @@ struct // PRE(Prevalence)
 * @param PPV array of positive predicted values.
 * @param TPR array of true positive rates.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of G scores for each class.
+* @param G output array of G scores for each class.
 */
 struct // G(G-measure geometric mean of precision and sensitivity)
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const real_t * TPR, const int32_t & Nclass, real_t * G)
   {
-    std :: unique_ptr < float[] > G (new float[Nclass]);
-    std :: transform(PPV, PPV + Nclass, TPR, G.get(),
-                     [](const float & i1, const float & i2)
-                     {
-                        return std :: sqrt(i1 * i2);
-                     });
-    return G;
+    for (int32_t i = 0; i < Nclass; ++i)
+      G[i] = (*this)(PPV[i], TPR[i]);
+  }
+
+  real_t operator() (const real_t & PPV, const real_t & TPR) const
+  {
+    return std :: sqrt(PPV * TPR);
   }
   /// @endcond
-} get_G;
+} get_G __unused;
 
 /**
 * @brief Random accuracy
@@ -823,21 +839,26 @@ struct // G(G-measure geometric mean of precision and sensitivity)
 * @param P array of true positive rates for each class.
 * @param POP array of true positive rates for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of RACC scores for each class.
+* @param RACC output array of RACC scores for each class.
 */
 struct // RACC(Random accuracy)
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * P, const count_type * POP, const int32_t & Nclass, real_t * RACC)
   {
-    std :: unique_ptr < float[] > RACC (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      RACC[i] = (TOP[i] * P[i]) / (POP[i] * POP[i] + epsil);
-    return RACC;
+      RACC[i] = (*this)(TOP[i], P[i], POP[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TOP, const count_type & P, const count_type & POP) const
+  {
+    const real_t pop = POP;
+    return (static_cast < real_t >(TOP) * P) / (pop * pop + epsil);
   }
   /// @endcond
-} get_RACC;
+} get_RACC __unused;
 
 /**
 * @brief Error rate
@@ -850,24 +871,23 @@ struct // RACC(Random accuracy)
 *
 * @param ACC array of accuracy scores for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of error rates for each class.
+* @param ERR_ACC output array of error rates for each class.
 */
 struct // ERR(Error rate)
 {
   /// @cond DEF
-  auto operator() (const float * ACC, const int32_t & Nclass)
+  auto operator() (const real_t * ACC, const int32_t & Nclass, real_t * ERR_ACC)
   {
-    std :: unique_ptr < float[] > ERR_ACC (new float[Nclass]);
-    std :: transform(ACC, ACC + Nclass, ERR_ACC.get(),
-                     [](const float & acc)
-                     {
-                        return 1.f - acc;
-                     });
-    return ERR_ACC;
+    for (int32_t i = 0; i < Nclass; ++i)
+      ERR_ACC[i] = (*this)(ACC[i]);
+  }
+
+  real_t operator() (const real_t & ACC) const
+  {
+    return 1.f - ACC;
   }
   /// @endcond
-} get_ERR_ACC;
+} get_ERR_ACC __unused;
 
 /**
 * @brief Random accuracy unbiased
@@ -883,22 +903,28 @@ struct // ERR(Error rate)
 * @param P array of true positive rates.
 * @param POP array of true positive rates.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of RACCU scores for each class.
+* @param RACCU output array of RACCU scores for each class.
 */
 struct // RACCU(Random accuracy unbiased)
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * P, const count_type * POP, const int32_t & Nclass, real_t * RACCU)
   {
-    std :: unique_ptr < float[] > RACCU (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      RACCU[i] = ( (TOP[i] + P[i]) * (TOP[i] + P[i]) ) /
-                   (POP[i] * POP[i] * 4.f + epsil);
-    return RACCU;
+      RACCU[i] = (*this)(TOP[i], P[i], POP[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TOP, const count_type & P, const count_type & POP) const
+  {
+    const real_t top_p = TOP + P;
+    const real_t pop = POP;
+    return ( top_p * top_p ) /
+             (pop * pop * 4.f + epsil);
   }
   /// @endcond
-} get_RACCU;
+} get_RACCU __unused;
 
 /**
 * @brief Jaccard index
@@ -916,21 +942,25 @@ struct // RACCU(Random accuracy unbiased)
 * @param TOP array of positive predicted values.
 * @param P array of true positive rates.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of J scores for each class.
+* @param jaccard_index output array of J scores for each class.
 */
 struct // J(Jaccard index)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TOP, const float * P, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TOP, const count_type * P, const int32_t & Nclass, real_t * jaccard_index)
   {
-    std :: unique_ptr < float[] > jaccard_index (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      jaccard_index[i] = TP[i] / (TOP[i] + P[i] - TP[i] + epsil);
-    return jaccard_index;
+      jaccard_index[i] = (*this)(TP[i], TOP[i], P[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & TOP, const count_type & P) const
+  {
+    return TP / (static_cast < real_t >(TOP + P - TP) + epsil);
   }
   /// @endcond
-} get_jaccard_index;
+} get_jaccard_index __unused;
 
 /**
 * @brief Information score
@@ -947,22 +977,26 @@ struct // J(Jaccard index)
 * @param FN array of false negative values.
 * @param POP array of true positive rates.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of IS scores for each class.
+* @param IS output array of IS scores for each class.
 */
 struct // IS(Information score)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const float * FN, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const count_type * FN, const count_type * POP, const int32_t & Nclass, real_t * IS)
   {
-    std :: unique_ptr < float[] > IS (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      IS[i] = -std :: log2((TP[i] + FN[i]) / (POP[i] + epsil)) +
-              (std :: log2(TP[i] / (TP[i] + FP[i] + epsil)));
-    return IS;
+      IS[i] = (*this)(TP[i], FP[i], FN[i], POP[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & FP, const count_type & FN, const count_type & POP) const
+  {
+    return -std :: log2((TP + FN) / (POP + epsil)) +
+           (std :: log2(TP / (TP + FP + epsil)));
   }
   /// @endcond
-} get_IS;
+} get_IS __unused;
 
 /**
 * @brief Confusion entropy
@@ -978,93 +1012,146 @@ struct // IS(Information score)
 * Hence the proposed measure is more precise than the two measures and can
 * substitute for them to evaluate classifiers in classification applications.
 *
-* @param confusion_matrix confusion matrix.
+* @param confusion_matrix confusion matrix (dense ravel array or sparse_matrix).
+* @param marginals marginals of the confusion matrix (row sums, column sums and diagonal).
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of CEN for each class.
+* @param CEN output array of CEN for each class.
 */
 struct // CEN(Confusion entropy)
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * marginals, const int32_t & Nclass, real_t * CEN)
   {
-    std :: unique_ptr < float[] > CEN (new float[Nclass]);
+    // the normalization of the class i is the sum of its row and column
+    const count_type * rows = marginals;
+    const count_type * cols = marginals + Nclass;
 
+    const real_t scale = std :: log(2 * (Nclass - 1));
+    std :: fill_n(CEN, Nclass, 0.f);
+
+    // each misclassified cell (i, j) contributes to the classes i and j
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      CEN[i] = 0.f;
+      const count_type * row = confusion_matrix + static_cast < int64_t >(i) * Nclass;
+      const real_t norm_i = static_cast < real_t >(rows[i] + cols[i]) + epsil;
 
       for (int32_t j = 0; j < Nclass; ++j)
       {
-        if (j != i)
-        {
-          float CEN_misclassification_calc = 0.f;
-
-          for (int32_t k = 0; k < Nclass; ++k)
-            CEN_misclassification_calc += confusion_matrix[i * Nclass + k] + confusion_matrix[ k * Nclass + i];
+        if ( j == i || row[j] == 0 )
+          continue;
 
-          const float P_j_k = confusion_matrix[i * Nclass + j] / (CEN_misclassification_calc + epsil);
-          const float P_k_j = confusion_matrix[j * Nclass + i] / (CEN_misclassification_calc + epsil);
+        const real_t P_i = row[j] / norm_i;
+        const real_t P_j = row[j] / (static_cast < real_t >(rows[j] + cols[j]) + epsil);
 
-          CEN[i] += P_j_k != 0.f ? P_j_k * (std :: log(P_j_k) / std :: log(2 * (Nclass - 1))) : 0.f;
-          CEN[i] += P_k_j != 0.f ? P_k_j * (std :: log(P_k_j) / std :: log(2 * (Nclass - 1))) : 0.f;
-        }
+        CEN[i] -= P_i * (std :: log(P_i) / scale);
+        CEN[j] -= P_j * (std :: log(P_j) / scale);
       }
-
-      CEN[i] = -CEN[i];
     }
+  }
+
+  template < typename count_type >
+  void operator() (const sparse_matrix & confusion_matrix, const count_type * marginals, const int32_t & Nclass, real_t * CEN)
+  {
+    // the normalization of the class i is the sum of its row and column
+    const count_type * rows = marginals;
+    const count_type * cols = marginals + Nclass;
+
+    const real_t scale = std :: log(2 * (Nclass - 1));
+    std :: fill_n(CEN, Nclass, 0.f);
+
+    // each misclassified cell (i, j) contributes to the classes i and j
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+      {
+        const int32_t j = confusion_matrix.col(k);
+
+        if ( j == i )
+          continue;
 
-    return CEN;
+        const real_t P_i = confusion_matrix.count(k) / (static_cast < real_t >(rows[i] + cols[i]) + epsil);
+        const real_t P_j = confusion_matrix.count(k) / (static_cast < real_t >(rows[j] + cols[j]) + epsil);
+
+        CEN[i] -= P_i * (std :: log(P_i) / scale);
+        CEN[j] -= P_j * (std :: log(P_j) / scale);
+      }
   }
   /// @endcond
-} get_CEN;
+} get_CEN __unused;
 
 /**
 * @brief Modified confusion entropy
 *
 * @details Modified version of CEN
 *
-* @param confusion_matrix confusion matrix.
+* @param confusion_matrix confusion matrix (dense ravel array or sparse_matrix).
+* @param marginals marginals of the confusion matrix (row sums, column sums and diagonal).
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of MCEN for each class.
+* @param MCEN output array of MCEN for each class.
 */
 struct // MCEN(Modified confusion entropy)
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * marginals, const int32_t & Nclass, real_t * MCEN)
   {
-    std :: unique_ptr < float[] > MCEN (new float[Nclass]);
+    // the normalization of the class i is the sum of its row and column (with the diagonal counted once)
+    const count_type * rows = marginals;
+    const count_type * cols = marginals + Nclass;
+    const count_type * diag = marginals + 2 * Nclass;
 
+    const real_t scale = std :: log(2 * (Nclass - 1));
+    std :: fill_n(MCEN, Nclass, 0.f);
+
+    // each misclassified cell (i, j) contributes to the classes i and j
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      MCEN[i] = 0.f;
+      const count_type * row = confusion_matrix + static_cast < int64_t >(i) * Nclass;
+      const real_t norm_i = static_cast < real_t >(rows[i] + cols[i] - diag[i]) + epsil;
 
       for (int32_t j = 0; j < Nclass; ++j)
       {
-        if (j != i)
-        {
-          float CEN_misclassification_calc = 0.f;
+        if ( j == i || row[j] == 0 )
+          continue;
 
-          for (int32_t k = 0; k < Nclass; ++k)
-            CEN_misclassification_calc += confusion_matrix[i * Nclass + k] + confusion_matrix[ k * Nclass + i];
+        const real_t P_i = row[j] / norm_i;
+        const real_t P_j = row[j] / (static_cast < real_t >(rows[j] + cols[j] - diag[j]) + epsil);
 
-          CEN_misclassification_calc -= confusion_matrix[i * Nclass + i];
+        MCEN[i] -= P_i * (std :: log(P_i) / scale);
+        MCEN[j] -= P_j * (std :: log(P_j) / scale);
+      }
+    }
+  }
 
-          const float P_j_k = confusion_matrix[i * Nclass + j] / (CEN_misclassification_calc + epsil);
-          const float P_k_j = confusion_matrix[j * Nclass + i] / (CEN_misclassification_calc + epsil);
+  template < typename count_type >
+  void operator() (const sparse_matrix & confusion_matrix, const count_type * marginals, const int32_t & Nclass, real_t * MCEN)
+  {
+    // the normalization of the class i is the sum of its row and column (with the diagonal counted once)
+    const count_type * rows = marginals;
+    const count_type * cols = marginals + Nclass;
+    const count_type * diag = marginals + 2 * Nclass;
 
-          MCEN[i] += P_j_k != 0.f ? P_j_k * (std :: log(P_j_k) / std :: log(2 * (Nclass - 1))) : 0.f;
-          MCEN[i] += P_k_j != 0.f ? P_k_j * (std :: log(P_k_j) / std :: log(2 * (Nclass - 1))) : 0.f;
-        }
-      }
+    const real_t scale = std :: log(2 * (Nclass - 1));
+    std :: fill_n(MCEN, Nclass, 0.f);
 
-      MCEN[i] = -MCEN[i];
-    }
-    return MCEN;
+    // each misclassified cell (i, j) contributes to the classes i and j
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+      {
+        const int32_t j = confusion_matrix.col(k);
+
+        if ( j == i )
+          continue;
+
+        const real_t P_i = confusion_matrix.count(k) / (static_cast < real_t >(rows[i] + cols[i] - diag[i]) + epsil);
+        const real_t P_j = confusion_matrix.count(k) / (static_cast < real_t >(rows[j] + cols[j] - diag[j]) + epsil);
+
+        MCEN[i] -= P_i * (std :: log(P_i) / scale);
+        MCEN[j] -= P_j * (std :: log(P_j) / scale);
+      }
   }
   /// @endcond
-} get_MCEN;
+} get_MCEN __unused;
 
 /**
 * @brief Area under the ROC curve
@@ -1083,24 +1170,23 @@ struct // MCEN(Modified confusion entropy)
 * @param TNR array of true negative rates
 * @param TPR array of true positive rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of AUC for each class.
+* @param AUC output array of AUC for each class.
 */
 struct // AUC(Area Under the ROC curve)
 {
   /// @cond DEF
-  auto operator() (const float * TNR, const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * TNR, const real_t * TPR, const int32_t & Nclass, real_t * AUC)
   {
-    std :: unique_ptr < float[] > AUC (new float[Nclass]);
-    std :: transform(TNR, TNR + Nclass, TPR, AUC.get(),
-                     [](const float & tnr, const float & tpr)
-                     {
-                        return (tnr + tpr) * .5f;
-                     });
-    return AUC;
+    for (int32_t i = 0; i < Nclass; ++i)
+      AUC[i] = (*this)(TNR[i], TPR[i]);
+  }
+
+  real_t operator() (const real_t & TNR, const real_t & TPR) const
+  {
+    return (TNR + TPR) * .5f;
   }
   /// @endcond
-} get_AUC;
+} get_AUC __unused;
 
 /**
 * @brief Distance index
@@ -1115,25 +1201,24 @@ struct // AUC(Area Under the ROC curve)
 * @param TNR array of true negative rates
 * @param TPR array of true positive rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of dInd for each class.
+* @param dIND output array of dInd for each class.
 */
 struct // dInd(Distance index)
 {
   /// @cond DEF
-  auto operator() (const float * TNR, const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * TNR, const real_t * TPR, const int32_t & Nclass, real_t * dIND)
   {
-    std :: unique_ptr < float[] > dIND (new float[Nclass]);
-    std :: transform(TNR, TNR + Nclass, TPR, dIND.get(),
-                     [](const float & tnr, const float & tpr)
-                     {
-                        return std :: sqrt( (1.f - tnr) * (1.f - tnr) +
-                                            (1.f - tpr) * (1.f - tpr) );
-                     });
-    return dIND;
+    for (int32_t i = 0; i < Nclass; ++i)
+      dIND[i] = (*this)(TNR[i], TPR[i]);
+  }
+
+  real_t operator() (const real_t & TNR, const real_t & TPR) const
+  {
+    return std :: sqrt( (1.f - TNR) * (1.f - TNR) +
+                        (1.f - TPR) * (1.f - TPR) );
   }
   /// @endcond
-} get_dIND;
+} get_dIND __unused;
 
 /**
 * @brief Similarity index
@@ -1147,24 +1232,23 @@ struct // dInd(Distance index)
 *
 * @param dInd array of distance indexes for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of sInd for each class.
+* @param sIND output array of sInd for each class.
 */
 struct // sInd(Similarity index)
 {
   /// @cond DEF
-  auto operator() (const float * dIND, const int32_t & Nclass)
+  auto operator() (const real_t * dIND, const int32_t & Nclass, real_t * sIND)
   {
-    std :: unique_ptr < float[] > sIND (new float[Nclass]);
-    std :: transform(dIND, dIND + Nclass, sIND.get(),
-                     [](const float & dind)
-                     {
-                        return 1.f - (dind / std :: sqrt(2));
-                     });
-    return sIND;
+    for (int32_t i = 0; i < Nclass; ++i)
+      sIND[i] = (*this)(dIND[i]);
+  }
+
+  real_t operator() (const real_t & dIND) const
+  {
+    return 1.f - (dIND / std :: sqrt(2));
   }
   /// @endcond
-} get_sIND;
+} get_sIND __unused;
 
 /**
 * @brief Discriminant power
@@ -1180,26 +1264,25 @@ struct // sInd(Similarity index)
 * @param TPR array of true positive rates
 * @param TNR array of true negative rates
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of DP for each class.
+* @param DP output array of DP for each class.
 */
 struct // DP(Discriminant power)
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const float * TNR, const int32_t & Nclass)
+  auto operator() (const real_t * TPR, const real_t * TNR, const int32_t & Nclass, real_t * DP)
   {
-    std :: unique_ptr < float[] > DP (new float[Nclass]);
-    std :: transform(TPR, TPR + Nclass, TNR, DP.get(),
-                     [](const float & tpr, const float & tnr)
-                     {
-                        return std :: sqrt(3) / 3.14f *
-                              (std :: log10(tpr / (1.f - tpr)) +
-                               std :: log10(tnr / (1.f - tnr)));
-                     });
-    return DP;
+    for (int32_t i = 0; i < Nclass; ++i)
+      DP[i] = (*this)(TPR[i], TNR[i]);
+  }
+
+  real_t operator() (const real_t & TPR, const real_t & TNR) const
+  {
+    return std :: sqrt(3) / 3.14f *
+           (std :: log10(TPR / (1.f - TPR)) +
+            std :: log10(TNR / (1.f - TNR)));
   }
   /// @endcond
-} get_DP;
+} get_DP __unused;
 
 /**
 * @brief Youden index
@@ -1219,20 +1302,23 @@ struct // DP(Discriminant power)
 *
 * @param BM array of bookmaker indexes for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of Y for each class.
+* @param Y output array of Y for each class.
 */
 struct // Y(Youden index)
 {
   /// @cond DEF
-  auto operator() (const float * BM, const int32_t & Nclass)
+  auto operator() (const real_t * BM, const int32_t & Nclass, real_t * Y)
   {
-    std :: unique_ptr < float[] > Y (new float[Nclass]);
-    std :: copy_n(BM, Nclass, Y.get());
-    return Y;
+    for (int32_t i = 0; i < Nclass; ++i)
+      Y[i] = (*this)(BM[i]);
+  }
+
+  real_t operator() (const real_t & BM) const
+  {
+    return BM;
   }
   /// @endcond
-} get_Y;
+} get_Y __unused;
 
 /**
 * @brief Positive likelihood ratio interpretation
@@ -1245,28 +1331,27 @@ struct // Y(Youden index)
 *
 * @param PLR array of positive likelihood ratio values.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of PLRI for each class.
+* @param PLRI output array of PLRI for each class.
 */
 struct // PLRI(Positive likelihood ratio interpretation)
 {
   /// @cond DEF
-  auto operator() (const float * PLR, const int32_t & Nclass)
+  auto operator() (const real_t * PLR, const int32_t & Nclass, real_t * PLRI)
   {
-    std :: unique_ptr < float[] > PLRI (new float[Nclass]);
-    std :: transform(PLR, PLR + Nclass, PLRI.get(),
-                     [](const float & plr)
-                     {
-                        return std :: isnan(plr) || std :: isinf(plr) ? -1.f :
-                                            plr <  1.f                ?  0.f :
-                                            plr >= 1.f && plr <  5.f  ?  1.f :
-                                            plr >= 5.f && plr < 10.f  ?  2.f :
-                                            3.f;
-                     });
-    return PLRI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      PLRI[i] = (*this)(PLR[i]);
+  }
+
+  real_t operator() (const real_t & PLR) const
+  {
+    return std :: isnan(PLR) || std :: isinf(PLR) ? -1.f :
+           PLR <  1.f                ?  0.f :
+           PLR >= 1.f && PLR <  5.f  ?  1.f :
+           PLR >= 5.f && PLR < 10.f  ?  2.f :
+           3.f;
   }
   /// @endcond
-} get_PLRI;
+} get_PLRI __unused;
 
 /**
 * @brief Negative likelihood ratio interpretation
@@ -1279,28 +1364,27 @@ struct // PLRI(Positive likelihood ratio interpretation)
 *
 * @param NLR array of negative likelihood ratio values for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of NLRI for each class.
+* @param NLRI output array of NLRI for each class.
 */
 struct // NLRI(Negative likelihood ratio interpretation)
 {
   /// @cond DEF
-  auto operator() (const float * NLR, const int32_t & Nclass)
+  auto operator() (const real_t * NLR, const int32_t & Nclass, real_t * NLRI)
   {
-    std :: unique_ptr < float[] > NLRI (new float[Nclass]);
-    std :: transform(NLR, NLR + Nclass, NLRI.get(),
-                     [](const float & nlr)
-                     {
-                        return std :: isnan(nlr) || std :: isinf(nlr) ? -1.f :
-                                            nlr <  .1f                ?  0.f :
-                                            nlr >= .1f && nlr < .2f   ?  1.f :
-                                            nlr >= .2f && nlr < .5f   ?  2.f :
-                                            3.f;
-                     });
-    return NLRI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      NLRI[i] = (*this)(NLR[i]);
+  }
+
+  real_t operator() (const real_t & NLR) const
+  {
+    return std :: isnan(NLR) || std :: isinf(NLR) ? -1.f :
+           NLR <  .1f                ?  0.f :
+           NLR >= .1f && NLR < .2f   ?  1.f :
+           NLR >= .2f && NLR < .5f   ?  2.f :
+           3.f;
   }
   /// @endcond
-} get_NLRI;
+} get_NLRI __unused;
 
 /**
 * @brief Discriminant power interpretation
@@ -1313,28 +1397,27 @@ struct // NLRI(Negative likelihood ratio interpretation)
 *
 * @param DP array of discriminant power values for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of DPI for each class.
+* @param DPI output array of DPI for each class.
 */
 struct // DPI(Discriminant power interpretation)
 {
   /// @cond DEF
-  auto operator() (const float * DP, const int32_t & Nclass)
+  auto operator() (const real_t * DP, const int32_t & Nclass, real_t * DPI)
   {
-    std :: unique_ptr < float[] > DPI (new float[Nclass]);
-    std :: transform(DP, DP + Nclass, DPI.get(),
-                     [](const float & dp)
-                     {
-                        return std :: isnan(dp) || std :: isinf(dp) ? -1.f :
-                                            dp <  1.f               ?  0.f :
-                                            dp >= 1.f && dp < 2.f   ?  1.f :
-                                            dp >= 2.f && dp < 3.f   ?  2.f :
-                                            3.f;
-                     });
-    return DPI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      DPI[i] = (*this)(DP[i]);
+  }
+
+  real_t operator() (const real_t & DP) const
+  {
+    return std :: isnan(DP) || std :: isinf(DP) ? -1.f :
+           DP <  1.f               ?  0.f :
+           DP >= 1.f && DP < 2.f   ?  1.f :
+           DP >= 2.f && DP < 3.f   ?  2.f :
+           3.f;
   }
   /// @endcond
-} get_DPI;
+} get_DPI __unused;
 
 /**
 * @brief AUC value interpretation
@@ -1348,28 +1431,27 @@ struct // DPI(Discriminant power interpretation)
 *
 * @param AUC array of area under the curve values for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of AUCI for each class.
+* @param AUCI output array of AUCI for each class.
 */
 struct // AUCI(AUC value interpretation)
 {
   /// @cond DEF
-  auto operator() (const float * AUC, const int32_t & Nclass)
+  auto operator() (const real_t * AUC, const int32_t & Nclass, real_t * AUCI)
   {
-    std :: unique_ptr < float[] > AUCI (new float[Nclass]);
-    std :: transform(AUC, AUC + Nclass, AUCI.get(),
-                     [](const float & auc)
-                     {
-                        return std :: isnan(auc) || std :: isinf(auc) ? -1.f :
-                                            auc <  .6f                ?  0.f :
-                                            auc >= .6f && auc < .7f   ?  1.f :
-                                            auc >= .7f && auc < .8f   ?  2.f :
-                                            3.f;
-                     });
-    return AUCI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      AUCI[i] = (*this)(AUC[i]);
+  }
+
+  real_t operator() (const real_t & AUC) const
+  {
+    return std :: isnan(AUC) || std :: isinf(AUC) ? -1.f :
+           AUC <  .6f                ?  0.f :
+           AUC >= .6f && AUC < .7f   ?  1.f :
+           AUC >= .7f && AUC < .8f   ?  2.f :
+           3.f;
   }
   /// @endcond
-} get_AUCI;
+} get_AUCI __unused;
 
 /**
 * @brief Gini index
@@ -1386,24 +1468,23 @@ struct // AUCI(AUC value interpretation)
 *
 * @param AUC array of area under the curve values for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of Gini-index scores for each class
+* @param GI output array of Gini-index scores for each class
 */
 struct // GI(Gini index)
 {
   /// @cond DEF
-  auto operator() (const float * AUC, const int32_t & Nclass)
+  auto operator() (const real_t * AUC, const int32_t & Nclass, real_t * GI)
   {
-    std :: unique_ptr < float[] > GI (new float[Nclass]);
-    std :: transform(AUC, AUC + Nclass, GI.get(),
-                     [](const float & auc)
-                     {
-                        return 2.f * auc - 1.f;
-                     });
-    return GI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      GI[i] = (*this)(AUC[i]);
+  }
+
+  real_t operator() (const real_t & AUC) const
+  {
+    return 2.f * AUC - 1.f;
   }
   /// @endcond
-} get_GI;
+} get_GI __unused;
 
 /**
 * @brief Lift score
@@ -1420,24 +1501,23 @@ struct // GI(Gini index)
 * @param PPV array of positive predicted values for each class.
 * @param PRE array of prevalence scores for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of LS scores for each class
+* @param LS output array of LS scores for each class
 */
 struct // LS(Lift score)
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const float * PRE, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const real_t * PRE, const int32_t & Nclass, real_t * LS)
   {
-    std :: unique_ptr < float[] > LS (new float[Nclass]);
-    std :: transform(PPV, PPV + Nclass, PRE, LS.get(),
-                     [](const float & ppv, const float & pre)
-                     {
-                        return ppv / (pre + epsil);
-                     });
-    return LS;
+    for (int32_t i = 0; i < Nclass; ++i)
+      LS[i] = (*this)(PPV[i], PRE[i]);
+  }
+
+  real_t operator() (const real_t & PPV, const real_t & PRE) const
+  {
+    return PPV / (PRE + epsil);
   }
   /// @endcond
-} get_LS;
+} get_LS __unused;
 
 /**
 * @brief Automatic/Manual
@@ -1452,24 +1532,24 @@ struct // LS(Lift score)
 * @param TOP array of positive predicted values for each class.
 * @param P array of the number of positive samples for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of AM scores for each class
+* @param AM output array of AM scores for each class
 */
 struct // AM(Difference between automatic and manual classification)
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * P, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * P, const int32_t & Nclass, real_t * AM)
   {
-    std :: unique_ptr < float[] > AM (new float[Nclass]);
-    std :: transform(TOP, TOP + Nclass, P, AM.get(),
-                     [](const float & top, const float & p)
-                     {
-                        return top - p;
-                     });
-    return AM;
+    for (int32_t i = 0; i < Nclass; ++i)
+      AM[i] = (*this)(TOP[i], P[i]);
+  }
+
+  real_t operator() (const real_t & TOP, const real_t & P) const
+  {
+    return TOP - P;
   }
   /// @endcond
-} get_AM;
+} get_AM __unused;
 
 /**
 * @brief Optimized precision
@@ -1488,23 +1568,24 @@ struct // AM(Difference between automatic and manual classification)
 * @param TPR array of true positive rates for each class.
 * @param TNR array of true negative rates for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of OP scores for each class
+* @param OP output array of OP scores for each class
 */
 struct // OP(Optimized precision)
 {
   /// @cond DEF
-  auto operator() (const float * ACC, const float * TPR, const float * TNR, const int32_t & Nclass)
+  auto operator() (const real_t * ACC, const real_t * TPR, const real_t * TNR, const int32_t & Nclass, real_t * OP)
   {
-    std :: unique_ptr < float[] > OP (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      OP[i] = ACC[i] - std :: fabs(TNR[i] - TPR[i]) /
-                                  (TPR[i] + TNR[i] + epsil);
+      OP[i] = (*this)(ACC[i], TPR[i], TNR[i]);
+  }
 
-    return OP;
+  real_t operator() (const real_t & ACC, const real_t & TPR, const real_t & TNR) const
+  {
+    return ACC - std :: fabs(TNR - TPR) /
+                       (TPR + TNR + epsil);
   }
   /// @endcond
-} get_OP;
+} get_OP __unused;
 
 /**
 * @brief Index of balanced accuracy
@@ -1519,24 +1600,23 @@ struct // OP(Optimized precision)
 * @param TPR array of true positive rates for each class.
 * @param TNR array of true negative rates for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of IBA scores for each class
+* @param IBA output array of IBA scores for each class
 */
 struct // IBA(Index of balanced accuracy)
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const float * TNR, const int32_t & Nclass)
+  auto operator() (const real_t * TPR, const real_t * TNR, const int32_t & Nclass, real_t * IBA)
   {
-    std :: unique_ptr < float[] > IBA (new float[Nclass]);
-    std :: transform(TPR, TPR + Nclass, TNR, IBA.get(),
-                     [](const float & tpr, const float & tnr)
-                     {
-                        return (1.f + tpr - tnr) * tpr * tnr;
-                     });
-    return IBA;
+    for (int32_t i = 0; i < Nclass; ++i)
+      IBA[i] = (*this)(TPR[i], TNR[i]);
+  }
+
+  real_t operator() (const real_t & TPR, const real_t & TNR) const
+  {
+    return (1.f + TPR - TNR) * TPR * TNR;
   }
   /// @endcond
-} get_IBA;
+} get_IBA __unused;
 
 /**
 * @brief G-mean
@@ -1550,24 +1630,23 @@ struct // IBA(Index of balanced accuracy)
 * @param TNR array of true negative rates for each class.
 * @param TPR array of true positive rates for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of GM scores for each class
+* @param GM output array of GM scores for each class
 */
 struct // GM(G-mean geometric mean of specificity and sensitivity)
 {
   /// @cond DEF
-  auto operator() (const float * TNR, const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * TNR, const real_t * TPR, const int32_t & Nclass, real_t * GM)
   {
-    std :: unique_ptr < float[] > GM (new float[Nclass]);
-    std :: transform(TNR, TNR + Nclass, TPR, GM.get(),
-                     [](const float & tnr, const float & tpr)
-                     {
-                        return std :: sqrt(tnr * tpr);
-                     });
-    return GM;
+    for (int32_t i = 0; i < Nclass; ++i)
+      GM[i] = (*this)(TNR[i], TPR[i]);
+  }
+
+  real_t operator() (const real_t & TNR, const real_t & TPR) const
+  {
+    return std :: sqrt(TNR * TPR);
   }
   /// @endcond
-} get_GM;
+} get_GM __unused;
 
 /**
 * @brief Yule's Q
@@ -1585,24 +1664,26 @@ struct // GM(G-mean geometric mean of specificity and sensitivity)
 * @param FP array of false positives for each class.
 * @param FN array of false negative for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of Q scores for each class
+* @param Q output array of Q scores for each class
 */
 struct // Q(Yule Q - coefficient of colligation)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TN, const float * FP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TN, const count_type * FP, const count_type * FN, const int32_t & Nclass, real_t * Q)
   {
-    std :: unique_ptr < float[] > Q (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-    {
-      const float OR = (TP[i] * TN[i]) / (FP[i] * FN[i] + epsil);
-      Q[i] = (OR - 1.f) / (OR + 1.f);
-    }
-    return Q;
+      Q[i] = (*this)(TP[i], TN[i], FP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & TN, const count_type & FP, const count_type & FN) const
+  {
+    const real_t OR = (static_cast < real_t >(TP) * TN) / (static_cast < real_t >(FP) * FN + epsil);
+    return (OR - 1.f) / (OR + 1.f);
   }
   /// @endcond
-} get_Q;
+} get_Q __unused;
 
 /**
 * @brief Adjusted G-mean
@@ -1620,31 +1701,29 @@ struct // Q(Yule Q - coefficient of colligation)
 * @param N array of number of negative samples for each class.
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of AGM score values for each class.
+* @param AGM output array of AGM score values for each class.
 */
 struct // AGM(Adjusted geometric mean)
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const float * TNR, const float * GM, const float * N, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const real_t * TPR, const real_t * TNR, const real_t * GM, const count_type * N, const count_type * POP, const int32_t & Nclass, real_t * AGM)
   {
-    std :: unique_ptr < float[] > AGM (new float[Nclass]);
-
     for (int32_t i = 0; i < Nclass; ++i)
-    {
-      if (POP[i] != 0.f)
-      {
-        AGM[i] = TPR[i] == 0.f ? 0.f :
-                (GM[i] + TNR[i] * N[i] / (POP[i] + epsil)) / (1.f + N[i] / (POP[i] + epsil));
-      }
-      else
-        AGM[i] = -1.f;
-    }
+      AGM[i] = (*this)(TPR[i], TNR[i], GM[i], N[i], POP[i]);
+  }
 
-    return AGM;
+  template < typename count_type >
+  real_t operator() (const real_t & TPR, const real_t & TNR, const real_t & GM, const count_type & N, const count_type & POP) const
+  {
+    if (POP != 0)
+      return TPR == 0.f ? 0.f :
+             (GM + TNR * N / (POP + epsil)) / (1.f + N / (POP + epsil));
+
+    return -1.f;
   }
   /// @endcond
-} get_AGM;
+} get_AGM __unused;
 
 /**
 * @brief Matthews correlation coefficient interpretation
@@ -1661,29 +1740,28 @@ struct // AGM(Adjusted geometric mean)
 *
 * @param MCC array of Matthews correlation coefficients for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of MCCI scores for each class.
+* @param MCCI output array of MCCI scores for each class.
 */
 struct // MCCI(Matthews correlation coefficient interpretation)
 {
   /// @cond DEF
-  auto operator() (const float * MCC, const int32_t & Nclass)
+  auto operator() (const real_t * MCC, const int32_t & Nclass, real_t * MCCI)
   {
-    std :: unique_ptr < float[] > MCCI (new float[Nclass]);
-    std :: transform(MCC, MCC + Nclass, MCCI.get(),
-                     [](const float & mcc)
-                     {
-                        return std :: isnan(mcc) || std :: isinf(mcc) ? -1.f :
-                                            mcc <  .3f                ?  0.f :
-                                            mcc >= .3f && mcc < .5f   ?  1.f :
-                                            mcc >= .5f && mcc < .7f   ?  2.f :
-                                            mcc >= .7 && mcc  < .9f   ?  3.f :
-                                            4.f;
-                     });
-    return MCCI;
+    for (int32_t i = 0; i < Nclass; ++i)
+      MCCI[i] = (*this)(MCC[i]);
+  }
+
+  real_t operator() (const real_t & MCC) const
+  {
+    return std :: isnan(MCC) || std :: isinf(MCC) ? -1.f :
+           MCC <  .3f                ?  0.f :
+           MCC >= .3f && MCC < .5f   ?  1.f :
+           MCC >= .5f && MCC < .7f   ?  2.f :
+           MCC >= .7 && MCC  < .9f   ?  3.f :
+           4.f;
   }
   /// @endcond
-} get_MCCI;
+} get_MCCI __unused;
 
 /**
 * @brief Adjusted F-score
@@ -1706,26 +1784,27 @@ struct // MCCI(Matthews correlation coefficient interpretation)
 * @param FN array of false negative
 * @param TN array of true negatives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of AGF scores for each class.
+* @param AGF output array of AGF scores for each class.
 */
 struct // AGF(Adjusted F-score)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FP, const float * FN, const float * TN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FP, const count_type * FN, const count_type * TN, const int32_t & Nclass, real_t * AGF)
   {
-    std :: unique_ptr < float[] > AGF (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-    {
-      const float F2 = (5.f * TP[i]) / (5.f * TP[i] + FP[i] + 4.f * FN[i] + epsil);
-      const float F05_inv = (1.25f * TN[i]) / (1.25f * TN[i] + FN[i] + .25f * FP[i] + epsil);
-      AGF[i] = std :: sqrt(F2 * F05_inv);
-    }
+      AGF[i] = (*this)(TP[i], FP[i], FN[i], TN[i]);
+  }
 
-    return AGF;
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & FP, const count_type & FN, const count_type & TN) const
+  {
+    const real_t F2 = (5.f * TP) / (5.f * TP + FP + 4.f * FN + epsil);
+    const real_t F05_inv = (1.25f * TN) / (1.25f * TN + FN + .25f * FP + epsil);
+    return std :: sqrt(F2 * F05_inv);
   }
   /// @endcond
-} get_AGF;
+} get_AGF __unused;
 
 /**
 * @brief Overlap coefficient
@@ -1743,24 +1822,25 @@ struct // AGF(Adjusted F-score)
 * @param TOP array of positive predicted values for each class.
 * @param P array of the number of positive samples for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of OC values for each class.
+* @param OC output array of OC values for each class.
 */
 struct // OC(Overlap coefficient)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TOP, const float * P, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TOP, const count_type * P, const int32_t & Nclass, real_t * OC)
   {
-    std :: unique_ptr < float[] > OC (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-    {
-      OC[i] = TP[i] / (std :: min(TOP[i], P[i]) + epsil);
-    }
+      OC[i] = (*this)(TP[i], TOP[i], P[i]);
+  }
 
-    return OC;
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & TOP, const count_type & P) const
+  {
+    return TP / (std :: min(TOP, P) + epsil);
   }
   /// @endcond
-} get_OC;
+} get_OC __unused;
 
 /**
 * @brief Otsuka-Ochiai coefficient
@@ -1779,24 +1859,25 @@ struct // OC(Overlap coefficient)
 * @param TOP array of positive predicted values for each class.
 * @param P array of the number of positive samples for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of OOC values for each class.
+* @param OOC output array of OOC values for each class.
 */
 struct // OOC(Otsuka-Ochiai coefficient)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TOP, const float * P, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TOP, const count_type * P, const int32_t & Nclass, real_t * OOC)
   {
-    std :: unique_ptr < float[] > OOC (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-    {
-      OOC[i] = TP[i] / (std :: sqrt(TOP[i] * P[i]) + epsil);
-    }
+      OOC[i] = (*this)(TP[i], TOP[i], P[i]);
+  }
 
-    return OOC;
+  template < typename count_type >
+  real_t operator() (const count_type & TP, const count_type & TOP, const count_type & P) const
+  {
+    return TP / (std :: sqrt(static_cast < real_t >(TOP) * P) + epsil);
   }
   /// @endcond
-} get_OOC;
+} get_OOC __unused;
 
 /**
 * @brief Area under the PR curve
@@ -1812,25 +1893,23 @@ struct // OOC(Otsuka-Ochiai coefficient)
 * @param PPV array of positive predicted values for each class.
 * @param TPR array of true positive rates for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of AUPR values for each class.
+* @param AUPR output array of AUPR values for each class.
 */
 struct // AUPR(Area under the PR curve)
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const real_t * TPR, const int32_t & Nclass, real_t * AUPR)
   {
-    std :: unique_ptr < float[] > AUPR (new float[Nclass]);
-    std :: transform(PPV, PPV + Nclass, TPR, AUPR.get(),
-                     [](const float & ppv, const float & tpr)
-                     {
-                        return (ppv + tpr) * .5f;
-                     });
+    for (int32_t i = 0; i < Nclass; ++i)
+      AUPR[i] = (*this)(PPV[i], TPR[i]);
+  }
 
-    return AUPR;
+  real_t operator() (const real_t & PPV, const real_t & TPR) const
+  {
+    return (PPV + TPR) * .5f;
   }
   /// @endcond
-} get_AUPR;
+} get_AUPR __unused;
 
 /**
 * @brief Bray-Curtis dissimilarity
@@ -1847,26 +1926,24 @@ struct // AUPR(Area under the PR curve)
 * @param P array of the number of positive samples for each class.
 * @param AM array of Automatic/Manual differences for each class.
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of BCD scores for each class.
+* @param BCD output array of BCD scores for each class.
 */
 struct // BCD(Bray-Curtis dissimilarity)
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * P, const float * AM, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * P, const real_t * AM, const int32_t & Nclass, real_t * BCD)
   {
-    std :: unique_ptr < float[] > BCD (new float[Nclass]);
-    const float s = std :: accumulate(TOP, TOP + Nclass, 0.f) +
-                    std :: accumulate(  P,   P + Nclass, 0.f) + epsil;
-    std :: transform(AM, AM + Nclass, BCD.get(),
-                     [&](const float & am)
+    const real_t s = std :: accumulate(TOP, TOP + Nclass, count_type(0)) +
+                    std :: accumulate(  P,   P + Nclass, count_type(0)) + epsil;
+    std :: transform(AM, AM + Nclass, BCD,
+                     [&](const real_t & am)
                      {
                         return std :: fabs(am) / s;
                      });
-    return BCD;
   }
   /// @endcond
-} get_BCD;
+} get_BCD __unused;
 
 
 #endif // __class_stats_h__
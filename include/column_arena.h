@@ -0,0 +1,148 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#ifndef __column_arena_h__
+#define __column_arena_h__
+
+#include <memory>           // std :: unique_ptr
+#include <cstdint>          // uintptr_t
+#include <cstddef>          // std :: size_t
+
+#include <parallel_utils.h> // cache_line
+
+/**
+* @class column_arena
+* @brief Single contiguous buffer which stores a set of aligned columns.
+*
+* @details The buffer is allocated by reserve and it is reused by the
+* following calls until a larger capacity is required.
+* The columns are carved in sequence by column and each one starts at
+* a cache line boundary, so different columns never share a cache line.
+* The pointers returned by column are views of the buffer: they are valid
+* until the next reallocation of the buffer (i.e. a reserve with larger capacity).
+*
+*/
+class column_arena
+{
+
+  std :: unique_ptr < unsigned char[] > buffer; ///< raw memory buffer
+
+  unsigned char * base; ///< first aligned byte of the buffer
+
+  std :: size_t capacity; ///< number of usable bytes (from base)
+  std :: size_t offset;   ///< number of bytes already carved
+
+public:
+
+  static constexpr std :: size_t alignment = cache_line; ///< alignment (in bytes) of each column
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  column_arena () : base (nullptr), capacity (0), offset (0)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~column_arena () = default;
+
+  /**
+  * @brief Number of bytes required by a column (padded to the alignment).
+  *
+  * @tparam T data type of the column
+  * @param size number of elements of the column
+  *
+  * @return The padded size of the column in bytes.
+  */
+  template < typename T >
+  static std :: size_t bytes (const int64_t & size)
+  {
+    return (static_cast < std :: size_t >(size) * sizeof(T) + alignment - 1) / alignment * alignment;
+  }
+
+  /**
+  * @brief Ensure that the buffer can store the given number of bytes and rewind it.
+  *
+  * @details The buffer is reallocated only if its capacity is not enough,
+  * otherwise the memory is reused (and the previous columns are overwritten
+  * by the next calls to column).
+  *
+  * @param size number of bytes (as sum of bytes of the columns)
+  *
+  * @return True if the buffer has been reallocated.
+  */
+  bool reserve (const std :: size_t & size)
+  {
+    this->offset = 0;
+
+    if ( size <= this->capacity )
+      return false;
+
+    this->buffer.reset(new unsigned char[size + alignment]);
+
+    const std :: uintptr_t address = reinterpret_cast < std :: uintptr_t >(this->buffer.get());
+    this->base = this->buffer.get() + (alignment - address % alignment) % alignment;
+    this->capacity = size;
+
+    return true;
+  }
+
+  /**
+  * @brief Carve the next column from the buffer.
+  *
+  * @tparam T data type of the column
+  * @param size number of elements of the column
+  *
+  * @return The pointer to the first element of the column.
+  */
+  template < typename T >
+  T * column (const int64_t & size)
+  {
+    T * col = reinterpret_cast < T * >(this->base + this->offset);
+    this->offset += bytes < T >(size);
+    return col;
+  }
+
+  /**
+  * @brief Size of the buffer.
+  *
+  * @return The number of usable bytes of the buffer.
+  */
+  std :: size_t size () const
+  {
+    return this->capacity;
+  }
+
+};
+
+#endif // __column_arena_h__
@@ -32,20 +32,46 @@
 #include <memory>     // std :: unique_ptr
 #include <algorithm>  // std :: transform
 #include <numeric>    // std :: accumulate
+#include <functional> // std :: minus
 #include <vector>     // std :: vector
-#include <set>        // std :: set
 #include <cmath>      // std :: log
 #include <cassert>    // assert
 #include <limits>     // std :: numeric_limits
 
+#include <label_map.h>      // label_map
+#include <unique_labels.h>  // unique_labels
+#include <parallel_utils.h> // parallel_chunks
+#include <column_arena.h>   // column_arena
+#include <sparse_matrix.h>  // sparse_matrix
+#include <stats_types.h>    // count_t, real_t
+
+/// @cond DEF
+#ifdef _MSC_VER
+
+  #ifndef __unused
+    #define __unused
+  #endif
+
+#else // Not Visual Studio Compiler
+
+  #ifndef __unused
+    #define __unused __attribute__((__unused__))
+  #endif
+
+#endif
+/// @endcond
+
 /// @cond DEF
-constexpr float inf = std :: numeric_limits < float > :: infinity();
-constexpr float epsil = std :: numeric_limits < float > :: min();
+constexpr real_t inf = std :: numeric_limits < real_t > :: infinity();
+constexpr real_t epsil = std :: numeric_limits < real_t > :: min();
 /// @endcond
 
 /**
 * @brief Get the array of classes.
 *
+* @details The classes are the sorted union of the distinct labels of the two
+* arrays, discovered in a single parallel pass (see unique_labels).
+*
 * @param lbl_true array of true labels as integers
 * @param lbl_pred array of predicted labels as integers
 * @param n_true size of lbl_true array
@@ -60,20 +86,48 @@ struct // Classes
   {
     assert (n_pred == n_true);
 
-    std :: set < int32_t > u1 (lbl_true, lbl_true + n_true);
-    std :: set < int32_t > u2 (lbl_pred, lbl_pred + n_pred);
+    const std :: vector < int32_t > labels = unique_labels(lbl_true, lbl_pred, std :: min(n_true, n_pred));
 
-    std :: vector < float > classes (u1.size() + u2.size());
-    auto it = std :: set_union(u1.begin(), u1.end(),
-                               u2.begin(), u2.end(),
-                               classes.begin());
-    classes.resize(it - classes.begin());
+    std :: vector < float > classes (labels.begin(), labels.end());
 
     return classes;
   }
   /// @endcond
-} get_classes;
+} get_classes __unused;
+
+
+/// @cond DEF
+constexpr int64_t private_cells = 1 << 24; ///< max number of counters in the private histograms of the confusion matrix
+/// @endcond
+
+/**
+* @brief Number of counters of the workspace required by get_confusion_matrix.
+*
+* @details The value is an upper bound for any number of chunks in [1, nchunks],
+* so a workspace reserved with nchunks = num_workers() is never reallocated by the
+* following evaluations with the same number of classes.
+*
+* @param Nclass size of classes array (aka number of classes)
+* @param nchunks max number of chunks of the label arrays
+*
+* @return The number of uint32_t counters.
+*/
+inline int64_t confusion_matrix_cells (const int32_t & Nclass, const int32_t & nchunks)
+{
+  const int64_t Ncell = static_cast < int64_t >(Nclass) * Nclass;
 
+  if ( Ncell == 0 )
+    return 0;
+
+  // private histograms padded to a multiple of the cache line to avoid false sharing
+  constexpr int64_t pad = cache_line / sizeof(uint32_t);
+  const int64_t stride = (Ncell + pad - 1) / pad * pad;
+
+  // number of private histograms which fit the memory budget
+  const int64_t fit = std :: min(static_cast < int64_t >(nchunks), private_cells / stride);
+
+  return std :: max(stride * fit, fit < nchunks ? Ncell : int64_t(0));
+}
 
 /**
 * @brief Get the confusion matrix of the labels
@@ -81,39 +135,203 @@ struct // Classes
 * @details A confusion matrix, also known as an error matrix, is a
 * specific table layout that allows visualization of the performance
 * of an algorithm.
+* The labels are remapped into class indexes using the label_map built
+* from the array of classes, so the accumulation costs O(n_lbl).
+* Labels which are not in the array of classes are ignored.
+* The label arrays are split in chunks (one for each available thread) which
+* are accumulated in private integer histograms and then reduced.
+* If the private histograms do not fit the memory budget (large number of classes)
+* a shared integer histogram with atomic updates is used.
+* The lookup table and the histograms are stored into the given buffers, which
+* are reused without any allocation if their capacity is enough.
 *
 * @param lbl_true array of true labels as integers
 * @param lbl_pred array of predicted labels as integers
 * @param n_lbl size of label arrays
 * @param classes array of classes
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The confusion matrix as ravel array
+* @param lut lookup table of the classes (rebuilt by the function)
+* @param workspace scratch memory of the histograms (see confusion_matrix_cells)
+* @param confusion_matrix output confusion matrix as ravel array (Nclass * Nclass)
 */
 struct // Confusion Matrix
 {
   /// @cond DEF
-  auto operator() (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl, const float * classes, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl, const float * classes, const int32_t & Nclass, label_map & lut, column_arena & workspace, count_type * confusion_matrix)
   {
-    std :: unique_ptr < float[] > confusion_matrix (new float[Nclass * Nclass]);
+    constexpr int64_t label_grain   = 1 << 15; // min number of labels for each chunk
+    constexpr int64_t cell_grain    = 1 << 14; // min number of cells for each reduction block
+
+    const int64_t Ncell = static_cast < int64_t >(Nclass) * Nclass;
+
+    // remap the labels into class indexes with O(1) lookup
+    lut.build(classes, Nclass);
+
+    const int32_t nchunks = num_chunks(n_lbl, label_grain);
 
-    std :: fill_n(confusion_matrix.get(), Nclass * Nclass, 0.f);
+    // private histograms padded to a multiple of the cache line to avoid false sharing
+    constexpr int64_t pad = cache_line / sizeof(uint32_t);
+    const int64_t stride = (Ncell + pad - 1) / pad * pad;
 
-    auto start = classes,
-         end   = classes + Nclass;
+    const int64_t cells = confusion_matrix_cells(Nclass, nchunks);
+    workspace.reserve(column_arena :: bytes < uint32_t >(cells));
+    uint32_t * hist = workspace.column < uint32_t >(cells);
 
-    int32_t i1 = 0;
-    int32_t i2 = 0;
-    for (int32_t i = 0; i < n_lbl; ++i)
+    if ( stride * nchunks > private_cells )
     {
-      i1 = std :: distance(start, std :: find(start, end, lbl_true[i]));
-      i2 = std :: distance(start, std :: find(start, end, lbl_pred[i]));
-      ++ confusion_matrix[i1 * Nclass + i2];
+      // large number of classes: shared integer histogram with atomic updates
+      std :: fill_n(hist, Ncell, 0u);
+
+      parallel_chunks(nchunks, [&] (const int32_t & c)
+      {
+        const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+        for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+        {
+          const int32_t t = lut[lbl_true[i]];
+          const int32_t p = lut[lbl_pred[i]];
+
+          if ( t < 0 || p < 0 )
+            continue;
+
+          const int64_t idx = static_cast < int64_t >(t) * Nclass + p;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          ++ hist[idx];
+        }
+      });
+
+      std :: copy_n(hist, Ncell, confusion_matrix);
+
+      return;
     }
-    return confusion_matrix;
+
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      uint32_t * local = hist + c * stride;
+      std :: fill_n(local, Ncell, 0u);
+
+      const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+      for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+      {
+        const int32_t t = lut[lbl_true[i]];
+        const int32_t p = lut[lbl_pred[i]];
+
+        if ( t >= 0 && p >= 0 )
+          ++ local[t * Nclass + p];
+      }
+    });
+
+    // reduction of the private histograms
+    const int32_t nblocks = num_chunks(Ncell * nchunks, cell_grain);
+
+    parallel_chunks(nblocks, [&] (const int32_t & b)
+    {
+      const int64_t end = chunk_begin(Ncell, b + 1, nblocks);
+
+      for (int64_t k = chunk_begin(Ncell, b, nblocks); k < end; ++k)
+      {
+        count_type count = 0;
+        for (int32_t c = 0; c < nchunks; ++c)
+          count += hist[c * stride + k];
+        confusion_matrix[k] = count;
+      }
+    });
+  }
+
+  /**
+  * @brief Get the confusion matrix of the labels using temporary buffers.
+  *
+  * @details Convenience overload for a single evaluation: the lookup table
+  * and the histograms are allocated by each call.
+  *
+  */
+  template < typename count_type >
+  void operator() (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl, const float * classes, const int32_t & Nclass, count_type * confusion_matrix)
+  {
+    label_map lut;
+    column_arena workspace;
+    (*this)(lbl_true, lbl_pred, n_lbl, classes, Nclass, lut, workspace, confusion_matrix);
   }
   /// @endcond
-} get_confusion_matrix;
+} get_confusion_matrix __unused;
+
+/**
+* @brief Get the marginals of the confusion matrix
+*
+* @details The row sums, the column sums and the diagonal of the confusion
+* matrix are evaluated in a single sweep: the matrix is visited row by row
+* in tiles of columns, so the partial column sums of the current tile stay
+* in cache and each row segment is a contiguous (vectorized) reduction.
+* The other counters (TP, FN, FP, TN) are derived from the marginals in O(Nclass).
+*
+* @param confusion_matrix the confusion matrix of the labels (dense ravel array or sparse_matrix)
+* @param Nclass size of classes array (aka number of classes)
+* @param marginals output array of row sums, column sums and diagonal (lenght := 3 * Nclass)
+*/
+struct // Marginals
+{
+  /// @cond DEF
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const int32_t & Nclass, count_type * marginals)
+  {
+    constexpr int32_t tile = 2048; // number of columns (partial column sums) kept in cache
+
+    count_type * rows = marginals;
+    count_type * cols = marginals + Nclass;
+    count_type * diag = marginals + 2 * Nclass;
+
+    std :: fill_n(marginals, 3 * Nclass, count_type(0));
+
+    for (int32_t j0 = 0; j0 < Nclass; j0 += tile)
+    {
+      const int32_t j1 = std :: min(j0 + tile, Nclass);
+
+      for (int32_t i = 0; i < Nclass; ++i)
+      {
+        const count_type * row = confusion_matrix + static_cast < int64_t >(i) * Nclass;
+        count_type sum = 0;
+
+        for (int32_t j = j0; j < j1; ++j)
+        {
+          const count_type cell = row[j];
+          sum += cell;
+          cols[j] += cell;
+        }
+
+        rows[i] += sum;
+      }
+
+      for (int32_t i = j0; i < j1; ++i)
+        diag[i] = confusion_matrix[static_cast < int64_t >(i) * Nclass + i];
+    }
+  }
+
+  template < typename count_type >
+  void operator() (const sparse_matrix & confusion_matrix, const int32_t & Nclass, count_type * marginals)
+  {
+    count_type * rows = marginals;
+    count_type * cols = marginals + Nclass;
+    count_type * diag = marginals + 2 * Nclass;
+
+    std :: fill_n(marginals, 3 * Nclass, count_type(0));
+
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+      {
+        const int32_t j = confusion_matrix.col(k);
+        const count_type cell = confusion_matrix.count(k);
+
+        rows[i] += cell;
+        cols[j] += cell;
+        diag[i] += (i == j) ? cell : count_type(0);
+      }
+  }
+  /// @endcond
+} get_marginals __unused;
 
 /**
 * @brief Get the True positive score
@@ -121,23 +339,20 @@ struct // Confusion Matrix
 * @details A true positive test result is one that detects the
 * condition when the condition is present (correctly identified).
 *
-* @param confusion_matrix the confusion matrix of the labels
+* @param marginals the marginals of the confusion matrix
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of True positive scores (lenght := Nclass)
+* @param TP output array of True positive scores (lenght := Nclass)
 */
 struct // TP(True positive/hit)
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * marginals, const int32_t & Nclass, count_type * TP)
   {
-    std :: unique_ptr < float[] > TP (new float[Nclass]);
-    for (int32_t i = 0; i < Nclass; ++i)
-      TP[i] = confusion_matrix[i * Nclass + i];
-    return TP;
+    std :: copy_n(marginals + 2 * Nclass, Nclass, TP);
   }
   /// @endcond
-} get_TP;
+} get_TP __unused;
 
 /**
 * @brief Get the False negative score
@@ -145,110 +360,74 @@ struct // TP(True positive/hit)
 * @details A false negative test result is one that does not detect the
 * condition when the condition is present (incorrectly rejected).
 *
-* @param confusion_matrix the confusion matrix of the labels
+* @param marginals the marginals of the confusion matrix
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of False negative scores (lenght := Nclass)
+* @param FN output array of False negative scores (lenght := Nclass)
 */
 struct // FN(False negative/miss/type 2 error)
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * marginals, const int32_t & Nclass, count_type * FN)
   {
-    std :: unique_ptr < float[] > FN (new float[Nclass]);
-    int32_t N;
-    for (int32_t i = 0; i < Nclass; ++i)
-    {
-      N = i * Nclass;
-      FN[i] = std :: accumulate(confusion_matrix + N,
-                                confusion_matrix + N + i,
-                                0.f) +
-              std :: accumulate(confusion_matrix + N + i + 1,
-                                confusion_matrix + N + Nclass,
-                                0.f);
-    }
-    return FN;
+    // row sum - diagonal
+    std :: transform(marginals, marginals + Nclass,
+                     marginals + 2 * Nclass,
+                     FN, std :: minus < count_type >());
   }
   /// @endcond
-} get_FN;
+} get_FN __unused;
 
 /**
 * @brief Get the False positive score
 *
 * @details A false positive test result is one that detects the condition when the condition is absent (incorrectly identified).
 *
-* @param confusion_matrix the confusion matrix of the labels
+* @param marginals the marginals of the confusion matrix
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of False positive scores (lenght := Nclass)
+* @param FP output array of False positive scores (lenght := Nclass)
 */
 struct // FP(False positive/type 1 error/false alarm)
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * marginals, const int32_t & Nclass, count_type * FP)
   {
-    std :: unique_ptr < float[] > FP (new float[Nclass]);
-    std :: fill_n(FP.get(), Nclass, 0.f);
-    for (int32_t i = 0; i < Nclass; ++i)
-      for (int32_t j = 0; j < Nclass; ++j)
-        FP[j] += (i != j) ? confusion_matrix[i * Nclass + j] : 0.f;
-
-    return FP;
+    // column sum - diagonal
+    std :: transform(marginals + Nclass, marginals + 2 * Nclass,
+                     marginals + 2 * Nclass,
+                     FP, std :: minus < count_type >());
   }
   /// @endcond
-} get_FP;
+} get_FP __unused;
 
 /**
 * @brief Get the True negative score
 *
 * @details A true negative test result is one that does not detect the condition when the condition is absent (correctly rejected).
 *
-* @param confusion_matrix the confusion matrix of the labels
+* @param marginals the marginals of the confusion matrix
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of True negative scores (lenght := Nclass)
+* @param TN output array of True negative scores (lenght := Nclass)
 */
 struct // TN(True negative/correct rejection)
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * marginals, const int32_t & Nclass, count_type * TN)
   {
-    std :: unique_ptr < float[] > TN (new float[Nclass]);
-    switch (Nclass)
-    {
-      case 1:
-      {
-        std :: cerr << "WARNING! Nclass must be greater than 1" << std :: endl;
-      } break;
-      case 2:
-      {
-        TN[0] = confusion_matrix[3];
-        TN[1] = confusion_matrix[0];
-      } break;
-      case 3:
-      {
-        TN[0] = confusion_matrix[4] + confusion_matrix[5] + confusion_matrix[7] + confusion_matrix[8];
-        TN[1] = confusion_matrix[0] + confusion_matrix[2] + confusion_matrix[6] + confusion_matrix[8];
-        TN[2] = confusion_matrix[0] + confusion_matrix[1] + confusion_matrix[3] + confusion_matrix[4];
-      } break;
-      default:
-      {
-        std :: fill_n(TN.get(), Nclass, 0.f);
+    const count_type * rows = marginals;
+    const count_type * cols = marginals + Nclass;
+    const count_type * diag = marginals + 2 * Nclass;
 
-        for (int32_t i = 0; i < Nclass; ++i)
-          for (int32_t j = 0; j < Nclass; ++j)
-            if (i != j)
-              TN[j] += std :: accumulate(confusion_matrix + i * Nclass,
-                                         confusion_matrix + i * Nclass + Nclass,
-                                         0.f) - confusion_matrix[i * Nclass + j];
+    const count_type total = std :: accumulate(rows, rows + Nclass, count_type(0));
 
-        std :: cerr << "WARNING! Nclass greater than 3 is not supported yet!" << std :: endl;
-      } break;
-    }
-    return TN;
+    // population - (row sum + column sum - diagonal)
+    for (int32_t i = 0; i < Nclass; ++i)
+      TN[i] = total - rows[i] - cols[i] + diag[i];
   }
   /// @endcond
-} get_TN;
+} get_TN __unused;
 
 /**
 * @brief Get the Total sample size.
@@ -262,21 +441,25 @@ struct // TN(True negative/correct rejection)
 * @param FP array of false positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of total samples for each class.
+* @param POP output array of total samples for each class.
 */
 struct // POP(Population)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TN, const float * FP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TN, const count_type * FP, const count_type * FN, const int32_t & Nclass, count_type * POP)
   {
-    std :: unique_ptr < float[] > POP (new float[Nclass]);
     for (int32_t i = 0; i < Nclass; ++i)
-      POP[i] = TP[i] + TN[i] + FP[i] + FN[i];
-    return POP;
+      POP[i] = (*this)(TP[i], TN[i], FP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  count_type operator() (const count_type & TP, const count_type & TN, const count_type & FP, const count_type & FN) const
+  {
+    return TP + TN + FP + FN;
   }
   /// @endcond
-} get_POP;
+} get_POP __unused;
 
 /**
 * @brief Number of positive samples.
@@ -290,24 +473,25 @@ struct // POP(Population)
 * @param TP array of true positives
 * @param FN array of false negative
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the number of positive samples for each class.
+* @param P output array of the number of positive samples for each class.
 */
 struct // P(Condition positive or support)
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FN, const int32_t & Nclass, count_type * P)
   {
-    std :: unique_ptr < float[] > P (new float[Nclass]);
-    std :: transform(TP, TP + Nclass, FN, P.get(),
-                     [](const float & tp, const float & fn)
-                     {
-                        return tp + fn;
-                     });
-    return P;
+    for (int32_t i = 0; i < Nclass; ++i)
+      P[i] = (*this)(TP[i], FN[i]);
+  }
+
+  template < typename count_type >
+  count_type operator() (const count_type & TP, const count_type & FN) const
+  {
+    return TP + FN;
   }
   /// @endcond
-} get_P;
+} get_P __unused;
 
 /**
 * @brief Number of negative samples
@@ -319,25 +503,25 @@ struct // P(Condition positive or support)
 * @param TN array of true negatives
 * @param FP array of false positives
 * @param Nclass size of classes array (aka number of classes)
-*
-* @return The array of the number of negative samples for each class
+* @param N output array of the number of negative samples for each class
 */
 struct // N(Condition negative)
 {
   /// @cond DEF
-  auto operator() (const float * TN, const float * FP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TN, const count_type * FP, const int32_t & Nclass, count_type * N)
+  {
+    for (int32_t i = 0; i < Nclass; ++i)
+      N[i] = (*this)(TN[i], FP[i]);
+  }
+
+  template < typename count_type >
+  count_type operator() (const count_type & TN, const count_type & FP) const
   {
-    std :: unique_ptr < float[] > N (new float[Nclass]);
-    for (int32_t i = 0; i < Nclass; ++i) N[i] = TN[i] + FP[i];
-    std :: transform(TN, TN + Nclass, FP, N.get(),
-                     [](const float & tn, const float & fp)
-                     {
-                        return tn + fp;
-                     });
-    return N;
+    return TN + FP;
   }
   /// @endcond
-} get_N;
+} get_N __unused;
 
 #endif // __common_stats_h__
 
@@ -0,0 +1,551 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#ifndef __confusion_accumulator_h__
+#define __confusion_accumulator_h__
+
+#include <vector>          // std :: vector
+#include <algorithm>       // std :: set_union
+#include <iterator>        // std :: back_inserter
+#include <istream>         // std :: istream
+#include <ostream>         // std :: ostream
+#include <cstdint>         // int32_t
+#include <limits>          // std :: numeric_limits
+#include <cassert>         // assert
+
+#include <label_map.h>     // label_map
+#include <unique_labels.h> // unique_labels
+#include <stats_types.h>   // count_t
+
+/**
+* @brief Add the given classes to a set and remap its confusion matrix.
+*
+* @details The set becomes the sorted union of the two arrays and the cells
+* of the matrix are moved into the larger matrix (the rows and the columns of
+* the new classes are empty). The function is shared by the accumulators of the
+* confusion matrix (e.g. confusion_accumulator and decayed_accumulator).
+*
+* @tparam T data type of the cells of the matrix
+* @tparam Labels container of labels
+* @param labels sorted array of classes (extended)
+* @param matrix confusion matrix as ravel array (Nclass * Nclass) of the classes (remapped)
+* @param lut lookup table from labels to class indexes (rebuilt)
+* @param found sorted array of classes
+*
+*/
+template < typename T, typename Labels >
+void extend_classes (std :: vector < float > & labels, std :: vector < T > & matrix, label_map & lut, const Labels & found)
+{
+  std :: vector < float > merged;
+  merged.reserve(labels.size() + found.size());
+  std :: set_union(labels.begin(), labels.end(), found.begin(), found.end(), std :: back_inserter(merged));
+
+  const int32_t Nold = static_cast < int32_t >(labels.size());
+  const int32_t Nnew = static_cast < int32_t >(merged.size());
+
+  if ( Nnew == Nold )
+    return;
+
+  // position of the old classes into the merged array
+  std :: vector < int32_t > pos (Nold);
+  for (int32_t i = 0, j = 0; i < Nold; ++i, ++j)
+  {
+    while ( merged[j] != labels[i] )
+      ++ j;
+    pos[i] = j;
+  }
+
+  std :: vector < T > remap (static_cast < std :: size_t >(Nnew) * Nnew, T(0));
+
+  for (int32_t i = 0; i < Nold; ++i)
+    for (int32_t j = 0; j < Nold; ++j)
+      remap[static_cast < int64_t >(pos[i]) * Nnew + pos[j]] = matrix[static_cast < int64_t >(i) * Nold + j];
+
+  labels.swap(merged);
+  matrix.swap(remap);
+  lut.build(labels.data(), Nnew);
+}
+
+/**
+* @class confusion_accumulator
+* @brief Confusion matrix updated incrementally by batches of labels.
+*
+* @details The accumulator stores the sorted array of classes found so far
+* and the corresponding confusion matrix (as ravel array), so the memory does
+* not depend on the number of accumulated labels.
+* When a batch contains new labels the set of classes is extended (once for
+* each batch) and the previous counts are remapped into the larger matrix.
+* If the classes are fixed (see reset) the labels out of the set are ignored
+* and the update does not perform any allocation.
+* The matrix is allocated by the first accumulation (update or merge), so a large
+* set of classes can be fixed without allocating its matrix (e.g. when the
+* scorer only evaluates the labels in sparse mode).
+* The accumulator is also the partial result of a distributed evaluation:
+* partials of different shards can be merged (with different sets of classes),
+* stored with a compact binary format (see save) and finally scored by finalize.
+*
+*/
+class confusion_accumulator
+{
+
+  std :: vector < float > labels;   ///< sorted array of classes
+  std :: vector < count_t > matrix; ///< confusion matrix as ravel array (Nclass * Nclass)
+
+  label_map lut; ///< lookup table from labels to class indexes
+
+  bool fixed; ///< true if the set of classes can not be extended
+
+  static constexpr int32_t magic_size = 4; ///< size of the header of the binary format
+  static constexpr uint8_t version = 1;    ///< version of the binary format
+
+public:
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  confusion_accumulator () : fixed (false)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~confusion_accumulator () = default;
+
+  /**
+  * @brief Clear the accumulated counts and set the classes.
+  *
+  * @details A non-empty array of classes fixes the set of classes,
+  * while an empty one (Nclass = 0) enables the discovery of the classes
+  * from the labels.
+  *
+  * @param classes sorted array of classes
+  * @param Nclass size of classes array (aka number of classes)
+  *
+  */
+  void reset (const float * classes, const int32_t & Nclass)
+  {
+    this->labels.assign(classes, classes + Nclass);
+    this->matrix.clear();
+    this->lut.build(this->labels.data(), Nclass);
+    this->fixed = Nclass > 0;
+  }
+
+  /**
+  * @brief Clear the accumulated counts keeping the classes.
+  *
+  */
+  void clear ()
+  {
+    std :: fill(this->matrix.begin(), this->matrix.end(), count_t(0));
+  }
+
+  /**
+  * @brief Accumulate a batch of labels into the confusion matrix.
+  *
+  * @details The labels are accumulated in a single pass: at the first
+  * unknown label the classes of the remaining part of the batch are
+  * added to the set (if it is not fixed) and the pass continues.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred array of predicted labels as integers
+  * @param n_lbl size of label arrays
+  *
+  */
+  void update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+  {
+    this->allocate();
+
+    int32_t i = 0;
+
+    while ( i < n_lbl )
+    {
+      const int32_t Nclass = this->size();
+      count_t * cm = this->matrix.data();
+
+      for (; i < n_lbl; ++i)
+      {
+        const int32_t t = this->lut[lbl_true[i]];
+        const int32_t p = this->lut[lbl_pred[i]];
+
+        if ( t < 0 || p < 0 )
+        {
+          if ( !this->fixed )
+            break;
+
+          continue;
+        }
+
+        ++ cm[static_cast < int64_t >(t) * Nclass + p];
+      }
+
+      if ( i < n_lbl )
+        extend_classes(this->labels, this->matrix, this->lut, unique_labels(lbl_true + i, lbl_pred + i, n_lbl - i));
+    }
+  }
+
+  /**
+  * @brief Remove a batch of labels from the confusion matrix.
+  *
+  * @details The batch must be already accumulated by update (e.g. the oldest
+  * labels of a sliding window), so each pair of labels costs a single decrement.
+  * The labels out of the set of classes are ignored, as in update with fixed classes,
+  * and a pair which was never accumulated is a precondition violation: it is
+  * asserted in debug builds and it never decrements an empty cell.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred array of predicted labels as integers
+  * @param n_lbl size of label arrays
+  *
+  */
+  void remove (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+  {
+    if ( this->matrix.empty() )
+      return;
+
+    const int32_t Nclass = this->size();
+    count_t * cm = this->matrix.data();
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      const int32_t t = this->lut[lbl_true[i]];
+      const int32_t p = this->lut[lbl_pred[i]];
+
+      if ( t < 0 || p < 0 )
+        continue;
+
+      count_t & cell = cm[static_cast < int64_t >(t) * Nclass + p];
+
+      assert (cell > 0);
+
+      if ( cell > 0 )
+        -- cell;
+    }
+  }
+
+  /**
+  * @brief Add the counts of another partial confusion matrix.
+  *
+  * @details The set of classes becomes the union of the two sets and the counts
+  * are remapped accordingly. If the classes are fixed the counts of the classes
+  * out of the set are ignored.
+  *
+  * @param other partial confusion matrix
+  *
+  */
+  void merge (const confusion_accumulator & other)
+  {
+    this->allocate();
+
+    if ( !this->fixed )
+      extend_classes(this->labels, this->matrix, this->lut, other.labels);
+
+    if ( other.matrix.empty() )
+      return;
+
+    const int32_t Nclass = this->size();
+    const int32_t Nother = other.size();
+
+    // position of the other classes into the current array (-1 if ignored)
+    std :: vector < int32_t > pos (Nother);
+    for (int32_t i = 0; i < Nother; ++i)
+      pos[i] = this->lut[static_cast < int32_t >(other.labels[i])];
+
+    for (int32_t i = 0; i < Nother; ++i)
+    {
+      if ( pos[i] < 0 )
+        continue;
+
+      for (int32_t j = 0; j < Nother; ++j)
+        if ( pos[j] >= 0 )
+          this->matrix[static_cast < int64_t >(pos[i]) * Nclass + pos[j]] += other.matrix[static_cast < int64_t >(i) * Nother + j];
+    }
+  }
+
+  /**
+  * @brief Write the partial confusion matrix in binary format.
+  *
+  * @details The format is a 4 bytes header ("SCCM"), the version and a flag byte
+  * (fixed classes), followed by the number of classes, the classes (as differences
+  * between consecutive values) and the counts of the matrix in row-major order.
+  * All the integers are stored as LEB128 variable-length values (the signed ones
+  * with zig-zag encoding), so the format does not depend on the endianness and
+  * the empty cells of the matrix take a single byte.
+  *
+  * @param os output binary stream
+  *
+  * @return True if the stream is still good after the write.
+  */
+  bool save (std :: ostream & os) const
+  {
+    os.write(magic(), magic_size);
+    os.put(static_cast < char >(version));
+    os.put(static_cast < char >(this->fixed ? 1 : 0));
+
+    write_varint(os, static_cast < uint64_t >(this->size()));
+
+    int64_t previous = 0;
+    for (const auto & lbl : this->labels)
+    {
+      const int64_t delta = static_cast < int64_t >(lbl) - previous;
+      write_varint(os, (static_cast < uint64_t >(delta) << 1) ^ static_cast < uint64_t >(delta >> 63));
+      previous = static_cast < int64_t >(lbl);
+    }
+
+    for (const auto & count : this->matrix)
+      write_varint(os, count);
+
+    // the matrix which is not allocated yet is stored as empty cells
+    const uint64_t Ncell = static_cast < uint64_t >(this->size()) * this->size();
+    for (uint64_t i = this->matrix.size(); i < Ncell; ++i)
+      write_varint(os, 0);
+
+    return os.good();
+  }
+
+  /**
+  * @brief Read a partial confusion matrix written by save.
+  *
+  * @details The current content is replaced only if the stream stores a valid
+  * partial confusion matrix.
+  *
+  * @param is input binary stream
+  *
+  * @return True if the partial confusion matrix has been read correctly.
+  */
+  bool load (std :: istream & is)
+  {
+    char header[magic_size];
+    if ( !is.read(header, magic_size) || !std :: equal(header, header + magic_size, magic()) )
+      return false;
+
+    const int ver = is.get();
+    const int flags = is.get();
+
+    uint64_t Nclass;
+    if ( ver != version || flags < 0 || flags > 1 || !read_varint(is, Nclass) || Nclass > static_cast < uint64_t >(std :: numeric_limits < int32_t > :: max()) )
+      return false;
+
+    std :: vector < float > classes (Nclass);
+
+    int64_t previous = 0;
+    for (uint64_t i = 0; i < Nclass; ++i)
+    {
+      uint64_t code;
+      if ( !read_varint(is, code) )
+        return false;
+
+      const int64_t lbl = previous + static_cast < int64_t >((code >> 1) ^ (~(code & 1) + 1));
+
+      // the classes must be strictly increasing 32 bit labels
+      if ( (i > 0 && lbl <= previous) || lbl < std :: numeric_limits < int32_t > :: min() || lbl > std :: numeric_limits < int32_t > :: max() )
+        return false;
+
+      classes[i] = static_cast < float >(lbl);
+      previous = lbl;
+    }
+
+    // each count takes at least one byte, so a shorter stream is rejected before the allocation
+    // (the matrix of a non-seekable stream grows with the counts actually read)
+    const uint64_t Ncell = Nclass * Nclass;
+    const uint64_t available = remaining(is);
+
+    if ( Ncell > available )
+      return false;
+
+    std :: vector < count_t > counts;
+    counts.reserve(std :: min(Ncell, available == std :: numeric_limits < uint64_t > :: max() ? uint64_t(1) << 16 : Ncell));
+
+    for (uint64_t i = 0; i < Ncell; ++i)
+    {
+      uint64_t count;
+      if ( !read_varint(is, count) )
+        return false;
+
+      counts.push_back(count);
+    }
+
+    this->labels.swap(classes);
+    this->matrix.swap(counts);
+    this->lut.build(this->labels.data(), this->size());
+    this->fixed = flags == 1;
+
+    return true;
+  }
+
+  /**
+  * @brief Compute the scores of the accumulated confusion matrix.
+  *
+  * @details This is the final step of a distributed evaluation, i.e the
+  * statistics pipeline run on the merged partials.
+  * Without any accumulated label the matrix of empty cells is scored.
+  *
+  * @tparam Scorer scorer type (see scorer :: compute_from_confusion_matrix)
+  * @param score scorer object which stores the results
+  *
+  */
+  template < typename Scorer >
+  void finalize (Scorer & score) const
+  {
+    if ( this->matrix.empty() )
+    {
+      const std :: vector < count_t > empty (static_cast < std :: size_t >(this->size()) * this->size(), count_t(0));
+      score.compute_from_confusion_matrix(empty.data(), this->size(), this->labels.data());
+      return;
+    }
+
+    score.compute_from_confusion_matrix(this->matrix.data(), this->size(), this->labels.data());
+  }
+
+  /**
+  * @brief Number of classes.
+  *
+  * @return The size of the classes array.
+  */
+  int32_t size () const
+  {
+    return static_cast < int32_t >(this->labels.size());
+  }
+
+  /**
+  * @brief Array of classes.
+  *
+  * @return The sorted array of classes found so far.
+  */
+  const std :: vector < float > & classes () const
+  {
+    return this->labels;
+  }
+
+  /**
+  * @brief Accumulated confusion matrix.
+  *
+  * @return The pointer to the ravel confusion matrix (Nclass * Nclass),
+  * nullptr if the matrix is not allocated yet (see update).
+  */
+  const count_t * data () const
+  {
+    return this->matrix.data();
+  }
+
+private:
+
+  /**
+  * @brief Allocate the matrix of the current classes, if it is not allocated yet.
+  *
+  */
+  void allocate ()
+  {
+    if ( this->matrix.empty() )
+      this->matrix.assign(static_cast < std :: size_t >(this->size()) * this->size(), count_t(0));
+  }
+
+  /**
+  * @brief Header of the binary format.
+  *
+  * @return The array of magic_size characters which starts a saved partial.
+  */
+  static const char * magic ()
+  {
+    return "SCCM";
+  }
+
+  /**
+  * @brief Number of bytes left in the input stream.
+  *
+  * @param is input binary stream
+  *
+  * @return The bytes between the current position and the end of the stream
+  * (the maximum value if the stream is not seekable).
+  */
+  static uint64_t remaining (std :: istream & is)
+  {
+    const std :: istream :: pos_type current = is.tellg();
+
+    if ( current == std :: istream :: pos_type(-1) )
+      return std :: numeric_limits < uint64_t > :: max();
+
+    is.seekg(0, std :: ios :: end);
+    const std :: istream :: pos_type end = is.tellg();
+    is.seekg(current);
+
+    return end < current ? 0 : static_cast < uint64_t >(end - current);
+  }
+
+  /**
+  * @brief Write an unsigned integer as LEB128 variable-length value.
+  *
+  * @param os output binary stream
+  * @param value integer value
+  *
+  */
+  static void write_varint (std :: ostream & os, uint64_t value)
+  {
+    while ( value >= 0x80 )
+    {
+      os.put(static_cast < char >((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+
+    os.put(static_cast < char >(value));
+  }
+
+  /**
+  * @brief Read an unsigned integer stored as LEB128 variable-length value.
+  *
+  * @param is input binary stream
+  * @param value integer value
+  *
+  * @return True if the value has been read correctly.
+  */
+  static bool read_varint (std :: istream & is, uint64_t & value)
+  {
+    value = 0;
+
+    for (int32_t shift = 0; shift < 64; shift += 7)
+    {
+      const int byte = is.get();
+
+      if ( byte == std :: istream :: traits_type :: eof() )
+        return false;
+
+      value |= static_cast < uint64_t >(byte & 0x7F) << shift;
+
+      if ( !(byte & 0x80) )
+        return true;
+    }
+
+    return false;
+  }
+
+};
+
+#endif // __confusion_accumulator_h__
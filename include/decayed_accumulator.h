@@ -0,0 +1,239 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __decayed_accumulator_h__
+#define __decayed_accumulator_h__
+
+#include <vector>                  // std :: vector
+#include <algorithm>               // std :: transform
+#include <iostream>                // std :: cerr
+#include <cstdlib>                 // std :: exit
+#include <cstdint>                 // int32_t
+
+#include <label_map.h>             // label_map
+#include <unique_labels.h>         // unique_labels
+#include <confusion_accumulator.h> // extend_classes
+
+/**
+* @class decayed_accumulator
+* @brief Confusion matrix of a stream with exponentially decayed weights.
+*
+* @details Each new pair of labels has unit weight while the weights of the
+* previous ones are multiplied by the decay factor, so the matrix follows the
+* recent behaviour of the classifier (the effective number of samples is
+* 1 / (1 - decay) at steady state).
+* The decay is not applied to the whole matrix: the counts are stored in units
+* which grow by 1 / decay at each label, so an update costs O(1) as for the
+* plain accumulator, and the matrix is rescaled (O(Nclass^2)) only when the
+* unit overflows the threshold.
+* The set of classes follows the rules of confusion_accumulator, i.e. it is
+* extended by the new labels unless it is fixed by reset.
+*
+*/
+class decayed_accumulator
+{
+
+  static constexpr double max_unit = 1e150; ///< threshold of the unit before the rescaling of the matrix
+
+  std :: vector < float > labels;   ///< sorted array of classes
+  std :: vector < double > matrix;  ///< confusion matrix (in units) as ravel array (Nclass * Nclass)
+
+  label_map lut; ///< lookup table from labels to class indexes
+
+  double decay; ///< decay factor of the weights for each new label
+  double unit;  ///< weight of the newest label in the units of the matrix
+  bool fixed;   ///< true if the set of classes can not be extended
+
+public:
+
+  /**
+  * @brief Construct the accumulator.
+  *
+  * @param decay decay factor in (0, 1] of the weights for each new label (1 gives the plain counts)
+  *
+  */
+  decayed_accumulator (const double & decay) : decay (decay), unit (1.), fixed (false)
+  {
+    // a null decay gives infinite units (i.e. NaN weights) and a decay out of (0, 1] is not a decay
+    if ( !(decay > 0. && decay <= 1.) )
+    {
+      std :: cerr << "The decay factor must be in (0, 1]" << std :: endl;
+      std :: exit(1);
+    }
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~decayed_accumulator () = default;
+
+  /**
+  * @brief Clear the accumulated weights and set the classes.
+  *
+  * @param classes sorted array of classes (see confusion_accumulator :: reset)
+  * @param Nclass size of classes array (aka number of classes)
+  *
+  */
+  void reset (const float * classes, const int32_t & Nclass)
+  {
+    this->labels.assign(classes, classes + Nclass);
+    this->matrix.assign(static_cast < std :: size_t >(Nclass) * Nclass, 0.);
+    this->lut.build(this->labels.data(), Nclass);
+    this->fixed = Nclass > 0;
+    this->unit = 1.;
+  }
+
+  /**
+  * @brief Clear the accumulated weights keeping the classes.
+  *
+  */
+  void clear ()
+  {
+    std :: fill(this->matrix.begin(), this->matrix.end(), 0.);
+    this->unit = 1.;
+  }
+
+  /**
+  * @brief Accumulate a batch of labels (in order of arrival) into the confusion matrix.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred array of predicted labels as integers
+  * @param n_lbl size of label arrays
+  *
+  */
+  void update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+  {
+    const double growth = 1. / this->decay;
+
+    int32_t i = 0;
+
+    while ( i < n_lbl )
+    {
+      const int32_t Nclass = this->size();
+      double * cm = this->matrix.data();
+
+      for (; i < n_lbl; ++i)
+      {
+        const int32_t t = this->lut[lbl_true[i]];
+        const int32_t p = this->lut[lbl_pred[i]];
+
+        if ( t < 0 || p < 0 )
+        {
+          if ( !this->fixed )
+            break;
+
+          continue;
+        }
+
+        this->unit *= growth;
+
+        if ( this->unit > max_unit )
+          this->rescale();
+
+        cm[static_cast < int64_t >(t) * Nclass + p] += this->unit;
+      }
+
+      if ( i < n_lbl )
+        extend_classes(this->labels, this->matrix, this->lut, unique_labels(lbl_true + i, lbl_pred + i, n_lbl - i));
+    }
+  }
+
+  /**
+  * @brief Compute the scores of the decayed confusion matrix.
+  *
+  * @details The weights are real-valued, so the scorer must store real-valued
+  * counts (i.e. weighted_scorer): the statistics refer to the effective number of samples.
+  *
+  * @tparam Scorer scorer type (see weighted_scorer)
+  * @param score scorer object which stores the results
+  *
+  */
+  template < typename Scorer >
+  void finalize (Scorer & score) const
+  {
+    const std :: vector < double > weights = this->weights();
+
+    score.compute_from_confusion_matrix(weights.data(), this->size(), this->labels.data());
+  }
+
+  /**
+  * @brief Decayed confusion matrix.
+  *
+  * @return The ravel confusion matrix (Nclass * Nclass) of the decayed weights.
+  */
+  std :: vector < double > weights () const
+  {
+    std :: vector < double > weights (this->matrix.size());
+    const double scale = 1. / this->unit;
+
+    std :: transform(this->matrix.begin(), this->matrix.end(), weights.begin(),
+                     [&] (const double & w) { return w * scale; });
+
+    return weights;
+  }
+
+  /**
+  * @brief Number of classes.
+  *
+  * @return The size of the classes array.
+  */
+  int32_t size () const
+  {
+    return static_cast < int32_t >(this->labels.size());
+  }
+
+  /**
+  * @brief Array of classes.
+  *
+  * @return The sorted array of classes found so far.
+  */
+  const std :: vector < float > & classes () const
+  {
+    return this->labels;
+  }
+
+private:
+
+  /**
+  * @brief Convert the matrix into the units of the newest label (i.e unit = 1).
+  *
+  */
+  void rescale ()
+  {
+    const double scale = 1. / this->unit;
+
+    for (auto & w : this->matrix)
+      w *= scale;
+
+    this->unit = 1.;
+  }
+
+};
+
+#endif // __decayed_accumulator_h__
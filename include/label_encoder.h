@@ -0,0 +1,514 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#ifndef __label_encoder_h__
+#define __label_encoder_h__
+
+#include <vector>           // std :: vector
+#include <algorithm>        // std :: sort
+#include <numeric>          // std :: iota
+#include <type_traits>      // std :: is_floating_point
+#include <cstring>          // std :: memcpy
+#include <cstdint>          // int32_t
+#include <limits>           // std :: numeric_limits
+
+#include <parallel_utils.h> // parallel_chunks
+
+/**
+* @class string_label
+* @brief View of a string label (fixed-width or variable-length) stored in an external buffer.
+*
+* @details The trailing null characters of the fixed-width strings are not part of
+* the view, so the same string stored with different widths gives the same label.
+* The characters are compared as unsigned values, i.e the order of the labels is the
+* order of the code points for UTF-8 and UCS4 strings.
+*
+* @tparam Char character type (uint8_t for bytes and UTF-8, uint32_t for UCS4)
+*
+*/
+template < typename Char >
+struct string_label
+{
+  const Char * data; ///< first character of the label
+  int64_t size;      ///< number of characters of the label
+
+  /**
+  * @brief Equality of two labels.
+  *
+  */
+  bool operator == (const string_label < Char > & other) const
+  {
+    return this->size == other.size && std :: equal(this->data, this->data + this->size, other.data);
+  }
+
+  /**
+  * @brief Inequality of two labels.
+  *
+  */
+  bool operator != (const string_label < Char > & other) const
+  {
+    return !(*this == other);
+  }
+
+  /**
+  * @brief Lexicographical order of two labels.
+  *
+  */
+  bool operator < (const string_label < Char > & other) const
+  {
+    return std :: lexicographical_compare(this->data, this->data + this->size, other.data, other.data + other.size);
+  }
+};
+
+/**
+* @brief Hash of the labels.
+*
+* @details Numerical labels are hashed by their bits, with a single value for the
+* floating point zeros and NaNs, and string labels by the FNV-1a hash of their characters.
+* The hash is then mixed by the MurmurHash3 finalizer, since the table uses its high bits
+* and the Fibonacci hashing of label_map clusters the labels given with a constant stride.
+*
+*/
+struct // Label hash
+{
+  /// @cond DEF
+  template < typename T >
+  uint64_t operator() (const T & label) const
+  {
+    uint64_t bits = 0;
+
+    if ( std :: is_floating_point < T > :: value )
+    {
+      // -0 == 0 and all the NaNs are the same label
+      const double value = label != label ? std :: numeric_limits < double > :: quiet_NaN() : static_cast < double >(label) + 0.;
+      std :: memcpy(&bits, &value, sizeof(double));
+    }
+    else
+      bits = static_cast < uint64_t >(label);
+
+    return mix(bits);
+  }
+
+  template < typename Char >
+  uint64_t operator() (const string_label < Char > & label) const
+  {
+    uint64_t hash = 14695981039346656037ull;
+
+    for (int64_t i = 0; i < label.size; ++i)
+      hash = (hash ^ static_cast < uint64_t >(label.data[i])) * 1099511628211ull;
+
+    return mix(hash);
+  }
+
+  static uint64_t mix (uint64_t bits)
+  {
+    bits ^= bits >> 33;
+    bits *= 0xff51afd7ed558ccdull;
+    bits ^= bits >> 33;
+    bits *= 0xc4ceb9fe1a85ec53ull;
+    bits ^= bits >> 33;
+    return bits;
+  }
+  /// @endcond
+} label_hash;
+
+/**
+* @brief Equality of the labels (all the NaNs are the same label).
+*
+*/
+struct // Label equal
+{
+  /// @cond DEF
+  template < typename T >
+  bool operator() (const T & a, const T & b) const
+  {
+    return a == b || (a != a && b != b);
+  }
+  /// @endcond
+} label_equal;
+
+/**
+* @brief Strict order of the labels (the NaNs are the last label).
+*
+*/
+struct // Label less
+{
+  /// @cond DEF
+  template < typename T >
+  bool operator() (const T & a, const T & b) const
+  {
+    return a < b || (a == a && b != b);
+  }
+  /// @endcond
+} label_less;
+
+
+/**
+* @class label_table
+* @brief Flat open-addressing hash table which assigns a dense index to each distinct label.
+*
+* @details The table uses linear probing with power-of-two capacity (as
+* label_set) and stores the labels in order of insertion, so the index of a label is
+* its position in the array of keys.
+*
+* @tparam T label type
+*
+*/
+template < typename T >
+class label_table
+{
+
+  std :: vector < int32_t > slots; ///< hash table of the label indexes (-1 for the empty slots)
+  int32_t shift;                   ///< hash shift (64 - log2(capacity))
+  int32_t mask;                    ///< hash mask (capacity - 1)
+
+public:
+
+  std :: vector < T > keys;        ///< distinct labels in order of insertion
+  std :: vector < int64_t > index; ///< position of an occurrence of each label
+
+  /**
+  * @brief Construct an empty table.
+  *
+  */
+  label_table ()
+  {
+    this->rehash(16);
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~label_table () = default;
+
+  /**
+  * @brief Number of distinct labels.
+  *
+  * @return The size of the table.
+  */
+  int32_t size () const
+  {
+    return static_cast < int32_t >(this->keys.size());
+  }
+
+  /**
+  * @brief Insert a label into the table.
+  *
+  * @details The table is doubled when the load factor exceeds 1/4, to keep the probe sequences short.
+  *
+  * @param label label value
+  * @param pos position of the label (stored only for new labels)
+  *
+  * @return The index of the label.
+  */
+  int32_t insert (const T & label, const int64_t & pos)
+  {
+    int32_t slot = static_cast < int32_t >(label_hash(label) >> this->shift);
+
+    while ( this->slots[slot] != -1 )
+    {
+      if ( label_equal(this->keys[this->slots[slot]], label) )
+        return this->slots[slot];
+
+      slot = (slot + 1) & this->mask;
+    }
+
+    const int32_t idx = this->size();
+
+    this->slots[slot] = idx;
+    this->keys.push_back(label);
+    this->index.push_back(pos);
+
+    if ( 4 * this->keys.size() > this->slots.size() )
+      this->rehash(this->size());
+
+    return idx;
+  }
+
+private:
+
+  /**
+  * @brief Resize the table to the first power of two greater than 4 * size
+  * and re-insert the stored labels.
+  *
+  * @param size number of labels to accommodate
+  *
+  */
+  void rehash (const int32_t & size)
+  {
+    int32_t nbits = 4;
+    while ( (int64_t(1) << nbits) <= 4 * static_cast < int64_t >(size) )
+      ++ nbits;
+
+    this->slots.assign(int64_t(1) << nbits, -1);
+    this->shift = 64 - nbits;
+    this->mask  = static_cast < int32_t >(this->slots.size()) - 1;
+
+    for (int32_t i = 0; i < this->size(); ++i)
+    {
+      int32_t slot = static_cast < int32_t >(label_hash(this->keys[i]) >> this->shift);
+      while ( this->slots[slot] != -1 )
+        slot = (slot + 1) & this->mask;
+
+      this->slots[slot] = i;
+    }
+  }
+
+};
+
+
+/**
+* @class label_encoder
+* @brief Encoder of two arrays of labels (of any type) into dense class indexes.
+*
+* @details The labels are hashed in a single parallel pass: each chunk of the arrays
+* fills a private label_table and writes the local indexes of its labels.
+* The private tables are merged, only the distinct labels are sorted and a second
+* (gather) pass rewrites the local indexes as the position of the label in the sorted
+* array of classes.
+* The cost is O(n_lbl + Nclass log Nclass), instead of the O(n_lbl log n_lbl) of a
+* sort-based encoding, and the codes are in [0, Nclass), so they can be used as
+* fixed classes of the scorer (see scorer :: set_classes) without any class discovery.
+*
+* Numerical labels are given as arrays of values, fixed-width strings as arrays of
+* characters with the width of each string and variable-length strings as arrays of
+* pointers and sizes.
+*
+*/
+class label_encoder
+{
+
+  std :: vector < int64_t > positions; ///< position of an occurrence of each class
+
+public:
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  label_encoder () = default;
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~label_encoder () = default;
+
+  /**
+  * @brief Number of classes found by the last encoding.
+  *
+  * @return The number of classes.
+  */
+  int32_t size () const
+  {
+    return static_cast < int32_t >(this->positions.size());
+  }
+
+  /**
+  * @brief Position of an occurrence of each class (in sorted order).
+  *
+  * @details The positions are referred to the concatenation of the true and predicted
+  * labels, i.e a position p >= n_lbl is the label lbl_pred[p - n_lbl].
+  *
+  * @return Pointer to the array of positions.
+  */
+  const int64_t * index () const
+  {
+    return this->positions.data();
+  }
+
+  /**
+  * @brief Encode two arrays of numerical labels.
+  *
+  * @tparam T label type (integral or floating point)
+  * @param lbl_true array of true labels
+  * @param lbl_pred array of predicted labels
+  * @param n_lbl size of label arrays
+  * @param code_true output array of true class indexes
+  * @param code_pred output array of predicted class indexes
+  *
+  * @return The number of classes.
+  */
+  template < typename T >
+  int32_t encode (const T * lbl_true, const T * lbl_pred, const int32_t & n_lbl, int32_t * code_true, int32_t * code_pred)
+  {
+    return this->encode_keys < T >([&] (const int64_t & i) { return lbl_true[i]; },
+                                   [&] (const int64_t & i) { return lbl_pred[i]; },
+                                   n_lbl, code_true, code_pred);
+  }
+
+  /**
+  * @brief Encode two arrays of fixed-width strings.
+  *
+  * @tparam Char character type (uint8_t for bytes, uint32_t for UCS4)
+  * @param lbl_true characters of the true labels (n_lbl * width_true)
+  * @param width_true number of characters of each true label
+  * @param lbl_pred characters of the predicted labels (n_lbl * width_pred)
+  * @param width_pred number of characters of each predicted label
+  * @param n_lbl size of label arrays
+  * @param code_true output array of true class indexes
+  * @param code_pred output array of predicted class indexes
+  *
+  * @return The number of classes.
+  */
+  template < typename Char >
+  int32_t encode_fixed (const Char * lbl_true, const int32_t & width_true, const Char * lbl_pred, const int32_t & width_pred, const int32_t & n_lbl, int32_t * code_true, int32_t * code_pred)
+  {
+    auto strip = [] (const Char * data, const int32_t & width)
+    {
+      int64_t size = width;
+      while ( size > 0 && data[size - 1] == Char(0) )
+        -- size;
+      return string_label < Char > {data, size};
+    };
+
+    return this->encode_keys < string_label < Char > >([&] (const int64_t & i) { return strip(lbl_true + i * width_true, width_true); },
+                                                       [&] (const int64_t & i) { return strip(lbl_pred + i * width_pred, width_pred); },
+                                                       n_lbl, code_true, code_pred);
+  }
+
+  /**
+  * @brief Encode two arrays of variable-length strings (e.g. UTF-8 encoded objects).
+  *
+  * @param lbl_true pointers to the characters of the true labels
+  * @param size_true number of characters of each true label
+  * @param lbl_pred pointers to the characters of the predicted labels
+  * @param size_pred number of characters of each predicted label
+  * @param n_lbl size of label arrays
+  * @param code_true output array of true class indexes
+  * @param code_pred output array of predicted class indexes
+  *
+  * @return The number of classes.
+  */
+  int32_t encode_strings (const uint8_t * const * lbl_true, const int64_t * size_true, const uint8_t * const * lbl_pred, const int64_t * size_pred, const int32_t & n_lbl, int32_t * code_true, int32_t * code_pred)
+  {
+    return this->encode_keys < string_label < uint8_t > >([&] (const int64_t & i) { return string_label < uint8_t > {lbl_true[i], size_true[i]}; },
+                                                          [&] (const int64_t & i) { return string_label < uint8_t > {lbl_pred[i], size_pred[i]}; },
+                                                          n_lbl, code_true, code_pred);
+  }
+
+private:
+
+  /**
+  * @brief Encode two arrays of labels given by their accessors.
+  *
+  * @tparam T label type
+  * @tparam True accessor type of the true labels, with signature T (int64_t)
+  * @tparam Pred accessor type of the predicted labels, with signature T (int64_t)
+  * @param get_true accessor of the true labels
+  * @param get_pred accessor of the predicted labels
+  * @param n_lbl size of label arrays
+  * @param code_true output array of true class indexes
+  * @param code_pred output array of predicted class indexes
+  *
+  * @return The number of classes.
+  */
+  template < typename T, typename True, typename Pred >
+  int32_t encode_keys (True && get_true, Pred && get_pred, const int32_t & n_lbl, int32_t * code_true, int32_t * code_pred)
+  {
+    constexpr int64_t label_grain = 1 << 15; // min number of labels for each chunk
+
+    const int32_t nchunks = num_chunks(n_lbl, label_grain);
+
+    // first pass: private tables and local indexes of each chunk
+
+    std :: vector < label_table < T > > tables (nchunks);
+
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      label_table < T > & table = tables[c];
+
+      const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+      for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+      {
+        code_true[i] = table.insert(get_true(i), i);
+        code_pred[i] = table.insert(get_pred(i), n_lbl + i);
+      }
+    });
+
+    // merge of the private tables (only the distinct labels)
+
+    label_table < T > classes;
+    std :: vector < std :: vector < int32_t > > remap (nchunks);
+
+    for (int32_t c = 0; c < nchunks; ++c)
+    {
+      remap[c].resize(tables[c].size());
+
+      for (int32_t k = 0; k < tables[c].size(); ++k)
+        remap[c][k] = classes.insert(tables[c].keys[k], tables[c].index[k]);
+    }
+
+    // sort of the distinct labels
+
+    const int32_t Nclass = classes.size();
+
+    std :: vector < int32_t > order (Nclass);
+    std :: iota(order.begin(), order.end(), 0);
+    std :: sort(order.begin(), order.end(), [&] (const int32_t & a, const int32_t & b)
+    {
+      return label_less(classes.keys[a], classes.keys[b]);
+    });
+
+    std :: vector < int32_t > rank (Nclass);
+    this->positions.resize(Nclass);
+
+    for (int32_t k = 0; k < Nclass; ++k)
+    {
+      rank[order[k]] = k;
+      this->positions[k] = classes.index[order[k]];
+    }
+
+    for (auto & local : remap)
+      for (auto & idx : local)
+        idx = rank[idx];
+
+    // second pass: local indexes to class indexes
+
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      const int32_t * local = remap[c].data();
+
+      const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+      for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+      {
+        code_true[i] = local[code_true[i]];
+        code_pred[i] = local[code_pred[i]];
+      }
+    });
+
+    return Nclass;
+  }
+
+};
+
+#endif // __label_encoder_h__
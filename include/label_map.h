@@ -0,0 +1,203 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __label_map_h__
+#define __label_map_h__
+
+#include <vector>     // std :: vector
+#include <algorithm>  // std :: minmax_element
+#include <cstdint>    // int32_t
+
+/**
+* @class label_map
+* @brief Lookup table which maps each label to its index in the array of classes.
+*
+* @details The table is built once from the output of get_classes and then each
+* query costs O(1), independently by the number of classes.
+* If the labels cover a compact range of values the table is a dense array
+* indexed by (label - min_label), otherwise the labels are stored into a flat
+* open-addressing hash table (linear probing with power-of-two capacity).
+*
+*/
+class label_map
+{
+
+  static constexpr int64_t dense_factor = 4;     ///< max ratio between label range and number of classes for dense layout
+  static constexpr int64_t dense_extra  = 1024;  ///< label range always stored as dense table
+
+  std :: vector < int32_t > table; ///< dense lookup table or hash values
+  std :: vector < int32_t > keys;  ///< hash keys (empty for dense layout)
+
+  int32_t min_lbl; ///< minimum label value
+  int32_t shift;   ///< hash shift (32 - log2(capacity))
+  int32_t mask;    ///< hash mask (capacity - 1)
+
+public:
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  label_map () : min_lbl (0), shift (0), mask (0)
+  {
+  }
+
+  /**
+  * @brief Construct the lookup table from the array of classes.
+  *
+  * @param classes array of classes
+  * @param Nclass size of classes array (aka number of classes)
+  *
+  */
+  label_map (const float * classes, const int32_t & Nclass) : label_map ()
+  {
+    this->build(classes, Nclass);
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~label_map () = default;
+
+  /**
+  * @brief (Re-)Build the lookup table from the array of classes.
+  *
+  * @details The memory buffers are reused if their capacity is enough to
+  * store the new table.
+  *
+  * @param classes array of classes
+  * @param Nclass size of classes array (aka number of classes)
+  *
+  */
+  void build (const float * classes, const int32_t & Nclass)
+  {
+    this->keys.clear();
+
+    if ( Nclass <= 0 )
+    {
+      this->table.clear();
+      return;
+    }
+
+    const auto range = std :: minmax_element(classes, classes + Nclass);
+
+    this->min_lbl = static_cast < int32_t >(*range.first);
+    const int64_t width = static_cast < int64_t >(*range.second) - this->min_lbl + 1;
+
+    if ( width <= dense_factor * Nclass + dense_extra )
+    {
+      this->table.assign(width, -1);
+
+      for (int32_t i = 0; i < Nclass; ++i)
+        this->table[static_cast < int32_t >(classes[i]) - this->min_lbl] = i;
+
+      return;
+    }
+
+    // capacity as the first power of two greater than 2 * Nclass
+    int32_t nbits = 1;
+    while ( (int64_t(1) << nbits) < 2 * static_cast < int64_t >(Nclass) )
+      ++ nbits;
+
+    const int32_t capacity = 1 << nbits;
+
+    this->shift = 32 - nbits;
+    this->mask  = capacity - 1;
+
+    this->table.assign(capacity, -1);
+    this->keys.assign(capacity, 0);
+
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      const int32_t lbl = static_cast < int32_t >(classes[i]);
+      int32_t pos = this->hash(lbl);
+
+      while ( this->table[pos] != -1 && this->keys[pos] != lbl )
+        pos = (pos + 1) & this->mask;
+
+      this->keys[pos]  = lbl;
+      this->table[pos] = i;
+    }
+  }
+
+  /**
+  * @brief Check if the table uses the dense layout.
+  *
+  * @return True if the lookup is a direct array access
+  */
+  bool dense () const
+  {
+    return this->keys.empty();
+  }
+
+  /**
+  * @brief Get the index of the given label.
+  *
+  * @param label label value
+  *
+  * @return The index of the label in the array of classes or -1 if it is not found.
+  */
+  int32_t operator[] (const int32_t & label) const
+  {
+    if ( this->dense() )
+    {
+      const int64_t pos = static_cast < int64_t >(label) - this->min_lbl;
+      return ( pos >= 0 && pos < static_cast < int64_t >(this->table.size()) ) ? this->table[pos] : -1;
+    }
+
+    int32_t pos = this->hash(label);
+
+    while ( this->table[pos] != -1 )
+    {
+      if ( this->keys[pos] == label )
+        return this->table[pos];
+
+      pos = (pos + 1) & this->mask;
+    }
+
+    return -1;
+  }
+
+private:
+
+  /**
+  * @brief Fibonacci hashing of the label.
+  *
+  * @param label label value
+  *
+  * @return The starting position of the label into the hash table.
+  */
+  int32_t hash (const int32_t & label) const
+  {
+    return static_cast < int32_t >( (static_cast < uint32_t >(label) * 2654435769u) >> this->shift );
+  }
+
+};
+
+#endif // __label_map_h__
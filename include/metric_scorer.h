@@ -0,0 +1,1282 @@
+/* This file was automatically generated */
+/* Any change will be lost in the next build */
+
+#ifndef __metric_scorer_h__
+#define __metric_scorer_h__
+
+#include <vector>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <iostream>
+#include <cassert>
+#include <numeric>
+#include <algorithm>
+#include <common_stats.h>
+#include <class_stats.h>
+#include <overall_stats.h>
+
+
+/**
+* @brief Identifiers of the statistics which can be selected by metric_scorer
+* and compile-time tables of their dependencies.
+*
+*/
+namespace metrics
+{
+	/**
+	* @brief Index of each statistic (in topological order of the dependencies).
+	*
+	*/
+	enum id : int32_t
+	{
+		classes,
+		confusion_matrix,
+		marginals,
+		TP,
+		FN,
+		FP,
+		TN,
+		POP,
+		P,
+		N,
+		TOP,
+		TON,
+		TPR,
+		TNR,
+		PPV,
+		NPV,
+		FNR,
+		FPR,
+		FDR,
+		FOR,
+		ACC,
+		F1_SCORE,
+		F05_SCORE,
+		F2_SCORE,
+		MCC,
+		BM,
+		MK,
+		ICSI,
+		PLR,
+		NLR,
+		DOR,
+		PRE,
+		G,
+		RACC,
+		ERR_ACC,
+		RACCU,
+		jaccard_index,
+		IS,
+		CEN,
+		MCEN,
+		AUC,
+		dIND,
+		sIND,
+		DP,
+		Y,
+		PLRI,
+		NLRI,
+		DPI,
+		AUCI,
+		GI,
+		LS,
+		AM,
+		OP,
+		IBA,
+		GM,
+		Q,
+		AGM,
+		MCCI,
+		AGF,
+		OC,
+		OOC,
+		AUPR,
+		BCD,
+		overall_accuracy,
+		overall_random_accuracy_unbiased,
+		overall_random_accuracy,
+		overall_kappa,
+		PC_PI,
+		PC_AC1,
+		PC_S,
+		PI,
+		AC1,
+		S,
+		kappa_SE,
+		kappa_unbiased,
+		kappa_no_prevalence,
+		kappa_CI_up,
+		kappa_CI_down,
+		overall_accuracy_se,
+		overall_accuracy_ci_up,
+		overall_accuracy_ci_down,
+		chi_square,
+		phi_square,
+		cramer_V,
+		response_entropy,
+		reference_entropy,
+		cross_entropy,
+		join_entropy,
+		conditional_entropy,
+		mutual_information,
+		kl_divergence,
+		lambda_B,
+		lambda_A,
+		DF,
+		overall_jaccard_index,
+		hamming_loss,
+		zero_one_loss,
+		NIR,
+		p_value,
+		overall_CEN,
+		overall_MCEN,
+		overall_MCC,
+		RR,
+		CBA,
+		AUNU,
+		AUNP,
+		RCI,
+		CSI,
+		overall_pearson_C,
+		TPR_PPV_F1_micro,
+		MCC_analysis,
+		kappa_analysis_cicchetti,
+		kappa_analysis_koch,
+		kappa_analysis_fleiss,
+		kappa_analysis_altman,
+		V_analysis,
+		TPR_macro,
+		PPV_macro,
+		ACC_macro,
+		F1_macro,
+		n_stats
+	};
+
+	/// @cond DEF
+	// dependencies of the k-th statistic are deps[offset[k] : offset[k + 1]]
+	constexpr int32_t offset[n_stats + 1] = { 0, 0, 1, 2, 3, 4, 5, 6, 10, 12, 14, 16, 18, 20, 22, 24, 26, 27, 28, 29, 30, 34, 37, 40, 43, 47, 49, 51, 53, 55, 57, 59, 61, 63, 66, 67, 70, 73, 77, 79, 81, 83, 85, 86, 88, 89, 90, 91, 92, 93, 94, 96, 98, 101, 103, 105, 109, 114, 115, 119, 122, 125, 127, 130, 132, 133, 134, 136, 139, 142, 143, 145, 147, 149, 152, 154, 155, 157, 159, 161, 163, 165, 169, 171, 172, 174, 176, 179, 181, 184, 186, 189, 192, 195, 196, 197, 199, 201, 203, 206, 209, 213, 216, 217, 220, 221, 224, 226, 227, 229, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241 };
+
+	constexpr int32_t deps[] = {
+		classes, // confusion_matrix
+		confusion_matrix, // marginals
+		marginals, // TP
+		marginals, // FN
+		marginals, // FP
+		marginals, // TN
+		TP, TN, FP, FN, // POP
+		TP, FN, // P
+		TN, FP, // N
+		TP, FP, // TOP
+		TN, FN, // TON
+		TP, FN, // TPR
+		TN, FP, // TNR
+		TP, FP, // PPV
+		TN, FN, // NPV
+		TPR, // FNR
+		TNR, // FPR
+		PPV, // FDR
+		NPV, // FOR
+		TP, FP, FN, TN, // ACC
+		TP, FP, FN, // F1_SCORE
+		TP, FP, FN, // F05_SCORE
+		TP, FP, FN, // F2_SCORE
+		TP, TN, FP, FN, // MCC
+		TPR, TNR, // BM
+		PPV, NPV, // MK
+		PPV, TPR, // ICSI
+		TPR, FPR, // PLR
+		FNR, TNR, // NLR
+		PLR, NLR, // DOR
+		P, POP, // PRE
+		PPV, TPR, // G
+		TOP, P, POP, // RACC
+		ACC, // ERR_ACC
+		TOP, P, POP, // RACCU
+		TP, TOP, P, // jaccard_index
+		TP, FP, FN, POP, // IS
+		confusion_matrix, marginals, // CEN
+		confusion_matrix, marginals, // MCEN
+		TNR, TPR, // AUC
+		TNR, TPR, // dIND
+		dIND, // sIND
+		TPR, TNR, // DP
+		BM, // Y
+		PLR, // PLRI
+		NLR, // NLRI
+		DP, // DPI
+		AUC, // AUCI
+		AUC, // GI
+		PPV, PRE, // LS
+		TOP, P, // AM
+		ACC, TPR, TNR, // OP
+		TPR, TNR, // IBA
+		TNR, TPR, // GM
+		TP, TN, FP, FN, // Q
+		TPR, TNR, GM, N, POP, // AGM
+		MCC, // MCCI
+		TP, FP, FN, TN, // AGF
+		TP, TOP, P, // OC
+		TP, TOP, P, // OOC
+		PPV, TPR, // AUPR
+		TOP, P, AM, // BCD
+		TP, POP, // overall_accuracy
+		RACCU, // overall_random_accuracy_unbiased
+		RACC, // overall_random_accuracy
+		overall_random_accuracy, overall_accuracy, // overall_kappa
+		P, TOP, POP, // PC_PI
+		P, TOP, POP, // PC_AC1
+		classes, // PC_S
+		PC_PI, overall_accuracy, // PI
+		PC_AC1, overall_accuracy, // AC1
+		PC_S, overall_accuracy, // S
+		overall_accuracy, overall_random_accuracy, POP, // kappa_SE
+		overall_random_accuracy_unbiased, overall_accuracy, // kappa_unbiased
+		overall_accuracy, // kappa_no_prevalence
+		overall_kappa, kappa_SE, // kappa_CI_up
+		overall_kappa, kappa_SE, // kappa_CI_down
+		overall_accuracy, POP, // overall_accuracy_se
+		overall_accuracy, overall_accuracy_se, // overall_accuracy_ci_up
+		overall_accuracy, overall_accuracy_se, // overall_accuracy_ci_down
+		confusion_matrix, TOP, P, POP, // chi_square
+		chi_square, POP, // phi_square
+		phi_square, // cramer_V
+		TOP, POP, // response_entropy
+		P, POP, // reference_entropy
+		TOP, P, POP, // cross_entropy
+		confusion_matrix, POP, // join_entropy
+		confusion_matrix, P, POP, // conditional_entropy
+		response_entropy, conditional_entropy, // mutual_information
+		P, TOP, POP, // kl_divergence
+		confusion_matrix, TOP, POP, // lambda_B
+		confusion_matrix, P, POP, // lambda_A
+		classes, // DF
+		jaccard_index, // overall_jaccard_index
+		TP, POP, // hamming_loss
+		TP, POP, // zero_one_loss
+		P, POP, // NIR
+		TP, POP, NIR, // p_value
+		TOP, P, CEN, // overall_CEN
+		TP, TOP, P, MCEN, // overall_MCEN
+		confusion_matrix, TOP, P, // overall_MCC
+		TOP, // RR
+		confusion_matrix, TOP, P, // CBA
+		AUC, // AUNU
+		P, POP, AUC, // AUNP
+		mutual_information, reference_entropy, // RCI
+		ICSI, // CSI
+		chi_square, POP, // overall_pearson_C
+		TP, FN, // TPR_PPV_F1_micro
+		overall_MCC, // MCC_analysis
+		overall_kappa, // kappa_analysis_cicchetti
+		overall_kappa, // kappa_analysis_koch
+		overall_kappa, // kappa_analysis_fleiss
+		overall_kappa, // kappa_analysis_altman
+		cramer_V, // V_analysis
+		TPR, // TPR_macro
+		PPV, // PPV_macro
+		ACC, // ACC_macro
+		F1_SCORE, // F1_macro
+	};
+
+	// storage of each statistic: 0 = count_t column, 1 = real_t column, 2 = real_t value, 3 = classes
+	constexpr int32_t kind[n_stats] = { 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 };
+	/// @endcond
+
+	/**
+	* @brief Compile-time layout of a set of statistics.
+	*
+	*/
+	struct selection
+	{
+		bool required[n_stats]; ///< true if the statistic is selected or it is a dependency of a selected one
+		int32_t slot[n_stats]; ///< position of the statistic in the storage of its kind
+		int32_t size[3]; ///< number of required statistics of each kind
+	};
+
+	/**
+	* @brief Close a set of statistics over their dependencies.
+	*
+	* @tparam Ms selected statistics
+	*
+	* @return The layout of the required statistics.
+	*/
+	template < int32_t ... Ms >
+	constexpr selection closure ()
+	{
+		selection layout = {};
+		const int32_t selected[] = { Ms ... };
+
+		for (const auto & k : selected)
+			layout.required[k] = true;
+
+		// the dependencies of a statistic always precede it
+		for (int32_t k = n_stats - 1; k >= 0; --k)
+			if ( layout.required[k] )
+				for (int32_t d = offset[k]; d < offset[k + 1]; ++d)
+					layout.required[deps[d]] = true;
+
+		for (int32_t k = 0; k < n_stats; ++k)
+			if ( layout.required[k] && kind[k] < 3 )
+				layout.slot[k] = layout.size[kind[k]]++;
+
+		return layout;
+	}
+
+	/**
+	* @brief Number of elements of the column of a statistic.
+	*
+	* @param stat index of the statistic
+	* @param Nclass number of classes
+	*
+	*/
+	inline int64_t column_size (const int32_t & stat, const int32_t & Nclass)
+	{
+		switch (stat)
+		{
+			case confusion_matrix: return static_cast < int64_t >(Nclass) * Nclass;
+			case marginals: return 3 * Nclass;
+			default: return Nclass;
+		}
+	}
+}
+
+/**
+* @class metric_scorer
+* @brief Scorer specialized at compile time on a set of statistics
+*
+* @details Only the selected statistics and their dependencies are stored and evaluated:
+* the layout of the storage is computed at compile time and the functors of the other
+* statistics are never instantiated. The statistics are evaluated serially in
+* topological order and the memory is reused by the following evaluations.
+*
+* @tparam Ms selected statistics (as metrics :: id)
+*
+*/
+template < int32_t ... Ms >
+class metric_scorer
+{
+	static_assert (sizeof ... (Ms) > 0, "At least one statistic must be selected");
+
+public:
+
+	static constexpr metrics :: selection layout = metrics :: closure < Ms ... >(); ///< compile-time layout of the statistics
+
+	std :: vector < float > classes; ///< array of classes
+
+	int32_t Nclass; ///< number of classes
+
+	column_arena arena; ///< contiguous memory of the columns of the required statistics
+
+	column_arena workspace; ///< scratch memory of the functors (e.g. the histograms of the confusion matrix)
+
+	label_map lut; ///< lookup table from labels to class indexes
+
+	bool fixed_classes; ///< true if the classes are given by set_classes (no class discovery)
+
+private:
+
+	/// @cond DEF
+	template < int32_t k >
+	struct metric {};
+	/// @endcond
+
+	std :: tuple < std :: array < count_t *, layout.size[0] >,
+	              std :: array < real_t *, layout.size[1] >,
+	              std :: array < real_t, layout.size[2] > > storage; ///< columns and values of the required statistics
+
+public:
+
+	/**
+	* @brief Default constructor.
+	*
+	*/
+	metric_scorer () : Nclass (0), fixed_classes (false)
+	{
+	}
+
+	/**
+	* @brief Column (pointer) or value of a required statistic.
+	*
+	* @tparam k index of the statistic (as metrics :: id)
+	*
+	*/
+	template < int32_t k >
+	auto & at ()
+	{
+		static_assert (layout.required[k] && metrics :: kind[k] < 3, "The statistic is not evaluated by this scorer");
+		return std :: get < layout.slot[k] >(std :: get < metrics :: kind[k] >(this->storage));
+	}
+
+	/**
+	* @brief Column (pointer) or value of a required statistic.
+	*
+	* @tparam k index of the statistic (as metrics :: id)
+	*
+	*/
+	template < int32_t k >
+	const auto & at () const
+	{
+		static_assert (layout.required[k] && metrics :: kind[k] < 3, "The statistic is not evaluated by this scorer");
+		return std :: get < layout.slot[k] >(std :: get < metrics :: kind[k] >(this->storage));
+	}
+
+	/**
+	* @brief Set the classes of the labels.
+	*
+	* @details The classes are not computed by the following calls to
+	* compute_score and the memory is reserved once.
+	*
+	* @param classes array of class labels
+	* @param Nclass number of classes
+	*
+	*/
+	void set_classes (const int32_t * classes, const int32_t & Nclass)
+	{
+		this->classes.assign(classes, classes + Nclass);
+
+		std :: sort(this->classes.begin(), this->classes.end());
+		this->classes.erase(std :: unique(this->classes.begin(), this->classes.end()), this->classes.end());
+
+		this->Nclass = static_cast < int32_t >(this->classes.size());
+		this->fixed_classes = this->Nclass > 0;
+
+		this->reserve(this->Nclass);
+		this->lut.build(this->classes.data(), this->Nclass);
+	}
+
+	/**
+	* @brief Compute the selected statistics.
+	*
+	* @param lbl_true array of true labels
+	* @param lbl_pred array of predicted labels
+	* @param n_true number of true labels
+	* @param n_pred number of predicted labels
+	*
+	*/
+	void compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)
+	{
+		assert (n_true == n_pred);
+
+		if ( !this->fixed_classes )
+			this->classes = get_classes ( lbl_true, lbl_pred, n_true, n_pred );
+
+		this->Nclass = static_cast < int32_t >(this->classes.size());
+
+		if ( this->Nclass <= 1 )
+		{
+			std :: cerr << "Nclass must be greater than 1" << std :: endl;
+			std :: exit(1);
+		}
+
+		this->reserve(this->Nclass);
+
+		get_confusion_matrix ( lbl_true, lbl_pred, n_true, this->classes.data(), this->Nclass, this->lut, this->workspace, this->template at < metrics :: confusion_matrix >() );
+
+		this->compute_stats();
+	}
+
+	/**
+	* @brief Compute the selected statistics from an existing confusion matrix.
+	*
+	* @tparam T integer data type of the confusion matrix (the counts are stored as count_t)
+	* @param confusion_matrix ravel array of the confusion matrix (Nclass x Nclass, rows are true labels)
+	* @param Nclass number of classes
+	* @param classes array of class labels (if nullptr the classes are 0, ..., Nclass - 1)
+	*
+	*/
+	template < typename T >
+	void compute_from_confusion_matrix (const T * confusion_matrix, const int32_t & Nclass, const float * classes = nullptr)
+	{
+		static_assert (std :: is_integral < T > :: value, "The counts of the confusion matrix must be integers");
+
+		if ( classes != nullptr )
+			this->classes.assign(classes, classes + Nclass);
+		else
+		{
+			this->classes.resize(Nclass);
+			std :: iota(this->classes.begin(), this->classes.end(), 0.f);
+		}
+
+		this->Nclass = Nclass;
+
+		if ( this->Nclass <= 1 )
+		{
+			std :: cerr << "Nclass must be greater than 1" << std :: endl;
+			std :: exit(1);
+		}
+
+		this->reserve(this->Nclass);
+
+		std :: transform(confusion_matrix, confusion_matrix + static_cast < int64_t >(Nclass) * Nclass,
+		                this->template at < metrics :: confusion_matrix >(),
+		                [] (const T & x) { return static_cast < count_t >(x); });
+
+		this->compute_stats();
+	}
+
+private:
+
+	/**
+	* @brief Carve the columns of the required statistics.
+	*
+	* @param Nclass number of classes
+	*
+	*/
+	void reserve (const int32_t & Nclass)
+	{
+		std :: size_t size = 0;
+
+		for (int32_t k = 0; k < metrics :: n_stats; ++k)
+		{
+			if ( layout.required[k] && metrics :: kind[k] == 0 )
+				size += column_arena :: bytes < count_t >(metrics :: column_size(k, Nclass));
+			else if ( layout.required[k] && metrics :: kind[k] == 1 )
+				size += column_arena :: bytes < real_t >(metrics :: column_size(k, Nclass));
+		}
+
+		this->arena.reserve(size);
+
+		for (int32_t k = 0; k < metrics :: n_stats; ++k)
+		{
+			if ( layout.required[k] && metrics :: kind[k] == 0 )
+				std :: get < 0 >(this->storage)[layout.slot[k]] = this->arena.template column < count_t >(metrics :: column_size(k, Nclass));
+			else if ( layout.required[k] && metrics :: kind[k] == 1 )
+				std :: get < 1 >(this->storage)[layout.slot[k]] = this->arena.template column < real_t >(metrics :: column_size(k, Nclass));
+		}
+
+		// histograms of the confusion matrix for any number of chunks
+		this->workspace.reserve(column_arena :: bytes < uint32_t >(confusion_matrix_cells(Nclass, num_workers())));
+	}
+
+	/**
+	* @brief Evaluate the required statistics (in topological order).
+	*
+	*/
+	void compute_stats ()
+	{
+		this->evaluate(metric < metrics :: marginals >(), std :: integral_constant < bool, layout.required[metrics :: marginals] >());
+		this->evaluate(metric < metrics :: TP >(), std :: integral_constant < bool, layout.required[metrics :: TP] >());
+		this->evaluate(metric < metrics :: FN >(), std :: integral_constant < bool, layout.required[metrics :: FN] >());
+		this->evaluate(metric < metrics :: FP >(), std :: integral_constant < bool, layout.required[metrics :: FP] >());
+		this->evaluate(metric < metrics :: TN >(), std :: integral_constant < bool, layout.required[metrics :: TN] >());
+		this->evaluate(metric < metrics :: POP >(), std :: integral_constant < bool, layout.required[metrics :: POP] >());
+		this->evaluate(metric < metrics :: P >(), std :: integral_constant < bool, layout.required[metrics :: P] >());
+		this->evaluate(metric < metrics :: N >(), std :: integral_constant < bool, layout.required[metrics :: N] >());
+		this->evaluate(metric < metrics :: TOP >(), std :: integral_constant < bool, layout.required[metrics :: TOP] >());
+		this->evaluate(metric < metrics :: TON >(), std :: integral_constant < bool, layout.required[metrics :: TON] >());
+		this->evaluate(metric < metrics :: TPR >(), std :: integral_constant < bool, layout.required[metrics :: TPR] >());
+		this->evaluate(metric < metrics :: TNR >(), std :: integral_constant < bool, layout.required[metrics :: TNR] >());
+		this->evaluate(metric < metrics :: PPV >(), std :: integral_constant < bool, layout.required[metrics :: PPV] >());
+		this->evaluate(metric < metrics :: NPV >(), std :: integral_constant < bool, layout.required[metrics :: NPV] >());
+		this->evaluate(metric < metrics :: FNR >(), std :: integral_constant < bool, layout.required[metrics :: FNR] >());
+		this->evaluate(metric < metrics :: FPR >(), std :: integral_constant < bool, layout.required[metrics :: FPR] >());
+		this->evaluate(metric < metrics :: FDR >(), std :: integral_constant < bool, layout.required[metrics :: FDR] >());
+		this->evaluate(metric < metrics :: FOR >(), std :: integral_constant < bool, layout.required[metrics :: FOR] >());
+		this->evaluate(metric < metrics :: ACC >(), std :: integral_constant < bool, layout.required[metrics :: ACC] >());
+		this->evaluate(metric < metrics :: F1_SCORE >(), std :: integral_constant < bool, layout.required[metrics :: F1_SCORE] >());
+		this->evaluate(metric < metrics :: F05_SCORE >(), std :: integral_constant < bool, layout.required[metrics :: F05_SCORE] >());
+		this->evaluate(metric < metrics :: F2_SCORE >(), std :: integral_constant < bool, layout.required[metrics :: F2_SCORE] >());
+		this->evaluate(metric < metrics :: MCC >(), std :: integral_constant < bool, layout.required[metrics :: MCC] >());
+		this->evaluate(metric < metrics :: BM >(), std :: integral_constant < bool, layout.required[metrics :: BM] >());
+		this->evaluate(metric < metrics :: MK >(), std :: integral_constant < bool, layout.required[metrics :: MK] >());
+		this->evaluate(metric < metrics :: ICSI >(), std :: integral_constant < bool, layout.required[metrics :: ICSI] >());
+		this->evaluate(metric < metrics :: PLR >(), std :: integral_constant < bool, layout.required[metrics :: PLR] >());
+		this->evaluate(metric < metrics :: NLR >(), std :: integral_constant < bool, layout.required[metrics :: NLR] >());
+		this->evaluate(metric < metrics :: DOR >(), std :: integral_constant < bool, layout.required[metrics :: DOR] >());
+		this->evaluate(metric < metrics :: PRE >(), std :: integral_constant < bool, layout.required[metrics :: PRE] >());
+		this->evaluate(metric < metrics :: G >(), std :: integral_constant < bool, layout.required[metrics :: G] >());
+		this->evaluate(metric < metrics :: RACC >(), std :: integral_constant < bool, layout.required[metrics :: RACC] >());
+		this->evaluate(metric < metrics :: ERR_ACC >(), std :: integral_constant < bool, layout.required[metrics :: ERR_ACC] >());
+		this->evaluate(metric < metrics :: RACCU >(), std :: integral_constant < bool, layout.required[metrics :: RACCU] >());
+		this->evaluate(metric < metrics :: jaccard_index >(), std :: integral_constant < bool, layout.required[metrics :: jaccard_index] >());
+		this->evaluate(metric < metrics :: IS >(), std :: integral_constant < bool, layout.required[metrics :: IS] >());
+		this->evaluate(metric < metrics :: CEN >(), std :: integral_constant < bool, layout.required[metrics :: CEN] >());
+		this->evaluate(metric < metrics :: MCEN >(), std :: integral_constant < bool, layout.required[metrics :: MCEN] >());
+		this->evaluate(metric < metrics :: AUC >(), std :: integral_constant < bool, layout.required[metrics :: AUC] >());
+		this->evaluate(metric < metrics :: dIND >(), std :: integral_constant < bool, layout.required[metrics :: dIND] >());
+		this->evaluate(metric < metrics :: sIND >(), std :: integral_constant < bool, layout.required[metrics :: sIND] >());
+		this->evaluate(metric < metrics :: DP >(), std :: integral_constant < bool, layout.required[metrics :: DP] >());
+		this->evaluate(metric < metrics :: Y >(), std :: integral_constant < bool, layout.required[metrics :: Y] >());
+		this->evaluate(metric < metrics :: PLRI >(), std :: integral_constant < bool, layout.required[metrics :: PLRI] >());
+		this->evaluate(metric < metrics :: NLRI >(), std :: integral_constant < bool, layout.required[metrics :: NLRI] >());
+		this->evaluate(metric < metrics :: DPI >(), std :: integral_constant < bool, layout.required[metrics :: DPI] >());
+		this->evaluate(metric < metrics :: AUCI >(), std :: integral_constant < bool, layout.required[metrics :: AUCI] >());
+		this->evaluate(metric < metrics :: GI >(), std :: integral_constant < bool, layout.required[metrics :: GI] >());
+		this->evaluate(metric < metrics :: LS >(), std :: integral_constant < bool, layout.required[metrics :: LS] >());
+		this->evaluate(metric < metrics :: AM >(), std :: integral_constant < bool, layout.required[metrics :: AM] >());
+		this->evaluate(metric < metrics :: OP >(), std :: integral_constant < bool, layout.required[metrics :: OP] >());
+		this->evaluate(metric < metrics :: IBA >(), std :: integral_constant < bool, layout.required[metrics :: IBA] >());
+		this->evaluate(metric < metrics :: GM >(), std :: integral_constant < bool, layout.required[metrics :: GM] >());
+		this->evaluate(metric < metrics :: Q >(), std :: integral_constant < bool, layout.required[metrics :: Q] >());
+		this->evaluate(metric < metrics :: AGM >(), std :: integral_constant < bool, layout.required[metrics :: AGM] >());
+		this->evaluate(metric < metrics :: MCCI >(), std :: integral_constant < bool, layout.required[metrics :: MCCI] >());
+		this->evaluate(metric < metrics :: AGF >(), std :: integral_constant < bool, layout.required[metrics :: AGF] >());
+		this->evaluate(metric < metrics :: OC >(), std :: integral_constant < bool, layout.required[metrics :: OC] >());
+		this->evaluate(metric < metrics :: OOC >(), std :: integral_constant < bool, layout.required[metrics :: OOC] >());
+		this->evaluate(metric < metrics :: AUPR >(), std :: integral_constant < bool, layout.required[metrics :: AUPR] >());
+		this->evaluate(metric < metrics :: BCD >(), std :: integral_constant < bool, layout.required[metrics :: BCD] >());
+		this->evaluate(metric < metrics :: overall_accuracy >(), std :: integral_constant < bool, layout.required[metrics :: overall_accuracy] >());
+		this->evaluate(metric < metrics :: overall_random_accuracy_unbiased >(), std :: integral_constant < bool, layout.required[metrics :: overall_random_accuracy_unbiased] >());
+		this->evaluate(metric < metrics :: overall_random_accuracy >(), std :: integral_constant < bool, layout.required[metrics :: overall_random_accuracy] >());
+		this->evaluate(metric < metrics :: overall_kappa >(), std :: integral_constant < bool, layout.required[metrics :: overall_kappa] >());
+		this->evaluate(metric < metrics :: PC_PI >(), std :: integral_constant < bool, layout.required[metrics :: PC_PI] >());
+		this->evaluate(metric < metrics :: PC_AC1 >(), std :: integral_constant < bool, layout.required[metrics :: PC_AC1] >());
+		this->evaluate(metric < metrics :: PC_S >(), std :: integral_constant < bool, layout.required[metrics :: PC_S] >());
+		this->evaluate(metric < metrics :: PI >(), std :: integral_constant < bool, layout.required[metrics :: PI] >());
+		this->evaluate(metric < metrics :: AC1 >(), std :: integral_constant < bool, layout.required[metrics :: AC1] >());
+		this->evaluate(metric < metrics :: S >(), std :: integral_constant < bool, layout.required[metrics :: S] >());
+		this->evaluate(metric < metrics :: kappa_SE >(), std :: integral_constant < bool, layout.required[metrics :: kappa_SE] >());
+		this->evaluate(metric < metrics :: kappa_unbiased >(), std :: integral_constant < bool, layout.required[metrics :: kappa_unbiased] >());
+		this->evaluate(metric < metrics :: kappa_no_prevalence >(), std :: integral_constant < bool, layout.required[metrics :: kappa_no_prevalence] >());
+		this->evaluate(metric < metrics :: kappa_CI_up >(), std :: integral_constant < bool, layout.required[metrics :: kappa_CI_up] >());
+		this->evaluate(metric < metrics :: kappa_CI_down >(), std :: integral_constant < bool, layout.required[metrics :: kappa_CI_down] >());
+		this->evaluate(metric < metrics :: overall_accuracy_se >(), std :: integral_constant < bool, layout.required[metrics :: overall_accuracy_se] >());
+		this->evaluate(metric < metrics :: overall_accuracy_ci_up >(), std :: integral_constant < bool, layout.required[metrics :: overall_accuracy_ci_up] >());
+		this->evaluate(metric < metrics :: overall_accuracy_ci_down >(), std :: integral_constant < bool, layout.required[metrics :: overall_accuracy_ci_down] >());
+		this->evaluate(metric < metrics :: chi_square >(), std :: integral_constant < bool, layout.required[metrics :: chi_square] >());
+		this->evaluate(metric < metrics :: phi_square >(), std :: integral_constant < bool, layout.required[metrics :: phi_square] >());
+		this->evaluate(metric < metrics :: cramer_V >(), std :: integral_constant < bool, layout.required[metrics :: cramer_V] >());
+		this->evaluate(metric < metrics :: response_entropy >(), std :: integral_constant < bool, layout.required[metrics :: response_entropy] >());
+		this->evaluate(metric < metrics :: reference_entropy >(), std :: integral_constant < bool, layout.required[metrics :: reference_entropy] >());
+		this->evaluate(metric < metrics :: cross_entropy >(), std :: integral_constant < bool, layout.required[metrics :: cross_entropy] >());
+		this->evaluate(metric < metrics :: join_entropy >(), std :: integral_constant < bool, layout.required[metrics :: join_entropy] >());
+		this->evaluate(metric < metrics :: conditional_entropy >(), std :: integral_constant < bool, layout.required[metrics :: conditional_entropy] >());
+		this->evaluate(metric < metrics :: mutual_information >(), std :: integral_constant < bool, layout.required[metrics :: mutual_information] >());
+		this->evaluate(metric < metrics :: kl_divergence >(), std :: integral_constant < bool, layout.required[metrics :: kl_divergence] >());
+		this->evaluate(metric < metrics :: lambda_B >(), std :: integral_constant < bool, layout.required[metrics :: lambda_B] >());
+		this->evaluate(metric < metrics :: lambda_A >(), std :: integral_constant < bool, layout.required[metrics :: lambda_A] >());
+		this->evaluate(metric < metrics :: DF >(), std :: integral_constant < bool, layout.required[metrics :: DF] >());
+		this->evaluate(metric < metrics :: overall_jaccard_index >(), std :: integral_constant < bool, layout.required[metrics :: overall_jaccard_index] >());
+		this->evaluate(metric < metrics :: hamming_loss >(), std :: integral_constant < bool, layout.required[metrics :: hamming_loss] >());
+		this->evaluate(metric < metrics :: zero_one_loss >(), std :: integral_constant < bool, layout.required[metrics :: zero_one_loss] >());
+		this->evaluate(metric < metrics :: NIR >(), std :: integral_constant < bool, layout.required[metrics :: NIR] >());
+		this->evaluate(metric < metrics :: p_value >(), std :: integral_constant < bool, layout.required[metrics :: p_value] >());
+		this->evaluate(metric < metrics :: overall_CEN >(), std :: integral_constant < bool, layout.required[metrics :: overall_CEN] >());
+		this->evaluate(metric < metrics :: overall_MCEN >(), std :: integral_constant < bool, layout.required[metrics :: overall_MCEN] >());
+		this->evaluate(metric < metrics :: overall_MCC >(), std :: integral_constant < bool, layout.required[metrics :: overall_MCC] >());
+		this->evaluate(metric < metrics :: RR >(), std :: integral_constant < bool, layout.required[metrics :: RR] >());
+		this->evaluate(metric < metrics :: CBA >(), std :: integral_constant < bool, layout.required[metrics :: CBA] >());
+		this->evaluate(metric < metrics :: AUNU >(), std :: integral_constant < bool, layout.required[metrics :: AUNU] >());
+		this->evaluate(metric < metrics :: AUNP >(), std :: integral_constant < bool, layout.required[metrics :: AUNP] >());
+		this->evaluate(metric < metrics :: RCI >(), std :: integral_constant < bool, layout.required[metrics :: RCI] >());
+		this->evaluate(metric < metrics :: CSI >(), std :: integral_constant < bool, layout.required[metrics :: CSI] >());
+		this->evaluate(metric < metrics :: overall_pearson_C >(), std :: integral_constant < bool, layout.required[metrics :: overall_pearson_C] >());
+		this->evaluate(metric < metrics :: TPR_PPV_F1_micro >(), std :: integral_constant < bool, layout.required[metrics :: TPR_PPV_F1_micro] >());
+		this->evaluate(metric < metrics :: MCC_analysis >(), std :: integral_constant < bool, layout.required[metrics :: MCC_analysis] >());
+		this->evaluate(metric < metrics :: kappa_analysis_cicchetti >(), std :: integral_constant < bool, layout.required[metrics :: kappa_analysis_cicchetti] >());
+		this->evaluate(metric < metrics :: kappa_analysis_koch >(), std :: integral_constant < bool, layout.required[metrics :: kappa_analysis_koch] >());
+		this->evaluate(metric < metrics :: kappa_analysis_fleiss >(), std :: integral_constant < bool, layout.required[metrics :: kappa_analysis_fleiss] >());
+		this->evaluate(metric < metrics :: kappa_analysis_altman >(), std :: integral_constant < bool, layout.required[metrics :: kappa_analysis_altman] >());
+		this->evaluate(metric < metrics :: V_analysis >(), std :: integral_constant < bool, layout.required[metrics :: V_analysis] >());
+		this->evaluate(metric < metrics :: TPR_macro >(), std :: integral_constant < bool, layout.required[metrics :: TPR_macro] >());
+		this->evaluate(metric < metrics :: PPV_macro >(), std :: integral_constant < bool, layout.required[metrics :: PPV_macro] >());
+		this->evaluate(metric < metrics :: ACC_macro >(), std :: integral_constant < bool, layout.required[metrics :: ACC_macro] >());
+		this->evaluate(metric < metrics :: F1_macro >(), std :: integral_constant < bool, layout.required[metrics :: F1_macro] >());
+	}
+
+	/// @cond DEF
+	// statistics out of the selection are not evaluated (and their functors are not instantiated)
+	template < int32_t k >
+	void evaluate (metric < k >, std :: false_type)
+	{
+	}
+
+	void evaluate (metric < metrics :: marginals >, std :: true_type)
+	{
+		get_marginals ( this->template at < metrics :: confusion_matrix >(), this->Nclass, this->template at < metrics :: marginals >() );
+	}
+
+	void evaluate (metric < metrics :: TP >, std :: true_type)
+	{
+		get_TP ( this->template at < metrics :: marginals >(), this->Nclass, this->template at < metrics :: TP >() );
+	}
+
+	void evaluate (metric < metrics :: FN >, std :: true_type)
+	{
+		get_FN ( this->template at < metrics :: marginals >(), this->Nclass, this->template at < metrics :: FN >() );
+	}
+
+	void evaluate (metric < metrics :: FP >, std :: true_type)
+	{
+		get_FP ( this->template at < metrics :: marginals >(), this->Nclass, this->template at < metrics :: FP >() );
+	}
+
+	void evaluate (metric < metrics :: TN >, std :: true_type)
+	{
+		get_TN ( this->template at < metrics :: marginals >(), this->Nclass, this->template at < metrics :: TN >() );
+	}
+
+	void evaluate (metric < metrics :: POP >, std :: true_type)
+	{
+		get_POP ( this->template at < metrics :: TP >(), this->template at < metrics :: TN >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: POP >() );
+	}
+
+	void evaluate (metric < metrics :: P >, std :: true_type)
+	{
+		get_P ( this->template at < metrics :: TP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: P >() );
+	}
+
+	void evaluate (metric < metrics :: N >, std :: true_type)
+	{
+		get_N ( this->template at < metrics :: TN >(), this->template at < metrics :: FP >(), this->Nclass, this->template at < metrics :: N >() );
+	}
+
+	void evaluate (metric < metrics :: TOP >, std :: true_type)
+	{
+		get_TOP ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->Nclass, this->template at < metrics :: TOP >() );
+	}
+
+	void evaluate (metric < metrics :: TON >, std :: true_type)
+	{
+		get_TON ( this->template at < metrics :: TN >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: TON >() );
+	}
+
+	void evaluate (metric < metrics :: TPR >, std :: true_type)
+	{
+		get_TPR ( this->template at < metrics :: TP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: TPR >() );
+	}
+
+	void evaluate (metric < metrics :: TNR >, std :: true_type)
+	{
+		get_TNR ( this->template at < metrics :: TN >(), this->template at < metrics :: FP >(), this->Nclass, this->template at < metrics :: TNR >() );
+	}
+
+	void evaluate (metric < metrics :: PPV >, std :: true_type)
+	{
+		get_PPV ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->Nclass, this->template at < metrics :: PPV >() );
+	}
+
+	void evaluate (metric < metrics :: NPV >, std :: true_type)
+	{
+		get_NPV ( this->template at < metrics :: TN >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: NPV >() );
+	}
+
+	void evaluate (metric < metrics :: FNR >, std :: true_type)
+	{
+		get_FNR ( this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: FNR >() );
+	}
+
+	void evaluate (metric < metrics :: FPR >, std :: true_type)
+	{
+		get_FPR ( this->template at < metrics :: TNR >(), this->Nclass, this->template at < metrics :: FPR >() );
+	}
+
+	void evaluate (metric < metrics :: FDR >, std :: true_type)
+	{
+		get_FDR ( this->template at < metrics :: PPV >(), this->Nclass, this->template at < metrics :: FDR >() );
+	}
+
+	void evaluate (metric < metrics :: FOR >, std :: true_type)
+	{
+		get_FOR ( this->template at < metrics :: NPV >(), this->Nclass, this->template at < metrics :: FOR >() );
+	}
+
+	void evaluate (metric < metrics :: ACC >, std :: true_type)
+	{
+		get_ACC ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->template at < metrics :: TN >(), this->Nclass, this->template at < metrics :: ACC >() );
+	}
+
+	void evaluate (metric < metrics :: F1_SCORE >, std :: true_type)
+	{
+		get_F1_SCORE ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: F1_SCORE >() );
+	}
+
+	void evaluate (metric < metrics :: F05_SCORE >, std :: true_type)
+	{
+		get_F05_SCORE ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: F05_SCORE >() );
+	}
+
+	void evaluate (metric < metrics :: F2_SCORE >, std :: true_type)
+	{
+		get_F2_SCORE ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: F2_SCORE >() );
+	}
+
+	void evaluate (metric < metrics :: MCC >, std :: true_type)
+	{
+		get_MCC ( this->template at < metrics :: TP >(), this->template at < metrics :: TN >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: MCC >() );
+	}
+
+	void evaluate (metric < metrics :: BM >, std :: true_type)
+	{
+		get_BM ( this->template at < metrics :: TPR >(), this->template at < metrics :: TNR >(), this->Nclass, this->template at < metrics :: BM >() );
+	}
+
+	void evaluate (metric < metrics :: MK >, std :: true_type)
+	{
+		get_MK ( this->template at < metrics :: PPV >(), this->template at < metrics :: NPV >(), this->Nclass, this->template at < metrics :: MK >() );
+	}
+
+	void evaluate (metric < metrics :: ICSI >, std :: true_type)
+	{
+		get_ICSI ( this->template at < metrics :: PPV >(), this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: ICSI >() );
+	}
+
+	void evaluate (metric < metrics :: PLR >, std :: true_type)
+	{
+		get_PLR ( this->template at < metrics :: TPR >(), this->template at < metrics :: FPR >(), this->Nclass, this->template at < metrics :: PLR >() );
+	}
+
+	void evaluate (metric < metrics :: NLR >, std :: true_type)
+	{
+		get_NLR ( this->template at < metrics :: FNR >(), this->template at < metrics :: TNR >(), this->Nclass, this->template at < metrics :: NLR >() );
+	}
+
+	void evaluate (metric < metrics :: DOR >, std :: true_type)
+	{
+		get_DOR ( this->template at < metrics :: PLR >(), this->template at < metrics :: NLR >(), this->Nclass, this->template at < metrics :: DOR >() );
+	}
+
+	void evaluate (metric < metrics :: PRE >, std :: true_type)
+	{
+		get_PRE ( this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass, this->template at < metrics :: PRE >() );
+	}
+
+	void evaluate (metric < metrics :: G >, std :: true_type)
+	{
+		get_G ( this->template at < metrics :: PPV >(), this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: G >() );
+	}
+
+	void evaluate (metric < metrics :: RACC >, std :: true_type)
+	{
+		get_RACC ( this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass, this->template at < metrics :: RACC >() );
+	}
+
+	void evaluate (metric < metrics :: ERR_ACC >, std :: true_type)
+	{
+		get_ERR_ACC ( this->template at < metrics :: ACC >(), this->Nclass, this->template at < metrics :: ERR_ACC >() );
+	}
+
+	void evaluate (metric < metrics :: RACCU >, std :: true_type)
+	{
+		get_RACCU ( this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass, this->template at < metrics :: RACCU >() );
+	}
+
+	void evaluate (metric < metrics :: jaccard_index >, std :: true_type)
+	{
+		get_jaccard_index ( this->template at < metrics :: TP >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->Nclass, this->template at < metrics :: jaccard_index >() );
+	}
+
+	void evaluate (metric < metrics :: IS >, std :: true_type)
+	{
+		get_IS ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->template at < metrics :: POP >(), this->Nclass, this->template at < metrics :: IS >() );
+	}
+
+	void evaluate (metric < metrics :: CEN >, std :: true_type)
+	{
+		get_CEN ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: marginals >(), this->Nclass, this->template at < metrics :: CEN >() );
+	}
+
+	void evaluate (metric < metrics :: MCEN >, std :: true_type)
+	{
+		get_MCEN ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: marginals >(), this->Nclass, this->template at < metrics :: MCEN >() );
+	}
+
+	void evaluate (metric < metrics :: AUC >, std :: true_type)
+	{
+		get_AUC ( this->template at < metrics :: TNR >(), this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: AUC >() );
+	}
+
+	void evaluate (metric < metrics :: dIND >, std :: true_type)
+	{
+		get_dIND ( this->template at < metrics :: TNR >(), this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: dIND >() );
+	}
+
+	void evaluate (metric < metrics :: sIND >, std :: true_type)
+	{
+		get_sIND ( this->template at < metrics :: dIND >(), this->Nclass, this->template at < metrics :: sIND >() );
+	}
+
+	void evaluate (metric < metrics :: DP >, std :: true_type)
+	{
+		get_DP ( this->template at < metrics :: TPR >(), this->template at < metrics :: TNR >(), this->Nclass, this->template at < metrics :: DP >() );
+	}
+
+	void evaluate (metric < metrics :: Y >, std :: true_type)
+	{
+		get_Y ( this->template at < metrics :: BM >(), this->Nclass, this->template at < metrics :: Y >() );
+	}
+
+	void evaluate (metric < metrics :: PLRI >, std :: true_type)
+	{
+		get_PLRI ( this->template at < metrics :: PLR >(), this->Nclass, this->template at < metrics :: PLRI >() );
+	}
+
+	void evaluate (metric < metrics :: NLRI >, std :: true_type)
+	{
+		get_NLRI ( this->template at < metrics :: NLR >(), this->Nclass, this->template at < metrics :: NLRI >() );
+	}
+
+	void evaluate (metric < metrics :: DPI >, std :: true_type)
+	{
+		get_DPI ( this->template at < metrics :: DP >(), this->Nclass, this->template at < metrics :: DPI >() );
+	}
+
+	void evaluate (metric < metrics :: AUCI >, std :: true_type)
+	{
+		get_AUCI ( this->template at < metrics :: AUC >(), this->Nclass, this->template at < metrics :: AUCI >() );
+	}
+
+	void evaluate (metric < metrics :: GI >, std :: true_type)
+	{
+		get_GI ( this->template at < metrics :: AUC >(), this->Nclass, this->template at < metrics :: GI >() );
+	}
+
+	void evaluate (metric < metrics :: LS >, std :: true_type)
+	{
+		get_LS ( this->template at < metrics :: PPV >(), this->template at < metrics :: PRE >(), this->Nclass, this->template at < metrics :: LS >() );
+	}
+
+	void evaluate (metric < metrics :: AM >, std :: true_type)
+	{
+		get_AM ( this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->Nclass, this->template at < metrics :: AM >() );
+	}
+
+	void evaluate (metric < metrics :: OP >, std :: true_type)
+	{
+		get_OP ( this->template at < metrics :: ACC >(), this->template at < metrics :: TPR >(), this->template at < metrics :: TNR >(), this->Nclass, this->template at < metrics :: OP >() );
+	}
+
+	void evaluate (metric < metrics :: IBA >, std :: true_type)
+	{
+		get_IBA ( this->template at < metrics :: TPR >(), this->template at < metrics :: TNR >(), this->Nclass, this->template at < metrics :: IBA >() );
+	}
+
+	void evaluate (metric < metrics :: GM >, std :: true_type)
+	{
+		get_GM ( this->template at < metrics :: TNR >(), this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: GM >() );
+	}
+
+	void evaluate (metric < metrics :: Q >, std :: true_type)
+	{
+		get_Q ( this->template at < metrics :: TP >(), this->template at < metrics :: TN >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->Nclass, this->template at < metrics :: Q >() );
+	}
+
+	void evaluate (metric < metrics :: AGM >, std :: true_type)
+	{
+		get_AGM ( this->template at < metrics :: TPR >(), this->template at < metrics :: TNR >(), this->template at < metrics :: GM >(), this->template at < metrics :: N >(), this->template at < metrics :: POP >(), this->Nclass, this->template at < metrics :: AGM >() );
+	}
+
+	void evaluate (metric < metrics :: MCCI >, std :: true_type)
+	{
+		get_MCCI ( this->template at < metrics :: MCC >(), this->Nclass, this->template at < metrics :: MCCI >() );
+	}
+
+	void evaluate (metric < metrics :: AGF >, std :: true_type)
+	{
+		get_AGF ( this->template at < metrics :: TP >(), this->template at < metrics :: FP >(), this->template at < metrics :: FN >(), this->template at < metrics :: TN >(), this->Nclass, this->template at < metrics :: AGF >() );
+	}
+
+	void evaluate (metric < metrics :: OC >, std :: true_type)
+	{
+		get_OC ( this->template at < metrics :: TP >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->Nclass, this->template at < metrics :: OC >() );
+	}
+
+	void evaluate (metric < metrics :: OOC >, std :: true_type)
+	{
+		get_OOC ( this->template at < metrics :: TP >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->Nclass, this->template at < metrics :: OOC >() );
+	}
+
+	void evaluate (metric < metrics :: AUPR >, std :: true_type)
+	{
+		get_AUPR ( this->template at < metrics :: PPV >(), this->template at < metrics :: TPR >(), this->Nclass, this->template at < metrics :: AUPR >() );
+	}
+
+	void evaluate (metric < metrics :: BCD >, std :: true_type)
+	{
+		get_BCD ( this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: AM >(), this->Nclass, this->template at < metrics :: BCD >() );
+	}
+
+	void evaluate (metric < metrics :: overall_accuracy >, std :: true_type)
+	{
+		this->template at < metrics :: overall_accuracy >() = get_overall_accuracy ( this->template at < metrics :: TP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_random_accuracy_unbiased >, std :: true_type)
+	{
+		this->template at < metrics :: overall_random_accuracy_unbiased >() = get_overall_random_accuracy_unbiased ( this->template at < metrics :: RACCU >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_random_accuracy >, std :: true_type)
+	{
+		this->template at < metrics :: overall_random_accuracy >() = get_overall_random_accuracy ( this->template at < metrics :: RACC >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_kappa >, std :: true_type)
+	{
+		this->template at < metrics :: overall_kappa >() = get_overall_kappa ( this->template at < metrics :: overall_random_accuracy >(), this->template at < metrics :: overall_accuracy >() );
+	}
+
+	void evaluate (metric < metrics :: PC_PI >, std :: true_type)
+	{
+		this->template at < metrics :: PC_PI >() = get_PC_PI ( this->template at < metrics :: P >(), this->template at < metrics :: TOP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: PC_AC1 >, std :: true_type)
+	{
+		this->template at < metrics :: PC_AC1 >() = get_PC_AC1 ( this->template at < metrics :: P >(), this->template at < metrics :: TOP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: PC_S >, std :: true_type)
+	{
+		this->template at < metrics :: PC_S >() = get_PC_S ( this->classes.data(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: PI >, std :: true_type)
+	{
+		this->template at < metrics :: PI >() = get_PI ( this->template at < metrics :: PC_PI >(), this->template at < metrics :: overall_accuracy >() );
+	}
+
+	void evaluate (metric < metrics :: AC1 >, std :: true_type)
+	{
+		this->template at < metrics :: AC1 >() = get_AC1 ( this->template at < metrics :: PC_AC1 >(), this->template at < metrics :: overall_accuracy >() );
+	}
+
+	void evaluate (metric < metrics :: S >, std :: true_type)
+	{
+		this->template at < metrics :: S >() = get_S ( this->template at < metrics :: PC_S >(), this->template at < metrics :: overall_accuracy >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_SE >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_SE >() = get_kappa_SE ( this->template at < metrics :: overall_accuracy >(), this->template at < metrics :: overall_random_accuracy >(), this->template at < metrics :: POP >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_unbiased >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_unbiased >() = get_kappa_unbiased ( this->template at < metrics :: overall_random_accuracy_unbiased >(), this->template at < metrics :: overall_accuracy >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_no_prevalence >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_no_prevalence >() = get_kappa_no_prevalence ( this->template at < metrics :: overall_accuracy >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_CI_up >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_CI_up >() = get_kappa_CI_up ( this->template at < metrics :: overall_kappa >(), this->template at < metrics :: kappa_SE >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_CI_down >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_CI_down >() = get_kappa_CI_down ( this->template at < metrics :: overall_kappa >(), this->template at < metrics :: kappa_SE >() );
+	}
+
+	void evaluate (metric < metrics :: overall_accuracy_se >, std :: true_type)
+	{
+		this->template at < metrics :: overall_accuracy_se >() = get_overall_accuracy_se ( this->template at < metrics :: overall_accuracy >(), this->template at < metrics :: POP >() );
+	}
+
+	void evaluate (metric < metrics :: overall_accuracy_ci_up >, std :: true_type)
+	{
+		this->template at < metrics :: overall_accuracy_ci_up >() = get_overall_accuracy_ci_up ( this->template at < metrics :: overall_accuracy >(), this->template at < metrics :: overall_accuracy_se >() );
+	}
+
+	void evaluate (metric < metrics :: overall_accuracy_ci_down >, std :: true_type)
+	{
+		this->template at < metrics :: overall_accuracy_ci_down >() = get_overall_accuracy_ci_down ( this->template at < metrics :: overall_accuracy >(), this->template at < metrics :: overall_accuracy_se >() );
+	}
+
+	void evaluate (metric < metrics :: chi_square >, std :: true_type)
+	{
+		this->template at < metrics :: chi_square >() = get_chi_square ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: phi_square >, std :: true_type)
+	{
+		this->template at < metrics :: phi_square >() = get_phi_square ( this->template at < metrics :: chi_square >(), this->template at < metrics :: POP >() );
+	}
+
+	void evaluate (metric < metrics :: cramer_V >, std :: true_type)
+	{
+		this->template at < metrics :: cramer_V >() = get_cramer_V ( this->template at < metrics :: phi_square >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: response_entropy >, std :: true_type)
+	{
+		this->template at < metrics :: response_entropy >() = get_response_entropy ( this->template at < metrics :: TOP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: reference_entropy >, std :: true_type)
+	{
+		this->template at < metrics :: reference_entropy >() = get_reference_entropy ( this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: cross_entropy >, std :: true_type)
+	{
+		this->template at < metrics :: cross_entropy >() = get_cross_entropy ( this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: join_entropy >, std :: true_type)
+	{
+		this->template at < metrics :: join_entropy >() = get_join_entropy ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: conditional_entropy >, std :: true_type)
+	{
+		this->template at < metrics :: conditional_entropy >() = get_conditional_entropy ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: mutual_information >, std :: true_type)
+	{
+		this->template at < metrics :: mutual_information >() = get_mutual_information ( this->template at < metrics :: response_entropy >(), this->template at < metrics :: conditional_entropy >() );
+	}
+
+	void evaluate (metric < metrics :: kl_divergence >, std :: true_type)
+	{
+		this->template at < metrics :: kl_divergence >() = get_kl_divergence ( this->template at < metrics :: P >(), this->template at < metrics :: TOP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: lambda_B >, std :: true_type)
+	{
+		this->template at < metrics :: lambda_B >() = get_lambda_B ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: TOP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: lambda_A >, std :: true_type)
+	{
+		this->template at < metrics :: lambda_A >() = get_lambda_A ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: DF >, std :: true_type)
+	{
+		this->template at < metrics :: DF >() = get_DF ( this->classes.data(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_jaccard_index >, std :: true_type)
+	{
+		this->template at < metrics :: overall_jaccard_index >() = get_overall_jaccard_index ( this->template at < metrics :: jaccard_index >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: hamming_loss >, std :: true_type)
+	{
+		this->template at < metrics :: hamming_loss >() = get_hamming_loss ( this->template at < metrics :: TP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: zero_one_loss >, std :: true_type)
+	{
+		this->template at < metrics :: zero_one_loss >() = get_zero_one_loss ( this->template at < metrics :: TP >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: NIR >, std :: true_type)
+	{
+		this->template at < metrics :: NIR >() = get_NIR ( this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: p_value >, std :: true_type)
+	{
+		this->template at < metrics :: p_value >() = get_p_value ( this->template at < metrics :: TP >(), this->template at < metrics :: POP >(), this->Nclass, this->template at < metrics :: NIR >() );
+	}
+
+	void evaluate (metric < metrics :: overall_CEN >, std :: true_type)
+	{
+		this->template at < metrics :: overall_CEN >() = get_overall_CEN ( this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: CEN >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_MCEN >, std :: true_type)
+	{
+		this->template at < metrics :: overall_MCEN >() = get_overall_MCEN ( this->template at < metrics :: TP >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->template at < metrics :: MCEN >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_MCC >, std :: true_type)
+	{
+		this->template at < metrics :: overall_MCC >() = get_overall_MCC ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: RR >, std :: true_type)
+	{
+		this->template at < metrics :: RR >() = get_RR ( this->template at < metrics :: TOP >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: CBA >, std :: true_type)
+	{
+		this->template at < metrics :: CBA >() = get_CBA ( this->template at < metrics :: confusion_matrix >(), this->template at < metrics :: TOP >(), this->template at < metrics :: P >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: AUNU >, std :: true_type)
+	{
+		this->template at < metrics :: AUNU >() = get_AUNU ( this->template at < metrics :: AUC >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: AUNP >, std :: true_type)
+	{
+		this->template at < metrics :: AUNP >() = get_AUNP ( this->template at < metrics :: P >(), this->template at < metrics :: POP >(), this->template at < metrics :: AUC >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: RCI >, std :: true_type)
+	{
+		this->template at < metrics :: RCI >() = get_RCI ( this->template at < metrics :: mutual_information >(), this->template at < metrics :: reference_entropy >() );
+	}
+
+	void evaluate (metric < metrics :: CSI >, std :: true_type)
+	{
+		this->template at < metrics :: CSI >() = get_CSI ( this->template at < metrics :: ICSI >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: overall_pearson_C >, std :: true_type)
+	{
+		this->template at < metrics :: overall_pearson_C >() = get_overall_pearson_C ( this->template at < metrics :: chi_square >(), this->template at < metrics :: POP >() );
+	}
+
+	void evaluate (metric < metrics :: TPR_PPV_F1_micro >, std :: true_type)
+	{
+		this->template at < metrics :: TPR_PPV_F1_micro >() = get_TPR_PPV_F1_micro ( this->template at < metrics :: TP >(), this->template at < metrics :: FN >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: MCC_analysis >, std :: true_type)
+	{
+		this->template at < metrics :: MCC_analysis >() = get_MCC_analysis ( this->template at < metrics :: overall_MCC >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_analysis_cicchetti >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_analysis_cicchetti >() = get_kappa_analysis_cicchetti ( this->template at < metrics :: overall_kappa >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_analysis_koch >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_analysis_koch >() = get_kappa_analysis_koch ( this->template at < metrics :: overall_kappa >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_analysis_fleiss >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_analysis_fleiss >() = get_kappa_analysis_fleiss ( this->template at < metrics :: overall_kappa >() );
+	}
+
+	void evaluate (metric < metrics :: kappa_analysis_altman >, std :: true_type)
+	{
+		this->template at < metrics :: kappa_analysis_altman >() = get_kappa_analysis_altman ( this->template at < metrics :: overall_kappa >() );
+	}
+
+	void evaluate (metric < metrics :: V_analysis >, std :: true_type)
+	{
+		this->template at < metrics :: V_analysis >() = get_V_analysis ( this->template at < metrics :: cramer_V >() );
+	}
+
+	void evaluate (metric < metrics :: TPR_macro >, std :: true_type)
+	{
+		this->template at < metrics :: TPR_macro >() = get_TPR_macro ( this->template at < metrics :: TPR >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: PPV_macro >, std :: true_type)
+	{
+		this->template at < metrics :: PPV_macro >() = get_PPV_macro ( this->template at < metrics :: PPV >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: ACC_macro >, std :: true_type)
+	{
+		this->template at < metrics :: ACC_macro >() = get_ACC_macro ( this->template at < metrics :: ACC >(), this->Nclass );
+	}
+
+	void evaluate (metric < metrics :: F1_macro >, std :: true_type)
+	{
+		this->template at < metrics :: F1_macro >() = get_F1_macro ( this->template at < metrics :: F1_SCORE >(), this->Nclass );
+	}
+	/// @endcond
+};
+
+/// @cond DEF
+template < int32_t ... Ms >
+constexpr metrics :: selection metric_scorer < Ms ... > :: layout;
+/// @endcond
+
+#endif // __metric_scorer_h__
@@ -31,22 +31,6 @@
 
 #include <common_stats.h>
 
-/// @cond DEF
-#ifdef _MSC_VER
-
-  #ifndef __unused
-    #define __unused
-  #endif
-
-#else // Not Visual Studio Compiler
-
-  #ifndef __unused
-    #define __unused __attribute__((__unused__))
-  #endif
-
-#endif
-/// @endcond
-
 /**
 * @brief Overall Accuracy
 *
@@ -64,12 +48,13 @@
 struct // Overall ACC
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * POP, const int32_t & Nclass)
   {
-    return std :: accumulate(TP, TP + Nclass, 0.f) / (POP[0] + epsil);
+    return std :: accumulate(TP, TP + Nclass, count_type(0)) / (POP[0] + epsil);
   }
   /// @endcond
-} get_overall_accuracy;
+} get_overall_accuracy __unused;
 
 /**
 * @brief Overall random accuracy unbiased.
@@ -87,12 +72,12 @@ struct // Overall ACC
 struct // Overall RACCU
 {
   /// @cond DEF
-  auto operator() (const float * RACCU, const int32_t & Nclass)
+  auto operator() (const real_t * RACCU, const int32_t & Nclass)
   {
-    return std :: accumulate(RACCU, RACCU + Nclass, 0.f);
+    return static_cast < real_t >(std :: accumulate(RACCU, RACCU + Nclass, 0.));
   }
   /// @endcond
-} get_overall_random_accuracy_unbiased;
+} get_overall_random_accuracy_unbiased __unused;
 
 /**
 * @brief Overall random accuracy
@@ -110,12 +95,12 @@ struct // Overall RACCU
 struct // Overall RACC
 {
   /// @cond DEF
-  auto operator() (const float * RACC, const int32_t & Nclass)
+  auto operator() (const real_t * RACC, const int32_t & Nclass)
   {
-    return std :: accumulate(RACC, RACC + Nclass, 0.f);
+    return static_cast < real_t >(std :: accumulate(RACC, RACC + Nclass, 0.));
   }
   /// @endcond
-} get_overall_random_accuracy;
+} get_overall_random_accuracy __unused;
 
 /**
 * @brief Kappa
@@ -138,12 +123,12 @@ struct // Overall RACC
 struct // Kappa
 {
   /// @cond DEF
-  auto operator() (const float & overall_random_accuracy, const float & overall_accuracy)
+  auto operator() (const real_t & overall_random_accuracy, const real_t & overall_accuracy)
   {
     return (overall_accuracy - overall_random_accuracy) / (1.f - overall_random_accuracy + epsil);
   }
   /// @endcond
-} get_overall_kappa;
+} get_overall_kappa __unused;
 
 /**
 * @brief Utility function for future scores.
@@ -164,15 +149,20 @@ struct // Kappa
 struct // PC_PI
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * TOP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * TOP, const count_type * POP, const int32_t & Nclass)
   {
-    float res = 0.f;
+    double res = 0.;
     for (int32_t i = 0; i < Nclass; ++i)
-      res += ( (P[i] + TOP[i]) * (P[i] + TOP[i]) ) / ( 4.f * POP[i] * POP[i] + epsil );
-    return res;
+    {
+      const double p_top = P[i] + TOP[i];
+      const double pop = POP[i];
+      res += ( p_top * p_top ) / ( 4.f * pop * pop + epsil );
+    }
+    return static_cast < real_t >(res);
   }
   /// @endcond
-} get_PC_PI;
+} get_PC_PI __unused;
 
 /**
 * @brief Utility function for future scores.
@@ -194,18 +184,19 @@ struct // PC_PI
 struct // PC_AC1
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * TOP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * TOP, const count_type * POP, const int32_t & Nclass)
   {
-    float AC1 = 0.f;
+    double AC1 = 0.;
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      const float pi = (P[i] + TOP[i]) / (2.f * POP[i] + epsil);
+      const double pi = (P[i] + TOP[i]) / (2. * POP[i] + epsil);
       AC1 += pi * (1.f - pi);
     }
-    return AC1 / (Nclass - 1 + epsil);
+    return static_cast < real_t >(AC1 / (Nclass - 1 + epsil));
   }
   /// @endcond
-} get_PC_AC1;
+} get_PC_AC1 __unused;
 
 /**
 * @brief One over classes.
@@ -225,10 +216,10 @@ struct // PC_S
   /// @cond DEF
   auto operator() (__unused const float * classes, const int32_t & Nclass)
   {
-    return 1.f / static_cast < float >(Nclass);
+    return 1.f / static_cast < real_t >(Nclass);
   }
   /// @endcond
-} get_PC_S;
+} get_PC_S __unused;
 
 /**
 * @brief Scott's Pi
@@ -256,12 +247,12 @@ struct // PC_S
 struct // Scott PI
 {
   /// @cond DEF
-  auto operator() (const float & PC_PI, const float & overall_accuracy)
+  auto operator() (const real_t & PC_PI, const real_t & overall_accuracy)
   {
     return (overall_accuracy - PC_PI) / (1.f - PC_PI + epsil);
   }
   /// @endcond
-} get_PI;
+} get_PI __unused;
 
 /**
 * @brief Gwet's AC1
@@ -285,12 +276,12 @@ struct // Scott PI
 struct // Get AC1
 {
   /// @cond DEF
-  auto operator() (const float & PC_AC1, const float & overall_accuracy)
+  auto operator() (const real_t & PC_AC1, const real_t & overall_accuracy)
   {
     return (overall_accuracy - PC_AC1) / (1.f - PC_AC1 + epsil);
   }
   /// @endcond
-} get_AC1;
+} get_AC1 __unused;
 
 /**
 * @brief Bennett's S
@@ -313,12 +304,12 @@ struct // Get AC1
 struct // Bennett S
 {
   /// @cond DEF
-  auto operator() (const float & PC_S, const float & overall_accuracy)
+  auto operator() (const real_t & PC_S, const real_t & overall_accuracy)
   {
     return (overall_accuracy - PC_S) / (1.f - PC_S + epsil);
   }
   /// @endcond
-} get_S;
+} get_S __unused;
 
 /**
 * @brief Kappa standard error
@@ -339,13 +330,14 @@ struct // Bennett S
 struct // Kappa Standard Error
 {
   /// @cond DEF
-  auto operator() (const float & overall_accuracy, const float & overall_random_accuracy, const float * POP)
+  template < typename count_type >
+  auto operator() (const real_t & overall_accuracy, const real_t & overall_random_accuracy, const count_type * POP)
   {
     return std :: sqrt( (overall_accuracy * (1.f - overall_accuracy) ) /
           (POP[0] * (1.f - overall_random_accuracy) * (1.f - overall_random_accuracy) + epsil) );
   }
   /// @endcond
-} get_kappa_SE;
+} get_kappa_SE __unused;
 
 /**
 * @brief Kappa unbiased
@@ -366,13 +358,13 @@ struct // Kappa Standard Error
 struct // Kappa Unbiased
 {
   /// @cond DEF
-  auto operator() (const float & overall_random_accuracy_unbiased, const float & overall_accuracy)
+  auto operator() (const real_t & overall_random_accuracy_unbiased, const real_t & overall_accuracy)
   {
     return (overall_accuracy - overall_random_accuracy_unbiased) /
            (1.f - overall_random_accuracy_unbiased + epsil);
   }
   /// @endcond
-} get_kappa_unbiased;
+} get_kappa_unbiased __unused;
 
 /**
 * @brief Kappa no prevalence
@@ -391,12 +383,12 @@ struct // Kappa Unbiased
 struct // Kappa No Prevalence
 {
   /// @cond DEF
-  auto operator() (const float & overall_accuracy)
+  auto operator() (const real_t & overall_accuracy)
   {
     return 2.f * overall_accuracy - 1.f;
   }
   /// @endcond
-} get_kappa_no_prevalence;
+} get_kappa_no_prevalence __unused;
 
 /**
 * @brief Kappa 95% CI
@@ -416,12 +408,12 @@ struct // Kappa No Prevalence
 struct // Kappa 95% CI up
 {
   /// @cond DEF
-  auto operator() (const float & overall_kappa, const float & kappa_SE)
+  auto operator() (const real_t & overall_kappa, const real_t & kappa_SE)
   {
     return overall_kappa + 1.96 * kappa_SE;
   }
   /// @endcond
-} get_kappa_CI_up;
+} get_kappa_CI_up __unused;
 
 /**
 * @brief Kappa 95% CI
@@ -441,12 +433,12 @@ struct // Kappa 95% CI up
 struct // Kappa 95% CI down
 {
   /// @cond DEF
-  auto operator() (const float & overall_kappa, const float & kappa_SE)
+  auto operator() (const real_t & overall_kappa, const real_t & kappa_SE)
   {
     return overall_kappa - 1.96 * kappa_SE;
   }
   /// @endcond
-} get_kappa_CI_down;
+} get_kappa_CI_down __unused;
 
 /**
 * @brief Standard error
@@ -467,12 +459,13 @@ struct // Kappa 95% CI down
 struct // Standard Error
 {
   /// @cond DEF
-  auto operator() (const float & overall_accuracy, const float * POP)
+  template < typename count_type >
+  auto operator() (const real_t & overall_accuracy, const count_type * POP)
   {
     return std :: sqrt( (overall_accuracy * (1.f - overall_accuracy)) / (POP[0] + epsil) );
   }
   /// @endcond
-} get_overall_accuracy_se;
+} get_overall_accuracy_se __unused;
 
 /**
 * @brief 95% CI (upper bound)
@@ -498,12 +491,12 @@ struct // Standard Error
 struct // 95% CI up
 {
   /// @cond DEF
-  auto operator() (const float & overall_accuracy, const float & overall_accuracy_se)
+  auto operator() (const real_t & overall_accuracy, const real_t & overall_accuracy_se)
   {
     return overall_accuracy + 1.96f * overall_accuracy_se;
   }
   /// @endcond
-} get_overall_accuracy_ci_up;
+} get_overall_accuracy_ci_up __unused;
 
 /**
 * @brief 95% CI (lower bound)
@@ -529,12 +522,12 @@ struct // 95% CI up
 struct // 95% CI down
 {
   /// @cond DEF
-  auto operator() (const float & overall_accuracy, const float & overall_accuracy_se)
+  auto operator() (const real_t & overall_accuracy, const real_t & overall_accuracy_se)
   {
     return overall_accuracy - 1.96f * overall_accuracy_se;
   }
   /// @endcond
-} get_overall_accuracy_ci_down;
+} get_overall_accuracy_ci_down __unused;
 
 /**
 * @brief Chi-squared
@@ -543,7 +536,7 @@ struct // 95% CI down
 * categorical data to evaluate how likely it is that any observed difference between
 * the sets arose by chance. It is suitable for unpaired data from large samples.
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param TOP array of positive predicted values for each class.
 * @param P array of true positive rates for each class.
 * @param POP array of true positive rates for each class.
@@ -554,20 +547,45 @@ struct // 95% CI down
 struct // Chi-Squared
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * TOP, const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * TOP, const count_type * P, const count_type * POP, const int32_t & Nclass)
   {
-    float res = 0.f;
+    double res = 0.;
     for (int32_t i = 0; i < Nclass; ++i)
       for (int32_t j = 0; j < Nclass; ++j)
       {
-        const float expected = (TOP[j] * P[i]) / (POP[i] + epsil);
-        const float cf = confusion_matrix[i * Nclass + j] - expected;
+        const double expected = (static_cast < double >(TOP[j]) * P[i]) / (static_cast < double >(POP[i]) + epsil);
+        const double cf = confusion_matrix[i * Nclass + j] - expected;
         res += (cf * cf) / (expected + epsil);
       }
-    return res;
+    return static_cast < real_t >(res);
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * TOP, const count_type * P, const count_type * POP, const int32_t & Nclass)
+  {
+    // an empty cell contributes its expected count, so the sum over all the cells
+    // is corrected by the non-zero ones
+    double res = 0.;
+    double top = 0.;
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      res += P[i] / (static_cast < double >(POP[i]) + epsil);
+      top += TOP[i];
+    }
+    res *= top;
+
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+      {
+        const double expected = (static_cast < double >(TOP[confusion_matrix.col(k)]) * P[i]) / (static_cast < double >(POP[i]) + epsil);
+        const double cf = confusion_matrix.count(k) - expected;
+        res += (cf * cf) / (expected + epsil) - expected;
+      }
+    return static_cast < real_t >(res);
   }
   /// @endcond
-} get_chi_square;
+} get_chi_square __unused;
 
 /**
 * @brief Phi-squared
@@ -590,12 +608,13 @@ struct // Chi-Squared
 struct // Phi-Squared
 {
   /// @cond DEF
-  auto operator() (const float & chi_square, const float * POP)
+  template < typename count_type >
+  auto operator() (const real_t & chi_square, const count_type * POP)
   {
     return chi_square / (POP[0] + epsil);
   }
   /// @endcond
-} get_phi_square;
+} get_phi_square __unused;
 
 /**
 * @brief Cramer's V
@@ -617,12 +636,12 @@ struct // Phi-Squared
 struct // Cramer V
 {
   /// @cond DEF
-  auto operator() (const float & phi_square, const int32_t & Nclass)
+  auto operator() (const real_t & phi_square, const int32_t & Nclass)
   {
-    return std::sqrt(phi_square / static_cast<float>(Nclass - 1));
+    return std::sqrt(phi_square / static_cast<real_t>(Nclass - 1));
   }
   /// @endcond
-} get_cramer_V;
+} get_cramer_V __unused;
 
 /**
 * @brief Response entropy
@@ -644,18 +663,19 @@ struct // Cramer V
 struct // Response Entropy
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * POP, const int32_t & Nclass)
   {
-    return -std :: inner_product(TOP, TOP + Nclass, POP, 0.f,
-                                 std :: plus < float >(),
-                                 [](const float & item, const float & pop)
-                                 {
-                                    float likelihood = item / (pop + epsil);
-                                    return likelihood * std :: log2(likelihood);
-                                 });
+    return static_cast < real_t >(-std :: inner_product(TOP, TOP + Nclass, POP, 0.,
+                                                        std :: plus < double >(),
+                                                        [](const double & item, const double & pop)
+                                                        {
+                                                           double likelihood = item / (pop + epsil);
+                                                           return likelihood * std :: log2(likelihood);
+                                                        }));
   }
   /// @endcond
-} get_response_entropy;
+} get_response_entropy __unused;
 
 /**
 * @brief Reference entropy
@@ -678,18 +698,19 @@ struct // Response Entropy
 struct // Reference Entropy
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * POP, const int32_t & Nclass)
   {
-    return -std :: inner_product(P, P + Nclass, POP, 0.f,
-                                 std :: plus < float >(),
-                                 [](const float & item, const float & pop)
-                                 {
-                                    float likelihood = item / (pop + epsil);
-                                    return likelihood * std :: log2(likelihood);
-                                 });
+    return static_cast < real_t >(-std :: inner_product(P, P + Nclass, POP, 0.,
+                                                        std :: plus < double >(),
+                                                        [](const double & item, const double & pop)
+                                                        {
+                                                           double likelihood = item / (pop + epsil);
+                                                           return likelihood * std :: log2(likelihood);
+                                                        }));
   }
   /// @endcond
-} get_reference_entropy;
+} get_reference_entropy __unused;
 
 /**
 * @brief Cross entropy
@@ -714,15 +735,16 @@ struct // Reference Entropy
 struct // Cross Entropy
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * P, const count_type * POP, const int32_t & Nclass)
   {
-    float res = 0.f;
+    double res = 0.;
     for (int32_t i = 0; i < Nclass; ++i)
-      res += (P[i] / (POP[i] + epsil)) * std :: log2(TOP[i] / (POP[i] + epsil));
-    return -res;
+      res += (P[i] / (static_cast < double >(POP[i]) + epsil)) * std :: log2(TOP[i] / (static_cast < double >(POP[i]) + epsil));
+    return static_cast < real_t >(-res);
   }
   /// @endcond
-} get_cross_entropy;
+} get_cross_entropy __unused;
 
 /**
 * @brief Joint entropy
@@ -735,7 +757,7 @@ struct // Cross Entropy
 * entropy_joint = - sum(P * log2(P))
 * ```
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
 *
@@ -744,19 +766,33 @@ struct // Cross Entropy
 struct // Joint Entropy
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * POP, const int32_t & Nclass)
   {
-    float res = 0.f, p_prime;
+    double res = 0., p_prime;
     for (int32_t i = 0; i < Nclass; ++i)
       for (int32_t j = 0; j < Nclass; ++j)
       {
-        p_prime = confusion_matrix[i * Nclass + j] / (POP[i] + epsil);
+        p_prime = confusion_matrix[i * Nclass + j] / (static_cast < double >(POP[i]) + epsil);
         res += (p_prime != 0.f) ? p_prime * std :: log2(p_prime) : 0.f;
       }
-    return -res;
+    return static_cast < real_t >(-res);
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * POP, const int32_t & Nclass)
+  {
+    double res = 0.;
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+      {
+        const double p_prime = confusion_matrix.count(k) / (static_cast < double >(POP[i]) + epsil);
+        res += p_prime * std :: log2(p_prime);
+      }
+    return static_cast < real_t >(-res);
   }
   /// @endcond
-} get_join_entropy;
+} get_join_entropy __unused;
 
 /**
 * @brief Conditional entropy
@@ -764,7 +800,7 @@ struct // Joint Entropy
 * @details The entropy of the distribution of categories in the response given that
 * the reference category was as specified.
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param P array of the number of positive samples for each class.
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
@@ -774,23 +810,41 @@ struct // Joint Entropy
 struct // Conditional Entropy
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * P, const count_type * POP, const int32_t & Nclass)
   {
-    float res = 0.f, p_prime, tmp;
+    double res = 0., p_prime, tmp;
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      tmp = 0.f;
+      tmp = 0.;
       for (int32_t j = 0; j < Nclass; ++j)
       {
-        p_prime = confusion_matrix[i * Nclass + j] / (P[i] + epsil);
+        p_prime = confusion_matrix[i * Nclass + j] / (static_cast < double >(P[i]) + epsil);
         tmp += (p_prime != 0.f) ? p_prime * std :: log2(p_prime) : 0.f;
       }
-      res += tmp * (P[i] / (POP[i] + epsil));
+      res += tmp * (P[i] / (static_cast < double >(POP[i]) + epsil));
+    }
+    return static_cast < real_t >(-res);
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * P, const count_type * POP, const int32_t & Nclass)
+  {
+    double res = 0.;
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      double tmp = 0.;
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+      {
+        const double p_prime = confusion_matrix.count(k) / (static_cast < double >(P[i]) + epsil);
+        tmp += p_prime * std :: log2(p_prime);
+      }
+      res += tmp * (P[i] / (static_cast < double >(POP[i]) + epsil));
     }
-    return -res;
+    return static_cast < real_t >(-res);
   }
   /// @endcond
-} get_conditional_entropy;
+} get_conditional_entropy __unused;
 
 /**
 * @brief Mutual information
@@ -813,12 +867,12 @@ struct // Conditional Entropy
 struct // Mutual Information
 {
   /// @cond DEF
-  auto operator() (const float & response_entropy, const float & conditional_entropy)
+  auto operator() (const real_t & response_entropy, const real_t & conditional_entropy)
   {
     return response_entropy - conditional_entropy;
   }
   /// @endcond
-} get_mutual_information;
+} get_mutual_information __unused;
 
 /**
 * @brief Kullback-Leibler divergence
@@ -843,18 +897,19 @@ struct // Mutual Information
 struct // KL Divergence
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * TOP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * TOP, const count_type * POP, const int32_t & Nclass)
   {
-    float res = 0.f, reference_likelihood;
+    double res = 0., reference_likelihood;
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      reference_likelihood = P[i] / (POP[i] + epsil);
-      res += reference_likelihood * std :: log2( reference_likelihood / (TOP[i] / (POP[i] + epsil)) );
+      reference_likelihood = P[i] / (static_cast < double >(POP[i]) + epsil);
+      res += reference_likelihood * std :: log2( reference_likelihood / (TOP[i] / (static_cast < double >(POP[i]) + epsil)) );
     }
-    return res;
+    return static_cast < real_t >(res);
   }
   /// @endcond
-} get_kl_divergence;
+} get_kl_divergence __unused;
 
 /**
 * @brief Goodman & Kruskal's lambda B
@@ -862,7 +917,7 @@ struct // KL Divergence
 * @details In probability theory and statistics, Goodman & Kruskal's lambda is a
 * measure of proportional reduction in error in cross tabulation analysis.
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param TOP array of positive predicted values for each class.
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
@@ -872,10 +927,11 @@ struct // KL Divergence
 struct // Lambda B
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * TOP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * TOP, const count_type * POP, const int32_t & Nclass)
   {
-    float maxresponse = -inf;
-    float res = 0.f;
+    double maxresponse = -inf;
+    double res = 0.;
 
     for (int32_t i = 0; i < Nclass; ++i)
     {
@@ -884,10 +940,31 @@ struct // Lambda B
                                  confusion_matrix + i * Nclass + Nclass);
     }
 
-    return (res - maxresponse) / (POP[0] - maxresponse + epsil);
+    return static_cast < real_t >((res - maxresponse) / (POP[0] - maxresponse + epsil));
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * TOP, const count_type * POP, const int32_t & Nclass)
+  {
+    double maxresponse = -inf;
+    double res = 0.;
+
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      maxresponse = TOP[i] > maxresponse ? TOP[i] : maxresponse;
+
+      // the empty cells of the row count as zero
+      count_t m = 0;
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+        m = std :: max(m, confusion_matrix.count(k));
+
+      res += m;
+    }
+
+    return static_cast < real_t >((res - maxresponse) / (POP[0] - maxresponse + epsil));
   }
   /// @endcond
-} get_lambda_B;
+} get_lambda_B __unused;
 
 /**
 * @brief Goodman & Kruskal's lambda A
@@ -895,7 +972,7 @@ struct // Lambda B
 * @details In probability theory and statistics, Goodman & Kruskal's lambda is a
 * measure of proportional reduction in error in cross tabulation analysis.
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param P array of the number of positive samples for each class.
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
@@ -905,27 +982,48 @@ struct // Lambda B
 struct // Lambda A
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * P, const count_type * POP, const int32_t & Nclass)
   {
-    float maxreference = -inf;
-    float res = 0.f;
+    double maxreference = -inf;
+    double res = 0.;
 
     for (int32_t i = 0; i < Nclass; ++i)
     {
       maxreference = P[i] > maxreference ? P[i] : maxreference;
 
-      float m = -inf;
+      double m = -inf;
       for (int32_t j = 0; j < Nclass; ++j) {
-        const float cf = confusion_matrix[j * Nclass + i];
+        const double cf = confusion_matrix[j * Nclass + i];
         m = cf > m ? cf : m;
       }
 
       res += m;
     }
-    return (res - maxreference) / (POP[0] - maxreference + epsil);
+    return static_cast < real_t >((res - maxreference) / (POP[0] - maxreference + epsil));
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * P, const count_type * POP, const int32_t & Nclass)
+  {
+    double maxreference = -inf;
+
+    // max of each column (the empty cells count as zero)
+    std :: vector < count_t > m (Nclass, count_t(0));
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = confusion_matrix.row_begin(i); k < confusion_matrix.row_end(i); ++k)
+        m[confusion_matrix.col(k)] = std :: max(m[confusion_matrix.col(k)], confusion_matrix.count(k));
+
+    double res = 0.;
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      maxreference = P[i] > maxreference ? P[i] : maxreference;
+      res += m[i];
+    }
+    return static_cast < real_t >((res - maxreference) / (POP[0] - maxreference + epsil));
   }
   /// @endcond
-} get_lambda_A;
+} get_lambda_A __unused;
 
 /**
 * @brief Chi-squared DF
@@ -947,10 +1045,10 @@ struct // Chi-Squared DF
   /// @cond DEF
   auto operator() (__unused const float * classes, const int32_t & Nclass)
   {
-    return static_cast< float >((Nclass - 1) * (Nclass - 1));
+    return static_cast< real_t >((Nclass - 1) * (Nclass - 1));
   }
   /// @endcond
-} get_DF;
+} get_DF __unused;
 
 /**
 * @brief Overall Jaccard index
@@ -968,12 +1066,12 @@ struct // Chi-Squared DF
 struct // Overall J
 {
   /// @cond DEF
-  auto operator() (const float * jaccard_index, const int32_t & Nclass)
+  auto operator() (const real_t * jaccard_index, const int32_t & Nclass)
   {
-    return std :: accumulate(jaccard_index, jaccard_index + Nclass, 0.f);
+    return static_cast < real_t >(std :: accumulate(jaccard_index, jaccard_index + Nclass, 0.));
   }
   /// @endcond
-} get_overall_jaccard_index;
+} get_overall_jaccard_index __unused;
 
 /**
 * @brief Hamming loss
@@ -993,12 +1091,13 @@ struct // Overall J
 struct // Hamming loss
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * POP, const int32_t & Nclass)
   {
-    return 1.f / (POP[0] + epsil) * (POP[0] - std :: accumulate(TP, TP + Nclass, 0.f));
+    return 1.f / (POP[0] + epsil) * (POP[0] - std :: accumulate(TP, TP + Nclass, count_type(0)));
   }
   /// @endcond
-} get_hamming_loss;
+} get_hamming_loss __unused;
 
 /**
 * @brief Zero-one loss
@@ -1019,12 +1118,13 @@ struct // Hamming loss
 struct // Zero-one Loss
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * POP, const int32_t & Nclass)
   {
-    return POP[0] - std :: accumulate(TP, TP + Nclass, 0.f);
+    return POP[0] - std :: accumulate(TP, TP + Nclass, count_type(0));
   }
   /// @endcond
-} get_zero_one_loss;
+} get_zero_one_loss __unused;
 
 /**
 * @brief No information rate
@@ -1044,12 +1144,175 @@ struct // Zero-one Loss
 struct // NIR
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * POP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * POP, const int32_t & Nclass)
   {
     return *std :: max_element(P, P + Nclass) / (POP[0] + epsil);
   }
   /// @endcond
-} get_NIR;
+} get_NIR __unused;
+
+/**
+* @brief Continued fraction of the regularized incomplete beta function.
+*
+* @details The fraction is evaluated with the modified Lentz's method and it
+* converges quickly for x < (a + 1) / (a + b + 2) (see regularized_beta).
+*
+* @param a first shape parameter
+* @param b second shape parameter
+* @param x evaluation point in (0, 1)
+*
+* @return The value of the continued fraction.
+*/
+inline double beta_fraction (const double & a, const double & b, const double & x)
+{
+  constexpr double eps  = 1e-15;  // relative tolerance
+  constexpr double tiny = 1e-300; // guard against divisions by zero
+
+  // the number of terms grows at most as sqrt(max(a, b))
+  const int32_t max_iter = 100 + static_cast < int32_t >(10. * std :: sqrt(std :: max(a, b)));
+
+  double c = 1.;
+  double d = 1. - (a + b) * x / (a + 1.);
+  d = 1. / (std :: fabs(d) < tiny ? tiny : d);
+  double h = d;
+
+  for (int32_t m = 1; m <= max_iter; ++m)
+  {
+    const int32_t m2 = 2 * m;
+
+    // even step
+    double aa = m * (b - m) * x / ((a - 1. + m2) * (a + m2));
+    d = 1. + aa * d;
+    d = 1. / (std :: fabs(d) < tiny ? tiny : d);
+    c = 1. + aa / c;
+    c = std :: fabs(c) < tiny ? tiny : c;
+    h *= d * c;
+
+    // odd step
+    aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + 1. + m2));
+    d = 1. + aa * d;
+    d = 1. / (std :: fabs(d) < tiny ? tiny : d);
+    c = 1. + aa / c;
+    c = std :: fabs(c) < tiny ? tiny : c;
+
+    const double delta = d * c;
+    h *= delta;
+
+    if ( std :: fabs(delta - 1.) < eps )
+      break;
+  }
+
+  return h;
+}
+
+/**
+* @brief Accurate evaluation of log(1 + y) - y.
+*
+* @details The power series is used for |y| < 0.5, where the direct difference
+* would cancel almost all the significant digits.
+*
+* @param y argument (y > -1)
+*
+* @return The value of log(1 + y) - y.
+*/
+inline double log1pmx (const double & y)
+{
+  if ( std :: fabs(y) >= 0.5 )
+    return std :: log1p(y) - y;
+
+  // log(1 + y) - y = sum_{k >= 2} (-1)^(k + 1) y^k / k
+  double res = 0.;
+  double pw = y;
+
+  for (int32_t k = 2; k < 100; ++k)
+  {
+    pw *= -y;
+    const double term = pw / k;
+    res += term;
+
+    if ( std :: fabs(term) <= 1e-17 * std :: fabs(res) )
+      break;
+  }
+
+  return res;
+}
+
+/**
+* @brief Uniform asymptotic expansion of the regularized incomplete beta function.
+*
+* @details Temme's expansion for large a + b:
+*
+* ```python
+* x0 = a / (a + b)
+* -eta**2 / 2 = x0 * log(x / x0) + (1 - x0) * log((1 - x) / (1 - x0)), sign(eta) = sign(x - x0)
+* I_x(a, b) ~ erfc(-eta * sqrt((a + b) / 2)) / 2 + exp(-(a + b) * eta**2 / 2) / sqrt(2 * pi * (a + b)) * (1 / eta - sqrt(x0 * (1 - x0)) / (x - x0))
+* ```
+*
+* The relative error is O(1 / min(a, b)) and the cost does not depend on the
+* shape parameters. The correction term tends to (1 - 2 x0) / (3 sqrt(x0 (1 - x0)))
+* for eta -> 0, and the limit is used where the two fractions would cancel.
+*
+* @param a first shape parameter (a >> 1)
+* @param b second shape parameter (b >> 1)
+* @param x evaluation point in (0, 1)
+*
+* @return The value of the regularized incomplete beta function.
+*/
+inline double regularized_beta_asymptotic (const double & a, const double & b, const double & x)
+{
+  constexpr double two_pi = 6.283185307179586;
+
+  const double n = a + b;
+  const double x0 = a / n;
+  const double s = std :: sqrt(x0 * (1. - x0));
+  const double u = x - x0;
+
+  // -eta^2 / 2, with the linear terms of the logarithms cancelled exactly
+  const double half_eta2 = -(x0 * log1pmx(u / x0) + (1. - x0) * log1pmx(-u / (1. - x0)));
+  const double eta = half_eta2 > 0. ? std :: copysign(std :: sqrt(2. * half_eta2), u) : 0.;
+
+  const double c0 = std :: fabs(eta) < 1e-5 ? (1. - 2. * x0) / (3. * s) : 1. / eta - s / u;
+
+  return .5 * std :: erfc(-eta * std :: sqrt(.5 * n)) + std :: exp(-n * half_eta2) / std :: sqrt(two_pi * n) * c0;
+}
+
+/**
+* @brief Regularized incomplete beta function I_x(a, b).
+*
+* @details The prefactor x^a (1 - x)^b / B(a, b) is evaluated in log-space
+* (by lgamma), so the function is stable for any size of the shape parameters.
+* The symmetry I_x(a, b) = 1 - I_{1-x}(b, a) is used to evaluate the continued
+* fraction in its fast converging region.
+* The number of terms of the continued fraction grows as sqrt(min(a, b)) near
+* the mean, so for min(a, b) > 1e6 the uniform asymptotic expansion is used
+* instead (see regularized_beta_asymptotic): its cost is constant and its
+* error is smaller than the rounding of the lgamma differences at that size.
+*
+* @param a first shape parameter (a > 0)
+* @param b second shape parameter (b > 0)
+* @param x evaluation point
+*
+* @return The value of the regularized incomplete beta function.
+*/
+inline double regularized_beta (const double & a, const double & b, const double & x)
+{
+  if ( x <= 0. )
+    return 0.;
+
+  if ( x >= 1. )
+    return 1.;
+
+  if ( std :: min(a, b) > 1e6 )
+    return regularized_beta_asymptotic(a, b, x);
+
+  if ( x > (a + 1.) / (a + b + 2.) )
+    return 1. - regularized_beta(b, a, 1. - x);
+
+  const double log_front = std :: lgamma(a + b) - std :: lgamma(a) - std :: lgamma(b) + a * std :: log(x) + b * std :: log1p(-x);
+
+  return std :: exp(log_front) * beta_fraction(a, b, x) / a;
+}
 
 /**
 * @brief P-Value
@@ -1068,6 +1331,10 @@ struct // NIR
 * p_value = 1 - sum([binomial(n, i) * p**i * (1 - p)**(n - i) for i in range(x)])
 * ```
 *
+* The binomial tail is evaluated as P(X >= x) = I_p(x, n - x + 1) using the
+* regularized incomplete beta function (see regularized_beta), so the cost does
+* not depend on the number of samples.
+*
 * @param TP array of number of true positives for each class.
 * @param POP array of total samples for each class.
 * @param Nclass size of classes array (aka number of classes)
@@ -1078,42 +1345,22 @@ struct // NIR
 struct // P-value
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * POP, const int32_t & Nclass, const float & NIR)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * POP, const int32_t & Nclass, const real_t & NIR)
   {
-    float p_value = 0.f;
-    const int32_t x = static_cast < int32_t > (std :: accumulate(TP, TP + Nclass, 0.f));
-
-    for (int32_t i = 0; i < x; ++i)
-    {
-      const int32_t r = i < POP[0] - i ? i : POP[0] - i;
-
-      int32_t numer = 1;
-
-      int32_t iter = POP[0];
-      while (iter > POP[0] - r)
-      {
-        numer *= iter;
-        -- iter;
-      }
-
-      int32_t denom = 1;
-
-      iter = 1;
-      while (iter < r + 1)
-      {
-        denom *= iter;
-        ++ iter;
-      }
+    const count_type pop = POP[0];
+    const count_type x = std :: accumulate(TP, TP + Nclass, count_type(0));
 
-      const int32_t ncr = numer / (denom + epsil);
+    if ( x == 0 )
+      return real_t(1);
 
-      p_value += ncr * std :: pow(NIR, i) * std :: pow(1.f - NIR, POP[0] - i);
-    }
+    if ( x > pop )
+      return real_t(0);
 
-    return 1.f - p_value;
+    return static_cast < real_t >(regularized_beta(static_cast < double >(x), static_cast < double >(pop - x + 1), static_cast < double >(NIR)));
   }
   /// @endcond
-} get_p_value;
+} get_p_value __unused;
 
 /**
 * @brief Overall CEN
@@ -1128,24 +1375,25 @@ struct // P-value
 struct // Overall CEN
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const float * P, const float * CEN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const count_type * P, const real_t * CEN, const int32_t & Nclass)
   {
-    float overall_CEN = 0.f;
+    double overall_CEN = 0.;
 
-    const float TOP_sum = std :: accumulate(TOP, TOP + Nclass, 0.f);
+    const double TOP_sum = std :: accumulate(TOP, TOP + Nclass, count_type(0));
 
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      const float up = TOP[i] + P[i];
-      const float down = 2.f * TOP_sum;
+      const double up = TOP[i] + P[i];
+      const double down = 2.f * TOP_sum;
 
       overall_CEN += (up / (down + epsil)) * CEN[i];
     }
 
-    return overall_CEN;
+    return static_cast < real_t >(overall_CEN);
   }
   /// @endcond
-} get_overall_CEN;
+} get_overall_CEN __unused;
 
 /**
 * @brief Overall MCEN
@@ -1161,32 +1409,33 @@ struct // Overall CEN
 struct // Overall MCEN
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * TOP, const float * P, const float * MCEN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * TOP, const count_type * P, const real_t * MCEN, const int32_t & Nclass)
   {
-    float overall_MCEN = 0.f;
+    double overall_MCEN = 0.;
 
-    const float alpha = Nclass == 2 ? 0.f : 1.f;
+    const double alpha = Nclass == 2 ? 0.f : 1.f;
 
-    const float TOP_sum = std :: accumulate(TOP, TOP + Nclass, 0.f);
-    const float TP_sum = std :: accumulate(TP, TP + Nclass, 0.f);
+    const double TOP_sum = std :: accumulate(TOP, TOP + Nclass, count_type(0));
+    const double TP_sum = std :: accumulate(TP, TP + Nclass, count_type(0));
 
     for (int32_t i = 0; i < Nclass; ++i)
     {
-      const float up = TOP[i] + P[i] - TP[i];
-      const float down = 2.f * TOP_sum - alpha * TP_sum;
+      const double up = TOP[i] + P[i] - TP[i];
+      const double down = 2.f * TOP_sum - alpha * TP_sum;
 
       overall_MCEN += (up / (down + epsil)) * MCEN[i];
     }
 
-    return overall_MCEN;
+    return static_cast < real_t >(overall_MCEN);
   }
   /// @endcond
-} get_overall_MCEN;
+} get_overall_MCEN __unused;
 
 /**
 * @brief Overall MCC
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param TOP array of positive predicted values for each class.
 * @param P array of number of positive samples for each class.
 * @param Nclass size of classes array (aka number of classes)
@@ -1196,24 +1445,43 @@ struct // Overall MCEN
 struct // Overall MCC
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * TOP, const float * P, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * TOP, const count_type * P, const int32_t & Nclass)
+  {
+    const double s = std :: accumulate(TOP, TOP + Nclass, count_type(0));
+    double cov_x_y = 0.;
+    double cov_x_x = 0.;
+    double cov_y_y = 0.;
+
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      cov_x_x += TOP[i] * (s - TOP[i]);
+      cov_y_y += P[i] *   (s - P[i]);
+      cov_x_y += confusion_matrix[i * Nclass + i] * s - static_cast < double >(P[i]) * TOP[i];
+    }
+
+    return static_cast < real_t >(cov_x_y / (std :: sqrt(cov_y_y * cov_x_x) + epsil));
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * TOP, const count_type * P, const int32_t & Nclass)
   {
-    const float s = std :: accumulate(TOP, TOP + Nclass, 0.f);
-    float cov_x_y = 0.f;
-    float cov_x_x = 0.f;
-    float cov_y_y = 0.f;
+    const double s = std :: accumulate(TOP, TOP + Nclass, count_type(0));
+    double cov_x_y = 0.;
+    double cov_x_x = 0.;
+    double cov_y_y = 0.;
 
     for (int32_t i = 0; i < Nclass; ++i)
     {
       cov_x_x += TOP[i] * (s - TOP[i]);
       cov_y_y += P[i] *   (s - P[i]);
-      cov_x_y += confusion_matrix[i * Nclass + i] * s - P[i] * TOP[i];
+      cov_x_y += confusion_matrix.at(i, i) * s - static_cast < double >(P[i]) * TOP[i];
     }
 
-    return cov_x_y / (std :: sqrt(cov_y_y * cov_x_x) + epsil);
+    return static_cast < real_t >(cov_x_y / (std :: sqrt(cov_y_y * cov_x_x) + epsil));
   }
   /// @endcond
-} get_overall_MCC;
+} get_overall_MCC __unused;
 
 /**
 * @brief Global performance index
@@ -1231,12 +1499,13 @@ struct // Overall MCC
 struct // RR
 {
   /// @cond DEF
-  auto operator() (const float * TOP, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TOP, const int32_t & Nclass)
   {
-    return std :: accumulate(TOP, TOP + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(TOP, TOP + Nclass, count_type(0))) / Nclass;
   }
   /// @endcond
-} get_RR;
+} get_RR __unused;
 
 /**
 * @brief Class balance accuracy.
@@ -1252,7 +1521,7 @@ struct // RR
 * CBA = sum(confusion_matrix / max(TOP, P)) / abs(C)
 * ```
 *
-* @param confusion_matrix Confusion matrix.
+* @param confusion_matrix Confusion matrix (dense ravel array or sparse_matrix).
 * @param TOP array of positive predicted values for each class.
 * @param P array of number of positive samples for each class.
 * @param Nclass size of classes array (aka number of classes)
@@ -1262,15 +1531,25 @@ struct // RR
 struct // CBA
 {
   /// @cond DEF
-  auto operator() (const float * confusion_matrix, const float * TOP, const float * P, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * confusion_matrix, const count_type * TOP, const count_type * P, const int32_t & Nclass)
+  {
+    double CBA = 0.;
+    for (int32_t i = 0; i < Nclass; ++i)
+      CBA += confusion_matrix[i * Nclass + i] / (static_cast < double >(std :: max(TOP[i], P[i])) + epsil);
+    return static_cast < real_t >(CBA / Nclass);
+  }
+
+  template < typename count_type >
+  real_t operator() (const sparse_matrix & confusion_matrix, const count_type * TOP, const count_type * P, const int32_t & Nclass)
   {
-    float CBA = 0.f;
+    double CBA = 0.;
     for (int32_t i = 0; i < Nclass; ++i)
-      CBA += confusion_matrix[i * Nclass + i] / (std :: max(TOP[i], P[i]) + epsil);
-    return CBA / Nclass;
+      CBA += confusion_matrix.at(i, i) / (static_cast < double >(std :: max(TOP[i], P[i])) + epsil);
+    return static_cast < real_t >(CBA / Nclass);
   }
   /// @endcond
-} get_CBA;
+} get_CBA __unused;
 
 /**
 * @brief AUNU
@@ -1291,12 +1570,12 @@ struct // CBA
 struct // AUNU
 {
   /// @cond DEF
-  auto operator() (const float * AUC, const int32_t & Nclass)
+  auto operator() (const real_t * AUC, const int32_t & Nclass)
   {
-    return std :: accumulate(AUC, AUC + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(AUC, AUC + Nclass, 0.) / Nclass);
   }
   /// @endcond
-} get_AUNU;
+} get_AUNU __unused;
 
 /**
 * @brief AUNP
@@ -1318,15 +1597,16 @@ struct // AUNU
 struct // AUNP
 {
   /// @cond DEF
-  auto operator() (const float * P, const float * POP, const float * AUC, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * P, const count_type * POP, const real_t * AUC, const int32_t & Nclass)
   {
-    float AUNP = 0.f;
+    double AUNP = 0.;
     for (int32_t i = 0; i < Nclass; ++i)
-      AUNP += P[i] / (POP[i] * AUC[i] + epsil);
-    return AUNP;
+      AUNP += P[i] / (static_cast < double >(POP[i]) * AUC[i] + epsil);
+    return static_cast < real_t >(AUNP);
   }
   /// @endcond
-} get_AUNP;
+} get_AUNP __unused;
 
 /**
 * @brief Relative classifier information
@@ -1344,12 +1624,12 @@ struct // AUNP
 struct // RCI
 {
   /// @cond DEF
-  auto operator() (const float & mutual_information, const float & reference_entropy)
+  auto operator() (const real_t & mutual_information, const real_t & reference_entropy)
   {
     return mutual_information / (reference_entropy + epsil);
   }
   /// @endcond
-} get_RCI;
+} get_RCI __unused;
 
 /**
 * @brief Classification success index
@@ -1369,12 +1649,12 @@ struct // RCI
 struct // CSI
 {
   /// @cond DEF
-  auto operator() (const float * ICSI, const int32_t & Nclass)
+  auto operator() (const real_t * ICSI, const int32_t & Nclass)
   {
-    return std :: accumulate(ICSI, ICSI + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(ICSI, ICSI + Nclass, 0.) / Nclass);
   }
   /// @endcond
-} get_CSI;
+} get_CSI __unused;
 
 /**
 * @brief Pearson's C
@@ -1397,12 +1677,13 @@ struct // CSI
 struct // Pearson C
 {
   /// @cond DEF
-  auto operator() (const float & chi_square, const float * POP)
+  template < typename count_type >
+  auto operator() (const real_t & chi_square, const count_type * POP)
   {
     return std :: sqrt (chi_square / (POP[0] + chi_square + epsil));
   }
   /// @endcond
-} get_overall_pearson_C;
+} get_overall_pearson_C __unused;
 
 
 /**
@@ -1423,14 +1704,15 @@ struct // Pearson C
 struct // TPR Micro, PPV Micro, F1 Micro
 {
   /// @cond DEF
-  auto operator() (const float * TP, const float * FN, const int32_t & Nclass)
+  template < typename count_type >
+  auto operator() (const count_type * TP, const count_type * FN, const int32_t & Nclass)
   {
-    const float TP_sum = std :: accumulate(TP, TP + Nclass, 0.f);
-    const float FN_sum = std :: accumulate(FN, FN + Nclass, 0.f);
-    return TP_sum / (TP_sum + FN_sum + epsil);
+    const double TP_sum = std :: accumulate(TP, TP + Nclass, count_type(0));
+    const double FN_sum = std :: accumulate(FN, FN + Nclass, count_type(0));
+    return static_cast < real_t >(TP_sum / (TP_sum + FN_sum + epsil));
   }
   /// @endcond
-} get_TPR_PPV_F1_micro;
+} get_TPR_PPV_F1_micro __unused;
 
 /**
 * @brief Matthews's benchmark
@@ -1452,7 +1734,7 @@ struct // TPR Micro, PPV Micro, F1 Micro
 struct // SOA6(Matthews)
 {
   /// @cond DEF
-  auto operator() (const float & overall_MCC)
+  auto operator() (const real_t & overall_MCC)
   {
     return std :: isnan(overall_MCC) || std :: isinf(overall_MCC) ? -1.f :
                         overall_MCC <  .3f                        ?  0.f :
@@ -1462,7 +1744,7 @@ struct // SOA6(Matthews)
                         4.f;
   }
   /// @endcond
-} get_MCC_analysis;
+} get_MCC_analysis __unused;
 
 /**
 * @brief Cicchetti's benchmark
@@ -1480,7 +1762,7 @@ struct // SOA6(Matthews)
 struct // SOA4(Cicchetti)
 {
   /// @cond DEF
-  auto operator() (const float & overall_kappa)
+  auto operator() (const real_t & overall_kappa)
   {
     return std :: isnan(overall_kappa) || std :: isinf(overall_kappa)  ? -1.f :
                         overall_kappa <   .4f                          ?  0.f :
@@ -1490,7 +1772,7 @@ struct // SOA4(Cicchetti)
                         0.f;
   }
   /// @endcond
-} get_kappa_analysis_cicchetti;
+} get_kappa_analysis_cicchetti __unused;
 
 /**
 * @brief Landis & Koch's benchmark
@@ -1510,7 +1792,7 @@ struct // SOA4(Cicchetti)
 struct // SOA1(Landis & Koch)
 {
   /// @cond DEF
-  auto operator() (const float & overall_kappa)
+  auto operator() (const real_t & overall_kappa)
   {
     return std :: isnan(overall_kappa) || std :: isinf(overall_kappa) ? -1.f :
                         overall_kappa <  .0f                          ?  0.f :
@@ -1522,7 +1804,7 @@ struct // SOA1(Landis & Koch)
                         0.f;
   }
   /// @endcond
-} get_kappa_analysis_koch;
+} get_kappa_analysis_koch __unused;
 
 /**
 * @brief Fleiss' benchmark
@@ -1539,7 +1821,7 @@ struct // SOA1(Landis & Koch)
 struct // SOA2(Fleiss)
 {
   /// @cond DEF
-  auto operator() (const float & overall_kappa)
+  auto operator() (const real_t & overall_kappa)
   {
     return std :: isnan(overall_kappa) || std :: isinf(overall_kappa) ? -1.f :
                         overall_kappa <  .4f                          ?  0.f :
@@ -1548,7 +1830,7 @@ struct // SOA2(Fleiss)
                         0.f;
   }
   /// @endcond
-} get_kappa_analysis_fleiss;
+} get_kappa_analysis_fleiss __unused;
 
 /**
 * @brief Altman's benchmark
@@ -1567,7 +1849,7 @@ struct // SOA2(Fleiss)
 struct // SOA3(Altman)
 {
   /// @cond DEF
-  auto operator() (const float & overall_kappa)
+  auto operator() (const real_t & overall_kappa)
   {
     return std :: isnan(overall_kappa) || std :: isinf(overall_kappa) ? -1.f :
                         overall_kappa <  .2f                          ?  0.f :
@@ -1578,7 +1860,7 @@ struct // SOA3(Altman)
                         0.f;
   }
   /// @endcond
-} get_kappa_analysis_altman;
+} get_kappa_analysis_altman __unused;
 
 /**
 * @brief Cramer's benchmark
@@ -1598,7 +1880,7 @@ struct // SOA3(Altman)
 struct // SOA5(Cramer)
 {
   /// @cond DEF
-  auto operator() (const float & cramer_V)
+  auto operator() (const real_t & cramer_V)
   {
     return cramer_V <                    .1f ? 0.f :
            cramer_V >= .1f && cramer_V < .2f ? 1.f :
@@ -1608,7 +1890,7 @@ struct // SOA5(Cramer)
            5.f;
   }
   /// @endcond
-} get_V_analysis;
+} get_V_analysis __unused;
 
 /**
 * @brief TPR_Macro
@@ -1626,12 +1908,12 @@ struct // SOA5(Cramer)
 struct // TPR Macro
 {
   /// @cond DEF
-  auto operator() (const float * TPR, const int32_t & Nclass)
+  auto operator() (const real_t * TPR, const int32_t & Nclass)
   {
-    return std :: accumulate(TPR, TPR + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(TPR, TPR + Nclass, 0.) / Nclass);
   }
   /// @endcond
-} get_TPR_macro;
+} get_TPR_macro __unused;
 
 /**
 * @brief PPV_Macro
@@ -1649,12 +1931,12 @@ struct // TPR Macro
 struct // PPV Macro
 {
   /// @cond DEF
-  auto operator() (const float * PPV, const int32_t & Nclass)
+  auto operator() (const real_t * PPV, const int32_t & Nclass)
   {
-    return std :: accumulate(PPV, PPV + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(PPV, PPV + Nclass, 0.) / Nclass);
   }
   /// @endcond
-} get_PPV_macro;
+} get_PPV_macro __unused;
 
 /**
 * @brief ACC_Macro
@@ -1672,12 +1954,12 @@ struct // PPV Macro
 struct // ACC Macro
 {
   /// @cond DEF
-  auto operator() (const float * ACC, const int32_t & Nclass)
+  auto operator() (const real_t * ACC, const int32_t & Nclass)
   {
-    return std :: accumulate(ACC, ACC + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(ACC, ACC + Nclass, 0.) / Nclass);
   }
   /// @endcond
-} get_ACC_macro;
+} get_ACC_macro __unused;
 
 /**
 * @brief F1_Macro
@@ -1695,12 +1977,12 @@ struct // ACC Macro
 struct // F1 Macro
 {
   /// @cond DEF
-  auto operator() (const float * F1_SCORE, const int32_t & Nclass)
+  auto operator() (const real_t * F1_SCORE, const int32_t & Nclass)
   {
-    return std :: accumulate(F1_SCORE, F1_SCORE + Nclass, 0.f) / Nclass;
+    return static_cast < real_t >(std :: accumulate(F1_SCORE, F1_SCORE + Nclass, 0.) / Nclass);
   }
   /// @endcond
-} get_F1_macro;
+} get_F1_macro __unused;
 
 
 
@@ -0,0 +1,196 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __parallel_utils_h__
+#define __parallel_utils_h__
+
+#include <cstdint>    // int32_t
+#include <algorithm>  // std :: min
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+/// @cond DEF
+#if defined(_OPENMP) && _OPENMP >= 200805 // OpenMP 3.0
+  #define __omp_tasks__
+#endif
+
+#if defined(_OPENMP) && _OPENMP >= 201307 // OpenMP 4.0
+  #define __omp_depend__
+#endif
+
+constexpr int32_t cache_line = 64; ///< size (in bytes) of a cache line
+/// @endcond
+
+/**
+* @brief Number of threads available for a data-parallel loop.
+*
+* @details If the function is called inside an active parallel region the
+* size of the current team is returned, otherwise the maximum number of
+* threads which can be used by a new parallel region.
+*
+* @return The number of workers.
+*/
+inline int32_t num_workers ()
+{
+#ifdef _OPENMP
+  return omp_in_parallel() ? omp_get_num_threads() : omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+/**
+* @brief Number of chunks in which a data-parallel loop must be split.
+*
+* @param size number of items to process
+* @param grain minimum number of items for each chunk
+*
+* @return The number of chunks (at least 1 and at most num_workers()).
+*/
+inline int32_t num_chunks (const int64_t & size, const int64_t & grain)
+{
+  return static_cast < int32_t >(std :: max(int64_t(1), std :: min(static_cast < int64_t >(num_workers()), size / grain)));
+}
+
+/**
+* @brief Begin of the i-th chunk of a range split into nchunks balanced parts.
+*
+* @param size number of items in the range
+* @param i chunk index
+* @param nchunks number of chunks
+*
+* @return The index of the first item of the chunk.
+*/
+inline int64_t chunk_begin (const int64_t & size, const int32_t & i, const int32_t & nchunks)
+{
+  return size * i / nchunks;
+}
+
+/**
+* @brief Run func(i) for each i in [0, nchunks) in parallel.
+*
+* @details If the function is called by a thread of an active team
+* (e.g. inside an omp section of scorer :: compute_score) the chunks
+* are spawned as tasks which are picked up by the idle threads of the team.
+* Otherwise a new parallel region is opened.
+* Without OpenMP (or with OpenMP < 3.0 inside a parallel region) the chunks
+* are processed serially.
+*
+* @tparam Func function type with signature void (int32_t)
+* @param nchunks number of chunks
+* @param func function to apply to each chunk index
+*
+*/
+template < typename Func >
+void parallel_chunks (const int32_t & nchunks, Func && func)
+{
+  if ( nchunks <= 1 )
+  {
+    for (int32_t i = 0; i < nchunks; ++i)
+      func(i);
+    return;
+  }
+
+#ifdef _OPENMP
+
+  if ( omp_in_parallel() )
+  {
+#ifdef __omp_tasks__
+
+    for (int32_t i = 0; i < nchunks; ++i)
+    {
+#pragma omp task firstprivate (i) shared (func)
+      func(i);
+    }
+
+#pragma omp taskwait
+
+#else
+
+    for (int32_t i = 0; i < nchunks; ++i)
+      func(i);
+
+#endif
+  }
+  else
+  {
+#pragma omp parallel for num_threads (nchunks) schedule (static, 1)
+    for (int32_t i = 0; i < nchunks; ++i)
+      func(i);
+  }
+
+#else
+
+  for (int32_t i = 0; i < nchunks; ++i)
+    func(i);
+
+#endif
+}
+
+/**
+* @brief Run func() with the current thread only.
+*
+* @details The function runs in a new team of one thread, so the worksharing
+* constructs of a scorer evaluation (e.g. the omp sections of scorer :: compute_score)
+* bind to that team and not to the team of the caller. This is how a single
+* evaluation is performed by each chunk of parallel_chunks.
+*
+* @tparam Func function type with signature void ()
+* @param func function to apply
+*
+*/
+template < typename Func >
+void serial_team (Func && func)
+{
+#ifdef _OPENMP
+#pragma omp parallel num_threads (1)
+#endif
+  func();
+}
+
+/**
+* @brief Seed of the random engine of the r-th replicate.
+*
+* @details Each replicate (e.g. a bootstrap resampling or a permutation) draws
+* from its own random engine, so the results do not depend on the number of
+* threads nor on the split of the replicates in chunks. The seeds are spaced
+* by the 64-bit golden ratio, so consecutive replicates get well separated seeds.
+*
+* @param seed global seed
+* @param r index of the replicate
+*
+* @return The seed of the replicate.
+*/
+inline uint64_t replicate_seed (const uint64_t & seed, const int64_t & r)
+{
+  return seed + 0x9E3779B97F4A7C15ULL * static_cast < uint64_t >(r + 1);
+}
+
+#endif // __parallel_utils_h__
@@ -0,0 +1,372 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __permutation_test_h__
+#define __permutation_test_h__
+
+#include <memory>           // std :: unique_ptr
+#include <vector>           // std :: vector
+#include <string>           // std :: string
+#include <random>           // std :: mt19937_64
+#include <algorithm>        // std :: set_union
+#include <iterator>         // std :: back_inserter
+#include <cmath>            // std :: abs
+#include <limits>           // std :: numeric_limits
+#include <cstdint>          // int32_t
+
+#include <scorer.h>         // scorer
+#include <label_map.h>      // label_map
+#include <unique_labels.h>  // unique_labels
+#include <stat_selection.h> // stat_selection
+#include <parallel_utils.h> // parallel_chunks, serial_team, replicate_seed
+
+/**
+* @class permutation_test
+* @brief Paired permutation test for the comparison of two classifiers on the same labels.
+*
+* @details Under the null hypothesis the two predictions of each sample are
+* exchangeable, so each permutation swaps the predictions of every sample with
+* probability 1/2 and the statistic of the test is the difference (B - A) of the
+* scores. Only the samples with different predictions change the confusion
+* matrices, and their swaps are applied as updates of the two observed matrices:
+* the samples are grouped by (true, pred A, pred B) and the number of swaps of
+* each group is a binomial draw. So the cost of a permutation depends only on the
+* number of classes, not on the number of samples.
+* The p-value is the (two-sided) fraction of permutations with an absolute
+* difference not smaller than the observed one, i.e. (count + 1) / (n_perm + 1).
+* Each permutation draws from its own random engine (see replicate_seed).
+*
+*/
+class permutation_test
+{
+
+  std :: vector < std :: unique_ptr < scorer > > workers; ///< scorers (A and B) of each chunk of permutations
+
+  stat_selection stats; ///< statistics to compare
+
+  std :: vector < count_t > observed;  ///< observed confusion matrices of A and B (2 * Nclass * Nclass)
+  std :: vector < count_t > permuted;  ///< permuted confusion matrices of each chunk
+  std :: vector < int64_t > groups;    ///< discordant samples as (true, pred A, pred B) cell indexes
+  std :: vector < count_t > sizes;     ///< number of samples of each group
+  std :: vector < int64_t > counts;    ///< number of extreme permutations of each value and chunk
+
+  std :: vector < double > diff;    ///< observed differences (B - A)
+  std :: vector < double > work;    ///< values of the statistics of each chunk (A and B)
+  std :: vector < real_t > pvalues; ///< p-values of the differences
+
+  std :: vector < float > classes; ///< classes of the labels
+
+  int32_t n_perm; ///< number of permutations
+  uint64_t seed;  ///< seed of the random engines
+
+public:
+
+  /**
+  * @brief Construct the permutation test.
+  *
+  * @param n_perm number of permutations
+  * @param seed seed of the random engines
+  *
+  */
+  permutation_test (const int32_t & n_perm = 1000, const uint64_t & seed = 42) : n_perm (n_perm), seed (seed)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~permutation_test () = default;
+
+  /**
+  * @brief Select the statistics to compare.
+  *
+  * @details Only the selected statistics (and their dependencies) are evaluated by
+  * the permutations. An empty list selects all the class and overall statistics.
+  *
+  * @param metrics names of the statistics (as the members of scorer, e.g. overall_MCC or F1_macro)
+  *
+  * @return False if some name is not a score (the selection is not modified).
+  */
+  bool select (const std :: vector < std :: string > & metrics)
+  {
+    return this->stats.select(metrics);
+  }
+
+  /**
+  * @brief Compute the p-values of the differences between the two predictions.
+  *
+  * @details As scorer :: compute_score the function can be called by all the
+  * threads of a parallel region: the permutations are distributed over the team.
+  * Outside a parallel region a new one is opened.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred_a array of labels predicted by the first classifier (A)
+  * @param lbl_pred_b array of labels predicted by the second classifier (B)
+  * @param n_lbl size of the label arrays
+  *
+  */
+  void compute (const int32_t * lbl_true, const int32_t * lbl_pred_a, const int32_t * lbl_pred_b, const int32_t & n_lbl)
+  {
+#ifdef _OPENMP
+#pragma omp single
+#endif
+    {
+      this->prepare(lbl_true, lbl_pred_a, lbl_pred_b, n_lbl);
+
+      const int32_t Nclass = static_cast < int32_t >(this->classes.size());
+      const int64_t Ncell = static_cast < int64_t >(Nclass) * Nclass;
+
+      this->stats.layout(Nclass);
+
+      const int32_t n_values = this->stats.values();
+      const int32_t nchunks = num_chunks(this->n_perm, 1);
+
+      while ( static_cast < int32_t >(this->workers.size()) < 2 * nchunks )
+        this->workers.emplace_back(new scorer());
+
+      this->permuted.resize(2 * Ncell * nchunks);
+      this->work.resize(2 * static_cast < int64_t >(n_values) * nchunks);
+      this->counts.assign(static_cast < int64_t >(n_values) * nchunks, 0);
+      this->diff.resize(n_values);
+
+      // observed differences
+      {
+        scorer & score_a = *this->workers[0];
+        scorer & score_b = *this->workers[1];
+
+        score_a.select(this->stats.names());
+        score_b.select(this->stats.names());
+
+        serial_team([&]
+        {
+          score_a.compute_from_confusion_matrix(this->observed.data(), Nclass, this->classes.data());
+          score_b.compute_from_confusion_matrix(this->observed.data() + Ncell, Nclass, this->classes.data());
+        });
+
+        double * values = this->work.data();
+
+        this->stats.extract(score_a, values);
+        this->stats.extract(score_b, values + n_values);
+
+        for (int32_t v = 0; v < n_values; ++v)
+          this->diff[v] = values[n_values + v] - values[v];
+      }
+
+      parallel_chunks(nchunks, [&] (const int32_t & c)
+      {
+        scorer & score_a = *this->workers[2 * c];
+        scorer & score_b = *this->workers[2 * c + 1];
+
+        score_a.select(this->stats.names());
+        score_b.select(this->stats.names());
+
+        count_t * cm_a = this->permuted.data() + 2 * Ncell * c;
+        count_t * cm_b = cm_a + Ncell;
+
+        double * values = this->work.data() + 2 * static_cast < int64_t >(n_values) * c;
+        int64_t * count = this->counts.data() + static_cast < int64_t >(n_values) * c;
+
+        const int64_t end = chunk_begin(this->n_perm, c + 1, nchunks);
+
+        for (int64_t r = chunk_begin(this->n_perm, c, nchunks); r < end; ++r)
+        {
+          this->permute(Nclass, r, cm_a, cm_b);
+
+          serial_team([&]
+          {
+            score_a.compute_from_confusion_matrix(cm_a, Nclass, this->classes.data());
+            score_b.compute_from_confusion_matrix(cm_b, Nclass, this->classes.data());
+          });
+
+          this->stats.extract(score_a, values);
+          this->stats.extract(score_b, values + n_values);
+
+          for (int32_t v = 0; v < n_values; ++v)
+            // the tolerance avoids to miss the permutations equivalent to the observed one
+            if ( std :: abs(values[n_values + v] - values[v]) >= std :: abs(this->diff[v]) * (1. - 1e-6) )
+              ++ count[v];
+        }
+      });
+
+      this->pvalues.resize(n_values);
+
+      for (int32_t v = 0; v < n_values; ++v)
+      {
+        int64_t extreme = 0;
+
+        for (int32_t c = 0; c < nchunks; ++c)
+          extreme += this->counts[static_cast < int64_t >(n_values) * c + v];
+
+        this->pvalues[v] = std :: isnan(this->diff[v]) ? std :: numeric_limits < real_t > :: quiet_NaN()
+                                                       : static_cast < real_t >(extreme + 1) / (this->n_perm + 1);
+      }
+    }
+  }
+
+  /**
+  * @brief P-values of a statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return Pointer to the p-values (Nclass values for the class statistics, 1 for the overall ones)
+  * or nullptr if the statistic was not compared.
+  */
+  const real_t * p_value (const std :: string & name) const
+  {
+    const int32_t v = this->stats.find(name);
+    return v < 0 ? nullptr : this->pvalues.data() + v;
+  }
+
+  /**
+  * @brief Observed differences (B - A) of a statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return Pointer to the differences (Nclass values for the class statistics, 1 for the overall ones)
+  * or nullptr if the statistic was not compared.
+  */
+  const double * difference (const std :: string & name) const
+  {
+    const int32_t v = this->stats.find(name);
+    return v < 0 ? nullptr : this->diff.data() + v;
+  }
+
+  /**
+  * @brief Number of values of a compared statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return The number of values (0 if the statistic was not compared).
+  */
+  int32_t size (const std :: string & name) const
+  {
+    return this->stats.size(name);
+  }
+
+private:
+
+  /**
+  * @brief Compute the observed confusion matrices and the groups of discordant samples.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred_a array of labels predicted by A
+  * @param lbl_pred_b array of labels predicted by B
+  * @param n_lbl size of the label arrays
+  *
+  */
+  void prepare (const int32_t * lbl_true, const int32_t * lbl_pred_a, const int32_t * lbl_pred_b, const int32_t & n_lbl)
+  {
+    const std :: vector < int32_t > labels_a = unique_labels(lbl_true, lbl_pred_a, n_lbl);
+    const std :: vector < int32_t > labels_b = unique_labels(lbl_true, lbl_pred_b, n_lbl);
+
+    this->classes.clear();
+    std :: set_union(labels_a.begin(), labels_a.end(), labels_b.begin(), labels_b.end(), std :: back_inserter(this->classes));
+
+    const int32_t Nclass = static_cast < int32_t >(this->classes.size());
+    const int64_t Ncell = static_cast < int64_t >(Nclass) * Nclass;
+
+    const label_map lut (this->classes.data(), Nclass);
+
+    this->observed.assign(2 * Ncell, count_t(0));
+    this->groups.clear();
+
+    count_t * cm_a = this->observed.data();
+    count_t * cm_b = cm_a + Ncell;
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      const int64_t t = lut[lbl_true[i]];
+      const int64_t a = lut[lbl_pred_a[i]];
+      const int64_t b = lut[lbl_pred_b[i]];
+
+      ++ cm_a[t * Nclass + a];
+      ++ cm_b[t * Nclass + b];
+
+      if ( a != b )
+        this->groups.push_back((t * Nclass + a) * Nclass + b);
+    }
+
+    // run-length encoding of the sorted groups
+    std :: sort(this->groups.begin(), this->groups.end());
+
+    this->sizes.clear();
+    int64_t n_groups = 0;
+
+    for (std :: size_t i = 0; i < this->groups.size(); ++i)
+    {
+      if ( i && this->groups[i] == this->groups[n_groups - 1] )
+        ++ this->sizes.back();
+      else
+      {
+        this->groups[n_groups++] = this->groups[i];
+        this->sizes.push_back(1);
+      }
+    }
+
+    this->groups.resize(n_groups);
+  }
+
+  /**
+  * @brief Swap a random subset of the discordant predictions.
+  *
+  * @param Nclass number of classes
+  * @param r index of the permutation
+  * @param cm_a permuted confusion matrix of A
+  * @param cm_b permuted confusion matrix of B
+  *
+  */
+  void permute (const int32_t & Nclass, const int64_t & r, count_t * cm_a, count_t * cm_b) const
+  {
+    const int64_t Ncell = static_cast < int64_t >(Nclass) * Nclass;
+
+    std :: copy_n(this->observed.data(), Ncell, cm_a);
+    std :: copy_n(this->observed.data() + Ncell, Ncell, cm_b);
+
+    std :: mt19937_64 engine (replicate_seed(this->seed, r));
+
+    for (std :: size_t g = 0; g < this->groups.size(); ++g)
+    {
+      std :: binomial_distribution < int64_t > draw (static_cast < int64_t >(this->sizes[g]), .5);
+      const count_t swaps = static_cast < count_t >(draw(engine));
+
+      const int64_t b = this->groups[g] % Nclass;
+      const int64_t a = this->groups[g] / Nclass % Nclass;
+      const int64_t t = this->groups[g] / Ncell;
+
+      // the swapped samples move from (t, a) to (t, b) for A and vice versa for B
+      cm_a[t * Nclass + a] -= swaps;
+      cm_a[t * Nclass + b] += swaps;
+      cm_b[t * Nclass + b] -= swaps;
+      cm_b[t * Nclass + a] += swaps;
+    }
+  }
+
+};
+
+#endif // __permutation_test_h__
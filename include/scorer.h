@@ -10,155 +10,318 @@
 #include <fstream>
 #include <cassert>
 #include <vector>
+#include <string>
+#include <bitset>
 #include <algorithm>
 #include <iterator>
+#include <numeric>
 #include <unordered_set>
+#include <type_traits>
+#include <stats_types.h>
+#include <column_arena.h>
+#include <label_map.h>
+#include <confusion_accumulator.h>
+#include <sparse_matrix.h>
 
 
 
+/// @cond DEF
+inline namespace __scorer_abi__
+{
+/// @endcond
+
 /**
-* @class scorer
+* @class basic_scorer
 * @brief Abstract type which stores the full list of scores and allows their evaluation using parallel environment
 *
 * @details Each member of the class represents a different score (class statistics and overall statistics).
+* The counters (confusion matrix, TP, FN, FP, TN, ...) are stored as count_type: the scorer of the labels
+* (scorer) uses exact integer counts, while the weighted_scorer uses real-valued counts, i.e. the
+* confusion matrices of weighted samples (e.g. see decayed_accumulator).
+*
+* @tparam count_type data type of the counters
 *
 */
-struct scorer
+template < typename count_type >
+struct basic_scorer
 {
-	std :: unique_ptr < float[] > confusion_matrix; ///< confusion_matrix array
-	std :: unique_ptr < float[] > TP; ///< TP array
-	std :: unique_ptr < float[] > FN; ///< FN array
-	std :: unique_ptr < float[] > FP; ///< FP array
-	std :: unique_ptr < float[] > TN; ///< TN array
-	std :: unique_ptr < float[] > POP; ///< POP array
-	std :: unique_ptr < float[] > P; ///< P array
-	std :: unique_ptr < float[] > N; ///< N array
-	std :: unique_ptr < float[] > TOP; ///< TOP array
-	std :: unique_ptr < float[] > TON; ///< TON array
-	std :: unique_ptr < float[] > TPR; ///< TPR array
-	std :: unique_ptr < float[] > TNR; ///< TNR array
-	std :: unique_ptr < float[] > PPV; ///< PPV array
-	std :: unique_ptr < float[] > NPV; ///< NPV array
-	std :: unique_ptr < float[] > FNR; ///< FNR array
-	std :: unique_ptr < float[] > FPR; ///< FPR array
-	std :: unique_ptr < float[] > FDR; ///< FDR array
-	std :: unique_ptr < float[] > FOR; ///< FOR array
-	std :: unique_ptr < float[] > ACC; ///< ACC array
-	std :: unique_ptr < float[] > F1_SCORE; ///< F1_SCORE array
-	std :: unique_ptr < float[] > F05_SCORE; ///< F05_SCORE array
-	std :: unique_ptr < float[] > F2_SCORE; ///< F2_SCORE array
-	std :: unique_ptr < float[] > MCC; ///< MCC array
-	std :: unique_ptr < float[] > BM; ///< BM array
-	std :: unique_ptr < float[] > MK; ///< MK array
-	std :: unique_ptr < float[] > ICSI; ///< ICSI array
-	std :: unique_ptr < float[] > PLR; ///< PLR array
-	std :: unique_ptr < float[] > NLR; ///< NLR array
-	std :: unique_ptr < float[] > DOR; ///< DOR array
-	std :: unique_ptr < float[] > PRE; ///< PRE array
-	std :: unique_ptr < float[] > G; ///< G array
-	std :: unique_ptr < float[] > RACC; ///< RACC array
-	std :: unique_ptr < float[] > ERR_ACC; ///< ERR_ACC array
-	std :: unique_ptr < float[] > RACCU; ///< RACCU array
-	std :: unique_ptr < float[] > jaccard_index; ///< jaccard_index array
-	std :: unique_ptr < float[] > IS; ///< IS array
-	std :: unique_ptr < float[] > CEN; ///< CEN array
-	std :: unique_ptr < float[] > MCEN; ///< MCEN array
-	std :: unique_ptr < float[] > AUC; ///< AUC array
-	std :: unique_ptr < float[] > dIND; ///< dIND array
-	std :: unique_ptr < float[] > sIND; ///< sIND array
-	std :: unique_ptr < float[] > DP; ///< DP array
-	std :: unique_ptr < float[] > Y; ///< Y array
-	std :: unique_ptr < float[] > PLRI; ///< PLRI array
-	std :: unique_ptr < float[] > NLRI; ///< NLRI array
-	std :: unique_ptr < float[] > DPI; ///< DPI array
-	std :: unique_ptr < float[] > AUCI; ///< AUCI array
-	std :: unique_ptr < float[] > GI; ///< GI array
-	std :: unique_ptr < float[] > LS; ///< LS array
-	std :: unique_ptr < float[] > AM; ///< AM array
-	std :: unique_ptr < float[] > OP; ///< OP array
-	std :: unique_ptr < float[] > IBA; ///< IBA array
-	std :: unique_ptr < float[] > GM; ///< GM array
-	std :: unique_ptr < float[] > Q; ///< Q array
-	std :: unique_ptr < float[] > AGM; ///< AGM array
-	std :: unique_ptr < float[] > MCCI; ///< MCCI array
-	std :: unique_ptr < float[] > AGF; ///< AGF array
-	std :: unique_ptr < float[] > OC; ///< OC array
-	std :: unique_ptr < float[] > OOC; ///< OOC array
-	std :: unique_ptr < float[] > AUPR; ///< AUPR array
-	std :: unique_ptr < float[] > BCD; ///< BCD array
-	float overall_accuracy; ///< overall_accuracy value
-	float overall_random_accuracy_unbiased; ///< overall_random_accuracy_unbiased value
-	float overall_random_accuracy; ///< overall_random_accuracy value
-	float overall_kappa; ///< overall_kappa value
-	float PC_PI; ///< PC_PI value
-	float PC_AC1; ///< PC_AC1 value
-	float PC_S; ///< PC_S value
-	float PI; ///< PI value
-	float AC1; ///< AC1 value
-	float S; ///< S value
-	float kappa_SE; ///< kappa_SE value
-	float kappa_unbiased; ///< kappa_unbiased value
-	float kappa_no_prevalence; ///< kappa_no_prevalence value
-	float kappa_CI_up; ///< kappa_CI_up value
-	float kappa_CI_down; ///< kappa_CI_down value
-	float overall_accuracy_se; ///< overall_accuracy_se value
-	float overall_accuracy_ci_up; ///< overall_accuracy_ci_up value
-	float overall_accuracy_ci_down; ///< overall_accuracy_ci_down value
-	float chi_square; ///< chi_square value
-	float phi_square; ///< phi_square value
-	float cramer_V; ///< cramer_V value
-	float response_entropy; ///< response_entropy value
-	float reference_entropy; ///< reference_entropy value
-	float cross_entropy; ///< cross_entropy value
-	float join_entropy; ///< join_entropy value
-	float conditional_entropy; ///< conditional_entropy value
-	float mutual_information; ///< mutual_information value
-	float kl_divergence; ///< kl_divergence value
-	float lambda_B; ///< lambda_B value
-	float lambda_A; ///< lambda_A value
-	float DF; ///< DF value
-	float overall_jaccard_index; ///< overall_jaccard_index value
-	float hamming_loss; ///< hamming_loss value
-	float zero_one_loss; ///< zero_one_loss value
-	float NIR; ///< NIR value
-	float p_value; ///< p_value value
-	float overall_CEN; ///< overall_CEN value
-	float overall_MCEN; ///< overall_MCEN value
-	float overall_MCC; ///< overall_MCC value
-	float RR; ///< RR value
-	float CBA; ///< CBA value
-	float AUNU; ///< AUNU value
-	float AUNP; ///< AUNP value
-	float RCI; ///< RCI value
-	float CSI; ///< CSI value
-	float overall_pearson_C; ///< overall_pearson_C value
-	float TPR_PPV_F1_micro; ///< TPR_PPV_F1_micro value
-	float MCC_analysis; ///< MCC_analysis value
-	float kappa_analysis_cicchetti; ///< kappa_analysis_cicchetti value
-	float kappa_analysis_koch; ///< kappa_analysis_koch value
-	float kappa_analysis_fleiss; ///< kappa_analysis_fleiss value
-	float kappa_analysis_altman; ///< kappa_analysis_altman value
-	float V_analysis; ///< V_analysis value
-	float TPR_macro; ///< TPR_macro value
-	float PPV_macro; ///< PPV_macro value
-	float ACC_macro; ///< ACC_macro value
-	float F1_macro; ///< F1_macro value
+	count_type * confusion_matrix = nullptr; ///< confusion_matrix array (view of the arena)
+	count_type * marginals = nullptr; ///< marginals array (view of the arena)
+	count_type * TP = nullptr; ///< TP array (view of the arena)
+	count_type * FN = nullptr; ///< FN array (view of the arena)
+	count_type * FP = nullptr; ///< FP array (view of the arena)
+	count_type * TN = nullptr; ///< TN array (view of the arena)
+	count_type * POP = nullptr; ///< POP array (view of the arena)
+	count_type * P = nullptr; ///< P array (view of the arena)
+	count_type * N = nullptr; ///< N array (view of the arena)
+	count_type * TOP = nullptr; ///< TOP array (view of the arena)
+	count_type * TON = nullptr; ///< TON array (view of the arena)
+	real_t * TPR = nullptr; ///< TPR array (view of the arena)
+	real_t * TNR = nullptr; ///< TNR array (view of the arena)
+	real_t * PPV = nullptr; ///< PPV array (view of the arena)
+	real_t * NPV = nullptr; ///< NPV array (view of the arena)
+	real_t * FNR = nullptr; ///< FNR array (view of the arena)
+	real_t * FPR = nullptr; ///< FPR array (view of the arena)
+	real_t * FDR = nullptr; ///< FDR array (view of the arena)
+	real_t * FOR = nullptr; ///< FOR array (view of the arena)
+	real_t * ACC = nullptr; ///< ACC array (view of the arena)
+	real_t * F1_SCORE = nullptr; ///< F1_SCORE array (view of the arena)
+	real_t * F05_SCORE = nullptr; ///< F05_SCORE array (view of the arena)
+	real_t * F2_SCORE = nullptr; ///< F2_SCORE array (view of the arena)
+	real_t * MCC = nullptr; ///< MCC array (view of the arena)
+	real_t * BM = nullptr; ///< BM array (view of the arena)
+	real_t * MK = nullptr; ///< MK array (view of the arena)
+	real_t * ICSI = nullptr; ///< ICSI array (view of the arena)
+	real_t * PLR = nullptr; ///< PLR array (view of the arena)
+	real_t * NLR = nullptr; ///< NLR array (view of the arena)
+	real_t * DOR = nullptr; ///< DOR array (view of the arena)
+	real_t * PRE = nullptr; ///< PRE array (view of the arena)
+	real_t * G = nullptr; ///< G array (view of the arena)
+	real_t * RACC = nullptr; ///< RACC array (view of the arena)
+	real_t * ERR_ACC = nullptr; ///< ERR_ACC array (view of the arena)
+	real_t * RACCU = nullptr; ///< RACCU array (view of the arena)
+	real_t * jaccard_index = nullptr; ///< jaccard_index array (view of the arena)
+	real_t * IS = nullptr; ///< IS array (view of the arena)
+	real_t * CEN = nullptr; ///< CEN array (view of the arena)
+	real_t * MCEN = nullptr; ///< MCEN array (view of the arena)
+	real_t * AUC = nullptr; ///< AUC array (view of the arena)
+	real_t * dIND = nullptr; ///< dIND array (view of the arena)
+	real_t * sIND = nullptr; ///< sIND array (view of the arena)
+	real_t * DP = nullptr; ///< DP array (view of the arena)
+	real_t * Y = nullptr; ///< Y array (view of the arena)
+	real_t * PLRI = nullptr; ///< PLRI array (view of the arena)
+	real_t * NLRI = nullptr; ///< NLRI array (view of the arena)
+	real_t * DPI = nullptr; ///< DPI array (view of the arena)
+	real_t * AUCI = nullptr; ///< AUCI array (view of the arena)
+	real_t * GI = nullptr; ///< GI array (view of the arena)
+	real_t * LS = nullptr; ///< LS array (view of the arena)
+	real_t * AM = nullptr; ///< AM array (view of the arena)
+	real_t * OP = nullptr; ///< OP array (view of the arena)
+	real_t * IBA = nullptr; ///< IBA array (view of the arena)
+	real_t * GM = nullptr; ///< GM array (view of the arena)
+	real_t * Q = nullptr; ///< Q array (view of the arena)
+	real_t * AGM = nullptr; ///< AGM array (view of the arena)
+	real_t * MCCI = nullptr; ///< MCCI array (view of the arena)
+	real_t * AGF = nullptr; ///< AGF array (view of the arena)
+	real_t * OC = nullptr; ///< OC array (view of the arena)
+	real_t * OOC = nullptr; ///< OOC array (view of the arena)
+	real_t * AUPR = nullptr; ///< AUPR array (view of the arena)
+	real_t * BCD = nullptr; ///< BCD array (view of the arena)
+	real_t overall_accuracy; ///< overall_accuracy value
+	real_t overall_random_accuracy_unbiased; ///< overall_random_accuracy_unbiased value
+	real_t overall_random_accuracy; ///< overall_random_accuracy value
+	real_t overall_kappa; ///< overall_kappa value
+	real_t PC_PI; ///< PC_PI value
+	real_t PC_AC1; ///< PC_AC1 value
+	real_t PC_S; ///< PC_S value
+	real_t PI; ///< PI value
+	real_t AC1; ///< AC1 value
+	real_t S; ///< S value
+	real_t kappa_SE; ///< kappa_SE value
+	real_t kappa_unbiased; ///< kappa_unbiased value
+	real_t kappa_no_prevalence; ///< kappa_no_prevalence value
+	real_t kappa_CI_up; ///< kappa_CI_up value
+	real_t kappa_CI_down; ///< kappa_CI_down value
+	real_t overall_accuracy_se; ///< overall_accuracy_se value
+	real_t overall_accuracy_ci_up; ///< overall_accuracy_ci_up value
+	real_t overall_accuracy_ci_down; ///< overall_accuracy_ci_down value
+	real_t chi_square; ///< chi_square value
+	real_t phi_square; ///< phi_square value
+	real_t cramer_V; ///< cramer_V value
+	real_t response_entropy; ///< response_entropy value
+	real_t reference_entropy; ///< reference_entropy value
+	real_t cross_entropy; ///< cross_entropy value
+	real_t join_entropy; ///< join_entropy value
+	real_t conditional_entropy; ///< conditional_entropy value
+	real_t mutual_information; ///< mutual_information value
+	real_t kl_divergence; ///< kl_divergence value
+	real_t lambda_B; ///< lambda_B value
+	real_t lambda_A; ///< lambda_A value
+	real_t DF; ///< DF value
+	real_t overall_jaccard_index; ///< overall_jaccard_index value
+	real_t hamming_loss; ///< hamming_loss value
+	real_t zero_one_loss; ///< zero_one_loss value
+	real_t NIR; ///< NIR value
+	real_t p_value; ///< p_value value
+	real_t overall_CEN; ///< overall_CEN value
+	real_t overall_MCEN; ///< overall_MCEN value
+	real_t overall_MCC; ///< overall_MCC value
+	real_t RR; ///< RR value
+	real_t CBA; ///< CBA value
+	real_t AUNU; ///< AUNU value
+	real_t AUNP; ///< AUNP value
+	real_t RCI; ///< RCI value
+	real_t CSI; ///< CSI value
+	real_t overall_pearson_C; ///< overall_pearson_C value
+	real_t TPR_PPV_F1_micro; ///< TPR_PPV_F1_micro value
+	real_t MCC_analysis; ///< MCC_analysis value
+	real_t kappa_analysis_cicchetti; ///< kappa_analysis_cicchetti value
+	real_t kappa_analysis_koch; ///< kappa_analysis_koch value
+	real_t kappa_analysis_fleiss; ///< kappa_analysis_fleiss value
+	real_t kappa_analysis_altman; ///< kappa_analysis_altman value
+	real_t V_analysis; ///< V_analysis value
+	real_t TPR_macro; ///< TPR_macro value
+	real_t PPV_macro; ///< PPV_macro value
+	real_t ACC_macro; ///< ACC_macro value
+	real_t F1_macro; ///< F1_macro value
 
 	std :: vector < float > classes; ///< array of classes
 
 	int32_t Nclass; ///< number of classes
 
+	column_arena arena; ///< contiguous memory of the arrays (one column for each statistic)
+
+	column_arena workspace; ///< scratch memory of the functors (e.g. the histograms of the confusion matrix)
+
+	label_map lut; ///< lookup table from labels to class indexes
+
+	bool fixed_classes; ///< true if the classes are given by set_classes (no class discovery)
+
+	confusion_accumulator stream; ///< confusion matrix accumulated by update
+
+	sparse_matrix sparse; ///< sparse confusion matrix (see compute_sparse)
+
+	bool sparse_mode; ///< true if the statistics are computed from the sparse confusion matrix
+
+	/// index of the statistics in topological order (each statistic follows its dependencies)
+	enum stat_index : int32_t
+	{
+		idx_classes,
+		idx_confusion_matrix,
+		idx_marginals,
+		idx_TP,
+		idx_FN,
+		idx_FP,
+		idx_TN,
+		idx_POP,
+		idx_P,
+		idx_N,
+		idx_TOP,
+		idx_TON,
+		idx_TPR,
+		idx_TNR,
+		idx_PPV,
+		idx_NPV,
+		idx_FNR,
+		idx_FPR,
+		idx_FDR,
+		idx_FOR,
+		idx_ACC,
+		idx_F1_SCORE,
+		idx_F05_SCORE,
+		idx_F2_SCORE,
+		idx_MCC,
+		idx_BM,
+		idx_MK,
+		idx_ICSI,
+		idx_PLR,
+		idx_NLR,
+		idx_DOR,
+		idx_PRE,
+		idx_G,
+		idx_RACC,
+		idx_ERR_ACC,
+		idx_RACCU,
+		idx_jaccard_index,
+		idx_IS,
+		idx_CEN,
+		idx_MCEN,
+		idx_AUC,
+		idx_dIND,
+		idx_sIND,
+		idx_DP,
+		idx_Y,
+		idx_PLRI,
+		idx_NLRI,
+		idx_DPI,
+		idx_AUCI,
+		idx_GI,
+		idx_LS,
+		idx_AM,
+		idx_OP,
+		idx_IBA,
+		idx_GM,
+		idx_Q,
+		idx_AGM,
+		idx_MCCI,
+		idx_AGF,
+		idx_OC,
+		idx_OOC,
+		idx_AUPR,
+		idx_BCD,
+		idx_overall_accuracy,
+		idx_overall_random_accuracy_unbiased,
+		idx_overall_random_accuracy,
+		idx_overall_kappa,
+		idx_PC_PI,
+		idx_PC_AC1,
+		idx_PC_S,
+		idx_PI,
+		idx_AC1,
+		idx_S,
+		idx_kappa_SE,
+		idx_kappa_unbiased,
+		idx_kappa_no_prevalence,
+		idx_kappa_CI_up,
+		idx_kappa_CI_down,
+		idx_overall_accuracy_se,
+		idx_overall_accuracy_ci_up,
+		idx_overall_accuracy_ci_down,
+		idx_chi_square,
+		idx_phi_square,
+		idx_cramer_V,
+		idx_response_entropy,
+		idx_reference_entropy,
+		idx_cross_entropy,
+		idx_join_entropy,
+		idx_conditional_entropy,
+		idx_mutual_information,
+		idx_kl_divergence,
+		idx_lambda_B,
+		idx_lambda_A,
+		idx_DF,
+		idx_overall_jaccard_index,
+		idx_hamming_loss,
+		idx_zero_one_loss,
+		idx_NIR,
+		idx_p_value,
+		idx_overall_CEN,
+		idx_overall_MCEN,
+		idx_overall_MCC,
+		idx_RR,
+		idx_CBA,
+		idx_AUNU,
+		idx_AUNP,
+		idx_RCI,
+		idx_CSI,
+		idx_overall_pearson_C,
+		idx_TPR_PPV_F1_micro,
+		idx_MCC_analysis,
+		idx_kappa_analysis_cicchetti,
+		idx_kappa_analysis_koch,
+		idx_kappa_analysis_fleiss,
+		idx_kappa_analysis_altman,
+		idx_V_analysis,
+		idx_TPR_macro,
+		idx_PPV_macro,
+		idx_ACC_macro,
+		idx_F1_macro,
+		n_stats
+	};
+
+	std :: bitset < n_stats > required; ///< statistics evaluated by compute_stats (see select)
+
 	/**
 	* @brief Default constructor.
 	*
 	*/
-	scorer ();
+	basic_scorer ();
 
 	/**
 	* @brief Default destructor.
 	*
 	*/
-	~scorer () = default;
+	~basic_scorer () = default;
 
 	// Members
 
@@ -174,9 +337,197 @@ struct scorer
 	void compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred);
 
 
+	/**
+	* @brief Accumulate a batch of labels into the streaming confusion matrix.
+	*
+	* @details Only the confusion matrix is updated (the batch is not stored): the statistics
+	* are evaluated by compute_score () when they are required. New classes are added to the
+	* set found so far, unless the classes are fixed by set_classes.
+	*
+	* @param lbl_true array of true labels
+	* @param lbl_pred array of predicted labels
+	* @param n_lbl size of the label arrays
+	*
+	*/
+	void update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl);
+
+
+	/**
+	* @brief Compute the available scores related to the labels accumulated by update.
+	*
+	* @details The accumulated confusion matrix is not modified, so further batches can be
+	* added and the scores recomputed at any time.
+	*
+	*/
+	void compute_score ();
+
+
+	/**
+	* @brief Compute the available scores from a confusion matrix, skipping the processing of the labels.
+	*
+	* @details The cost is O(Nclass^2), independently by the number of samples which were
+	* accumulated into the matrix. The function is instantiated for count_t, int32_t and int64_t
+	* matrices, and also for float and double matrices if the counters are real-valued
+	* (weighted_scorer): a real-valued matrix is rejected at compile time by the scorer with integer
+	* counts, instead of being truncated.
+	*
+	* @tparam T data type of the confusion matrix
+	* @param confusion_matrix confusion matrix as ravel array (Nclass * Nclass) with true labels along the rows
+	* @param Nclass number of classes
+	* @param classes array of classes in the order of the rows (if nullptr the classes are 0, ..., Nclass - 1)
+	*
+	*/
+	template < typename T, typename std :: enable_if < std :: is_integral < T > :: value || std :: is_floating_point < count_type > :: value, int > :: type = 0 >
+	void compute_from_confusion_matrix (const T * confusion_matrix, const int32_t & Nclass, const float * classes = nullptr);
+
+
+	/**
+	* @brief Compute the available scores using a sparse confusion matrix.
+	*
+	* @details The confusion matrix is stored in CSR format (see sparse_matrix) and the
+	* functors which read it iterate only the non-zero cells, so the memory and the cost
+	* scale with the number of distinct (true, pred) pairs instead of Nclass^2.
+	* This is the evaluation for very large numbers of classes: the dense confusion matrix
+	* is not allocated and the confusion_matrix member is not valid.
+	*
+	* @param lbl_true array of true labels
+	* @param lbl_pred array of predicted labels
+	* @param n_true size of the array lbl_true (aka number of true labels)
+	* @param n_pred size of the array lbl_pred (aka number of predicted labels)
+	*
+	*/
+	void compute_sparse (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred);
+
+
+	/**
+	* @brief Compute the available scores from a sparse confusion matrix (see compute_sparse).
+	*
+	* @param confusion_matrix sparse confusion matrix with true labels along the rows
+	* @param classes array of classes in the order of the rows (if nullptr the classes are 0, ..., Nclass - 1)
+	*
+	*/
+	void compute_from_sparse_matrix (const sparse_matrix & confusion_matrix, const float * classes = nullptr);
+
+
+	/**
+	* @brief Select the statistics to evaluate (lazy evaluation).
+	*
+	* @details The next evaluations compute only the given statistics and their dependencies
+	* (the transitive closure in the dependency graph), while the other members are left
+	* untouched. The fused class statistics are evaluated together if any of them is required.
+	* An empty list restores the evaluation of all the statistics.
+	*
+	* @param metrics names of the statistics (as the members of the class, e.g. ACC or overall_accuracy)
+	*
+	* @return False if some name is not a statistic (the selection is not modified).
+	*/
+	bool select (const std :: vector < std :: string > & metrics);
+
+
+	/**
+	* @brief Index of a statistic from its name.
+	*
+	* @param name name of the statistic (as the member of the class)
+	*
+	* @return The index of the statistic (see stat_index) or -1 if it is not found.
+	*/
+	static int32_t stat_id (const std :: string & name);
+
+
+	/**
+	* @brief Number of values of a statistic.
+	*
+	* @param stat index of the statistic (see stat_index)
+	*
+	* @return Nclass for the class statistics, 1 for the overall ones and 0 for
+	* the classes and the confusion matrix (which are not scores).
+	*/
+	int32_t stat_size (const int32_t & stat) const;
+
+
+	/**
+	* @brief Value of a statistic by index.
+	*
+	* @param stat index of the statistic (see stat_index)
+	* @param i index of the class (ignored by the overall statistics)
+	*
+	* @return The value of the statistic as double.
+	*/
+	double stat_value (const int32_t & stat, const int32_t & i) const;
+
+
+	/**
+	* @brief Compute the statistics from the confusion matrix and the array of classes.
+	*
+	* @details The arrays of the statistics must be already reserved (see reserve) and the
+	* confusion matrix filled. As compute_score it can be called by all the threads of a
+	* parallel region. With OpenMP >= 4.0 the functors are scheduled as a task graph
+	* (see compute_stats_tasks), otherwise by the layers of omp sections (see compute_stats_layers).
+	*
+	*/
+	void compute_stats ();
+
+
+	/**
+	* @brief Compute the statistics by layers of omp sections.
+	*
+	* @details Each layer contains the functors which depend only by the previous layers
+	* and it ends with an implicit barrier, so the slowest functor of a layer delays all
+	* the following ones.
+	*
+	*/
+	void compute_stats_layers ();
+
+
+	/**
+	* @brief Compute the statistics as a graph of omp tasks.
+	*
+	* @details Each functor is a task with depend clauses on its inputs and outputs, so it
+	* starts as soon as its inputs are ready, without barriers between the layers.
+	* Without OpenMP >= 4.0 the functors are evaluated serially in topological order.
+	*
+	*/
+	void compute_stats_tasks ();
+
+
+	/**
+	* @brief Set the arrays of the statistics as views of the arena for the given number of classes.
+	*
+	* @details The arena is reallocated only if its capacity is not enough,
+	* so repeated calls with the same number of classes reuse the same memory.
+	* The dense confusion matrix and the workspace of its histograms take O(Nclass^2)
+	* memory, so they are reserved only for the dense evaluations.
+	*
+	* @param Nclass number of classes
+	* @param dense true if the dense confusion matrix is required (false in sparse mode)
+	*
+	*/
+	void reserve (const int32_t & Nclass, const bool & dense);
+
+
+	/**
+	* @brief Fix the array of classes used by the next evaluations.
+	*
+	* @details The classes are not discovered from the labels anymore and the labels which
+	* are not in the given set are ignored. The memory of the statistics is reserved here,
+	* while the dense confusion matrix and its workspace (O(Nclass^2) memory) are reserved by
+	* the first dense evaluation, so the following calls to compute_score do not perform any
+	* allocation and a large set of classes can be fixed for compute_sparse.
+	* The streaming confusion matrix (see update) is cleared and it takes the same classes.
+	* An empty set (Nclass = 0) restores the discovery of the classes from the labels.
+	*
+	* @param classes array of classes (duplicates are removed)
+	* @param Nclass size of the array of classes
+	*
+	*/
+	void set_classes (const int32_t * classes, const int32_t & Nclass);
+
+
 	/**
 	* @brief Print the scores related to class statistics, i.e a score for each class. The output is a table in which each score is represented by a row.
 	*
+	* @details The statistics out of the selection (see select) are not evaluated, so their rows are skipped.
+	*
 	* @tparam Os output stream data type
 	* @param os ostream (es. std :: cout)
 	*
@@ -188,6 +539,8 @@ struct scorer
 	/**
 	* @brief Print the scores related to overall statistics, i.e a global score among classes. The output is a table in which each score is represented by a row.
 	*
+	* @details As in print_class_stats, only the selected statistics are printed.
+	*
 	* @tparam Os output stream data type
 	* @param os ostream (es. std :: cout)
 	*
@@ -225,6 +578,21 @@ struct scorer
 
 };
 
+/// @cond DEF
+} // end namespace __scorer_abi__
+/// @endcond
+
+/// Scorer of the labels (exact integer counts).
+using scorer = basic_scorer < count_t >;
+
+/// Scorer of weighted samples (real-valued counts).
+using weighted_scorer = basic_scorer < double >;
+
+/// @cond DEF
+extern template struct basic_scorer < count_t >;
+extern template struct basic_scorer < double >;
+/// @endcond
+
 
 #endif // __scorer_h__
 
@@ -7,388 +7,685 @@
 #include <scorer.h>
 
 
-template < typename Os >
-void scorer :: print_class_stats (Os & os)
+template < typename count_type >
+template < typename T, typename std :: enable_if < std :: is_integral < T > :: value || std :: is_floating_point < count_type > :: value, int > :: type >
+void basic_scorer < count_type > :: compute_from_confusion_matrix (const T * confusion_matrix, const int32_t & Nclass, const float * classes)
 {
+#ifdef __pythonic__
+#ifdef _OPENMP
+#pragma omp parallel
+	{
+#endif
+#endif
+
+#ifdef _OPENMP
+#pragma omp single
+#endif
+	{
+		if ( classes != nullptr )
+			this->classes.assign(classes, classes + Nclass);
+		else
+		{
+			this->classes.resize(Nclass);
+			std :: iota(this->classes.begin(), this->classes.end(), 0.f);
+		}
+
+		this->Nclass = Nclass;
+	}
+
+	if ( this->Nclass <= 1 )
+	{
+#ifdef _OPENMP
+#pragma omp single
+#endif
+		std :: cerr << "Nclass must be greater than 1" << std :: endl;
+		std :: exit(1);
+	}
+
+#ifdef _OPENMP
+#pragma omp single
+#endif
+	{
+		this->sparse_mode = false;
+		this->reserve(this->Nclass, true);
+		std :: transform(confusion_matrix, confusion_matrix + static_cast < int64_t >(Nclass) * Nclass, this->confusion_matrix,
+		                [] (const T & x) { return static_cast < count_type >(x); });
+	}
+
+	this->compute_stats();
+
+#ifdef __pythonic__
+#ifdef _OPENMP
+	} // end computation function
+#endif
+#endif
+}
 
-	os << std :: left << std :: setw(40) << "Classes";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << classes[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "TP(True positive/hit)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TP[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "FN(False negative/miss/type 2 error)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FN[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "FP(False positive/type 1 error/false alarm)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FP[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "TN(True negative/correct rejection)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TN[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "POP(Population)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << POP[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "P(Condition positive or support)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << P[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "N(Condition negative)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << N[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "TOP(Test outcome positive)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TOP[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "TON(Test outcome negative)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TON[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "TPR(Sensitivity / recall / hit rate / true positive rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TPR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "TNR(Specificity or true negative rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TNR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "PPV(Precision or positive predictive value)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PPV[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "NPV(Negative predictive value)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << NPV[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "FNR(Miss rate or false negative rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FNR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "FPR(Fall-out or false positive rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FPR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "FDR(False discovery rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FDR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "FOR(False omission rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FOR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "ACC(Accuracy)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << ACC[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "F1(F1 score - harmonic mean of precision and sensitivity)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << F1_SCORE[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "F0.5(F0.5 score)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << F05_SCORE[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "F2(F2 score)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << F2_SCORE[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "MCC(Matthews correlation coefficient)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MCC[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "BM(Informedness or bookmaker informedness)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << BM[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "MK(Markedness)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MK[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "ICSI(Individual classification success index)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << ICSI[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "PLR(Positive likelihood ratio)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PLR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "NLR(Negative likelihood ratio)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << NLR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "DOR(Diagnostic odds ratio)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << DOR[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "PRE(Prevalence)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PRE[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "G(G-measure geometric mean of precision and sensitivity)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << G[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "RACC(Random accuracy)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << RACC[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "ERR(Error rate)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << ERR_ACC[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "RACCU(Random accuracy unbiased)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << RACCU[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "J(Jaccard index)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << jaccard_index[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "IS(Information score)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << IS[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "CEN(Confusion entropy)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << CEN[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "MCEN(Modified confusion entropy)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MCEN[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "AUC(Area Under the ROC curve)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AUC[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "dInd(Distance index)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << dIND[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "sInd(Similarity index)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << sIND[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "DP(Discriminant power)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << DP[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "Y(Youden index)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << Y[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "PLRI(Positive likelihood ratio interpretation)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PLRI[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "NLRI(Negative likelihood ratio interpretation)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << NLRI[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "DPI(Discriminant power interpretation)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << DPI[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "AUCI(AUC value interpretation)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AUCI[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "GI(Gini index)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << GI[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "LS(Lift score)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << LS[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "AM(Difference between automatic and manual classification)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AM[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "OP(Optimized precision)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << OP[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "IBA(Index of balanced accuracy)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << IBA[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "GM(G-mean geometric mean of specificity and sensitivity)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << GM[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "Q(Yule Q - coefficient of colligation)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << Q[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "AGM(Adjusted geometric mean)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AGM[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "MCCI(Matthews correlation coefficient interpretation)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MCCI[i] << " ";
-	os << std :: endl;
 
-	os << std :: left << std :: setw(40) << "AGF(Adjusted F-score)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AGF[i] << " ";
-	os << std :: endl;
 
-	os << std :: left << std :: setw(40) << "OC(Overlap coefficient)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << OC[i] << " ";
-	os << std :: endl;
-
-	os << std :: left << std :: setw(40) << "OOC(Otsuka-Ochiai coefficient)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << OOC[i] << " ";
-	os << std :: endl;
+template < typename count_type >
+template < typename Os >
+void basic_scorer < count_type > :: print_class_stats (Os & os)
+{
 
-	os << std :: left << std :: setw(40) << "AUPR(Area under the PR curve)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AUPR[i] << " ";
+	os << std :: left << std :: setw(40) << "Classes";
+	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << classes[i] << " ";
 	os << std :: endl;
 
-	os << std :: left << std :: setw(40) << "BCD(Bray-Curtis dissimilarity)";
-	for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << BCD[i] << " ";
-	os << std :: endl;
+	if ( this->required[idx_TP] )
+	{
+		os << std :: left << std :: setw(40) << "TP(True positive/hit)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TP[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_FN] )
+	{
+		os << std :: left << std :: setw(40) << "FN(False negative/miss/type 2 error)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FN[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_FP] )
+	{
+		os << std :: left << std :: setw(40) << "FP(False positive/type 1 error/false alarm)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FP[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_TN] )
+	{
+		os << std :: left << std :: setw(40) << "TN(True negative/correct rejection)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TN[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_POP] )
+	{
+		os << std :: left << std :: setw(40) << "POP(Population)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << POP[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_P] )
+	{
+		os << std :: left << std :: setw(40) << "P(Condition positive or support)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << P[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_N] )
+	{
+		os << std :: left << std :: setw(40) << "N(Condition negative)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << N[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_TOP] )
+	{
+		os << std :: left << std :: setw(40) << "TOP(Test outcome positive)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TOP[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_TON] )
+	{
+		os << std :: left << std :: setw(40) << "TON(Test outcome negative)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TON[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_TPR] )
+	{
+		os << std :: left << std :: setw(40) << "TPR(Sensitivity / recall / hit rate / true positive rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TPR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_TNR] )
+	{
+		os << std :: left << std :: setw(40) << "TNR(Specificity or true negative rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << TNR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_PPV] )
+	{
+		os << std :: left << std :: setw(40) << "PPV(Precision or positive predictive value)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PPV[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_NPV] )
+	{
+		os << std :: left << std :: setw(40) << "NPV(Negative predictive value)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << NPV[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_FNR] )
+	{
+		os << std :: left << std :: setw(40) << "FNR(Miss rate or false negative rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FNR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_FPR] )
+	{
+		os << std :: left << std :: setw(40) << "FPR(Fall-out or false positive rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FPR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_FDR] )
+	{
+		os << std :: left << std :: setw(40) << "FDR(False discovery rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FDR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_FOR] )
+	{
+		os << std :: left << std :: setw(40) << "FOR(False omission rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << FOR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_ACC] )
+	{
+		os << std :: left << std :: setw(40) << "ACC(Accuracy)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << ACC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_F1_SCORE] )
+	{
+		os << std :: left << std :: setw(40) << "F1(F1 score - harmonic mean of precision and sensitivity)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << F1_SCORE[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_F05_SCORE] )
+	{
+		os << std :: left << std :: setw(40) << "F0.5(F0.5 score)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << F05_SCORE[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_F2_SCORE] )
+	{
+		os << std :: left << std :: setw(40) << "F2(F2 score)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << F2_SCORE[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_MCC] )
+	{
+		os << std :: left << std :: setw(40) << "MCC(Matthews correlation coefficient)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MCC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_BM] )
+	{
+		os << std :: left << std :: setw(40) << "BM(Informedness or bookmaker informedness)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << BM[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_MK] )
+	{
+		os << std :: left << std :: setw(40) << "MK(Markedness)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MK[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_ICSI] )
+	{
+		os << std :: left << std :: setw(40) << "ICSI(Individual classification success index)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << ICSI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_PLR] )
+	{
+		os << std :: left << std :: setw(40) << "PLR(Positive likelihood ratio)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PLR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_NLR] )
+	{
+		os << std :: left << std :: setw(40) << "NLR(Negative likelihood ratio)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << NLR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_DOR] )
+	{
+		os << std :: left << std :: setw(40) << "DOR(Diagnostic odds ratio)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << DOR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_PRE] )
+	{
+		os << std :: left << std :: setw(40) << "PRE(Prevalence)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PRE[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_G] )
+	{
+		os << std :: left << std :: setw(40) << "G(G-measure geometric mean of precision and sensitivity)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << G[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_RACC] )
+	{
+		os << std :: left << std :: setw(40) << "RACC(Random accuracy)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << RACC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_ERR_ACC] )
+	{
+		os << std :: left << std :: setw(40) << "ERR(Error rate)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << ERR_ACC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_RACCU] )
+	{
+		os << std :: left << std :: setw(40) << "RACCU(Random accuracy unbiased)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << RACCU[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_jaccard_index] )
+	{
+		os << std :: left << std :: setw(40) << "J(Jaccard index)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << jaccard_index[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_IS] )
+	{
+		os << std :: left << std :: setw(40) << "IS(Information score)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << IS[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_CEN] )
+	{
+		os << std :: left << std :: setw(40) << "CEN(Confusion entropy)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << CEN[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_MCEN] )
+	{
+		os << std :: left << std :: setw(40) << "MCEN(Modified confusion entropy)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MCEN[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_AUC] )
+	{
+		os << std :: left << std :: setw(40) << "AUC(Area Under the ROC curve)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AUC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_dIND] )
+	{
+		os << std :: left << std :: setw(40) << "dInd(Distance index)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << dIND[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_sIND] )
+	{
+		os << std :: left << std :: setw(40) << "sInd(Similarity index)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << sIND[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_DP] )
+	{
+		os << std :: left << std :: setw(40) << "DP(Discriminant power)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << DP[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_Y] )
+	{
+		os << std :: left << std :: setw(40) << "Y(Youden index)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << Y[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_PLRI] )
+	{
+		os << std :: left << std :: setw(40) << "PLRI(Positive likelihood ratio interpretation)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << PLRI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_NLRI] )
+	{
+		os << std :: left << std :: setw(40) << "NLRI(Negative likelihood ratio interpretation)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << NLRI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_DPI] )
+	{
+		os << std :: left << std :: setw(40) << "DPI(Discriminant power interpretation)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << DPI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_AUCI] )
+	{
+		os << std :: left << std :: setw(40) << "AUCI(AUC value interpretation)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AUCI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_GI] )
+	{
+		os << std :: left << std :: setw(40) << "GI(Gini index)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << GI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_LS] )
+	{
+		os << std :: left << std :: setw(40) << "LS(Lift score)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << LS[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_AM] )
+	{
+		os << std :: left << std :: setw(40) << "AM(Difference between automatic and manual classification)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AM[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_OP] )
+	{
+		os << std :: left << std :: setw(40) << "OP(Optimized precision)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << OP[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_IBA] )
+	{
+		os << std :: left << std :: setw(40) << "IBA(Index of balanced accuracy)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << IBA[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_GM] )
+	{
+		os << std :: left << std :: setw(40) << "GM(G-mean geometric mean of specificity and sensitivity)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << GM[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_Q] )
+	{
+		os << std :: left << std :: setw(40) << "Q(Yule Q - coefficient of colligation)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << Q[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_AGM] )
+	{
+		os << std :: left << std :: setw(40) << "AGM(Adjusted geometric mean)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AGM[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_MCCI] )
+	{
+		os << std :: left << std :: setw(40) << "MCCI(Matthews correlation coefficient interpretation)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << MCCI[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_AGF] )
+	{
+		os << std :: left << std :: setw(40) << "AGF(Adjusted F-score)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AGF[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_OC] )
+	{
+		os << std :: left << std :: setw(40) << "OC(Overlap coefficient)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << OC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_OOC] )
+	{
+		os << std :: left << std :: setw(40) << "OOC(Otsuka-Ochiai coefficient)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << OOC[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_AUPR] )
+	{
+		os << std :: left << std :: setw(40) << "AUPR(Area under the PR curve)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << AUPR[i] << " ";
+		os << std :: endl;
+	}
+
+	if ( this->required[idx_BCD] )
+	{
+		os << std :: left << std :: setw(40) << "BCD(Bray-Curtis dissimilarity)";
+		for (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << BCD[i] << " ";
+		os << std :: endl;
+	}
 
 }
 
 
 
+template < typename count_type >
 template < typename Os >
-void scorer :: print_overall_stats (Os & os)
+void basic_scorer < count_type > :: print_overall_stats (Os & os)
 {
 
-	os << std :: left << std :: setw(40) << "Overall ACC" << std :: setw(20) << overall_accuracy << std :: endl;
+	if ( this->required[idx_overall_accuracy] )
+		os << std :: left << std :: setw(40) << "Overall ACC" << std :: setw(20) << overall_accuracy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Overall RACCU" << std :: setw(20) << overall_random_accuracy_unbiased << std :: endl;
+	if ( this->required[idx_overall_random_accuracy_unbiased] )
+		os << std :: left << std :: setw(40) << "Overall RACCU" << std :: setw(20) << overall_random_accuracy_unbiased << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Overall RACC" << std :: setw(20) << overall_random_accuracy << std :: endl;
+	if ( this->required[idx_overall_random_accuracy] )
+		os << std :: left << std :: setw(40) << "Overall RACC" << std :: setw(20) << overall_random_accuracy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Kappa" << std :: setw(20) << overall_kappa << std :: endl;
+	if ( this->required[idx_overall_kappa] )
+		os << std :: left << std :: setw(40) << "Kappa" << std :: setw(20) << overall_kappa << std :: endl;
 
-	os << std :: left << std :: setw(40) << "PC_PI" << std :: setw(20) << PC_PI << std :: endl;
+	if ( this->required[idx_PC_PI] )
+		os << std :: left << std :: setw(40) << "PC_PI" << std :: setw(20) << PC_PI << std :: endl;
 
-	os << std :: left << std :: setw(40) << "PC_AC1" << std :: setw(20) << PC_AC1 << std :: endl;
+	if ( this->required[idx_PC_AC1] )
+		os << std :: left << std :: setw(40) << "PC_AC1" << std :: setw(20) << PC_AC1 << std :: endl;
 
-	os << std :: left << std :: setw(40) << "PC_S" << std :: setw(20) << PC_S << std :: endl;
+	if ( this->required[idx_PC_S] )
+		os << std :: left << std :: setw(40) << "PC_S" << std :: setw(20) << PC_S << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Scott PI" << std :: setw(20) << PI << std :: endl;
+	if ( this->required[idx_PI] )
+		os << std :: left << std :: setw(40) << "Scott PI" << std :: setw(20) << PI << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Get AC1" << std :: setw(20) << AC1 << std :: endl;
+	if ( this->required[idx_AC1] )
+		os << std :: left << std :: setw(40) << "Get AC1" << std :: setw(20) << AC1 << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Bennett S" << std :: setw(20) << S << std :: endl;
+	if ( this->required[idx_S] )
+		os << std :: left << std :: setw(40) << "Bennett S" << std :: setw(20) << S << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Kappa Standard Error" << std :: setw(20) << kappa_SE << std :: endl;
+	if ( this->required[idx_kappa_SE] )
+		os << std :: left << std :: setw(40) << "Kappa Standard Error" << std :: setw(20) << kappa_SE << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Kappa Unbiased" << std :: setw(20) << kappa_unbiased << std :: endl;
+	if ( this->required[idx_kappa_unbiased] )
+		os << std :: left << std :: setw(40) << "Kappa Unbiased" << std :: setw(20) << kappa_unbiased << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Kappa No Prevalence" << std :: setw(20) << kappa_no_prevalence << std :: endl;
+	if ( this->required[idx_kappa_no_prevalence] )
+		os << std :: left << std :: setw(40) << "Kappa No Prevalence" << std :: setw(20) << kappa_no_prevalence << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Kappa 95% CI up" << std :: setw(20) << kappa_CI_up << std :: endl;
+	if ( this->required[idx_kappa_CI_up] )
+		os << std :: left << std :: setw(40) << "Kappa 95% CI up" << std :: setw(20) << kappa_CI_up << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Kappa 95% CI down" << std :: setw(20) << kappa_CI_down << std :: endl;
+	if ( this->required[idx_kappa_CI_down] )
+		os << std :: left << std :: setw(40) << "Kappa 95% CI down" << std :: setw(20) << kappa_CI_down << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Standard Error" << std :: setw(20) << overall_accuracy_se << std :: endl;
+	if ( this->required[idx_overall_accuracy_se] )
+		os << std :: left << std :: setw(40) << "Standard Error" << std :: setw(20) << overall_accuracy_se << std :: endl;
 
-	os << std :: left << std :: setw(40) << "95% CI up" << std :: setw(20) << overall_accuracy_ci_up << std :: endl;
+	if ( this->required[idx_overall_accuracy_ci_up] )
+		os << std :: left << std :: setw(40) << "95% CI up" << std :: setw(20) << overall_accuracy_ci_up << std :: endl;
 
-	os << std :: left << std :: setw(40) << "95% CI down" << std :: setw(20) << overall_accuracy_ci_down << std :: endl;
+	if ( this->required[idx_overall_accuracy_ci_down] )
+		os << std :: left << std :: setw(40) << "95% CI down" << std :: setw(20) << overall_accuracy_ci_down << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Chi-Squared" << std :: setw(20) << chi_square << std :: endl;
+	if ( this->required[idx_chi_square] )
+		os << std :: left << std :: setw(40) << "Chi-Squared" << std :: setw(20) << chi_square << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Phi-Squared" << std :: setw(20) << phi_square << std :: endl;
+	if ( this->required[idx_phi_square] )
+		os << std :: left << std :: setw(40) << "Phi-Squared" << std :: setw(20) << phi_square << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Cramer V" << std :: setw(20) << cramer_V << std :: endl;
+	if ( this->required[idx_cramer_V] )
+		os << std :: left << std :: setw(40) << "Cramer V" << std :: setw(20) << cramer_V << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Response Entropy" << std :: setw(20) << response_entropy << std :: endl;
+	if ( this->required[idx_response_entropy] )
+		os << std :: left << std :: setw(40) << "Response Entropy" << std :: setw(20) << response_entropy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Reference Entropy" << std :: setw(20) << reference_entropy << std :: endl;
+	if ( this->required[idx_reference_entropy] )
+		os << std :: left << std :: setw(40) << "Reference Entropy" << std :: setw(20) << reference_entropy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Cross Entropy" << std :: setw(20) << cross_entropy << std :: endl;
+	if ( this->required[idx_cross_entropy] )
+		os << std :: left << std :: setw(40) << "Cross Entropy" << std :: setw(20) << cross_entropy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Joint Entropy" << std :: setw(20) << join_entropy << std :: endl;
+	if ( this->required[idx_join_entropy] )
+		os << std :: left << std :: setw(40) << "Joint Entropy" << std :: setw(20) << join_entropy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Conditional Entropy" << std :: setw(20) << conditional_entropy << std :: endl;
+	if ( this->required[idx_conditional_entropy] )
+		os << std :: left << std :: setw(40) << "Conditional Entropy" << std :: setw(20) << conditional_entropy << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Mutual Information" << std :: setw(20) << mutual_information << std :: endl;
+	if ( this->required[idx_mutual_information] )
+		os << std :: left << std :: setw(40) << "Mutual Information" << std :: setw(20) << mutual_information << std :: endl;
 
-	os << std :: left << std :: setw(40) << "KL Divergence" << std :: setw(20) << kl_divergence << std :: endl;
+	if ( this->required[idx_kl_divergence] )
+		os << std :: left << std :: setw(40) << "KL Divergence" << std :: setw(20) << kl_divergence << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Lambda B" << std :: setw(20) << lambda_B << std :: endl;
+	if ( this->required[idx_lambda_B] )
+		os << std :: left << std :: setw(40) << "Lambda B" << std :: setw(20) << lambda_B << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Lambda A" << std :: setw(20) << lambda_A << std :: endl;
+	if ( this->required[idx_lambda_A] )
+		os << std :: left << std :: setw(40) << "Lambda A" << std :: setw(20) << lambda_A << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Chi-Squared DF" << std :: setw(20) << DF << std :: endl;
+	if ( this->required[idx_DF] )
+		os << std :: left << std :: setw(40) << "Chi-Squared DF" << std :: setw(20) << DF << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Overall J" << std :: setw(20) << overall_jaccard_index << std :: endl;
+	if ( this->required[idx_overall_jaccard_index] )
+		os << std :: left << std :: setw(40) << "Overall J" << std :: setw(20) << overall_jaccard_index << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Hamming loss" << std :: setw(20) << hamming_loss << std :: endl;
+	if ( this->required[idx_hamming_loss] )
+		os << std :: left << std :: setw(40) << "Hamming loss" << std :: setw(20) << hamming_loss << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Zero-one Loss" << std :: setw(20) << zero_one_loss << std :: endl;
+	if ( this->required[idx_zero_one_loss] )
+		os << std :: left << std :: setw(40) << "Zero-one Loss" << std :: setw(20) << zero_one_loss << std :: endl;
 
-	os << std :: left << std :: setw(40) << "NIR" << std :: setw(20) << NIR << std :: endl;
+	if ( this->required[idx_NIR] )
+		os << std :: left << std :: setw(40) << "NIR" << std :: setw(20) << NIR << std :: endl;
 
-	os << std :: left << std :: setw(40) << "P-value" << std :: setw(20) << p_value << std :: endl;
+	if ( this->required[idx_p_value] )
+		os << std :: left << std :: setw(40) << "P-value" << std :: setw(20) << p_value << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Overall CEN" << std :: setw(20) << overall_CEN << std :: endl;
+	if ( this->required[idx_overall_CEN] )
+		os << std :: left << std :: setw(40) << "Overall CEN" << std :: setw(20) << overall_CEN << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Overall MCEN" << std :: setw(20) << overall_MCEN << std :: endl;
+	if ( this->required[idx_overall_MCEN] )
+		os << std :: left << std :: setw(40) << "Overall MCEN" << std :: setw(20) << overall_MCEN << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Overall MCC" << std :: setw(20) << overall_MCC << std :: endl;
+	if ( this->required[idx_overall_MCC] )
+		os << std :: left << std :: setw(40) << "Overall MCC" << std :: setw(20) << overall_MCC << std :: endl;
 
-	os << std :: left << std :: setw(40) << "RR" << std :: setw(20) << RR << std :: endl;
+	if ( this->required[idx_RR] )
+		os << std :: left << std :: setw(40) << "RR" << std :: setw(20) << RR << std :: endl;
 
-	os << std :: left << std :: setw(40) << "CBA" << std :: setw(20) << CBA << std :: endl;
+	if ( this->required[idx_CBA] )
+		os << std :: left << std :: setw(40) << "CBA" << std :: setw(20) << CBA << std :: endl;
 
-	os << std :: left << std :: setw(40) << "AUNU" << std :: setw(20) << AUNU << std :: endl;
+	if ( this->required[idx_AUNU] )
+		os << std :: left << std :: setw(40) << "AUNU" << std :: setw(20) << AUNU << std :: endl;
 
-	os << std :: left << std :: setw(40) << "AUNP" << std :: setw(20) << AUNP << std :: endl;
+	if ( this->required[idx_AUNP] )
+		os << std :: left << std :: setw(40) << "AUNP" << std :: setw(20) << AUNP << std :: endl;
 
-	os << std :: left << std :: setw(40) << "RCI" << std :: setw(20) << RCI << std :: endl;
+	if ( this->required[idx_RCI] )
+		os << std :: left << std :: setw(40) << "RCI" << std :: setw(20) << RCI << std :: endl;
 
-	os << std :: left << std :: setw(40) << "CSI" << std :: setw(20) << CSI << std :: endl;
+	if ( this->required[idx_CSI] )
+		os << std :: left << std :: setw(40) << "CSI" << std :: setw(20) << CSI << std :: endl;
 
-	os << std :: left << std :: setw(40) << "Pearson C" << std :: setw(20) << overall_pearson_C << std :: endl;
+	if ( this->required[idx_overall_pearson_C] )
+		os << std :: left << std :: setw(40) << "Pearson C" << std :: setw(20) << overall_pearson_C << std :: endl;
 
-	os << std :: left << std :: setw(40) << "TPR Micro, PPV Micro, F1 Micro" << std :: setw(20) << TPR_PPV_F1_micro << std :: endl;
+	if ( this->required[idx_TPR_PPV_F1_micro] )
+		os << std :: left << std :: setw(40) << "TPR Micro, PPV Micro, F1 Micro" << std :: setw(20) << TPR_PPV_F1_micro << std :: endl;
 
-	os << std :: left << std :: setw(40) << "SOA6(Matthews)" << std :: setw(20) << MCC_analysis << std :: endl;
+	if ( this->required[idx_MCC_analysis] )
+		os << std :: left << std :: setw(40) << "SOA6(Matthews)" << std :: setw(20) << MCC_analysis << std :: endl;
 
-	os << std :: left << std :: setw(40) << "SOA4(Cicchetti)" << std :: setw(20) << kappa_analysis_cicchetti << std :: endl;
+	if ( this->required[idx_kappa_analysis_cicchetti] )
+		os << std :: left << std :: setw(40) << "SOA4(Cicchetti)" << std :: setw(20) << kappa_analysis_cicchetti << std :: endl;
 
-	os << std :: left << std :: setw(40) << "SOA1(Landis & Koch)" << std :: setw(20) << kappa_analysis_koch << std :: endl;
+	if ( this->required[idx_kappa_analysis_koch] )
+		os << std :: left << std :: setw(40) << "SOA1(Landis & Koch)" << std :: setw(20) << kappa_analysis_koch << std :: endl;
 
-	os << std :: left << std :: setw(40) << "SOA2(Fleiss)" << std :: setw(20) << kappa_analysis_fleiss << std :: endl;
+	if ( this->required[idx_kappa_analysis_fleiss] )
+		os << std :: left << std :: setw(40) << "SOA2(Fleiss)" << std :: setw(20) << kappa_analysis_fleiss << std :: endl;
 
-	os << std :: left << std :: setw(40) << "SOA3(Altman)" << std :: setw(20) << kappa_analysis_altman << std :: endl;
+	if ( this->required[idx_kappa_analysis_altman] )
+		os << std :: left << std :: setw(40) << "SOA3(Altman)" << std :: setw(20) << kappa_analysis_altman << std :: endl;
 
-	os << std :: left << std :: setw(40) << "SOA5(Cramer)" << std :: setw(20) << V_analysis << std :: endl;
+	if ( this->required[idx_V_analysis] )
+		os << std :: left << std :: setw(40) << "SOA5(Cramer)" << std :: setw(20) << V_analysis << std :: endl;
 
-	os << std :: left << std :: setw(40) << "TPR Macro" << std :: setw(20) << TPR_macro << std :: endl;
+	if ( this->required[idx_TPR_macro] )
+		os << std :: left << std :: setw(40) << "TPR Macro" << std :: setw(20) << TPR_macro << std :: endl;
 
-	os << std :: left << std :: setw(40) << "PPV Macro" << std :: setw(20) << PPV_macro << std :: endl;
+	if ( this->required[idx_PPV_macro] )
+		os << std :: left << std :: setw(40) << "PPV Macro" << std :: setw(20) << PPV_macro << std :: endl;
 
-	os << std :: left << std :: setw(40) << "ACC Macro" << std :: setw(20) << ACC_macro << std :: endl;
+	if ( this->required[idx_ACC_macro] )
+		os << std :: left << std :: setw(40) << "ACC Macro" << std :: setw(20) << ACC_macro << std :: endl;
 
-	os << std :: left << std :: setw(40) << "F1 Macro" << std :: setw(20) << F1_macro << std :: endl;
+	if ( this->required[idx_F1_macro] )
+		os << std :: left << std :: setw(40) << "F1 Macro" << std :: setw(20) << F1_macro << std :: endl;
 
 }
 
 
 
-void scorer :: print ()
+template < typename count_type >
+void basic_scorer < count_type > :: print ()
 {
 	this->print_class_stats < std :: ostream >(std :: cout);
 	std :: cout << std :: endl;
 	this->print_overall_stats < std :: ostream >(std :: cout);
 }
 
-void scorer :: dump (const std :: string & filename)
+template < typename count_type >
+void basic_scorer < count_type > :: dump (const std :: string & filename)
 {
 	std :: ofstream os (filename + ".cl_stats");
 	os << "stats," << std :: endl;
@@ -401,8 +698,9 @@ void scorer :: dump (const std :: string & filename)
 	os.close();
 }
 
+template < typename count_type >
 template < typename dtype >
-int32_t * scorer :: encoder (dtype * arr, const int32_t & size)
+int32_t * basic_scorer < count_type > :: encoder (dtype * arr, const int32_t & size)
 {
 
 	int32_t * encode = new int32_t [size];
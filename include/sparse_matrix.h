@@ -0,0 +1,376 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __sparse_matrix_h__
+#define __sparse_matrix_h__
+
+#include <vector>           // std :: vector
+#include <algorithm>        // std :: sort
+#include <cstdint>          // int32_t
+
+#include <label_map.h>      // label_map
+#include <parallel_utils.h> // parallel_chunks
+#include <stats_types.h>    // count_t
+
+/**
+* @class sparse_matrix
+* @brief Confusion matrix stored in compressed sparse row (CSR) format.
+*
+* @details Only the non-zero cells are stored (sorted by row and column), so the
+* memory and the cost of the statistics scale with the number of distinct
+* (true, pred) pairs instead of Nclass * Nclass. This is the representation of
+* the confusion matrix for very large numbers of classes (see scorer :: compute_sparse).
+* The matrix is built from the labels by a parallel counting sort on the rows
+* followed by the sort of the (short) rows, so the dense matrix is never allocated.
+*
+*/
+class sparse_matrix
+{
+
+  std :: vector < int64_t > row_ptr; ///< position of the first non-zero cell of each row (Nclass + 1)
+  std :: vector < int32_t > cols;    ///< column of each non-zero cell
+  std :: vector < count_t > counts;  ///< count of each non-zero cell
+
+  std :: vector < int32_t > buffer;  ///< predicted classes sorted by row (temporary buffer of build)
+  std :: vector < int64_t > offset;  ///< bucket offsets of each chunk of labels (temporary buffer of build)
+
+public:
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  sparse_matrix () : row_ptr (1, 0)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~sparse_matrix () = default;
+
+  /**
+  * @brief Build the matrix from the labels.
+  *
+  * @details The pairs of labels out of the set of classes are ignored.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred array of predicted labels as integers
+  * @param n_lbl size of label arrays
+  * @param lut lookup table from labels to class indexes
+  * @param Nclass number of classes
+  *
+  */
+  void build (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl, const label_map & lut, const int32_t & Nclass)
+  {
+    // the grain bounds the size of the private histograms to the number of labels
+    const int32_t nchunks = num_chunks(n_lbl, std :: max(int64_t(1) << 15, static_cast < int64_t >(Nclass)));
+
+    // histogram of the rows of each chunk
+    this->offset.assign(static_cast < int64_t >(nchunks) * Nclass, 0);
+
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      int64_t * hist = this->offset.data() + static_cast < int64_t >(c) * Nclass;
+      const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+      for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+      {
+        const int32_t t = lut[lbl_true[i]];
+
+        if ( t >= 0 && lut[lbl_pred[i]] >= 0 )
+          ++ hist[t];
+      }
+    });
+
+    // exclusive scan in (row, chunk) order, so each chunk writes its own slice of each bucket
+    std :: vector < int64_t > bucket (Nclass + 1, 0);
+
+    for (int32_t r = 0; r < Nclass; ++r)
+    {
+      int64_t start = bucket[r];
+
+      for (int32_t c = 0; c < nchunks; ++c)
+      {
+        int64_t & h = this->offset[static_cast < int64_t >(c) * Nclass + r];
+        const int64_t size = h;
+        h = start;
+        start += size;
+      }
+
+      bucket[r + 1] = start;
+    }
+
+    this->buffer.resize(bucket[Nclass]);
+
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      int64_t * pos = this->offset.data() + static_cast < int64_t >(c) * Nclass;
+      const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+      for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+      {
+        const int32_t t = lut[lbl_true[i]];
+        const int32_t p = lut[lbl_pred[i]];
+
+        if ( t >= 0 && p >= 0 )
+          this->buffer[pos[t]++] = p;
+      }
+    });
+
+    this->compress(bucket, Nclass);
+  }
+
+  /**
+  * @brief Build the matrix from a dense confusion matrix.
+  *
+  * @tparam T data type of the dense matrix
+  * @param confusion_matrix dense confusion matrix as ravel array (Nclass * Nclass)
+  * @param Nclass number of classes
+  *
+  */
+  template < typename T >
+  void assign (const T * confusion_matrix, const int32_t & Nclass)
+  {
+    this->row_ptr.assign(1, 0);
+    this->cols.clear();
+    this->counts.clear();
+
+    for (int32_t i = 0; i < Nclass; ++i)
+    {
+      for (int32_t j = 0; j < Nclass; ++j)
+      {
+        const count_t count = static_cast < count_t >(confusion_matrix[static_cast < int64_t >(i) * Nclass + j]);
+
+        if ( count )
+        {
+          this->cols.push_back(j);
+          this->counts.push_back(count);
+        }
+      }
+
+      this->row_ptr.push_back(static_cast < int64_t >(this->cols.size()));
+    }
+  }
+
+  /**
+  * @brief Number of classes (rows of the matrix).
+  *
+  */
+  int32_t size () const
+  {
+    return static_cast < int32_t >(this->row_ptr.size()) - 1;
+  }
+
+  /**
+  * @brief Number of non-zero cells.
+  *
+  */
+  int64_t nnz () const
+  {
+    return static_cast < int64_t >(this->cols.size());
+  }
+
+  /**
+  * @brief Position of the first non-zero cell of a row.
+  *
+  * @param i row index (true class)
+  *
+  */
+  int64_t row_begin (const int32_t & i) const
+  {
+    return this->row_ptr[i];
+  }
+
+  /**
+  * @brief Position after the last non-zero cell of a row.
+  *
+  * @param i row index (true class)
+  *
+  */
+  int64_t row_end (const int32_t & i) const
+  {
+    return this->row_ptr[i + 1];
+  }
+
+  /**
+  * @brief Column (predicted class) of a non-zero cell.
+  *
+  * @param k position of the cell
+  *
+  */
+  int32_t col (const int64_t & k) const
+  {
+    return this->cols[k];
+  }
+
+  /**
+  * @brief Count of a non-zero cell.
+  *
+  * @param k position of the cell
+  *
+  */
+  count_t count (const int64_t & k) const
+  {
+    return this->counts[k];
+  }
+
+  /**
+  * @brief Count of a cell of the matrix.
+  *
+  * @details The cell is found by binary search into the row.
+  *
+  * @param i row index (true class)
+  * @param j column index (predicted class)
+  *
+  * @return The count of the cell (0 if it is not stored).
+  */
+  count_t at (const int32_t & i, const int32_t & j) const
+  {
+    const auto first = this->cols.begin() + this->row_ptr[i];
+    const auto last  = this->cols.begin() + this->row_ptr[i + 1];
+    const auto it = std :: lower_bound(first, last, j);
+
+    return ( it != last && *it == j ) ? this->counts[std :: distance(this->cols.begin(), it)] : count_t(0);
+  }
+
+  /**
+  * @brief Sum of the counts of a row.
+  *
+  * @param i row index (true class)
+  *
+  */
+  count_t row_sum (const int32_t & i) const
+  {
+    count_t sum = 0;
+    for (int64_t k = this->row_ptr[i]; k < this->row_ptr[i + 1]; ++k)
+      sum += this->counts[k];
+    return sum;
+  }
+
+  /**
+  * @brief Sums of the counts of the columns.
+  *
+  * @param sums output array of the column sums (lenght := Nclass)
+  *
+  */
+  void col_sums (count_t * sums) const
+  {
+    std :: fill_n(sums, this->size(), count_t(0));
+
+    for (int64_t k = 0; k < this->nnz(); ++k)
+      sums[this->cols[k]] += this->counts[k];
+  }
+
+  /**
+  * @brief Expand the matrix into a dense array.
+  *
+  * @param confusion_matrix output ravel array (Nclass * Nclass)
+  *
+  */
+  void to_dense (count_t * confusion_matrix) const
+  {
+    const int32_t Nclass = this->size();
+
+    std :: fill_n(confusion_matrix, static_cast < int64_t >(Nclass) * Nclass, count_t(0));
+
+    for (int32_t i = 0; i < Nclass; ++i)
+      for (int64_t k = this->row_ptr[i]; k < this->row_ptr[i + 1]; ++k)
+        confusion_matrix[static_cast < int64_t >(i) * Nclass + this->cols[k]] = this->counts[k];
+  }
+
+private:
+
+  /**
+  * @brief Sort the predicted classes of each row and count the distinct ones.
+  *
+  * @param bucket position of the first predicted class of each row into the buffer (Nclass + 1)
+  * @param Nclass number of classes
+  *
+  */
+  void compress (const std :: vector < int64_t > & bucket, const int32_t & Nclass)
+  {
+    constexpr int64_t row_grain = 1 << 12; // min number of rows for each chunk
+
+    const int32_t nchunks = num_chunks(Nclass, row_grain);
+
+    this->row_ptr.assign(Nclass + 1, 0);
+
+    // number of distinct cells of each row
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      const int64_t end = chunk_begin(Nclass, c + 1, nchunks);
+
+      for (int64_t r = chunk_begin(Nclass, c, nchunks); r < end; ++r)
+      {
+        int32_t * first = this->buffer.data() + bucket[r];
+        int32_t * last  = this->buffer.data() + bucket[r + 1];
+
+        std :: sort(first, last);
+
+        int64_t distinct = 0;
+        for (int32_t * it = first; it != last; ++it)
+          distinct += ( it == first || *it != *(it - 1) );
+
+        this->row_ptr[r + 1] = distinct;
+      }
+    });
+
+    for (int32_t r = 0; r < Nclass; ++r)
+      this->row_ptr[r + 1] += this->row_ptr[r];
+
+    this->cols.resize(this->row_ptr[Nclass]);
+    this->counts.resize(this->row_ptr[Nclass]);
+
+    // run-length encoding of the sorted rows
+    parallel_chunks(nchunks, [&] (const int32_t & c)
+    {
+      const int64_t end = chunk_begin(Nclass, c + 1, nchunks);
+
+      for (int64_t r = chunk_begin(Nclass, c, nchunks); r < end; ++r)
+      {
+        int64_t k = this->row_ptr[r] - 1;
+
+        for (int64_t i = bucket[r]; i < bucket[r + 1]; ++i)
+        {
+          if ( i == bucket[r] || this->buffer[i] != this->buffer[i - 1] )
+          {
+            this->cols[++k] = this->buffer[i];
+            this->counts[k] = 0;
+          }
+
+          ++ this->counts[k];
+        }
+      }
+    });
+  }
+
+};
+
+#endif // __sparse_matrix_h__
@@ -0,0 +1,192 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __stat_selection_h__
+#define __stat_selection_h__
+
+#include <vector>    // std :: vector
+#include <string>    // std :: string
+#include <algorithm> // std :: find
+#include <cstdint>   // int32_t
+
+#include <scorer.h>  // scorer
+
+/**
+* @class stat_selection
+* @brief Set of statistics resampled by the inference engines (e.g. bootstrap).
+*
+* @details The values of the selected statistics are flattened into a single
+* array: the class statistics take Nclass values while the overall ones take a
+* single value. The classes and the confusion matrix are the input of the
+* engines, so they can not be selected.
+*
+*/
+class stat_selection
+{
+
+  std :: vector < std :: string > metrics; ///< names of the selected statistics
+  std :: vector < int32_t > stats;         ///< indexes of the selected statistics
+  std :: vector < int32_t > offset;        ///< offset of the values of each statistic (stats.size() + 1)
+
+public:
+
+  /**
+  * @brief Default constructor.
+  *
+  */
+  stat_selection () : offset (1, 0)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~stat_selection () = default;
+
+  /**
+  * @brief Select the statistics.
+  *
+  * @param metrics names of the statistics (as the members of scorer). An empty
+  * list selects all the class and overall statistics.
+  *
+  * @return False if some name is not a score (the selection is not modified).
+  */
+  bool select (const std :: vector < std :: string > & metrics)
+  {
+    for (const auto & name : metrics)
+    {
+      const int32_t k = scorer :: stat_id(name);
+
+      if ( k < 0 || k == scorer :: idx_classes || k == scorer :: idx_confusion_matrix || k == scorer :: idx_marginals )
+        return false;
+    }
+
+    this->metrics = metrics;
+    return true;
+  }
+
+  /**
+  * @brief Names of the selected statistics (empty for all).
+  *
+  */
+  const std :: vector < std :: string > & names () const
+  {
+    return this->metrics;
+  }
+
+  /**
+  * @brief Set the offsets of the values for the given number of classes.
+  *
+  * @param Nclass number of classes
+  *
+  */
+  void layout (const int32_t & Nclass)
+  {
+    scorer probe;
+    probe.Nclass = Nclass;
+
+    this->stats.clear();
+
+    if ( this->metrics.empty() )
+    {
+      for (int32_t k = 0; k < scorer :: n_stats; ++k)
+        if ( probe.stat_size(k) )
+          this->stats.push_back(k);
+    }
+    else
+      for (const auto & name : this->metrics)
+        this->stats.push_back(scorer :: stat_id(name));
+
+    this->offset.assign(1, 0);
+
+    for (const auto & k : this->stats)
+      this->offset.push_back(this->offset.back() + probe.stat_size(k));
+  }
+
+  /**
+  * @brief Total number of values of the selected statistics (see layout).
+  *
+  */
+  int32_t values () const
+  {
+    return this->offset.back();
+  }
+
+  /**
+  * @brief Copy the values of the selected statistics.
+  *
+  * @param score scorer with the evaluated statistics
+  * @param out output array
+  * @param stride distance between two consecutive values into the output array
+  *
+  */
+  void extract (const scorer & score, double * out, const int64_t & stride = 1) const
+  {
+    for (std :: size_t s = 0; s < this->stats.size(); ++s)
+      for (int32_t v = this->offset[s]; v < this->offset[s + 1]; ++v)
+        out[v * stride] = score.stat_value(this->stats[s], v - this->offset[s]);
+  }
+
+  /**
+  * @brief Position of the first value of a statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return The position or -1 if the statistic is not selected.
+  */
+  int32_t find (const std :: string & name) const
+  {
+    const int32_t k = scorer :: stat_id(name);
+    const auto it = std :: find(this->stats.begin(), this->stats.end(), k);
+
+    return ( k < 0 || it == this->stats.end() ) ? -1 : this->offset[std :: distance(this->stats.begin(), it)];
+  }
+
+  /**
+  * @brief Number of values of a statistic.
+  *
+  * @param name name of the statistic
+  *
+  * @return The number of values (0 if the statistic is not selected).
+  */
+  int32_t size (const std :: string & name) const
+  {
+    const int32_t k = scorer :: stat_id(name);
+    const auto it = std :: find(this->stats.begin(), this->stats.end(), k);
+
+    if ( k < 0 || it == this->stats.end() )
+      return 0;
+
+    const auto s = std :: distance(this->stats.begin(), it);
+    return this->offset[s + 1] - this->offset[s];
+  }
+
+};
+
+#endif // __stat_selection_h__
@@ -0,0 +1,67 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#ifndef __stats_types_h__
+#define __stats_types_h__
+
+#include <cstdint>    // uint64_t
+
+/**
+* @brief Data type of the counters (confusion matrix, TP, FN, FP, TN, POP, P, N, TOP, TON).
+*
+* @details The counts are stored as exact 64-bit integers and they are converted
+* to floating point only by the functors which evaluate rates and scores.
+*
+*/
+using count_t = uint64_t;
+
+/**
+* @brief Data type of the scores (rates, class statistics and overall statistics).
+*
+* @details The scores are stored in single precision by default, while the
+* build option DOUBLE (i.e. the __double_precision__ definition) switches the
+* functors and the scorer to double precision.
+* The definition is a public property of the library (exported by the CMake
+* targets, by the pkg-config file and by setup.py --double), and the scorer is
+* declared into a namespace tagged by the precision (__scorer_abi__), so a program
+* compiled with a different precision of the library fails to link instead of
+* reading a different layout of the scorer.
+* The accumulating reductions (e.g. the Chi-Squared, the entropies and the
+* averages over the classes) always use double accumulators, independently of real_t.
+*
+*/
+#ifdef __double_precision__
+  using real_t = double;
+  #define __scorer_abi__ double_precision
+#else
+  using real_t = float;
+  #define __scorer_abi__ single_precision
+#endif
+
+#endif // __stats_types_h__
@@ -0,0 +1,359 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#ifndef __unique_labels_h__
+#define __unique_labels_h__
+
+#include <vector>           // std :: vector
+#include <algorithm>        // std :: sort
+#include <memory>           // std :: unique_ptr
+#include <cstdint>          // int32_t
+#include <limits>           // std :: numeric_limits
+
+#include <parallel_utils.h> // parallel_chunks
+
+/**
+* @class label_set
+* @brief Flat open-addressing hash set of labels.
+*
+* @details The set uses linear probing with power-of-two capacity and
+* Fibonacci hashing of the keys (the same scheme of label_map).
+* Empty slots are marked by a sentinel value provided at construction time,
+* so the sentinel can not be stored into the set.
+*
+*/
+class label_set
+{
+
+  std :: vector < int32_t > keys; ///< hash table
+
+  int32_t empty; ///< sentinel value of the empty slots
+  int32_t count; ///< number of stored labels
+  int32_t shift; ///< hash shift (32 - log2(capacity))
+  int32_t mask;  ///< hash mask (capacity - 1)
+
+public:
+
+  /**
+  * @brief Construct an empty set.
+  *
+  * @param empty sentinel value of the empty slots (it can not be inserted)
+  * @param hint expected number of labels
+  *
+  */
+  label_set (const int32_t & empty, const int32_t & hint = 16) : empty (empty), count (0)
+  {
+    this->rehash(hint);
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~label_set () = default;
+
+  /**
+  * @brief Number of labels stored into the set.
+  *
+  * @return The size of the set.
+  */
+  int32_t size () const
+  {
+    return this->count;
+  }
+
+  /**
+  * @brief Insert a label into the set.
+  *
+  * @details The table is doubled when the load factor exceeds 1/2.
+  *
+  * @param label label value (different from the sentinel)
+  *
+  */
+  void insert (const int32_t & label)
+  {
+    int32_t pos = this->hash(label);
+
+    while ( this->keys[pos] != this->empty )
+    {
+      if ( this->keys[pos] == label )
+        return;
+
+      pos = (pos + 1) & this->mask;
+    }
+
+    this->keys[pos] = label;
+
+    if ( 2 * ++ this->count > static_cast < int32_t >(this->keys.size()) )
+      this->rehash(this->count);
+  }
+
+  /**
+  * @brief Insert all the labels of another set (with the same sentinel).
+  *
+  * @param other set to merge
+  *
+  */
+  void merge (const label_set & other)
+  {
+    for (const auto & key : other.keys)
+      if ( key != other.empty )
+        this->insert(key);
+  }
+
+  /**
+  * @brief Append the stored labels (in arbitrary order) to the given vector.
+  *
+  * @param out output vector
+  *
+  */
+  void dump (std :: vector < int32_t > & out) const
+  {
+    for (const auto & key : this->keys)
+      if ( key != this->empty )
+        out.push_back(key);
+  }
+
+private:
+
+  /**
+  * @brief Fibonacci hashing of the label.
+  *
+  * @param label label value
+  *
+  * @return The starting position of the label into the hash table.
+  */
+  int32_t hash (const int32_t & label) const
+  {
+    return static_cast < int32_t >( (static_cast < uint32_t >(label) * 2654435769u) >> this->shift );
+  }
+
+  /**
+  * @brief Resize the table to the first power of two greater than 2 * size
+  * and re-insert the stored labels.
+  *
+  * @param size number of labels to accommodate
+  *
+  */
+  void rehash (const int32_t & size)
+  {
+    int32_t nbits = 4;
+    while ( (int64_t(1) << nbits) <= 2 * static_cast < int64_t >(size) )
+      ++ nbits;
+
+    std :: vector < int32_t > old (int64_t(1) << nbits, this->empty);
+    std :: swap(old, this->keys);
+
+    this->shift = 32 - nbits;
+    this->mask  = static_cast < int32_t >(this->keys.size()) - 1;
+    this->count = 0;
+
+    for (const auto & key : old)
+      if ( key != this->empty )
+      {
+        int32_t pos = this->hash(key);
+        while ( this->keys[pos] != this->empty )
+          pos = (pos + 1) & this->mask;
+
+        this->keys[pos] = key;
+        ++ this->count;
+      }
+  }
+
+};
+
+
+/**
+* @brief Sorted array of the distinct labels found in two label arrays.
+*
+* @details The labels are discovered without sorting the input arrays:
+* a first parallel pass evaluates the range [min, max] of the labels,
+* then a second parallel pass marks each label into a bitmap (compact range)
+* or into a flat open-addressing hash set (sparse range).
+* Each chunk of labels works on a private bitmap/hash set which are merged at the end,
+* while bitmaps which do not fit the memory budget are shared and updated with atomic operations.
+* Only the distinct labels are sorted, i.e. the cost is O(n_lbl + width / 64) for
+* the bitmap and O(n_lbl + Nclass log Nclass) for the hash set.
+*
+* @param lbl_true array of true labels
+* @param lbl_pred array of predicted labels
+* @param n_lbl size of the label arrays
+*
+* @return The sorted vector of distinct labels.
+*/
+inline std :: vector < int32_t > unique_labels (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+{
+  constexpr int64_t label_grain   = 1 << 15; // min number of labels for each chunk
+  constexpr int64_t word_grain    = 1 << 14; // min number of bitmap words for each reduction block
+  constexpr int64_t bitmap_factor = 16;      // max number of bitmap bits for each label
+  constexpr int64_t bitmap_extra  = 1 << 20; // label range always stored as bitmap
+  constexpr int64_t private_words = 1 << 22; // max number of words in the private bitmaps
+
+  std :: vector < int32_t > labels;
+
+  if ( n_lbl <= 0 )
+    return labels;
+
+  const int32_t nchunks = num_chunks(n_lbl, label_grain);
+
+  // first pass: range of the labels
+
+  std :: vector < int32_t > lows  (nchunks, std :: numeric_limits < int32_t > :: max());
+  std :: vector < int32_t > highs (nchunks, std :: numeric_limits < int32_t > :: min());
+
+  parallel_chunks(nchunks, [&] (const int32_t & c)
+  {
+    int32_t low  = std :: numeric_limits < int32_t > :: max();
+    int32_t high = std :: numeric_limits < int32_t > :: min();
+
+    const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+    for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+    {
+      low  = std :: min(low,  std :: min(lbl_true[i], lbl_pred[i]));
+      high = std :: max(high, std :: max(lbl_true[i], lbl_pred[i]));
+    }
+
+    lows[c]  = low;
+    highs[c] = high;
+  });
+
+  const int32_t min_lbl = *std :: min_element(lows.begin(), lows.end());
+  const int32_t max_lbl = *std :: max_element(highs.begin(), highs.end());
+  const int64_t width   = static_cast < int64_t >(max_lbl) - min_lbl + 1;
+
+  // second pass: label discovery
+
+  if ( width <= bitmap_factor * n_lbl + bitmap_extra )
+  {
+    const int64_t nwords = (width + 63) / 64;
+
+    // private bitmaps padded to a multiple of the cache line to avoid false sharing
+    constexpr int64_t pad = cache_line / sizeof(uint64_t);
+    const int64_t stride  = (nwords + pad - 1) / pad * pad;
+
+    std :: unique_ptr < uint64_t[] > bitmap;
+
+    if ( stride * nchunks > private_words )
+    {
+      // wide range: shared bitmap with atomic updates
+      bitmap.reset(new uint64_t[nwords]);
+      std :: fill_n(bitmap.get(), nwords, uint64_t(0));
+
+      parallel_chunks(nchunks, [&] (const int32_t & c)
+      {
+        const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+        for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+        {
+          for (const int64_t offset : {static_cast < int64_t >(lbl_true[i]) - min_lbl, static_cast < int64_t >(lbl_pred[i]) - min_lbl})
+          {
+            const uint64_t bit = uint64_t(1) << (offset & 63);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            bitmap[offset >> 6] |= bit;
+          }
+        }
+      });
+    }
+    else
+    {
+      std :: unique_ptr < uint64_t[] > local_bitmaps (new uint64_t[stride * nchunks]);
+
+      parallel_chunks(nchunks, [&] (const int32_t & c)
+      {
+        uint64_t * local = local_bitmaps.get() + c * stride;
+        std :: fill_n(local, nwords, uint64_t(0));
+
+        const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+        for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+        {
+          const int64_t t = static_cast < int64_t >(lbl_true[i]) - min_lbl;
+          const int64_t p = static_cast < int64_t >(lbl_pred[i]) - min_lbl;
+          local[t >> 6] |= uint64_t(1) << (t & 63);
+          local[p >> 6] |= uint64_t(1) << (p & 63);
+        }
+      });
+
+      // reduction of the private bitmaps into the first one
+      const int32_t nblocks = num_chunks(nwords * nchunks, word_grain);
+
+      parallel_chunks(nblocks, [&] (const int32_t & b)
+      {
+        const int64_t end = chunk_begin(nwords, b + 1, nblocks);
+
+        for (int64_t k = chunk_begin(nwords, b, nblocks); k < end; ++k)
+          for (int32_t c = 1; c < nchunks; ++c)
+            local_bitmaps[k] |= local_bitmaps[c * stride + k];
+      });
+
+      bitmap = std :: move(local_bitmaps);
+    }
+
+    // the scan of the bitmap gives the labels already sorted
+    for (int64_t k = 0; k < nwords; ++k)
+      for (uint64_t word = bitmap[k], bit = 0; word; word >>= 1, ++bit)
+        if ( word & 1 )
+          labels.push_back(static_cast < int32_t >(min_lbl + (k << 6) + bit));
+
+    return labels;
+  }
+
+  // sparse range: private hash sets using the minimum label (always present) as sentinel
+
+  std :: vector < label_set > sets (nchunks, label_set(min_lbl));
+
+  parallel_chunks(nchunks, [&] (const int32_t & c)
+  {
+    label_set & local = sets[c];
+
+    const int64_t end = chunk_begin(n_lbl, c + 1, nchunks);
+
+    for (int64_t i = chunk_begin(n_lbl, c, nchunks); i < end; ++i)
+    {
+      if ( lbl_true[i] != min_lbl ) local.insert(lbl_true[i]);
+      if ( lbl_pred[i] != min_lbl ) local.insert(lbl_pred[i]);
+    }
+  });
+
+  for (int32_t c = 1; c < nchunks; ++c)
+    sets[0].merge(sets[c]);
+
+  labels.reserve(sets[0].size() + 1);
+  labels.push_back(min_lbl);
+  sets[0].dump(labels);
+
+  std :: sort(labels.begin() + 1, labels.end());
+
+  return labels;
+}
+
+#endif // __unique_labels_h__
@@ -0,0 +1,220 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+#ifndef __window_accumulator_h__
+#define __window_accumulator_h__
+
+#include <vector>                  // std :: vector
+#include <algorithm>               // std :: min
+#include <cstdint>                 // int32_t
+
+#include <confusion_accumulator.h> // confusion_accumulator
+
+/**
+* @class window_accumulator
+* @brief Confusion matrix of the last labels of a stream (sliding window).
+*
+* @details The last capacity pairs of labels are stored into a ring buffer and
+* the confusion matrix is updated incrementally: each new pair is added to the
+* matrix and the pair which leaves the window is removed, so the cost of an
+* update is O(1) for each label, independently by the size of the window.
+* The statistics are computed only on read (see finalize).
+* The set of classes follows the rules of confusion_accumulator, i.e. it is
+* extended by the new labels (the classes which leave the window are kept
+* with empty rows and columns) unless it is fixed by reset.
+*
+*/
+class window_accumulator
+{
+
+  std :: vector < int32_t > ring_true; ///< ring buffer of the true labels
+  std :: vector < int32_t > ring_pred; ///< ring buffer of the predicted labels
+
+  confusion_accumulator matrix; ///< confusion matrix of the labels in the window
+
+  int32_t head;  ///< position of the oldest pair of labels into the ring buffers
+  int32_t count; ///< number of pairs of labels in the window
+
+public:
+
+  /**
+  * @brief Construct the window.
+  *
+  * @param capacity max number of pairs of labels in the window
+  *
+  */
+  window_accumulator (const int32_t & capacity) : ring_true (capacity), ring_pred (capacity), head (0), count (0)
+  {
+  }
+
+  /**
+  * @brief Default destructor.
+  *
+  */
+  ~window_accumulator () = default;
+
+  /**
+  * @brief Empty the window and set the classes.
+  *
+  * @param classes sorted array of classes (see confusion_accumulator :: reset)
+  * @param Nclass size of classes array (aka number of classes)
+  *
+  */
+  void reset (const float * classes, const int32_t & Nclass)
+  {
+    this->matrix.reset(classes, Nclass);
+    this->head = 0;
+    this->count = 0;
+  }
+
+  /**
+  * @brief Empty the window keeping the classes.
+  *
+  */
+  void clear ()
+  {
+    this->matrix.clear();
+    this->head = 0;
+    this->count = 0;
+  }
+
+  /**
+  * @brief Push a batch of labels into the window.
+  *
+  * @details The oldest pairs which exceed the capacity are removed from the
+  * confusion matrix. The ring buffers are processed as (at most two)
+  * contiguous spans, so a batch costs O(n_lbl) as a sequence of single updates.
+  * If the batch is larger than the window only its last capacity pairs are used.
+  *
+  * @param lbl_true array of true labels as integers
+  * @param lbl_pred array of predicted labels as integers
+  * @param n_lbl size of label arrays
+  *
+  */
+  void update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+  {
+    const int32_t capacity = this->capacity();
+
+    if ( capacity <= 0 )
+      return;
+
+    const int32_t n_new = std :: min(n_lbl, capacity);
+    lbl_true += n_lbl - n_new;
+    lbl_pred += n_lbl - n_new;
+
+    // the oldest pairs leave the window
+    this->evict(this->count + n_new - capacity);
+
+    // the new pairs are appended after the newest one
+    int32_t tail = (this->head + this->count) % capacity;
+
+    for (int32_t done = 0; done < n_new; )
+    {
+      const int32_t span = std :: min(n_new - done, capacity - tail);
+
+      std :: copy_n(lbl_true + done, span, this->ring_true.data() + tail);
+      std :: copy_n(lbl_pred + done, span, this->ring_pred.data() + tail);
+
+      done += span;
+      tail = (tail + span) % capacity;
+    }
+
+    this->matrix.update(lbl_true, lbl_pred, n_new);
+    this->count += n_new;
+  }
+
+  /**
+  * @brief Compute the scores of the labels in the window.
+  *
+  * @tparam Scorer scorer type (see scorer :: compute_from_confusion_matrix)
+  * @param score scorer object which stores the results
+  *
+  */
+  template < typename Scorer >
+  void finalize (Scorer & score) const
+  {
+    this->matrix.finalize(score);
+  }
+
+  /**
+  * @brief Number of pairs of labels in the window.
+  *
+  */
+  int32_t size () const
+  {
+    return this->count;
+  }
+
+  /**
+  * @brief Max number of pairs of labels in the window.
+  *
+  */
+  int32_t capacity () const
+  {
+    return static_cast < int32_t >(this->ring_true.size());
+  }
+
+  /**
+  * @brief Confusion matrix of the window.
+  *
+  * @return The accumulator which stores the classes and the counts of the window.
+  */
+  const confusion_accumulator & confusion_matrix () const
+  {
+    return this->matrix;
+  }
+
+private:
+
+  /**
+  * @brief Remove the oldest pairs of labels from the window.
+  *
+  * @param n_old number of pairs to remove (no-op if not positive)
+  *
+  */
+  void evict (int32_t n_old)
+  {
+    const int32_t capacity = this->capacity();
+
+    n_old = std :: min(n_old, this->count);
+
+    while ( n_old > 0 )
+    {
+      const int32_t span = std :: min(n_old, capacity - this->head);
+
+      this->matrix.remove(this->ring_true.data() + this->head, this->ring_pred.data() + this->head, span);
+
+      this->head = (this->head + span) % capacity;
+      this->count -= span;
+      n_old -= span;
+    }
+  }
+
+};
+
+#endif // __window_accumulator_h__
@@ -7,9 +7,20 @@
 # ***************************************************
 
 from libcpp.vector cimport vector
+from libcpp.string cimport string
+from libcpp cimport bool
 from libcpp.memory cimport unique_ptr
+from libc.stdint cimport uint64_t
+from libc.stdint cimport int64_t
+from libc.stdint cimport uint8_t
 
-cdef extern from "scorer.h":
+ctypedef uint64_t count_t
+
+cdef extern from "stats_types.h":
+  # float or double according to the DOUBLE build option
+  ctypedef float real_t
+
+cdef extern from "scorer.h" nogil:
 
   cppclass scorer:
 
@@ -18,137 +29,210 @@ cdef extern from "scorer.h":
     # Attributes
 
     vector[float] classes
-    unique_ptr[float] confusion_matrix
-    unique_ptr[float] TP
-    unique_ptr[float] FN
-    unique_ptr[float] FP
-    unique_ptr[float] TN
-    unique_ptr[float] POP
-    unique_ptr[float] P
-    unique_ptr[float] N
-    unique_ptr[float] TOP
-    unique_ptr[float] TON
-    unique_ptr[float] TPR
-    unique_ptr[float] TNR
-    unique_ptr[float] PPV
-    unique_ptr[float] NPV
-    unique_ptr[float] FNR
-    unique_ptr[float] FPR
-    unique_ptr[float] FDR
-    unique_ptr[float] FOR
-    unique_ptr[float] ACC
-    unique_ptr[float] F1_SCORE
-    unique_ptr[float] F05_SCORE
-    unique_ptr[float] F2_SCORE
-    unique_ptr[float] MCC
-    unique_ptr[float] BM
-    unique_ptr[float] MK
-    unique_ptr[float] ICSI
-    unique_ptr[float] PLR
-    unique_ptr[float] NLR
-    unique_ptr[float] DOR
-    unique_ptr[float] PRE
-    unique_ptr[float] G
-    unique_ptr[float] RACC
-    unique_ptr[float] ERR_ACC
-    unique_ptr[float] RACCU
-    unique_ptr[float] jaccard_index
-    unique_ptr[float] IS
-    unique_ptr[float] CEN
-    unique_ptr[float] MCEN
-    unique_ptr[float] AUC
-    unique_ptr[float] dIND
-    unique_ptr[float] sIND
-    unique_ptr[float] DP
-    unique_ptr[float] Y
-    unique_ptr[float] PLRI
-    unique_ptr[float] NLRI
-    unique_ptr[float] DPI
-    unique_ptr[float] AUCI
-    unique_ptr[float] GI
-    unique_ptr[float] LS
-    unique_ptr[float] AM
-    unique_ptr[float] OP
-    unique_ptr[float] IBA
-    unique_ptr[float] GM
-    unique_ptr[float] Q
-    unique_ptr[float] AGM
-    unique_ptr[float] MCCI
-    unique_ptr[float] AGF
-    unique_ptr[float] OC
-    unique_ptr[float] OOC
-    unique_ptr[float] AUPR
-    unique_ptr[float] BCD
-    float overall_accuracy
-    float overall_random_accuracy_unbiased
-    float overall_random_accuracy
-    float overall_kappa
-    float PI
-    float AC1
-    float S
-    float kappa_SE
-    float kappa_unbiased
-    float kappa_no_prevalence
-    float kappa_CI_up
-    float kappa_CI_down
-    float overall_accuracy_se
-    float overall_accuracy_ci_up
-    float overall_accuracy_ci_down
-    float chi_square
-    float phi_square
-    float cramer_V
-    float response_entropy
-    float reference_entropy
-    float cross_entropy
-    float join_entropy
-    float conditional_entropy
-    float mutual_information
-    float kl_divergence
-    float lambda_B
-    float lambda_A
-    float DF
-    float overall_jaccard_index
-    float hamming_loss
-    float zero_one_loss
-    float NIR
-    float p_value
-    float overall_CEN
-    float overall_MCEN
-    float overall_MCC
-    float RR
-    float CBA
-    float AUNU
-    float AUNP
-    float RCI
-    float CSI
-    float overall_pearson_C
-    float TPR_PPV_F1_micro
-    float MCC_analysis
-    float kappa_analysis_cicchetti
-    float kappa_analysis_koch
-    float kappa_analysis_fleiss
-    float kappa_analysis_altman
-    float V_analysis
-    float TPR_macro
-    float PPV_macro
-    float ACC_macro
-    float F1_macro
+    count_t * confusion_matrix
+    count_t * TP
+    count_t * FN
+    count_t * FP
+    count_t * TN
+    count_t * POP
+    count_t * P
+    count_t * N
+    count_t * TOP
+    count_t * TON
+    real_t * TPR
+    real_t * TNR
+    real_t * PPV
+    real_t * NPV
+    real_t * FNR
+    real_t * FPR
+    real_t * FDR
+    real_t * FOR
+    real_t * ACC
+    real_t * F1_SCORE
+    real_t * F05_SCORE
+    real_t * F2_SCORE
+    real_t * MCC
+    real_t * BM
+    real_t * MK
+    real_t * ICSI
+    real_t * PLR
+    real_t * NLR
+    real_t * DOR
+    real_t * PRE
+    real_t * G
+    real_t * RACC
+    real_t * ERR_ACC
+    real_t * RACCU
+    real_t * jaccard_index
+    real_t * IS
+    real_t * CEN
+    real_t * MCEN
+    real_t * AUC
+    real_t * dIND
+    real_t * sIND
+    real_t * DP
+    real_t * Y
+    real_t * PLRI
+    real_t * NLRI
+    real_t * DPI
+    real_t * AUCI
+    real_t * GI
+    real_t * LS
+    real_t * AM
+    real_t * OP
+    real_t * IBA
+    real_t * GM
+    real_t * Q
+    real_t * AGM
+    real_t * MCCI
+    real_t * AGF
+    real_t * OC
+    real_t * OOC
+    real_t * AUPR
+    real_t * BCD
+    real_t overall_accuracy
+    real_t overall_random_accuracy_unbiased
+    real_t overall_random_accuracy
+    real_t overall_kappa
+    real_t PI
+    real_t AC1
+    real_t S
+    real_t kappa_SE
+    real_t kappa_unbiased
+    real_t kappa_no_prevalence
+    real_t kappa_CI_up
+    real_t kappa_CI_down
+    real_t overall_accuracy_se
+    real_t overall_accuracy_ci_up
+    real_t overall_accuracy_ci_down
+    real_t chi_square
+    real_t phi_square
+    real_t cramer_V
+    real_t response_entropy
+    real_t reference_entropy
+    real_t cross_entropy
+    real_t join_entropy
+    real_t conditional_entropy
+    real_t mutual_information
+    real_t kl_divergence
+    real_t lambda_B
+    real_t lambda_A
+    real_t DF
+    real_t overall_jaccard_index
+    real_t hamming_loss
+    real_t zero_one_loss
+    real_t NIR
+    real_t p_value
+    real_t overall_CEN
+    real_t overall_MCEN
+    real_t overall_MCC
+    real_t RR
+    real_t CBA
+    real_t AUNU
+    real_t AUNP
+    real_t RCI
+    real_t CSI
+    real_t overall_pearson_C
+    real_t TPR_PPV_F1_micro
+    real_t MCC_analysis
+    real_t kappa_analysis_cicchetti
+    real_t kappa_analysis_koch
+    real_t kappa_analysis_fleiss
+    real_t kappa_analysis_altman
+    real_t V_analysis
+    real_t TPR_macro
+    real_t PPV_macro
+    real_t ACC_macro
+    real_t F1_macro
 
     # Methods
     void compute_score(int *, int *, int, int)
+    void compute_from_confusion_matrix[T](T *, int, float *)
+    void set_classes(int *, int)
+    bool select(vector[string])
     void print_class_stats[T](T&)
     void print_overall_stats[T](T&)
 
 
+cdef extern from "batch_scorer.h" nogil:
+
+  cppclass batch_scorer:
+
+    batch_scorer() except +
+
+    void compute_score(int **, int **, int *, int)
+    void compute_score(int *, int *, int, int)
+    bool select(vector[string])
+    int size()
+    scorer & operator[](int)
+
+
+cdef extern from "bootstrap.h" nogil:
+
+  cppclass bootstrap:
+
+    bootstrap(int, uint64_t) except +
+
+    bool select(vector[string])
+    void compute(count_t *, int, float *, float)
+    const real_t * ci_down(string)
+    const real_t * ci_up(string)
+    int size(string)
+
+
+cdef extern from "permutation_test.h" nogil:
+
+  cppclass permutation_test:
+
+    permutation_test(int, uint64_t) except +
+
+    bool select(vector[string])
+    void compute(int *, int *, int *, int)
+    const real_t * p_value(string)
+    const double * difference(string)
+    int size(string)
+
+
+cdef extern from "label_encoder.h" nogil:
+
+  cppclass label_encoder:
+
+    label_encoder() except +
+
+    int encode[T](T *, T *, int, int *, int *)
+    int encode_fixed[T](T *, int, T *, int, int, int *, int *)
+    int encode_strings(const uint8_t **, int64_t *, const uint8_t **, int64_t *, int, int *, int *)
+    int size()
+    const int64_t * index()
+
+
 cdef extern from "<utility>" namespace "std" nogil:
 
   cdef unique_ptr[scorer] move(unique_ptr[scorer])
 
 
-cdef class _scorer:
+cdef class _score_owner:
 
   cdef unique_ptr[scorer] thisptr
+  cdef unique_ptr[batch_scorer] batchptr
+  cdef object selected
+
+
+cdef class _score_buffer:
+
+  cdef _score_owner owner
+  cdef char * data
+  cdef Py_ssize_t shape[1]
+  cdef Py_ssize_t strides[1]
+  cdef bytes fmt
+
+
+cdef class _scorer:
+
+  cdef vector[string] _stats
+  cdef object _selected
 
-  cdef public:
-    int Nclass
+  cdef _score_owner _new_scorer (self)
+  cdef _score_owner _new_batch_scorer (self)
+  cdef dict _score (self, scorer * obj, _score_owner owner)
   
\ No newline at end of file
@@ -5,6 +5,7 @@ import numpy as np
 import warnings
 
 from scorer.lib.scorer import _scorer
+from scorer.lib.scorer import _encode_labels
 
 __author__  = ['Nico Curti']
 __email__   = ['nico.curti2@unibo.it']
@@ -81,44 +82,66 @@ class Scorer (dict):
           class_name, len(true), len(pred)))
 
 
-  def _label2numbers (self, arr):
+  def _label2numbers (self, lbl_true, lbl_pred):
     '''
-    Convert labels to numerical values
+    Convert the labels of the two arrays to numerical values
 
     Parameters
     ----------
-      arr : array_like
-        The array of labels
+      lbl_true : array_like
+        The array of true labels
+
+      lbl_pred : array_like
+        The array of predicted labels
 
     Returns
     -------
-      numeric_labels : np.ndarray
-        Array of numerical labels obtained by the
-        LabelEncoder transform
+      true_labels : np.ndarray
+        Array of numerical true labels
+
+      pred_labels : np.ndarray
+        Array of numerical predicted labels
+
+      classes : np.ndarray
+        Sorted array of the classes, i.e the label
+        of each numerical value
 
     Notes
     -----
       .. note::
         The C++ function allows only numerical (integer)
         values as labels in input.
-        For more general support refers to the C++ example.
+        The labels are encoded by the C++ label_encoder,
+        which hashes the labels (numbers, fixed-width
+        strings and str objects) in a single parallel pass
+        instead of sorting them.
+        The other dtypes are encoded by np.unique.
 
     Examples
     --------
     >>> from scorer import scorer
-    >>> y = ('A', 'A', 'B', 'B')
-    >>> num_y = scorer()._label2numbers(y)
-    >>> print(num_y)
-      [0, 0, 1, 1]
+    >>> y_true = ('A', 'A', 'B', 'B')
+    >>> y_pred = ('A', 'C', 'B', 'B')
+    >>> num_true, num_pred, classes = scorer()._label2numbers(y_true, y_pred)
+    >>> print(num_true, num_pred, classes)
+      [0, 0, 1, 1] [0, 2, 1, 1] ['A', 'B', 'C']
     '''
-    unique, numeric_labels = np.unique(arr, return_inverse=True)
+    lbl_true = np.asarray(lbl_true).ravel()
+    lbl_pred = np.asarray(lbl_pred).ravel()
+
+    encoded = _encode_labels(lbl_true, lbl_pred)
 
-    if unique.size <= 1:
+    if encoded is None:
+      classes, numeric_labels = np.unique(np.concatenate((lbl_true, lbl_pred)), return_inverse=True)
+      numeric_labels = numeric_labels.astype('int32')
+      encoded = (numeric_labels[:lbl_true.size], numeric_labels[lbl_true.size:], classes)
+
+    if encoded[2].size <= 1:
       raise ValueError('The number of classes must be greater than 1')
 
-    return numeric_labels.astype('int32'), unique
+    return encoded
 
-  def evaluate (self, lbl_true, lbl_pred):
+  def evaluate (self, lbl_true, lbl_pred, metrics=None):
     '''
     Evaluate scores of prediction labels vs true labels
 
@@ -130,6 +153,11 @@ class Scorer (dict):
       lbl_pred : array-like
         List of predicted labels
 
+      metrics : str or array-like (default=None)
+        Names of the metrics to evaluate (score keys or sklearn names).
+        Only the required metrics and their dependencies are computed.
+        If None all the available metrics are evaluated
+
     Returns
     -------
       self
@@ -150,25 +178,427 @@ class Scorer (dict):
     >>> y_pred = y_pred.tolist()
     >>>
     >>> scorer.evaluate(y_true, y_pred)
+    >>>
+    >>> # Evaluate only a subset of metrics
+    >>>
+    >>> scorer.evaluate(y_true, y_pred, metrics=['accuracy_score', 'F1(F1 score - harmonic mean of precision and sensitivity)'])
 
     Notes
     -----
     .. note::
       The score evaluation is possible only with integer labels.
       The input labels are encoded in integers using the C++
-      version of the label encoder (_label2numbers).
+      version of the label encoder (_label2numbers), whose
+      codes are used as classes of the scorer without any
+      further discovery of the classes.
     '''
 
     self._check_params(lbl_true, lbl_pred)
 
-    y_true, true_names = self._label2numbers(lbl_true)
-    y_pred, true_names = self._label2numbers(lbl_pred)
+    y_true, y_pred, names = self._label2numbers(lbl_true, lbl_pred)
 
     # set contiguous order memory for c++ compatibility
     y_true = np.ascontiguousarray(y_true)
     y_pred = np.ascontiguousarray(y_pred)
 
-    score = self._obj.evaluate(y_true, y_pred, len(y_true))
+    self._select(metrics)
+    score = self._obj.evaluate(y_true, y_pred, len(y_true), len(names))
+    self._set_score(score, names)
+
+    return self
+
+  def evaluate_confusion_matrix (self, confusion_matrix, classes=None, metrics=None):
+    '''
+    Evaluate scores from a confusion matrix, skipping the processing of the labels
+
+    Parameters
+    ----------
+      confusion_matrix : array-like
+        Square matrix of counts with true labels along the rows
+        and predicted labels along the columns
+
+      classes : array-like (default=None)
+        Names of the classes in the order of the rows.
+        If None the classes are 0, ..., Nclass - 1
+
+      metrics : str or array-like (default=None)
+        Names of the metrics to evaluate (see evaluate)
+
+    Returns
+    -------
+      self
+
+    Examples
+    --------
+    >>> from scorer import Scorer
+    >>> cm = [[3, 0, 0],
+    >>>       [0, 1, 2],
+    >>>       [2, 1, 3]]
+    >>>
+    >>> scorer = Scorer()
+    >>> scorer.evaluate_confusion_matrix(cm, classes=['a', 'b', 'c'])
+
+    Notes
+    -----
+    .. note::
+      The cost of the evaluation depends only on the number of
+      classes, so it is the natural way to score matrices which
+      are accumulated (e.g. summed) over different data shards.
+    '''
+
+    confusion_matrix = np.asarray(confusion_matrix)
+
+    if confusion_matrix.ndim != 2 or confusion_matrix.shape[0] != confusion_matrix.shape[1]:
+      class_name = self.__class__.__name__
+      raise ValueError('{0}: wrong shape found. '
+        'The confusion matrix must be a square matrix, '
+        'found shape {1}'.format(class_name, confusion_matrix.shape))
+
+    Nclass = confusion_matrix.shape[0]
+
+    if Nclass <= 1:
+      raise ValueError('The number of classes must be greater than 1')
+
+    if np.any(confusion_matrix < 0):
+      raise ValueError('The confusion matrix must contain non-negative counts')
+
+    names = np.arange(Nclass) if classes is None else np.asarray(classes)
+
+    if len(names) != Nclass:
+      class_name = self.__class__.__name__
+      raise ValueError('{0}: wrong shapes found. '
+        'Found {1} classes for a confusion matrix of {2} classes'.format(
+          class_name, len(names), Nclass))
+
+    # set contiguous order memory for c++ compatibility
+    confusion_matrix = np.ascontiguousarray(confusion_matrix.ravel(), dtype=np.uint64)
+    encoded = np.arange(Nclass, dtype=np.float32)
+
+    self._select(metrics)
+    score = self._obj.evaluate_confusion_matrix(confusion_matrix, encoded, Nclass)
+    self._set_score(score, names)
+
+    return self
+
+  def evaluate_batch (self, lbl_true, lbl_pred, metrics=None):
+    '''
+    Evaluate the scores of K predictions in a single call
+
+    Parameters
+    ----------
+      lbl_true : list of array-like or array-like
+        List of K arrays of true labels or a single array
+        of true labels shared by all the predictions
+
+      lbl_pred : list of array-like or 2D array-like
+        List of K arrays of predicted labels or a matrix
+        (n_samples, K) with a prediction for each column
+
+      metrics : str or array-like (default=None)
+        Names of the metrics to evaluate (see evaluate)
+
+    Returns
+    -------
+      scores : list of Scorer
+        The scores of each prediction
+
+    Examples
+    --------
+    >>> from scorer import Scorer
+    >>> y_true = np.random.choice([0, 1, 2], size=(100, ))
+    >>> y_pred = np.random.choice([0, 1, 2], size=(100, 10))
+    >>>
+    >>> scores = Scorer().evaluate_batch(y_true, y_pred)
+    >>> print([score['Overall ACC'] for score in scores])
+
+    Notes
+    -----
+    .. note::
+      The evaluations are distributed over the available threads
+      (each one is computed serially), so the batch is efficient
+      for many small label arrays (e.g. bootstrap or hyperparameter search).
+    '''
+
+    columns = not isinstance(lbl_pred, (list, tuple)) or not len(lbl_pred) or np.ndim(lbl_pred[0]) == 0
+
+    if columns:
+      lbl_pred = np.asarray(lbl_pred)
+
+      if lbl_pred.ndim != 2:
+        class_name = self.__class__.__name__
+        raise ValueError('{0}: wrong shape found. '
+          'The predictions must be a matrix (n_samples, K), '
+          'found shape {1}'.format(class_name, lbl_pred.shape))
+
+      lbl_pred = list(lbl_pred.T)
+
+    shared = not isinstance(lbl_true, (list, tuple)) or not len(lbl_true) or np.ndim(lbl_true[0]) == 0
+    lbl_true = [np.asarray(lbl_true)] * len(lbl_pred) if shared else [np.asarray(y) for y in lbl_true]
+    lbl_pred = [np.asarray(y) for y in lbl_pred]
+
+    if len(lbl_true) != len(lbl_pred):
+      class_name = self.__class__.__name__
+      raise ValueError('{0}: wrong shapes found. '
+        'Found {1} true arrays and {2} predicted arrays'.format(
+          class_name, len(lbl_true), len(lbl_pred)))
+
+    for true, pred in zip(lbl_true, lbl_pred):
+      self._check_params(true, pred)
+
+    # the labels of all the evaluations are encoded together
+    names = np.unique(np.concatenate((lbl_true[:1] if shared else lbl_true) + lbl_pred))
+
+    def encode (arr):
+      return np.ascontiguousarray(np.searchsorted(names, arr), dtype=np.int32)
+
+    y_true = [encode(y) for y in (lbl_true[:1] if shared else lbl_true)]
+    y_pred = [encode(y) for y in lbl_pred]
+
+    for k in range(len(y_pred)):
+      if np.unique(np.concatenate((y_true[0 if shared else k], y_pred[k]))).size <= 1:
+        raise ValueError('The number of classes must be greater than 1')
+
+    self._select(metrics)
+
+    if shared and columns:
+      scores = self._obj.evaluate_columns(y_true[0], np.ascontiguousarray(y_pred))
+    else:
+      scores = self._obj.evaluate_batch(y_true * len(y_pred) if shared else y_true, y_pred)
+
+    results = []
+
+    for score in scores:
+      result = Scorer()
+      result._set_score(score, names[np.asarray(score['Classes'], dtype=int)])
+      results.append(result)
+
+    return results
+
+  def bootstrap (self, n_reps=1000, alpha=0.05, metrics=None, seed=42):
+    '''
+    Bootstrap confidence intervals of the scores
+
+    Parameters
+    ----------
+      n_reps : int (default=1000)
+        Number of bootstrap replicates
+
+      alpha : float (default=0.05)
+        Significance level, i.e. the intervals cover the (1 - alpha)
+        of the replicates
+
+      metrics : str or array-like (default=None)
+        Names of the metrics (score keys or sklearn names).
+        If None the intervals of all the available scores are computed
+
+      seed : int (default=42)
+        Seed of the random number generator
+
+    Returns
+    -------
+      intervals : dict
+        Lower and upper bounds of each metric (arrays for the class scores)
+
+    Examples
+    --------
+    >>> from scorer import Scorer
+    >>> y_true = np.random.choice([0, 1, 2], size=(100, ))
+    >>> y_pred = np.random.choice([0, 1, 2], size=(100, ))
+    >>>
+    >>> scorer = Scorer()
+    >>> scorer.evaluate(y_true, y_pred)
+    >>> ci = scorer.bootstrap(n_reps=1000, metrics=['accuracy_score', 'class_f1score'])
+
+    Notes
+    -----
+    .. note::
+      The replicates resample the confusion matrix (multinomial draws
+      of each row), so the cost does not depend on the number of samples.
+      The results are reproducible for a given seed, independently by
+      the number of threads.
+    '''
+
+    if not len(self):
+      class_name = self.__class__.__name__
+      raise ValueError('{0}: score not computed yet. '
+                       'Please use the "evaluate" method before'.format(
+                        class_name))
+
+    if not 0. < alpha < 1.:
+      raise ValueError('The significance level must be in (0, 1)')
+
+    labels, stats = self._inference_stats(metrics, 'Bootstrap')
+
+    confusion_matrix = np.ascontiguousarray(np.ravel(self['Confusion Matrix']), dtype=np.uint64)
+    Nclass = len(self['Classes'])
+    encoded = np.arange(Nclass, dtype=np.float32)
+
+    intervals = self._obj.compute_bootstrap(confusion_matrix, encoded, Nclass, stats, n_reps, seed, alpha)
+
+    return {label : tuple(bound[0] if len(bound) == 1 else np.asarray(bound) for bound in intervals[stat])
+            for label, stat in zip(labels, stats)}
+
+  def permutation_test (self, lbl_true, lbl_pred_a, lbl_pred_b, n_perm=1000, metrics=None, seed=42):
+    '''
+    Paired permutation test between two classifiers evaluated on the same labels
+
+    Parameters
+    ----------
+      lbl_true : array-like
+        List of true labels
+
+      lbl_pred_a : array-like
+        List of labels predicted by the first classifier
+
+      lbl_pred_b : array-like
+        List of labels predicted by the second classifier
+
+      n_perm : int (default=1000)
+        Number of permutations
+
+      metrics : str or array-like (default=None)
+        Names of the metrics (score keys or sklearn names).
+        If None all the available scores are compared
+
+      seed : int (default=42)
+        Seed of the random number generator
+
+    Returns
+    -------
+      pvalues : dict
+        Two-sided p-value of the difference of each metric (arrays for the class scores)
+
+    Examples
+    --------
+    >>> from scorer import Scorer
+    >>> y_true = np.random.choice([0, 1, 2], size=(100, ))
+    >>> y_pred_a = np.random.choice([0, 1, 2], size=(100, ))
+    >>> y_pred_b = np.random.choice([0, 1, 2], size=(100, ))
+    >>>
+    >>> scorer = Scorer()
+    >>> pvalues = scorer.permutation_test(y_true, y_pred_a, y_pred_b, metrics=['accuracy_score', 'mcc'])
+
+    Notes
+    -----
+    .. note::
+      The scores of the first classifier are stored into the scorer.
+      Each permutation swaps the two predictions of each sample with
+      probability 1/2 and it is applied as an update of the two confusion
+      matrices, so the cost does not depend on the number of samples.
+      The results are reproducible for a given seed, independently by
+      the number of threads.
+    '''
+
+    lbl_true = np.asarray(lbl_true)
+    lbl_pred_a = np.asarray(lbl_pred_a)
+    lbl_pred_b = np.asarray(lbl_pred_b)
+
+    self._check_params(lbl_true, lbl_pred_a)
+    self._check_params(lbl_true, lbl_pred_b)
+
+    self.evaluate(lbl_true, lbl_pred_a, metrics=metrics)
+
+    labels, stats = self._inference_stats(metrics, 'Permutation test')
+
+    # the labels of the two classifiers are encoded together
+    names = np.unique(np.concatenate((lbl_true, lbl_pred_a, lbl_pred_b)))
+
+    def encode (arr):
+      return np.ascontiguousarray(np.searchsorted(names, arr), dtype=np.int32)
+
+    pvalues = self._obj.compute_permutation_test(encode(lbl_true), encode(lbl_pred_a), encode(lbl_pred_b),
+                                                 len(lbl_true), stats, n_perm, seed)
+
+    return {label : pvalues[stat][0] if len(pvalues[stat]) == 1 else np.asarray(pvalues[stat])
+            for label, stat in zip(labels, stats)}
+
+  def _inference_stats (self, metrics, engine):
+    '''
+    Labels and native names of the scores resampled by the inference engines
+
+    Parameters
+    ----------
+      metrics : str or array-like
+        Names of the metrics (score keys or sklearn names).
+        If None all the available numerical scores are used
+
+      engine : str
+        Name of the engine (used in the error message)
+
+    Returns
+    -------
+      labels : list
+        Score keys
+
+      stats : list
+        Names of the corresponding members of the C++ scorer
+    '''
+
+    members = self._obj._members
+
+    if metrics is None:
+      # the interpretations of the scores are not numerical
+      labels = [label for label in self.keys()
+                if len(members.get(label, [])) == 1 and np.asarray(self[label]).dtype.kind in 'biuf']
+
+    else:
+
+      # convert str to iterable
+      if isinstance(metrics, str):
+        metrics = [metrics]
+
+      available_metrics = self._get_available_metrics
+      labels = [available_metrics.get(metric, metric) for metric in metrics]
+
+      unknown = [label for label in labels if len(members.get(label, [])) != 1]
+
+      if unknown:
+        raise ValueError('{0} is not available for the metrics: {1}'.format(engine, ', '.join(unknown)))
+
+    return labels, [members[label][0] for label in labels]
+
+  def _select (self, metrics):
+    '''
+    Restrict the evaluation to the given metrics
+
+    Parameters
+    ----------
+      metrics : str or array-like
+        Names of the metrics (score keys or sklearn names).
+        If None all the metrics are evaluated
+
+    Notes
+    -----
+    .. note::
+      If a metric is not found a ValueError is raised.
+    '''
+
+    if metrics is None:
+      self._obj.select([])
+      return
+
+    # convert str to iterable
+    if isinstance(metrics, str):
+      metrics = [metrics]
+
+    available_metrics = self._get_available_metrics
+    metrics = [available_metrics.get(metric, metric) for metric in metrics]
+
+    self._obj.select(metrics)
+
+  def _set_score (self, score, names):
+    '''
+    Store the scores computed by the C++ object
+
+    Parameters
+    ----------
+      score : dict
+        Scores as returned by the Cython object
+
+      names : array-like
+        Names of the classes
+    '''
+    self.clear()
     self.update(score)
 
     with warnings.catch_warnings():
@@ -176,9 +606,7 @@ class Scorer (dict):
       self['Confusion Matrix'] = np.reshape(self['Confusion Matrix'],
                                             newshape=(len(self['Classes']),
                                                       len(self['Classes'])))
-      self['Classes'] = true_names
-
-    return self
+      self['Classes'] = names
 
   @property
   def score (self):
@@ -347,7 +775,7 @@ class Scorer (dict):
     '''
     Object representation
     '''
-    return str(self._obj)
+    return '<Scorer (classes: {0})>'.format(self.num_classes)
 
   def __str__ (self):
     '''
@@ -366,7 +794,7 @@ class Scorer (dict):
     array_fmt   = ' '.join(['{:>20}'    for _ in range(len(self['Classes']))])
 
     for k, v in self.items():
-      if isinstance(v, list) and k not in ['Classes', 'Confusion Matrix']:
+      if isinstance(v, (list, np.ndarray)) and k not in ['Classes', 'Confusion Matrix']:
         try:
           fmt += '{name:<80} {value}\n'.format(**{'name' : k,
                                                   'value' : numeric_fmt.format(*v)})
@@ -379,7 +807,7 @@ class Scorer (dict):
     fmt += '\nOverall Statistics:\n\n'
 
     for k, v in self.items():
-      if not isinstance(v, list) and k not in ['Classes', 'Confusion Matrix']:
+      if not isinstance(v, (list, np.ndarray)) and k not in ['Classes', 'Confusion Matrix']:
         try:
           fmt += '{name:<80} {value:.3f}\n'.format(**{'name' : k, 'value' : v})
         except (ValueError, TypeError):
@@ -80,9 +80,11 @@ def score_metrics (y_true, y_pred, metrics=['accuracy_score']):
                       Available metrics are {1}'.format(
                       metrics, ','.join(available_metrics)))
 
-  scorer.evaluate(y_true, y_pred)
-
   metrics = [available_metrics[metric] for metric in metrics]
+
+  # evaluate only the required metrics (and their dependencies)
+  scorer.evaluate(y_true, y_pred, metrics=metrics)
+
   results = [scorer[metric] for metric in metrics]
 
   return results if len(results) > 1 else results[0]
@@ -8,138 +8,615 @@
 
 from cython.operator cimport dereference as deref
 from libcpp.memory cimport unique_ptr
+from cpython.buffer cimport PyBUF_FORMAT
+
+from libcpp.vector cimport vector
+from libcpp.string cimport string
 
 from scorer cimport scorer
+from scorer cimport batch_scorer
+from scorer cimport bootstrap
+from scorer cimport permutation_test
+from scorer cimport label_encoder
+from libc.stdint cimport uint64_t
+from libc.stdint cimport int64_t
+from libc.stdint cimport uint8_t
+from libc.stdint cimport uint32_t
+from scorer cimport count_t
+from scorer cimport real_t
+
+cdef extern from "Python.h":
+  const char * PyUnicode_AsUTF8AndSize (object, Py_ssize_t *) except NULL
+
+import numpy as np
+
+
+# Owner of the C++ objects which store the results of an evaluation
+# (with the metrics selected at the call): the arrays returned by the
+# _scorer keep a reference to it.
+cdef class _score_owner:
+  pass
+
+
+# Buffer protocol exporter of an array stored in a _score_owner
+cdef class _score_buffer:
+
+  def __getbuffer__ (self, Py_buffer * buffer, int flags):
+    buffer.buf = self.data
+    buffer.obj = self
+    buffer.len = self.shape[0] * self.strides[0]
+    buffer.readonly = 0
+    buffer.itemsize = self.strides[0]
+    buffer.format = <char *> self.fmt if flags & PyBUF_FORMAT else NULL
+    buffer.ndim = 1
+    buffer.shape = self.shape
+    buffer.strides = self.strides
+    buffer.suboffsets = NULL
+    buffer.internal = NULL
+
+  def __releasebuffer__ (self, Py_buffer * buffer):
+    pass
+
+
+cdef object _as_array (_score_owner owner, void * data, Py_ssize_t size, Py_ssize_t itemsize, bytes fmt):
+  # the numpy array shares the memory of the C++ object without any copy
+  cdef _score_buffer view = _score_buffer.__new__(_score_buffer)
+  view.owner = owner
+  view.data = <char *> data
+  view.shape[0] = size
+  view.strides[0] = itemsize
+  view.fmt = fmt
+  return np.asarray(view)
+
+cdef object _count_array (_score_owner owner, count_t * data, Py_ssize_t size):
+  return _as_array(owner, data, size, sizeof(count_t), b'Q')
+
+cdef object _real_array (_score_owner owner, real_t * data, Py_ssize_t size):
+  return _as_array(owner, data, size, sizeof(real_t), b'd' if sizeof(real_t) == sizeof(double) else b'f')
+
+cdef object _float_array (_score_owner owner, float * data, Py_ssize_t size):
+  return _as_array(owner, data, size, sizeof(float), b'f')
+
+
+def _encode_labels (lbl_true, lbl_pred):
+  # Encode the labels of the two arrays into the indexes of their sorted classes
+  # with the hash-based label_encoder (a single parallel pass without GIL).
+  # Supported labels are numbers, fixed-width strings and str objects:
+  # the function returns None for the other dtypes.
+
+  cdef int n_lbl = lbl_true.shape[0]
+
+  if n_lbl == 0:
+    return None
+
+  kind_true, kind_pred = lbl_true.dtype.kind, lbl_pred.dtype.kind
+
+  code_true = np.empty(shape=(n_lbl, ), dtype=np.int32)
+  code_pred = np.empty(shape=(n_lbl, ), dtype=np.int32)
+
+  cdef int[::1] c_true = code_true
+  cdef int[::1] c_pred = code_pred
+  cdef int * y_true = &c_true[0]
+  cdef int * y_pred = &c_pred[0]
+
+  cdef label_encoder encoder
+  cdef int Nclass
+
+  cdef int[::1] i32_true, i32_pred
+  cdef int64_t[::1] i64_true, i64_pred
+  cdef float[::1] f32_true, f32_pred
+  cdef double[::1] f64_true, f64_pred
+  cdef uint8_t[::1] s_true, s_pred
+  cdef uint32_t[::1] u_true, u_pred
+  cdef int * pi32_true
+  cdef int * pi32_pred
+  cdef int64_t * pi64_true
+  cdef int64_t * pi64_pred
+  cdef float * pf32_true
+  cdef float * pf32_pred
+  cdef double * pf64_true
+  cdef double * pf64_pred
+  cdef uint8_t * ps_true
+  cdef uint8_t * ps_pred
+  cdef uint32_t * pu_true
+  cdef uint32_t * pu_pred
+  cdef int w_true, w_pred
+  cdef vector[const uint8_t *] p_true, p_pred
+  cdef vector[int64_t] l_true, l_pred
+  cdef Py_ssize_t size
+  cdef int i
+
+  if kind_true in 'biuf' and kind_pred in 'biuf':
+
+    dtype = np.result_type(lbl_true.dtype, lbl_pred.dtype)
+
+    if dtype == np.int32:
+      i32_true = np.ascontiguousarray(lbl_true, dtype=np.int32)
+      i32_pred = np.ascontiguousarray(lbl_pred, dtype=np.int32)
+      pi32_true, pi32_pred = &i32_true[0], &i32_pred[0]
+      with nogil:
+        Nclass = encoder.encode[int](pi32_true, pi32_pred, n_lbl, y_true, y_pred)
+
+    elif dtype.kind in 'biu':
+      i64_true = np.ascontiguousarray(lbl_true, dtype=np.int64)
+      i64_pred = np.ascontiguousarray(lbl_pred, dtype=np.int64)
+      pi64_true, pi64_pred = &i64_true[0], &i64_pred[0]
+      with nogil:
+        Nclass = encoder.encode[int64_t](pi64_true, pi64_pred, n_lbl, y_true, y_pred)
+
+    elif dtype == np.float32:
+      f32_true = np.ascontiguousarray(lbl_true, dtype=np.float32)
+      f32_pred = np.ascontiguousarray(lbl_pred, dtype=np.float32)
+      pf32_true, pf32_pred = &f32_true[0], &f32_pred[0]
+      with nogil:
+        Nclass = encoder.encode[float](pf32_true, pf32_pred, n_lbl, y_true, y_pred)
+
+    else:
+      f64_true = np.ascontiguousarray(lbl_true, dtype=np.float64)
+      f64_pred = np.ascontiguousarray(lbl_pred, dtype=np.float64)
+      pf64_true, pf64_pred = &f64_true[0], &f64_pred[0]
+      with nogil:
+        Nclass = encoder.encode[double](pf64_true, pf64_pred, n_lbl, y_true, y_pred)
+
+  elif kind_true == kind_pred == 'S':
+
+    # the strings of the two arrays can have different widths
+    w_true, w_pred = lbl_true.dtype.itemsize, lbl_pred.dtype.itemsize
+    s_true = np.ascontiguousarray(lbl_true).view(np.uint8)
+    s_pred = np.ascontiguousarray(lbl_pred).view(np.uint8)
+    ps_true, ps_pred = &s_true[0], &s_pred[0]
+    with nogil:
+      Nclass = encoder.encode_fixed[uint8_t](ps_true, w_true, ps_pred, w_pred, n_lbl, y_true, y_pred)
+
+  elif kind_true == kind_pred == 'U':
+
+    w_true, w_pred = lbl_true.dtype.itemsize // 4, lbl_pred.dtype.itemsize // 4
+    u_true = np.ascontiguousarray(lbl_true, dtype=lbl_true.dtype.newbyteorder('=')).view(np.uint32)
+    u_pred = np.ascontiguousarray(lbl_pred, dtype=lbl_pred.dtype.newbyteorder('=')).view(np.uint32)
+    pu_true, pu_pred = &u_true[0], &u_pred[0]
+    with nogil:
+      Nclass = encoder.encode_fixed[uint32_t](pu_true, w_true, pu_pred, w_pred, n_lbl, y_true, y_pred)
+
+  elif kind_true == kind_pred == 'O':
+
+    # views of the UTF-8 buffers cached by the str objects
+    p_true.resize(n_lbl)
+    p_pred.resize(n_lbl)
+    l_true.resize(n_lbl)
+    l_pred.resize(n_lbl)
+
+    for i, (t, p) in enumerate(zip(lbl_true, lbl_pred)):
+      if type(t) is not str or type(p) is not str:
+        return None
+
+      p_true[i] = <const uint8_t *> PyUnicode_AsUTF8AndSize(t, &size)
+      l_true[i] = size
+      p_pred[i] = <const uint8_t *> PyUnicode_AsUTF8AndSize(p, &size)
+      l_pred[i] = size
+
+    with nogil:
+      Nclass = encoder.encode_strings(p_true.data(), l_true.data(), p_pred.data(), l_pred.data(), n_lbl, y_true, y_pred)
+
+  else:
+    return None
+
+  # names of the classes from a position of each of them
+  index = np.asarray(<int64_t[:Nclass]> encoder.index()).copy()
+  from_true = index < n_lbl
+
+  names = np.empty(shape=(Nclass, ), dtype=np.result_type(lbl_true.dtype, lbl_pred.dtype))
+  names[from_true] = lbl_true[index[from_true]]
+  names[~from_true] = lbl_pred[index[~from_true] - n_lbl]
+
+  return code_true, code_pred, names
+
 
 cdef class _scorer:
 
   def __init__ (self):
-    self.thisptr.reset(new scorer())
-
-
-  def evaluate (self, int[::1] lbl_true, int[::1] lbl_pred, int n_lbl):
-    deref(self.thisptr).compute_score(&lbl_true[0], &lbl_pred[0], n_lbl, n_lbl)
-
-    self.Nclass = deref(self.thisptr).classes.size()
-
-    score = {
-              'Classes': deref(self.thisptr).classes,
-              'Confusion Matrix': [int((deref(self.thisptr).confusion_matrix.get())[i]) for i in range(self.Nclass * self.Nclass)],
-              'TP(True positive/hit)' : [(deref(self.thisptr).TP.get())[i] for i in range(self.Nclass)],
-              'FN(False negative/miss/type 2 error)' : [(deref(self.thisptr).FN.get())[i] for i in range(self.Nclass)],
-              'FP(False positive/type 1 error/false alarm)' : [(deref(self.thisptr).FP.get())[i] for i in range(self.Nclass)],
-              'TN(True negative/correct rejection)' : [(deref(self.thisptr).TN.get())[i] for i in range(self.Nclass)],
-              'POP(Population)' : [(deref(self.thisptr).POP.get())[i] for i in range(self.Nclass)],
-              'P(Condition positive or support)' : [(deref(self.thisptr).P.get())[i] for i in range(self.Nclass)],
-              'N(Condition negative)' : [(deref(self.thisptr).N.get())[i] for i in range(self.Nclass)],
-              'TOP(Test outcome positive)' : [(deref(self.thisptr).TOP.get())[i] for i in range(self.Nclass)],
-              'TON(Test outcome negative)' : [(deref(self.thisptr).TON.get())[i] for i in range(self.Nclass)],
-              'TPR(Sensitivity / recall / hit rate / true positive rate)' : [(deref(self.thisptr).TPR.get())[i] for i in range(self.Nclass)],
-              'TNR(Specificity or true negative rate)' : [(deref(self.thisptr).TNR.get())[i] for i in range(self.Nclass)],
-              'PPV(Precision or positive predictive value)' : [(deref(self.thisptr).PPV.get())[i] for i in range(self.Nclass)],
-              'NPV(Negative predictive value)' : [(deref(self.thisptr).NPV.get())[i] for i in range(self.Nclass)],
-              'FNR(Miss rate or false negative rate)' : [(deref(self.thisptr).FNR.get())[i] for i in range(self.Nclass)],
-              'FPR(Fall-out or false positive rate)' : [(deref(self.thisptr).FPR.get())[i] for i in range(self.Nclass)],
-              'FDR(False discovery rate)' : [(deref(self.thisptr).FDR.get())[i] for i in range(self.Nclass)],
-              'FOR(False omission rate)' : [(deref(self.thisptr).FOR.get())[i] for i in range(self.Nclass)],
-              'ACC(Accuracy)' : [(deref(self.thisptr).ACC.get())[i] for i in range(self.Nclass)],
-              'F1(F1 score - harmonic mean of precision and sensitivity)' : [(deref(self.thisptr).F1_SCORE.get())[i] for i in range(self.Nclass)],
-              'F0.5(F0.5 score)' : [(deref(self.thisptr).F05_SCORE.get())[i] for i in range(self.Nclass)],
-              'F2(F2 score)' : [(deref(self.thisptr).F2_SCORE.get())[i] for i in range(self.Nclass)],
-              'MCC(Matthews correlation coefficient)' : [(deref(self.thisptr).MCC.get())[i] for i in range(self.Nclass)],
-              'BM(Informedness or bookmaker informedness)' : [(deref(self.thisptr).BM.get())[i] for i in range(self.Nclass)],
-              'MK(Markedness)' : [(deref(self.thisptr).MK.get())[i] for i in range(self.Nclass)],
-              'ICSI(Individual classification success index)' : [(deref(self.thisptr).ICSI.get())[i] for i in range(self.Nclass)],
-              'PLR(Positive likelihood ratio)' : [(deref(self.thisptr).PLR.get())[i] for i in range(self.Nclass)],
-              'NLR(Negative likelihood ratio)' : [(deref(self.thisptr).NLR.get())[i] for i in range(self.Nclass)],
-              'DOR(Diagnostic odds ratio)' : [(deref(self.thisptr).DOR.get())[i] for i in range(self.Nclass)],
-              'PRE(Prevalence)' : [(deref(self.thisptr).PRE.get())[i] for i in range(self.Nclass)],
-              'G(G-measure geometric mean of precision and sensitivity)' : [(deref(self.thisptr).G.get())[i] for i in range(self.Nclass)],
-              'RACC(Random accuracy)' : [(deref(self.thisptr).RACC.get())[i] for i in range(self.Nclass)],
-              'ERR(Error rate)' : [(deref(self.thisptr).ERR_ACC.get())[i] for i in range(self.Nclass)],
-              'RACCU(Random accuracy unbiased)' : [(deref(self.thisptr).RACCU.get())[i] for i in range(self.Nclass)],
-              'J(Jaccard index)' : [(deref(self.thisptr).jaccard_index.get())[i] for i in range(self.Nclass)],
-              'IS(Information score)' : [(deref(self.thisptr).IS.get())[i] for i in range(self.Nclass)],
-              'CEN(Confusion entropy)' : [(deref(self.thisptr).CEN.get())[i] for i in range(self.Nclass)],
-              'MCEN(Modified confusion entropy)' : [(deref(self.thisptr).MCEN.get())[i] for i in range(self.Nclass)],
-              'AUC(Area Under the ROC curve)' : [(deref(self.thisptr).AUC.get())[i] for i in range(self.Nclass)],
-              'dInd(Distance index)' : [(deref(self.thisptr).dIND.get())[i] for i in range(self.Nclass)],
-              'sInd(Similarity index)' : [(deref(self.thisptr).sIND.get())[i] for i in range(self.Nclass)],
-              'DP(Discriminant power)' : [(deref(self.thisptr).DP.get())[i] for i in range(self.Nclass)],
-              'Y(Youden index)' : [(deref(self.thisptr).Y.get())[i] for i in range(self.Nclass)],
-              'PLRI(Positive likelihood ratio interpretation)' : [(deref(self.thisptr).PLRI.get())[i] for i in range(self.Nclass)],
-              'NLRI(Negative likelihood ratio interpretation)' : [(deref(self.thisptr).NLRI.get())[i] for i in range(self.Nclass)],
-              'DPI(Discriminant power interpretation)' : [(deref(self.thisptr).DPI.get())[i] for i in range(self.Nclass)],
-              'AUCI(AUC value interpretation)' : [(deref(self.thisptr).AUCI.get())[i] for i in range(self.Nclass)],
-              'GI(Gini index)' : [(deref(self.thisptr).GI.get())[i] for i in range(self.Nclass)],
-              'LS(Lift score)' : [(deref(self.thisptr).LS.get())[i] for i in range(self.Nclass)],
-              'AM(Difference between automatic and manual classification)' : [(deref(self.thisptr).AM.get())[i] for i in range(self.Nclass)],
-              'OP(Optimized precision)' : [(deref(self.thisptr).OP.get())[i] for i in range(self.Nclass)],
-              'IBA(Index of balanced accuracy)' : [(deref(self.thisptr).IBA.get())[i] for i in range(self.Nclass)],
-              'GM(G-mean geometric mean of specificity and sensitivity)' : [(deref(self.thisptr).GM.get())[i] for i in range(self.Nclass)],
-              'Q(Yule Q - coefficient of colligation)' : [(deref(self.thisptr).Q.get())[i] for i in range(self.Nclass)],
-              'AGM(Adjusted geometric mean)' : [(deref(self.thisptr).AGM.get())[i] for i in range(self.Nclass)],
-              'MCCI(Matthews correlation coefficient interpretation)' : [(deref(self.thisptr).MCCI.get())[i] for i in range(self.Nclass)],
-              'AGF(Adjusted F-score)' : [(deref(self.thisptr).AGF.get())[i] for i in range(self.Nclass)],
-              'OC(Overlap coefficient)' : [(deref(self.thisptr).OC.get())[i] for i in range(self.Nclass)],
-              'OOC(Otsuka-Ochiai coefficient)' : [(deref(self.thisptr).OOC.get())[i] for i in range(self.Nclass)],
-              'AUPR(Area under the PR curve)' : [(deref(self.thisptr).AUPR.get())[i] for i in range(self.Nclass)],
-              'BCD(Bray-Curtis dissimilarity)' : [(deref(self.thisptr).BCD.get())[i] for i in range(self.Nclass)],
-              'Overall ACC' : deref(self.thisptr).overall_accuracy,
-              'Overall RACCU' : deref(self.thisptr).overall_random_accuracy_unbiased,
-              'Overall RACC' : deref(self.thisptr).overall_random_accuracy,
-              'Kappa' : deref(self.thisptr).overall_kappa,
-              'Scott PI' : deref(self.thisptr).PI,
-              'Get AC1' : deref(self.thisptr).AC1,
-              'Bennett S' : deref(self.thisptr).S,
-              'Kappa Standard Error' : deref(self.thisptr).kappa_SE,
-              'Kappa Unbiased' : deref(self.thisptr).kappa_unbiased,
-              'Kappa No Prevalence' : deref(self.thisptr).kappa_no_prevalence,
-              'Kappa 95% CI': (deref(self.thisptr).kappa_CI_up, deref(self.thisptr).kappa_CI_down),
-              'Standard Error' : deref(self.thisptr).overall_accuracy_se,
-              '95% CI': (deref(self.thisptr).overall_accuracy_ci_up, deref(self.thisptr).overall_accuracy_ci_down),
-              'Chi-Squared' : deref(self.thisptr).chi_square,
-              'Phi-Squared' : deref(self.thisptr).phi_square,
-              'Cramer V' : deref(self.thisptr).cramer_V,
-              'Response Entropy' : deref(self.thisptr).response_entropy,
-              'Reference Entropy' : deref(self.thisptr).reference_entropy,
-              'Cross Entropy' : deref(self.thisptr).cross_entropy,
-              'Joint Entropy' : deref(self.thisptr).join_entropy,
-              'Conditional Entropy' : deref(self.thisptr).conditional_entropy,
-              'Mutual Information' : deref(self.thisptr).mutual_information,
-              'KL Divergence' : deref(self.thisptr).kl_divergence,
-              'Lambda B' : deref(self.thisptr).lambda_B,
-              'Lambda A' : deref(self.thisptr).lambda_A,
-              'Chi-Squared DF' : deref(self.thisptr).DF,
-              'Overall J': (deref(self.thisptr).overall_jaccard_index, deref(self.thisptr).overall_jaccard_index / self.Nclass),
-              'Hamming loss' : deref(self.thisptr).hamming_loss,
-              'Zero-one Loss' : deref(self.thisptr).zero_one_loss,
-              'NIR' : deref(self.thisptr).NIR,
-              'P-value' : deref(self.thisptr).p_value,
-              'Overall CEN' : deref(self.thisptr).overall_CEN,
-              'Overall MCEN' : deref(self.thisptr).overall_MCEN,
-              'Overall MCC' : deref(self.thisptr).overall_MCC,
-              'RR' : deref(self.thisptr).RR,
-              'CBA' : deref(self.thisptr).CBA,
-              'AUNU' : deref(self.thisptr).AUNU,
-              'AUNP' : deref(self.thisptr).AUNP,
-              'RCI' : deref(self.thisptr).RCI,
-              'CSI' : deref(self.thisptr).CSI,
-              'Pearson C' : deref(self.thisptr).overall_pearson_C,
-              'TPR Micro' : deref(self.thisptr).TPR_PPV_F1_micro,
-              'PPV Micro' : deref(self.thisptr).TPR_PPV_F1_micro,
-              'F1 Micro' : deref(self.thisptr).TPR_PPV_F1_micro,
-              'SOA6(Matthews)' : deref(self.thisptr).MCC_analysis,
-              'SOA4(Cicchetti)' : deref(self.thisptr).kappa_analysis_cicchetti,
-              'SOA1(Landis & Koch)' : deref(self.thisptr).kappa_analysis_koch,
-              'SOA2(Fleiss)' : deref(self.thisptr).kappa_analysis_fleiss,
-              'SOA3(Altman)' : deref(self.thisptr).kappa_analysis_altman,
-              'SOA5(Cramer)' : deref(self.thisptr).V_analysis,
-              'TPR Macro' : deref(self.thisptr).TPR_macro,
-              'PPV Macro' : deref(self.thisptr).PPV_macro,
-              'ACC Macro' : deref(self.thisptr).ACC_macro,
-              'F1 Macro' : deref(self.thisptr).F1_macro,
-            }
+    self._selected = None
+
+
+  # The C++ computations release the GIL: each call evaluates a new scorer object
+  # and keeps the selected metrics and the classes in its owner, so the same _scorer
+  # can be used by concurrent Python threads (select affects only the following calls)
+
+  def evaluate (self, int[::1] lbl_true, int[::1] lbl_pred, int n_lbl, int Nclass=0):
+    # Nclass > 0 if the labels are already encoded in [0, Nclass): the classes are not discovered
+    cdef _score_owner owner = self._new_scorer()
+    cdef scorer * obj = owner.thisptr.get()
+    cdef int * y_true = &lbl_true[0]
+    cdef int * y_pred = &lbl_pred[0]
+    cdef int[::1] classes = np.arange(Nclass, dtype=np.int32)
+    cdef int * codes = &classes[0] if Nclass > 0 else NULL
+
+    with nogil:
+      if Nclass > 0:
+        obj.set_classes(codes, Nclass)
+      obj.compute_score(y_true, y_pred, n_lbl, n_lbl)
+
+    return self._score(obj, owner)
+
+  def evaluate_confusion_matrix (self, count_t[::1] confusion_matrix, float[::1] classes, int Nclass):
+    cdef _score_owner owner = self._new_scorer()
+    cdef scorer * obj = owner.thisptr.get()
+    cdef count_t * cm = &confusion_matrix[0]
+    cdef float * names = &classes[0]
+
+    with nogil:
+      obj.compute_from_confusion_matrix[count_t](cm, Nclass, names)
+
+    return self._score(obj, owner)
+
+  def evaluate_batch (self, list lbl_true, list lbl_pred):
+
+    cdef int K = len(lbl_pred)
+    cdef vector[int *] true_ptr
+    cdef vector[int *] pred_ptr
+    cdef vector[int] sizes
+    cdef int[::1] y_true
+    cdef int[::1] y_pred
+
+    for k in range(K):
+      y_true = lbl_true[k]
+      y_pred = lbl_pred[k]
+      true_ptr.push_back(&y_true[0])
+      pred_ptr.push_back(&y_pred[0])
+      sizes.push_back(y_true.shape[0])
+
+    cdef _score_owner owner = self._new_batch_scorer()
+    cdef batch_scorer * obj = owner.batchptr.get()
+
+    with nogil:
+      obj.compute_score(true_ptr.data(), pred_ptr.data(), sizes.data(), K)
+
+    return self._get_batch_score(owner)
+
+  def evaluate_columns (self, int[::1] lbl_true, int[:, ::1] lbl_pred):
+    cdef _score_owner owner = self._new_batch_scorer()
+    cdef batch_scorer * obj = owner.batchptr.get()
+    cdef int * y_true = &lbl_true[0]
+    cdef int * y_pred = &lbl_pred[0, 0]
+    cdef int n_lbl = lbl_pred.shape[0]
+    cdef int K = lbl_pred.shape[1]
+
+    with nogil:
+      obj.compute_score(y_true, y_pred, K, n_lbl)
+
+    return self._get_batch_score(owner)
+
+  def compute_bootstrap (self, count_t[::1] confusion_matrix, float[::1] classes, int Nclass, list stats, int n_reps, uint64_t seed, float alpha):
+
+    cdef unique_ptr[bootstrap] engine
+    engine.reset(new bootstrap(n_reps, seed))
+
+    cdef vector[string] names
+    for stat in stats:
+      names.push_back(stat.encode('utf-8'))
+
+    if not deref(engine).select(names):
+      raise ValueError('Unknown statistics: {0}'.format(', '.join(stats)))
+
+    cdef count_t * cm = &confusion_matrix[0]
+    cdef float * names_ptr = &classes[0]
+
+    with nogil:
+      deref(engine).compute(cm, Nclass, names_ptr, alpha)
+
+    intervals = {}
+    for stat, name in zip(stats, names):
+      intervals[stat] = ([deref(engine).ci_down(name)[i] for i in range(deref(engine).size(name))],
+                         [deref(engine).ci_up(name)[i] for i in range(deref(engine).size(name))])
+
+    return intervals
+
+  def compute_permutation_test (self, int[::1] lbl_true, int[::1] lbl_pred_a, int[::1] lbl_pred_b, int n_lbl, list stats, int n_perm, uint64_t seed):
+
+    cdef unique_ptr[permutation_test] engine
+    engine.reset(new permutation_test(n_perm, seed))
+
+    cdef vector[string] names
+    for stat in stats:
+      names.push_back(stat.encode('utf-8'))
+
+    if not deref(engine).select(names):
+      raise ValueError('Unknown statistics: {0}'.format(', '.join(stats)))
+
+    cdef int * y_true = &lbl_true[0]
+    cdef int * y_pred_a = &lbl_pred_a[0]
+    cdef int * y_pred_b = &lbl_pred_b[0]
+
+    with nogil:
+      deref(engine).compute(y_true, y_pred_a, y_pred_b, n_lbl)
+
+    pvalues = {}
+    for stat, name in zip(stats, names):
+      pvalues[stat] = [deref(engine).p_value(name)[i] for i in range(deref(engine).size(name))]
+
+    return pvalues
+
+  def select (self, metrics):
+    # the new selection is swapped in at the end, so the concurrent calls see either the old or the new one
+    cdef vector[string] stats
+
+    if not metrics:
+      self._stats.swap(stats)
+      self._selected = None
+      return
+
+    selected = set(metrics)
+    unknown = selected.difference(self._members)
+
+    if unknown:
+      raise ValueError('Unknown metrics: {0}'.format(', '.join(sorted(unknown))))
+
+    for metric in selected:
+      for stat in self._members[metric]:
+        stats.push_back(stat.encode('utf-8'))
+
+    self._stats.swap(stats)
+    self._selected = selected
+
+  cdef _score_owner _new_scorer (self):
+    # each evaluation is stored in a new object, so the arrays of the previous results stay valid
+    cdef _score_owner owner = _score_owner.__new__(_score_owner)
+    owner.thisptr.reset(new scorer())
+    owner.selected = self._selected
+
+    if not self._stats.empty():
+      deref(owner.thisptr).select(self._stats)
+
+    return owner
+
+  cdef _score_owner _new_batch_scorer (self):
+    cdef _score_owner owner = _score_owner.__new__(_score_owner)
+    owner.batchptr.reset(new batch_scorer())
+    owner.selected = self._selected
+
+    if not self._stats.empty():
+      deref(owner.batchptr).select(self._stats)
+
+    return owner
+
+  def _get_batch_score (self, _score_owner owner):
+    return [self._score(&deref(owner.batchptr)[k], owner) for k in range(deref(owner.batchptr).size())]
+
+  cdef dict _score (self, scorer * obj, _score_owner owner):
+
+    cdef int Nclass = deref(obj).classes.size()
+    selected = owner.selected
+
+    score = {}
+    score['Classes'] = _float_array(owner, deref(obj).classes.data(), Nclass)
+    score['Confusion Matrix'] = _count_array(owner, deref(obj).confusion_matrix, Nclass * Nclass)
+    if selected is None or 'TP(True positive/hit)' in selected:
+      score['TP(True positive/hit)'] = _count_array(owner, deref(obj).TP, Nclass)
+    if selected is None or 'FN(False negative/miss/type 2 error)' in selected:
+      score['FN(False negative/miss/type 2 error)'] = _count_array(owner, deref(obj).FN, Nclass)
+    if selected is None or 'FP(False positive/type 1 error/false alarm)' in selected:
+      score['FP(False positive/type 1 error/false alarm)'] = _count_array(owner, deref(obj).FP, Nclass)
+    if selected is None or 'TN(True negative/correct rejection)' in selected:
+      score['TN(True negative/correct rejection)'] = _count_array(owner, deref(obj).TN, Nclass)
+    if selected is None or 'POP(Population)' in selected:
+      score['POP(Population)'] = _count_array(owner, deref(obj).POP, Nclass)
+    if selected is None or 'P(Condition positive or support)' in selected:
+      score['P(Condition positive or support)'] = _count_array(owner, deref(obj).P, Nclass)
+    if selected is None or 'N(Condition negative)' in selected:
+      score['N(Condition negative)'] = _count_array(owner, deref(obj).N, Nclass)
+    if selected is None or 'TOP(Test outcome positive)' in selected:
+      score['TOP(Test outcome positive)'] = _count_array(owner, deref(obj).TOP, Nclass)
+    if selected is None or 'TON(Test outcome negative)' in selected:
+      score['TON(Test outcome negative)'] = _count_array(owner, deref(obj).TON, Nclass)
+    if selected is None or 'TPR(Sensitivity / recall / hit rate / true positive rate)' in selected:
+      score['TPR(Sensitivity / recall / hit rate / true positive rate)'] = _real_array(owner, deref(obj).TPR, Nclass)
+    if selected is None or 'TNR(Specificity or true negative rate)' in selected:
+      score['TNR(Specificity or true negative rate)'] = _real_array(owner, deref(obj).TNR, Nclass)
+    if selected is None or 'PPV(Precision or positive predictive value)' in selected:
+      score['PPV(Precision or positive predictive value)'] = _real_array(owner, deref(obj).PPV, Nclass)
+    if selected is None or 'NPV(Negative predictive value)' in selected:
+      score['NPV(Negative predictive value)'] = _real_array(owner, deref(obj).NPV, Nclass)
+    if selected is None or 'FNR(Miss rate or false negative rate)' in selected:
+      score['FNR(Miss rate or false negative rate)'] = _real_array(owner, deref(obj).FNR, Nclass)
+    if selected is None or 'FPR(Fall-out or false positive rate)' in selected:
+      score['FPR(Fall-out or false positive rate)'] = _real_array(owner, deref(obj).FPR, Nclass)
+    if selected is None or 'FDR(False discovery rate)' in selected:
+      score['FDR(False discovery rate)'] = _real_array(owner, deref(obj).FDR, Nclass)
+    if selected is None or 'FOR(False omission rate)' in selected:
+      score['FOR(False omission rate)'] = _real_array(owner, deref(obj).FOR, Nclass)
+    if selected is None or 'ACC(Accuracy)' in selected:
+      score['ACC(Accuracy)'] = _real_array(owner, deref(obj).ACC, Nclass)
+    if selected is None or 'F1(F1 score - harmonic mean of precision and sensitivity)' in selected:
+      score['F1(F1 score - harmonic mean of precision and sensitivity)'] = _real_array(owner, deref(obj).F1_SCORE, Nclass)
+    if selected is None or 'F0.5(F0.5 score)' in selected:
+      score['F0.5(F0.5 score)'] = _real_array(owner, deref(obj).F05_SCORE, Nclass)
+    if selected is None or 'F2(F2 score)' in selected:
+      score['F2(F2 score)'] = _real_array(owner, deref(obj).F2_SCORE, Nclass)
+    if selected is None or 'MCC(Matthews correlation coefficient)' in selected:
+      score['MCC(Matthews correlation coefficient)'] = _real_array(owner, deref(obj).MCC, Nclass)
+    if selected is None or 'BM(Informedness or bookmaker informedness)' in selected:
+      score['BM(Informedness or bookmaker informedness)'] = _real_array(owner, deref(obj).BM, Nclass)
+    if selected is None or 'MK(Markedness)' in selected:
+      score['MK(Markedness)'] = _real_array(owner, deref(obj).MK, Nclass)
+    if selected is None or 'ICSI(Individual classification success index)' in selected:
+      score['ICSI(Individual classification success index)'] = _real_array(owner, deref(obj).ICSI, Nclass)
+    if selected is None or 'PLR(Positive likelihood ratio)' in selected:
+      score['PLR(Positive likelihood ratio)'] = _real_array(owner, deref(obj).PLR, Nclass)
+    if selected is None or 'NLR(Negative likelihood ratio)' in selected:
+      score['NLR(Negative likelihood ratio)'] = _real_array(owner, deref(obj).NLR, Nclass)
+    if selected is None or 'DOR(Diagnostic odds ratio)' in selected:
+      score['DOR(Diagnostic odds ratio)'] = _real_array(owner, deref(obj).DOR, Nclass)
+    if selected is None or 'PRE(Prevalence)' in selected:
+      score['PRE(Prevalence)'] = _real_array(owner, deref(obj).PRE, Nclass)
+    if selected is None or 'G(G-measure geometric mean of precision and sensitivity)' in selected:
+      score['G(G-measure geometric mean of precision and sensitivity)'] = _real_array(owner, deref(obj).G, Nclass)
+    if selected is None or 'RACC(Random accuracy)' in selected:
+      score['RACC(Random accuracy)'] = _real_array(owner, deref(obj).RACC, Nclass)
+    if selected is None or 'ERR(Error rate)' in selected:
+      score['ERR(Error rate)'] = _real_array(owner, deref(obj).ERR_ACC, Nclass)
+    if selected is None or 'RACCU(Random accuracy unbiased)' in selected:
+      score['RACCU(Random accuracy unbiased)'] = _real_array(owner, deref(obj).RACCU, Nclass)
+    if selected is None or 'J(Jaccard index)' in selected:
+      score['J(Jaccard index)'] = _real_array(owner, deref(obj).jaccard_index, Nclass)
+    if selected is None or 'IS(Information score)' in selected:
+      score['IS(Information score)'] = _real_array(owner, deref(obj).IS, Nclass)
+    if selected is None or 'CEN(Confusion entropy)' in selected:
+      score['CEN(Confusion entropy)'] = _real_array(owner, deref(obj).CEN, Nclass)
+    if selected is None or 'MCEN(Modified confusion entropy)' in selected:
+      score['MCEN(Modified confusion entropy)'] = _real_array(owner, deref(obj).MCEN, Nclass)
+    if selected is None or 'AUC(Area Under the ROC curve)' in selected:
+      score['AUC(Area Under the ROC curve)'] = _real_array(owner, deref(obj).AUC, Nclass)
+    if selected is None or 'dInd(Distance index)' in selected:
+      score['dInd(Distance index)'] = _real_array(owner, deref(obj).dIND, Nclass)
+    if selected is None or 'sInd(Similarity index)' in selected:
+      score['sInd(Similarity index)'] = _real_array(owner, deref(obj).sIND, Nclass)
+    if selected is None or 'DP(Discriminant power)' in selected:
+      score['DP(Discriminant power)'] = _real_array(owner, deref(obj).DP, Nclass)
+    if selected is None or 'Y(Youden index)' in selected:
+      score['Y(Youden index)'] = _real_array(owner, deref(obj).Y, Nclass)
+    if selected is None or 'PLRI(Positive likelihood ratio interpretation)' in selected:
+      score['PLRI(Positive likelihood ratio interpretation)'] = _real_array(owner, deref(obj).PLRI, Nclass)
+    if selected is None or 'NLRI(Negative likelihood ratio interpretation)' in selected:
+      score['NLRI(Negative likelihood ratio interpretation)'] = _real_array(owner, deref(obj).NLRI, Nclass)
+    if selected is None or 'DPI(Discriminant power interpretation)' in selected:
+      score['DPI(Discriminant power interpretation)'] = _real_array(owner, deref(obj).DPI, Nclass)
+    if selected is None or 'AUCI(AUC value interpretation)' in selected:
+      score['AUCI(AUC value interpretation)'] = _real_array(owner, deref(obj).AUCI, Nclass)
+    if selected is None or 'GI(Gini index)' in selected:
+      score['GI(Gini index)'] = _real_array(owner, deref(obj).GI, Nclass)
+    if selected is None or 'LS(Lift score)' in selected:
+      score['LS(Lift score)'] = _real_array(owner, deref(obj).LS, Nclass)
+    if selected is None or 'AM(Difference between automatic and manual classification)' in selected:
+      score['AM(Difference between automatic and manual classification)'] = _real_array(owner, deref(obj).AM, Nclass)
+    if selected is None or 'OP(Optimized precision)' in selected:
+      score['OP(Optimized precision)'] = _real_array(owner, deref(obj).OP, Nclass)
+    if selected is None or 'IBA(Index of balanced accuracy)' in selected:
+      score['IBA(Index of balanced accuracy)'] = _real_array(owner, deref(obj).IBA, Nclass)
+    if selected is None or 'GM(G-mean geometric mean of specificity and sensitivity)' in selected:
+      score['GM(G-mean geometric mean of specificity and sensitivity)'] = _real_array(owner, deref(obj).GM, Nclass)
+    if selected is None or 'Q(Yule Q - coefficient of colligation)' in selected:
+      score['Q(Yule Q - coefficient of colligation)'] = _real_array(owner, deref(obj).Q, Nclass)
+    if selected is None or 'AGM(Adjusted geometric mean)' in selected:
+      score['AGM(Adjusted geometric mean)'] = _real_array(owner, deref(obj).AGM, Nclass)
+    if selected is None or 'MCCI(Matthews correlation coefficient interpretation)' in selected:
+      score['MCCI(Matthews correlation coefficient interpretation)'] = _real_array(owner, deref(obj).MCCI, Nclass)
+    if selected is None or 'AGF(Adjusted F-score)' in selected:
+      score['AGF(Adjusted F-score)'] = _real_array(owner, deref(obj).AGF, Nclass)
+    if selected is None or 'OC(Overlap coefficient)' in selected:
+      score['OC(Overlap coefficient)'] = _real_array(owner, deref(obj).OC, Nclass)
+    if selected is None or 'OOC(Otsuka-Ochiai coefficient)' in selected:
+      score['OOC(Otsuka-Ochiai coefficient)'] = _real_array(owner, deref(obj).OOC, Nclass)
+    if selected is None or 'AUPR(Area under the PR curve)' in selected:
+      score['AUPR(Area under the PR curve)'] = _real_array(owner, deref(obj).AUPR, Nclass)
+    if selected is None or 'BCD(Bray-Curtis dissimilarity)' in selected:
+      score['BCD(Bray-Curtis dissimilarity)'] = _real_array(owner, deref(obj).BCD, Nclass)
+    if selected is None or 'Overall ACC' in selected:
+      score['Overall ACC'] = deref(obj).overall_accuracy
+    if selected is None or 'Overall RACCU' in selected:
+      score['Overall RACCU'] = deref(obj).overall_random_accuracy_unbiased
+    if selected is None or 'Overall RACC' in selected:
+      score['Overall RACC'] = deref(obj).overall_random_accuracy
+    if selected is None or 'Kappa' in selected:
+      score['Kappa'] = deref(obj).overall_kappa
+    if selected is None or 'Scott PI' in selected:
+      score['Scott PI'] = deref(obj).PI
+    if selected is None or 'Get AC1' in selected:
+      score['Get AC1'] = deref(obj).AC1
+    if selected is None or 'Bennett S' in selected:
+      score['Bennett S'] = deref(obj).S
+    if selected is None or 'Kappa Standard Error' in selected:
+      score['Kappa Standard Error'] = deref(obj).kappa_SE
+    if selected is None or 'Kappa Unbiased' in selected:
+      score['Kappa Unbiased'] = deref(obj).kappa_unbiased
+    if selected is None or 'Kappa No Prevalence' in selected:
+      score['Kappa No Prevalence'] = deref(obj).kappa_no_prevalence
+    if selected is None or 'Kappa 95% CI' in selected:
+      score['Kappa 95% CI'] = (deref(obj).kappa_CI_up, deref(obj).kappa_CI_down)
+    if selected is None or 'Standard Error' in selected:
+      score['Standard Error'] = deref(obj).overall_accuracy_se
+    if selected is None or '95% CI' in selected:
+      score['95% CI'] = (deref(obj).overall_accuracy_ci_up, deref(obj).overall_accuracy_ci_down)
+    if selected is None or 'Chi-Squared' in selected:
+      score['Chi-Squared'] = deref(obj).chi_square
+    if selected is None or 'Phi-Squared' in selected:
+      score['Phi-Squared'] = deref(obj).phi_square
+    if selected is None or 'Cramer V' in selected:
+      score['Cramer V'] = deref(obj).cramer_V
+    if selected is None or 'Response Entropy' in selected:
+      score['Response Entropy'] = deref(obj).response_entropy
+    if selected is None or 'Reference Entropy' in selected:
+      score['Reference Entropy'] = deref(obj).reference_entropy
+    if selected is None or 'Cross Entropy' in selected:
+      score['Cross Entropy'] = deref(obj).cross_entropy
+    if selected is None or 'Joint Entropy' in selected:
+      score['Joint Entropy'] = deref(obj).join_entropy
+    if selected is None or 'Conditional Entropy' in selected:
+      score['Conditional Entropy'] = deref(obj).conditional_entropy
+    if selected is None or 'Mutual Information' in selected:
+      score['Mutual Information'] = deref(obj).mutual_information
+    if selected is None or 'KL Divergence' in selected:
+      score['KL Divergence'] = deref(obj).kl_divergence
+    if selected is None or 'Lambda B' in selected:
+      score['Lambda B'] = deref(obj).lambda_B
+    if selected is None or 'Lambda A' in selected:
+      score['Lambda A'] = deref(obj).lambda_A
+    if selected is None or 'Chi-Squared DF' in selected:
+      score['Chi-Squared DF'] = deref(obj).DF
+    if selected is None or 'Overall J' in selected:
+      score['Overall J'] = (deref(obj).overall_jaccard_index, deref(obj).overall_jaccard_index / Nclass)
+    if selected is None or 'Hamming loss' in selected:
+      score['Hamming loss'] = deref(obj).hamming_loss
+    if selected is None or 'Zero-one Loss' in selected:
+      score['Zero-one Loss'] = deref(obj).zero_one_loss
+    if selected is None or 'NIR' in selected:
+      score['NIR'] = deref(obj).NIR
+    if selected is None or 'P-value' in selected:
+      score['P-value'] = deref(obj).p_value
+    if selected is None or 'Overall CEN' in selected:
+      score['Overall CEN'] = deref(obj).overall_CEN
+    if selected is None or 'Overall MCEN' in selected:
+      score['Overall MCEN'] = deref(obj).overall_MCEN
+    if selected is None or 'Overall MCC' in selected:
+      score['Overall MCC'] = deref(obj).overall_MCC
+    if selected is None or 'RR' in selected:
+      score['RR'] = deref(obj).RR
+    if selected is None or 'CBA' in selected:
+      score['CBA'] = deref(obj).CBA
+    if selected is None or 'AUNU' in selected:
+      score['AUNU'] = deref(obj).AUNU
+    if selected is None or 'AUNP' in selected:
+      score['AUNP'] = deref(obj).AUNP
+    if selected is None or 'RCI' in selected:
+      score['RCI'] = deref(obj).RCI
+    if selected is None or 'CSI' in selected:
+      score['CSI'] = deref(obj).CSI
+    if selected is None or 'Pearson C' in selected:
+      score['Pearson C'] = deref(obj).overall_pearson_C
+    if selected is None or 'TPR Micro' in selected:
+      score['TPR Micro'] = deref(obj).TPR_PPV_F1_micro
+    if selected is None or 'PPV Micro' in selected:
+      score['PPV Micro'] = deref(obj).TPR_PPV_F1_micro
+    if selected is None or 'F1 Micro' in selected:
+      score['F1 Micro'] = deref(obj).TPR_PPV_F1_micro
+    if selected is None or 'SOA6(Matthews)' in selected:
+      score['SOA6(Matthews)'] = deref(obj).MCC_analysis
+    if selected is None or 'SOA4(Cicchetti)' in selected:
+      score['SOA4(Cicchetti)'] = deref(obj).kappa_analysis_cicchetti
+    if selected is None or 'SOA1(Landis & Koch)' in selected:
+      score['SOA1(Landis & Koch)'] = deref(obj).kappa_analysis_koch
+    if selected is None or 'SOA2(Fleiss)' in selected:
+      score['SOA2(Fleiss)'] = deref(obj).kappa_analysis_fleiss
+    if selected is None or 'SOA3(Altman)' in selected:
+      score['SOA3(Altman)'] = deref(obj).kappa_analysis_altman
+    if selected is None or 'SOA5(Cramer)' in selected:
+      score['SOA5(Cramer)'] = deref(obj).V_analysis
+    if selected is None or 'TPR Macro' in selected:
+      score['TPR Macro'] = deref(obj).TPR_macro
+    if selected is None or 'PPV Macro' in selected:
+      score['PPV Macro'] = deref(obj).PPV_macro
+    if selected is None or 'ACC Macro' in selected:
+      score['ACC Macro'] = deref(obj).ACC_macro
+    if selected is None or 'F1 Macro' in selected:
+      score['F1 Macro'] = deref(obj).F1_macro
 
     _mcc_analysis = ['Negligible', 'Weak', 'Moderate', 'Strong', 'Very Strong', 'None']
     _nlr_analysis = ['Good', 'Fair', 'Poor', 'Negligible', 'None']
@@ -152,18 +629,28 @@ cdef class _scorer:
     _kfleiss_analysis    = ['Poor', 'Intermediate to Good', 'Excellent', 'None']
     _kaltman_analysis    = ['Poor', 'Fair', 'Moderate', 'Good', 'Very Good', 'None']
 
-    score['SOA1(Landis & Koch)'] = _kkoch_analysis[     int(score['SOA1(Landis & Koch)'])]
-    score['SOA2(Fleiss)'       ] = _kfleiss_analysis[   int(score['SOA2(Fleiss)'])]
-    score['SOA3(Altman)'       ] = _kaltman_analysis[   int(score['SOA3(Altman)'])]
-    score['SOA4(Cicchetti)'    ] = _kcicchetti_analysis[int(score['SOA4(Cicchetti)'])]
-    score['SOA5(Cramer)'       ] = _V_analysis[         int(score['SOA5(Cramer)'])]
-    score['SOA6(Matthews)'     ] = _mcc_analysis[       int(score['SOA6(Matthews)'])]
+    _soa = (('SOA1(Landis & Koch)', _kkoch_analysis),
+            ('SOA2(Fleiss)', _kfleiss_analysis),
+            ('SOA3(Altman)', _kaltman_analysis),
+            ('SOA4(Cicchetti)', _kcicchetti_analysis),
+            ('SOA5(Cramer)', _V_analysis),
+            ('SOA6(Matthews)', _mcc_analysis),
+           )
+
+    _interpretation = (('NLRI(Negative likelihood ratio interpretation)', _nlr_analysis),
+                       ('PLRI(Positive likelihood ratio interpretation)', _plr_analysis),
+                       ('AUCI(AUC value interpretation)', _auc_analysis),
+                       ('DPI(Discriminant power interpretation)', _dp_analysis),
+                       ('MCCI(Matthews correlation coefficient interpretation)', _mcc_analysis),
+                      )
 
-    score['NLRI(Negative likelihood ratio interpretation)'] = [_nlr_analysis[int(item)] for item in score['NLRI(Negative likelihood ratio interpretation)']]
-    score['PLRI(Positive likelihood ratio interpretation)'] = [_plr_analysis[int(item)] for item in score['PLRI(Positive likelihood ratio interpretation)']]
-    score['AUCI(AUC value interpretation)'] = [_auc_analysis[int(item)] for item in score['AUCI(AUC value interpretation)']]
-    score['DPI(Discriminant power interpretation)' ] = [_dp_analysis[int(item)] for item in score['DPI(Discriminant power interpretation)' ]]
-    score['MCCI(Matthews correlation coefficient interpretation)'] = [_mcc_analysis[int(item)] for item in score['MCCI(Matthews correlation coefficient interpretation)']]
+    for key, analysis in _soa:
+      if key in score:
+        score[key] = analysis[int(score[key])]
+
+    for key, analysis in _interpretation:
+      if key in score:
+        score[key] = [analysis[int(item)] for item in score[key]]
 
     return score
 
@@ -276,9 +763,124 @@ cdef class _scorer:
            }
 
   @property
-  def num_classes (self):
-    return deref(self.thisptr).classes.size()
+  def _members (self):
+    return {
+             'Classes' : [],
+             'Confusion Matrix' : [],
+             'TP(True positive/hit)' : ['TP'],
+             'FN(False negative/miss/type 2 error)' : ['FN'],
+             'FP(False positive/type 1 error/false alarm)' : ['FP'],
+             'TN(True negative/correct rejection)' : ['TN'],
+             'POP(Population)' : ['POP'],
+             'P(Condition positive or support)' : ['P'],
+             'N(Condition negative)' : ['N'],
+             'TOP(Test outcome positive)' : ['TOP'],
+             'TON(Test outcome negative)' : ['TON'],
+             'TPR(Sensitivity / recall / hit rate / true positive rate)' : ['TPR'],
+             'TNR(Specificity or true negative rate)' : ['TNR'],
+             'PPV(Precision or positive predictive value)' : ['PPV'],
+             'NPV(Negative predictive value)' : ['NPV'],
+             'FNR(Miss rate or false negative rate)' : ['FNR'],
+             'FPR(Fall-out or false positive rate)' : ['FPR'],
+             'FDR(False discovery rate)' : ['FDR'],
+             'FOR(False omission rate)' : ['FOR'],
+             'ACC(Accuracy)' : ['ACC'],
+             'F1(F1 score - harmonic mean of precision and sensitivity)' : ['F1_SCORE'],
+             'F0.5(F0.5 score)' : ['F05_SCORE'],
+             'F2(F2 score)' : ['F2_SCORE'],
+             'MCC(Matthews correlation coefficient)' : ['MCC'],
+             'BM(Informedness or bookmaker informedness)' : ['BM'],
+             'MK(Markedness)' : ['MK'],
+             'ICSI(Individual classification success index)' : ['ICSI'],
+             'PLR(Positive likelihood ratio)' : ['PLR'],
+             'NLR(Negative likelihood ratio)' : ['NLR'],
+             'DOR(Diagnostic odds ratio)' : ['DOR'],
+             'PRE(Prevalence)' : ['PRE'],
+             'G(G-measure geometric mean of precision and sensitivity)' : ['G'],
+             'RACC(Random accuracy)' : ['RACC'],
+             'ERR(Error rate)' : ['ERR_ACC'],
+             'RACCU(Random accuracy unbiased)' : ['RACCU'],
+             'J(Jaccard index)' : ['jaccard_index'],
+             'IS(Information score)' : ['IS'],
+             'CEN(Confusion entropy)' : ['CEN'],
+             'MCEN(Modified confusion entropy)' : ['MCEN'],
+             'AUC(Area Under the ROC curve)' : ['AUC'],
+             'dInd(Distance index)' : ['dIND'],
+             'sInd(Similarity index)' : ['sIND'],
+             'DP(Discriminant power)' : ['DP'],
+             'Y(Youden index)' : ['Y'],
+             'PLRI(Positive likelihood ratio interpretation)' : ['PLRI'],
+             'NLRI(Negative likelihood ratio interpretation)' : ['NLRI'],
+             'DPI(Discriminant power interpretation)' : ['DPI'],
+             'AUCI(AUC value interpretation)' : ['AUCI'],
+             'GI(Gini index)' : ['GI'],
+             'LS(Lift score)' : ['LS'],
+             'AM(Difference between automatic and manual classification)' : ['AM'],
+             'OP(Optimized precision)' : ['OP'],
+             'IBA(Index of balanced accuracy)' : ['IBA'],
+             'GM(G-mean geometric mean of specificity and sensitivity)' : ['GM'],
+             'Q(Yule Q - coefficient of colligation)' : ['Q'],
+             'AGM(Adjusted geometric mean)' : ['AGM'],
+             'MCCI(Matthews correlation coefficient interpretation)' : ['MCCI'],
+             'AGF(Adjusted F-score)' : ['AGF'],
+             'OC(Overlap coefficient)' : ['OC'],
+             'OOC(Otsuka-Ochiai coefficient)' : ['OOC'],
+             'AUPR(Area under the PR curve)' : ['AUPR'],
+             'BCD(Bray-Curtis dissimilarity)' : ['BCD'],
+             'Overall ACC' : ['overall_accuracy'],
+             'Overall RACCU' : ['overall_random_accuracy_unbiased'],
+             'Overall RACC' : ['overall_random_accuracy'],
+             'Kappa' : ['overall_kappa'],
+             'Scott PI' : ['PI'],
+             'Get AC1' : ['AC1'],
+             'Bennett S' : ['S'],
+             'Kappa Standard Error' : ['kappa_SE'],
+             'Kappa Unbiased' : ['kappa_unbiased'],
+             'Kappa No Prevalence' : ['kappa_no_prevalence'],
+             'Kappa 95% CI' : ['kappa_CI_up', 'kappa_CI_down'],
+             'Standard Error' : ['overall_accuracy_se'],
+             '95% CI' : ['overall_accuracy_ci_up', 'overall_accuracy_ci_down'],
+             'Chi-Squared' : ['chi_square'],
+             'Phi-Squared' : ['phi_square'],
+             'Cramer V' : ['cramer_V'],
+             'Response Entropy' : ['response_entropy'],
+             'Reference Entropy' : ['reference_entropy'],
+             'Cross Entropy' : ['cross_entropy'],
+             'Joint Entropy' : ['join_entropy'],
+             'Conditional Entropy' : ['conditional_entropy'],
+             'Mutual Information' : ['mutual_information'],
+             'KL Divergence' : ['kl_divergence'],
+             'Lambda B' : ['lambda_B'],
+             'Lambda A' : ['lambda_A'],
+             'Chi-Squared DF' : ['DF'],
+             'Overall J' : ['overall_jaccard_index'],
+             'Hamming loss' : ['hamming_loss'],
+             'Zero-one Loss' : ['zero_one_loss'],
+             'NIR' : ['NIR'],
+             'P-value' : ['p_value'],
+             'Overall CEN' : ['overall_CEN'],
+             'Overall MCEN' : ['overall_MCEN'],
+             'Overall MCC' : ['overall_MCC'],
+             'RR' : ['RR'],
+             'CBA' : ['CBA'],
+             'AUNU' : ['AUNU'],
+             'AUNP' : ['AUNP'],
+             'RCI' : ['RCI'],
+             'CSI' : ['CSI'],
+             'Pearson C' : ['overall_pearson_C'],
+             'TPR Micro' : ['TPR_PPV_F1_micro'],
+             'PPV Micro' : ['TPR_PPV_F1_micro'],
+             'F1 Micro' : ['TPR_PPV_F1_micro'],
+             'SOA6(Matthews)' : ['MCC_analysis'],
+             'SOA4(Cicchetti)' : ['kappa_analysis_cicchetti'],
+             'SOA1(Landis & Koch)' : ['kappa_analysis_koch'],
+             'SOA2(Fleiss)' : ['kappa_analysis_fleiss'],
+             'SOA3(Altman)' : ['kappa_analysis_altman'],
+             'SOA5(Cramer)' : ['V_analysis'],
+             'TPR Macro' : ['TPR_macro'],
+             'PPV Macro' : ['PPV_macro'],
+             'ACC Macro' : ['ACC_macro'],
+             'F1 Macro' : ['F1_macro'],
+           }
 
-  def __repr__ (self):
-    return '<Scorer (classes: {0})>'.format(self.num_classes)
   
\ No newline at end of file
@@ -67,7 +67,8 @@ class cmake_build_ext (build_ext):
         '-DCMAKE_BUILD_TYPE:STRING=' + config,
         '-DPYWRAP:BOOL=ON',
         '-DBUILD_DOCS:BOOL={}'.format('ON' if os.environ.get('READTHEDOCS', None) == 'True' else 'OFF'),
-        '-DOMP:BOOL={}'.format('ON' if ENABLE_OMP else 'OFF')
+        '-DOMP:BOOL={}'.format('ON' if ENABLE_OMP else 'OFF'),
+        '-DDOUBLE:BOOL={}'.format('ON' if ENABLE_DOUBLE else 'OFF')
     ]
 
     # example of build args
@@ -221,6 +222,12 @@ if '--omp' in sys.argv:
   ENABLE_OMP = True
   sys.argv.remove('--omp')
 
+ENABLE_DOUBLE = False
+
+if '--double' in sys.argv:
+  ENABLE_DOUBLE = True
+  sys.argv.remove('--double')
+
 # Import the README and use it as the long-description.
 # Note: this will only work if 'README.md' is present in your MANIFEST.in file!
 try:
@@ -7,12 +7,702 @@
 #include <overall_stats.h>
 
 
-scorer :: scorer ()
+/// @cond DEF
+// names of the statistics (in the order of scorer :: stat_index)
+static const char * stat_names[scorer :: n_stats] = {
+	"classes",
+	"confusion_matrix",
+	"marginals",
+	"TP",
+	"FN",
+	"FP",
+	"TN",
+	"POP",
+	"P",
+	"N",
+	"TOP",
+	"TON",
+	"TPR",
+	"TNR",
+	"PPV",
+	"NPV",
+	"FNR",
+	"FPR",
+	"FDR",
+	"FOR",
+	"ACC",
+	"F1_SCORE",
+	"F05_SCORE",
+	"F2_SCORE",
+	"MCC",
+	"BM",
+	"MK",
+	"ICSI",
+	"PLR",
+	"NLR",
+	"DOR",
+	"PRE",
+	"G",
+	"RACC",
+	"ERR_ACC",
+	"RACCU",
+	"jaccard_index",
+	"IS",
+	"CEN",
+	"MCEN",
+	"AUC",
+	"dIND",
+	"sIND",
+	"DP",
+	"Y",
+	"PLRI",
+	"NLRI",
+	"DPI",
+	"AUCI",
+	"GI",
+	"LS",
+	"AM",
+	"OP",
+	"IBA",
+	"GM",
+	"Q",
+	"AGM",
+	"MCCI",
+	"AGF",
+	"OC",
+	"OOC",
+	"AUPR",
+	"BCD",
+	"overall_accuracy",
+	"overall_random_accuracy_unbiased",
+	"overall_random_accuracy",
+	"overall_kappa",
+	"PC_PI",
+	"PC_AC1",
+	"PC_S",
+	"PI",
+	"AC1",
+	"S",
+	"kappa_SE",
+	"kappa_unbiased",
+	"kappa_no_prevalence",
+	"kappa_CI_up",
+	"kappa_CI_down",
+	"overall_accuracy_se",
+	"overall_accuracy_ci_up",
+	"overall_accuracy_ci_down",
+	"chi_square",
+	"phi_square",
+	"cramer_V",
+	"response_entropy",
+	"reference_entropy",
+	"cross_entropy",
+	"join_entropy",
+	"conditional_entropy",
+	"mutual_information",
+	"kl_divergence",
+	"lambda_B",
+	"lambda_A",
+	"DF",
+	"overall_jaccard_index",
+	"hamming_loss",
+	"zero_one_loss",
+	"NIR",
+	"p_value",
+	"overall_CEN",
+	"overall_MCEN",
+	"overall_MCC",
+	"RR",
+	"CBA",
+	"AUNU",
+	"AUNP",
+	"RCI",
+	"CSI",
+	"overall_pearson_C",
+	"TPR_PPV_F1_micro",
+	"MCC_analysis",
+	"kappa_analysis_cicchetti",
+	"kappa_analysis_koch",
+	"kappa_analysis_fleiss",
+	"kappa_analysis_altman",
+	"V_analysis",
+	"TPR_macro",
+	"PPV_macro",
+	"ACC_macro",
+	"F1_macro",
+};
+
+// dependencies of the k-th statistic are stat_deps[stat_offset[k] : stat_offset[k + 1]]
+static const int32_t stat_offset[scorer :: n_stats + 1] = { 0, 0, 1, 2, 3, 4, 5, 6, 10, 12, 14, 16, 18, 20, 22, 24, 26, 27, 28, 29, 30, 34, 37, 40, 43, 47, 49, 51, 53, 55, 57, 59, 61, 63, 66, 67, 70, 73, 77, 79, 81, 83, 85, 86, 88, 89, 90, 91, 92, 93, 94, 96, 98, 101, 103, 105, 109, 114, 115, 119, 122, 125, 127, 130, 132, 133, 134, 136, 139, 142, 143, 145, 147, 149, 152, 154, 155, 157, 159, 161, 163, 165, 169, 171, 172, 174, 176, 179, 181, 184, 186, 189, 192, 195, 196, 197, 199, 201, 203, 206, 209, 213, 216, 217, 220, 221, 224, 226, 227, 229, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241 };
+
+static const int32_t stat_deps[] = {
+	scorer :: idx_classes, // confusion_matrix
+	scorer :: idx_confusion_matrix, // marginals
+	scorer :: idx_marginals, // TP
+	scorer :: idx_marginals, // FN
+	scorer :: idx_marginals, // FP
+	scorer :: idx_marginals, // TN
+	scorer :: idx_TP, scorer :: idx_TN, scorer :: idx_FP, scorer :: idx_FN, // POP
+	scorer :: idx_TP, scorer :: idx_FN, // P
+	scorer :: idx_TN, scorer :: idx_FP, // N
+	scorer :: idx_TP, scorer :: idx_FP, // TOP
+	scorer :: idx_TN, scorer :: idx_FN, // TON
+	scorer :: idx_TP, scorer :: idx_FN, // TPR
+	scorer :: idx_TN, scorer :: idx_FP, // TNR
+	scorer :: idx_TP, scorer :: idx_FP, // PPV
+	scorer :: idx_TN, scorer :: idx_FN, // NPV
+	scorer :: idx_TPR, // FNR
+	scorer :: idx_TNR, // FPR
+	scorer :: idx_PPV, // FDR
+	scorer :: idx_NPV, // FOR
+	scorer :: idx_TP, scorer :: idx_FP, scorer :: idx_FN, scorer :: idx_TN, // ACC
+	scorer :: idx_TP, scorer :: idx_FP, scorer :: idx_FN, // F1_SCORE
+	scorer :: idx_TP, scorer :: idx_FP, scorer :: idx_FN, // F05_SCORE
+	scorer :: idx_TP, scorer :: idx_FP, scorer :: idx_FN, // F2_SCORE
+	scorer :: idx_TP, scorer :: idx_TN, scorer :: idx_FP, scorer :: idx_FN, // MCC
+	scorer :: idx_TPR, scorer :: idx_TNR, // BM
+	scorer :: idx_PPV, scorer :: idx_NPV, // MK
+	scorer :: idx_PPV, scorer :: idx_TPR, // ICSI
+	scorer :: idx_TPR, scorer :: idx_FPR, // PLR
+	scorer :: idx_FNR, scorer :: idx_TNR, // NLR
+	scorer :: idx_PLR, scorer :: idx_NLR, // DOR
+	scorer :: idx_P, scorer :: idx_POP, // PRE
+	scorer :: idx_PPV, scorer :: idx_TPR, // G
+	scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_POP, // RACC
+	scorer :: idx_ACC, // ERR_ACC
+	scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_POP, // RACCU
+	scorer :: idx_TP, scorer :: idx_TOP, scorer :: idx_P, // jaccard_index
+	scorer :: idx_TP, scorer :: idx_FP, scorer :: idx_FN, scorer :: idx_POP, // IS
+	scorer :: idx_confusion_matrix, scorer :: idx_marginals, // CEN
+	scorer :: idx_confusion_matrix, scorer :: idx_marginals, // MCEN
+	scorer :: idx_TNR, scorer :: idx_TPR, // AUC
+	scorer :: idx_TNR, scorer :: idx_TPR, // dIND
+	scorer :: idx_dIND, // sIND
+	scorer :: idx_TPR, scorer :: idx_TNR, // DP
+	scorer :: idx_BM, // Y
+	scorer :: idx_PLR, // PLRI
+	scorer :: idx_NLR, // NLRI
+	scorer :: idx_DP, // DPI
+	scorer :: idx_AUC, // AUCI
+	scorer :: idx_AUC, // GI
+	scorer :: idx_PPV, scorer :: idx_PRE, // LS
+	scorer :: idx_TOP, scorer :: idx_P, // AM
+	scorer :: idx_ACC, scorer :: idx_TPR, scorer :: idx_TNR, // OP
+	scorer :: idx_TPR, scorer :: idx_TNR, // IBA
+	scorer :: idx_TNR, scorer :: idx_TPR, // GM
+	scorer :: idx_TP, scorer :: idx_TN, scorer :: idx_FP, scorer :: idx_FN, // Q
+	scorer :: idx_TPR, scorer :: idx_TNR, scorer :: idx_GM, scorer :: idx_N, scorer :: idx_POP, // AGM
+	scorer :: idx_MCC, // MCCI
+	scorer :: idx_TP, scorer :: idx_FP, scorer :: idx_FN, scorer :: idx_TN, // AGF
+	scorer :: idx_TP, scorer :: idx_TOP, scorer :: idx_P, // OC
+	scorer :: idx_TP, scorer :: idx_TOP, scorer :: idx_P, // OOC
+	scorer :: idx_PPV, scorer :: idx_TPR, // AUPR
+	scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_AM, // BCD
+	scorer :: idx_TP, scorer :: idx_POP, // overall_accuracy
+	scorer :: idx_RACCU, // overall_random_accuracy_unbiased
+	scorer :: idx_RACC, // overall_random_accuracy
+	scorer :: idx_overall_random_accuracy, scorer :: idx_overall_accuracy, // overall_kappa
+	scorer :: idx_P, scorer :: idx_TOP, scorer :: idx_POP, // PC_PI
+	scorer :: idx_P, scorer :: idx_TOP, scorer :: idx_POP, // PC_AC1
+	scorer :: idx_classes, // PC_S
+	scorer :: idx_PC_PI, scorer :: idx_overall_accuracy, // PI
+	scorer :: idx_PC_AC1, scorer :: idx_overall_accuracy, // AC1
+	scorer :: idx_PC_S, scorer :: idx_overall_accuracy, // S
+	scorer :: idx_overall_accuracy, scorer :: idx_overall_random_accuracy, scorer :: idx_POP, // kappa_SE
+	scorer :: idx_overall_random_accuracy_unbiased, scorer :: idx_overall_accuracy, // kappa_unbiased
+	scorer :: idx_overall_accuracy, // kappa_no_prevalence
+	scorer :: idx_overall_kappa, scorer :: idx_kappa_SE, // kappa_CI_up
+	scorer :: idx_overall_kappa, scorer :: idx_kappa_SE, // kappa_CI_down
+	scorer :: idx_overall_accuracy, scorer :: idx_POP, // overall_accuracy_se
+	scorer :: idx_overall_accuracy, scorer :: idx_overall_accuracy_se, // overall_accuracy_ci_up
+	scorer :: idx_overall_accuracy, scorer :: idx_overall_accuracy_se, // overall_accuracy_ci_down
+	scorer :: idx_confusion_matrix, scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_POP, // chi_square
+	scorer :: idx_chi_square, scorer :: idx_POP, // phi_square
+	scorer :: idx_phi_square, // cramer_V
+	scorer :: idx_TOP, scorer :: idx_POP, // response_entropy
+	scorer :: idx_P, scorer :: idx_POP, // reference_entropy
+	scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_POP, // cross_entropy
+	scorer :: idx_confusion_matrix, scorer :: idx_POP, // join_entropy
+	scorer :: idx_confusion_matrix, scorer :: idx_P, scorer :: idx_POP, // conditional_entropy
+	scorer :: idx_response_entropy, scorer :: idx_conditional_entropy, // mutual_information
+	scorer :: idx_P, scorer :: idx_TOP, scorer :: idx_POP, // kl_divergence
+	scorer :: idx_confusion_matrix, scorer :: idx_TOP, scorer :: idx_POP, // lambda_B
+	scorer :: idx_confusion_matrix, scorer :: idx_P, scorer :: idx_POP, // lambda_A
+	scorer :: idx_classes, // DF
+	scorer :: idx_jaccard_index, // overall_jaccard_index
+	scorer :: idx_TP, scorer :: idx_POP, // hamming_loss
+	scorer :: idx_TP, scorer :: idx_POP, // zero_one_loss
+	scorer :: idx_P, scorer :: idx_POP, // NIR
+	scorer :: idx_TP, scorer :: idx_POP, scorer :: idx_NIR, // p_value
+	scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_CEN, // overall_CEN
+	scorer :: idx_TP, scorer :: idx_TOP, scorer :: idx_P, scorer :: idx_MCEN, // overall_MCEN
+	scorer :: idx_confusion_matrix, scorer :: idx_TOP, scorer :: idx_P, // overall_MCC
+	scorer :: idx_TOP, // RR
+	scorer :: idx_confusion_matrix, scorer :: idx_TOP, scorer :: idx_P, // CBA
+	scorer :: idx_AUC, // AUNU
+	scorer :: idx_P, scorer :: idx_POP, scorer :: idx_AUC, // AUNP
+	scorer :: idx_mutual_information, scorer :: idx_reference_entropy, // RCI
+	scorer :: idx_ICSI, // CSI
+	scorer :: idx_chi_square, scorer :: idx_POP, // overall_pearson_C
+	scorer :: idx_TP, scorer :: idx_FN, // TPR_PPV_F1_micro
+	scorer :: idx_overall_MCC, // MCC_analysis
+	scorer :: idx_overall_kappa, // kappa_analysis_cicchetti
+	scorer :: idx_overall_kappa, // kappa_analysis_koch
+	scorer :: idx_overall_kappa, // kappa_analysis_fleiss
+	scorer :: idx_overall_kappa, // kappa_analysis_altman
+	scorer :: idx_cramer_V, // V_analysis
+	scorer :: idx_TPR, // TPR_macro
+	scorer :: idx_PPV, // PPV_macro
+	scorer :: idx_ACC, // ACC_macro
+	scorer :: idx_F1_SCORE, // F1_macro
+};
+
+static std :: bitset < scorer :: n_stats > stats_mask (std :: initializer_list < int32_t > stats)
 {
+	std :: bitset < scorer :: n_stats > mask;
+	for (const auto & k : stats)
+		mask.set(k);
+	return mask;
+}
+
+// statistics evaluated by the fused kernels
+static const std :: bitset < scorer :: n_stats > class_stats_mask = stats_mask({
+	scorer :: idx_POP, scorer :: idx_P, scorer :: idx_N, scorer :: idx_TOP, scorer :: idx_TON, scorer :: idx_TPR,
+	scorer :: idx_TNR, scorer :: idx_PPV, scorer :: idx_NPV, scorer :: idx_FNR, scorer :: idx_FPR, scorer :: idx_FDR,
+	scorer :: idx_FOR, scorer :: idx_ACC, scorer :: idx_F1_SCORE, scorer :: idx_F05_SCORE, scorer :: idx_F2_SCORE, scorer :: idx_MCC,
+	scorer :: idx_BM, scorer :: idx_MK, scorer :: idx_ICSI, scorer :: idx_PLR, scorer :: idx_NLR, scorer :: idx_DOR,
+	scorer :: idx_PRE, scorer :: idx_G, scorer :: idx_RACC, scorer :: idx_ERR_ACC, scorer :: idx_RACCU, scorer :: idx_jaccard_index,
+	scorer :: idx_IS, scorer :: idx_AUC, scorer :: idx_dIND, scorer :: idx_sIND, scorer :: idx_DP, scorer :: idx_Y,
+	scorer :: idx_PLRI, scorer :: idx_NLRI, scorer :: idx_DPI, scorer :: idx_AUCI, scorer :: idx_GI, scorer :: idx_LS,
+	scorer :: idx_AM, scorer :: idx_OP, scorer :: idx_IBA, scorer :: idx_GM, scorer :: idx_Q, scorer :: idx_AGM,
+	scorer :: idx_MCCI, scorer :: idx_AGF, scorer :: idx_OC, scorer :: idx_OOC, scorer :: idx_AUPR
+});
+/// @endcond
+
+
+template < typename count_type >
+basic_scorer < count_type > :: basic_scorer () : Nclass (0), fixed_classes (false), sparse_mode (false)
+{
+	this->required.set();
+}
+
+
+template < typename count_type >
+bool basic_scorer < count_type > :: select (const std :: vector < std :: string > & metrics)
+{
+	std :: bitset < n_stats > required;
+
+	for (const auto & name : metrics)
+	{
+		const int32_t k = stat_id(name);
+
+		if ( k < 0 )
+			return false;
+
+		required.set(k);
+	}
+
+	if ( required.none() )
+	{
+		this->required.set();
+		return true;
+	}
+
+	// the statistics are in topological order, so a single backward scan
+	// propagates the requests to all the (transitive) dependencies
+	for (int32_t k = n_stats - 1; k >= 0; --k)
+		if ( required[k] )
+			for (int32_t d = stat_offset[k]; d < stat_offset[k + 1]; ++d)
+				required.set(stat_deps[d]);
+
+	this->required = required;
+
+	return true;
+}
+
+
+template < typename count_type >
+int32_t basic_scorer < count_type > :: stat_id (const std :: string & name)
+{
+	const auto it = std :: find(stat_names, stat_names + n_stats, name);
+
+	return it == stat_names + n_stats ? -1 : static_cast < int32_t >(std :: distance(stat_names, it));
+}
+
+
+template < typename count_type >
+int32_t basic_scorer < count_type > :: stat_size (const int32_t & stat) const
+{
+	switch (stat)
+	{
+		case idx_TP:
+		case idx_FN:
+		case idx_FP:
+		case idx_TN:
+		case idx_POP:
+		case idx_P:
+		case idx_N:
+		case idx_TOP:
+		case idx_TON:
+		case idx_TPR:
+		case idx_TNR:
+		case idx_PPV:
+		case idx_NPV:
+		case idx_FNR:
+		case idx_FPR:
+		case idx_FDR:
+		case idx_FOR:
+		case idx_ACC:
+		case idx_F1_SCORE:
+		case idx_F05_SCORE:
+		case idx_F2_SCORE:
+		case idx_MCC:
+		case idx_BM:
+		case idx_MK:
+		case idx_ICSI:
+		case idx_PLR:
+		case idx_NLR:
+		case idx_DOR:
+		case idx_PRE:
+		case idx_G:
+		case idx_RACC:
+		case idx_ERR_ACC:
+		case idx_RACCU:
+		case idx_jaccard_index:
+		case idx_IS:
+		case idx_CEN:
+		case idx_MCEN:
+		case idx_AUC:
+		case idx_dIND:
+		case idx_sIND:
+		case idx_DP:
+		case idx_Y:
+		case idx_PLRI:
+		case idx_NLRI:
+		case idx_DPI:
+		case idx_AUCI:
+		case idx_GI:
+		case idx_LS:
+		case idx_AM:
+		case idx_OP:
+		case idx_IBA:
+		case idx_GM:
+		case idx_Q:
+		case idx_AGM:
+		case idx_MCCI:
+		case idx_AGF:
+		case idx_OC:
+		case idx_OOC:
+		case idx_AUPR:
+		case idx_BCD:
+			return this->Nclass;
+		case idx_overall_accuracy:
+		case idx_overall_random_accuracy_unbiased:
+		case idx_overall_random_accuracy:
+		case idx_overall_kappa:
+		case idx_PC_PI:
+		case idx_PC_AC1:
+		case idx_PC_S:
+		case idx_PI:
+		case idx_AC1:
+		case idx_S:
+		case idx_kappa_SE:
+		case idx_kappa_unbiased:
+		case idx_kappa_no_prevalence:
+		case idx_kappa_CI_up:
+		case idx_kappa_CI_down:
+		case idx_overall_accuracy_se:
+		case idx_overall_accuracy_ci_up:
+		case idx_overall_accuracy_ci_down:
+		case idx_chi_square:
+		case idx_phi_square:
+		case idx_cramer_V:
+		case idx_response_entropy:
+		case idx_reference_entropy:
+		case idx_cross_entropy:
+		case idx_join_entropy:
+		case idx_conditional_entropy:
+		case idx_mutual_information:
+		case idx_kl_divergence:
+		case idx_lambda_B:
+		case idx_lambda_A:
+		case idx_DF:
+		case idx_overall_jaccard_index:
+		case idx_hamming_loss:
+		case idx_zero_one_loss:
+		case idx_NIR:
+		case idx_p_value:
+		case idx_overall_CEN:
+		case idx_overall_MCEN:
+		case idx_overall_MCC:
+		case idx_RR:
+		case idx_CBA:
+		case idx_AUNU:
+		case idx_AUNP:
+		case idx_RCI:
+		case idx_CSI:
+		case idx_overall_pearson_C:
+		case idx_TPR_PPV_F1_micro:
+		case idx_MCC_analysis:
+		case idx_kappa_analysis_cicchetti:
+		case idx_kappa_analysis_koch:
+		case idx_kappa_analysis_fleiss:
+		case idx_kappa_analysis_altman:
+		case idx_V_analysis:
+		case idx_TPR_macro:
+		case idx_PPV_macro:
+		case idx_ACC_macro:
+		case idx_F1_macro:
+			return 1;
+		default: return 0;
+	}
+}
+
+
+template < typename count_type >
+double basic_scorer < count_type > :: stat_value (const int32_t & stat, const int32_t & i) const
+{
+	switch (stat)
+	{
+		case idx_TP: return static_cast < double >(this->TP[i]);
+		case idx_FN: return static_cast < double >(this->FN[i]);
+		case idx_FP: return static_cast < double >(this->FP[i]);
+		case idx_TN: return static_cast < double >(this->TN[i]);
+		case idx_POP: return static_cast < double >(this->POP[i]);
+		case idx_P: return static_cast < double >(this->P[i]);
+		case idx_N: return static_cast < double >(this->N[i]);
+		case idx_TOP: return static_cast < double >(this->TOP[i]);
+		case idx_TON: return static_cast < double >(this->TON[i]);
+		case idx_TPR: return static_cast < double >(this->TPR[i]);
+		case idx_TNR: return static_cast < double >(this->TNR[i]);
+		case idx_PPV: return static_cast < double >(this->PPV[i]);
+		case idx_NPV: return static_cast < double >(this->NPV[i]);
+		case idx_FNR: return static_cast < double >(this->FNR[i]);
+		case idx_FPR: return static_cast < double >(this->FPR[i]);
+		case idx_FDR: return static_cast < double >(this->FDR[i]);
+		case idx_FOR: return static_cast < double >(this->FOR[i]);
+		case idx_ACC: return static_cast < double >(this->ACC[i]);
+		case idx_F1_SCORE: return static_cast < double >(this->F1_SCORE[i]);
+		case idx_F05_SCORE: return static_cast < double >(this->F05_SCORE[i]);
+		case idx_F2_SCORE: return static_cast < double >(this->F2_SCORE[i]);
+		case idx_MCC: return static_cast < double >(this->MCC[i]);
+		case idx_BM: return static_cast < double >(this->BM[i]);
+		case idx_MK: return static_cast < double >(this->MK[i]);
+		case idx_ICSI: return static_cast < double >(this->ICSI[i]);
+		case idx_PLR: return static_cast < double >(this->PLR[i]);
+		case idx_NLR: return static_cast < double >(this->NLR[i]);
+		case idx_DOR: return static_cast < double >(this->DOR[i]);
+		case idx_PRE: return static_cast < double >(this->PRE[i]);
+		case idx_G: return static_cast < double >(this->G[i]);
+		case idx_RACC: return static_cast < double >(this->RACC[i]);
+		case idx_ERR_ACC: return static_cast < double >(this->ERR_ACC[i]);
+		case idx_RACCU: return static_cast < double >(this->RACCU[i]);
+		case idx_jaccard_index: return static_cast < double >(this->jaccard_index[i]);
+		case idx_IS: return static_cast < double >(this->IS[i]);
+		case idx_CEN: return static_cast < double >(this->CEN[i]);
+		case idx_MCEN: return static_cast < double >(this->MCEN[i]);
+		case idx_AUC: return static_cast < double >(this->AUC[i]);
+		case idx_dIND: return static_cast < double >(this->dIND[i]);
+		case idx_sIND: return static_cast < double >(this->sIND[i]);
+		case idx_DP: return static_cast < double >(this->DP[i]);
+		case idx_Y: return static_cast < double >(this->Y[i]);
+		case idx_PLRI: return static_cast < double >(this->PLRI[i]);
+		case idx_NLRI: return static_cast < double >(this->NLRI[i]);
+		case idx_DPI: return static_cast < double >(this->DPI[i]);
+		case idx_AUCI: return static_cast < double >(this->AUCI[i]);
+		case idx_GI: return static_cast < double >(this->GI[i]);
+		case idx_LS: return static_cast < double >(this->LS[i]);
+		case idx_AM: return static_cast < double >(this->AM[i]);
+		case idx_OP: return static_cast < double >(this->OP[i]);
+		case idx_IBA: return static_cast < double >(this->IBA[i]);
+		case idx_GM: return static_cast < double >(this->GM[i]);
+		case idx_Q: return static_cast < double >(this->Q[i]);
+		case idx_AGM: return static_cast < double >(this->AGM[i]);
+		case idx_MCCI: return static_cast < double >(this->MCCI[i]);
+		case idx_AGF: return static_cast < double >(this->AGF[i]);
+		case idx_OC: return static_cast < double >(this->OC[i]);
+		case idx_OOC: return static_cast < double >(this->OOC[i]);
+		case idx_AUPR: return static_cast < double >(this->AUPR[i]);
+		case idx_BCD: return static_cast < double >(this->BCD[i]);
+		case idx_overall_accuracy: return static_cast < double >(this->overall_accuracy);
+		case idx_overall_random_accuracy_unbiased: return static_cast < double >(this->overall_random_accuracy_unbiased);
+		case idx_overall_random_accuracy: return static_cast < double >(this->overall_random_accuracy);
+		case idx_overall_kappa: return static_cast < double >(this->overall_kappa);
+		case idx_PC_PI: return static_cast < double >(this->PC_PI);
+		case idx_PC_AC1: return static_cast < double >(this->PC_AC1);
+		case idx_PC_S: return static_cast < double >(this->PC_S);
+		case idx_PI: return static_cast < double >(this->PI);
+		case idx_AC1: return static_cast < double >(this->AC1);
+		case idx_S: return static_cast < double >(this->S);
+		case idx_kappa_SE: return static_cast < double >(this->kappa_SE);
+		case idx_kappa_unbiased: return static_cast < double >(this->kappa_unbiased);
+		case idx_kappa_no_prevalence: return static_cast < double >(this->kappa_no_prevalence);
+		case idx_kappa_CI_up: return static_cast < double >(this->kappa_CI_up);
+		case idx_kappa_CI_down: return static_cast < double >(this->kappa_CI_down);
+		case idx_overall_accuracy_se: return static_cast < double >(this->overall_accuracy_se);
+		case idx_overall_accuracy_ci_up: return static_cast < double >(this->overall_accuracy_ci_up);
+		case idx_overall_accuracy_ci_down: return static_cast < double >(this->overall_accuracy_ci_down);
+		case idx_chi_square: return static_cast < double >(this->chi_square);
+		case idx_phi_square: return static_cast < double >(this->phi_square);
+		case idx_cramer_V: return static_cast < double >(this->cramer_V);
+		case idx_response_entropy: return static_cast < double >(this->response_entropy);
+		case idx_reference_entropy: return static_cast < double >(this->reference_entropy);
+		case idx_cross_entropy: return static_cast < double >(this->cross_entropy);
+		case idx_join_entropy: return static_cast < double >(this->join_entropy);
+		case idx_conditional_entropy: return static_cast < double >(this->conditional_entropy);
+		case idx_mutual_information: return static_cast < double >(this->mutual_information);
+		case idx_kl_divergence: return static_cast < double >(this->kl_divergence);
+		case idx_lambda_B: return static_cast < double >(this->lambda_B);
+		case idx_lambda_A: return static_cast < double >(this->lambda_A);
+		case idx_DF: return static_cast < double >(this->DF);
+		case idx_overall_jaccard_index: return static_cast < double >(this->overall_jaccard_index);
+		case idx_hamming_loss: return static_cast < double >(this->hamming_loss);
+		case idx_zero_one_loss: return static_cast < double >(this->zero_one_loss);
+		case idx_NIR: return static_cast < double >(this->NIR);
+		case idx_p_value: return static_cast < double >(this->p_value);
+		case idx_overall_CEN: return static_cast < double >(this->overall_CEN);
+		case idx_overall_MCEN: return static_cast < double >(this->overall_MCEN);
+		case idx_overall_MCC: return static_cast < double >(this->overall_MCC);
+		case idx_RR: return static_cast < double >(this->RR);
+		case idx_CBA: return static_cast < double >(this->CBA);
+		case idx_AUNU: return static_cast < double >(this->AUNU);
+		case idx_AUNP: return static_cast < double >(this->AUNP);
+		case idx_RCI: return static_cast < double >(this->RCI);
+		case idx_CSI: return static_cast < double >(this->CSI);
+		case idx_overall_pearson_C: return static_cast < double >(this->overall_pearson_C);
+		case idx_TPR_PPV_F1_micro: return static_cast < double >(this->TPR_PPV_F1_micro);
+		case idx_MCC_analysis: return static_cast < double >(this->MCC_analysis);
+		case idx_kappa_analysis_cicchetti: return static_cast < double >(this->kappa_analysis_cicchetti);
+		case idx_kappa_analysis_koch: return static_cast < double >(this->kappa_analysis_koch);
+		case idx_kappa_analysis_fleiss: return static_cast < double >(this->kappa_analysis_fleiss);
+		case idx_kappa_analysis_altman: return static_cast < double >(this->kappa_analysis_altman);
+		case idx_V_analysis: return static_cast < double >(this->V_analysis);
+		case idx_TPR_macro: return static_cast < double >(this->TPR_macro);
+		case idx_PPV_macro: return static_cast < double >(this->PPV_macro);
+		case idx_ACC_macro: return static_cast < double >(this->ACC_macro);
+		case idx_F1_macro: return static_cast < double >(this->F1_macro);
+		default: return 0.;
+	}
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: reserve (const int32_t & Nclass, const bool & dense)
+{
+	// the dense confusion matrix is allocated only if required (otherwise confusion_matrix is nullptr)
+	const int64_t Ncell = dense ? static_cast < int64_t >(Nclass) * Nclass : 0;
+
+	this->arena.reserve(column_arena :: bytes < count_type >(Ncell) +
+	                    column_arena :: bytes < count_type >(3 * Nclass) +
+	                    column_arena :: bytes < count_type >(Nclass) * 9 +
+	                    column_arena :: bytes < real_t >(Nclass) * 51);
+
+	this->confusion_matrix = dense ? this->arena.template column < count_type >(Ncell) : nullptr;
+	this->marginals = this->arena.template column < count_type >(3 * Nclass);
+	this->TP = this->arena.template column < count_type >(Nclass);
+	this->FN = this->arena.template column < count_type >(Nclass);
+	this->FP = this->arena.template column < count_type >(Nclass);
+	this->TN = this->arena.template column < count_type >(Nclass);
+	this->POP = this->arena.template column < count_type >(Nclass);
+	this->P = this->arena.template column < count_type >(Nclass);
+	this->N = this->arena.template column < count_type >(Nclass);
+	this->TOP = this->arena.template column < count_type >(Nclass);
+	this->TON = this->arena.template column < count_type >(Nclass);
+	this->TPR = this->arena.template column < real_t >(Nclass);
+	this->TNR = this->arena.template column < real_t >(Nclass);
+	this->PPV = this->arena.template column < real_t >(Nclass);
+	this->NPV = this->arena.template column < real_t >(Nclass);
+	this->FNR = this->arena.template column < real_t >(Nclass);
+	this->FPR = this->arena.template column < real_t >(Nclass);
+	this->FDR = this->arena.template column < real_t >(Nclass);
+	this->FOR = this->arena.template column < real_t >(Nclass);
+	this->ACC = this->arena.template column < real_t >(Nclass);
+	this->F1_SCORE = this->arena.template column < real_t >(Nclass);
+	this->F05_SCORE = this->arena.template column < real_t >(Nclass);
+	this->F2_SCORE = this->arena.template column < real_t >(Nclass);
+	this->MCC = this->arena.template column < real_t >(Nclass);
+	this->BM = this->arena.template column < real_t >(Nclass);
+	this->MK = this->arena.template column < real_t >(Nclass);
+	this->ICSI = this->arena.template column < real_t >(Nclass);
+	this->PLR = this->arena.template column < real_t >(Nclass);
+	this->NLR = this->arena.template column < real_t >(Nclass);
+	this->DOR = this->arena.template column < real_t >(Nclass);
+	this->PRE = this->arena.template column < real_t >(Nclass);
+	this->G = this->arena.template column < real_t >(Nclass);
+	this->RACC = this->arena.template column < real_t >(Nclass);
+	this->ERR_ACC = this->arena.template column < real_t >(Nclass);
+	this->RACCU = this->arena.template column < real_t >(Nclass);
+	this->jaccard_index = this->arena.template column < real_t >(Nclass);
+	this->IS = this->arena.template column < real_t >(Nclass);
+	this->CEN = this->arena.template column < real_t >(Nclass);
+	this->MCEN = this->arena.template column < real_t >(Nclass);
+	this->AUC = this->arena.template column < real_t >(Nclass);
+	this->dIND = this->arena.template column < real_t >(Nclass);
+	this->sIND = this->arena.template column < real_t >(Nclass);
+	this->DP = this->arena.template column < real_t >(Nclass);
+	this->Y = this->arena.template column < real_t >(Nclass);
+	this->PLRI = this->arena.template column < real_t >(Nclass);
+	this->NLRI = this->arena.template column < real_t >(Nclass);
+	this->DPI = this->arena.template column < real_t >(Nclass);
+	this->AUCI = this->arena.template column < real_t >(Nclass);
+	this->GI = this->arena.template column < real_t >(Nclass);
+	this->LS = this->arena.template column < real_t >(Nclass);
+	this->AM = this->arena.template column < real_t >(Nclass);
+	this->OP = this->arena.template column < real_t >(Nclass);
+	this->IBA = this->arena.template column < real_t >(Nclass);
+	this->GM = this->arena.template column < real_t >(Nclass);
+	this->Q = this->arena.template column < real_t >(Nclass);
+	this->AGM = this->arena.template column < real_t >(Nclass);
+	this->MCCI = this->arena.template column < real_t >(Nclass);
+	this->AGF = this->arena.template column < real_t >(Nclass);
+	this->OC = this->arena.template column < real_t >(Nclass);
+	this->OOC = this->arena.template column < real_t >(Nclass);
+	this->AUPR = this->arena.template column < real_t >(Nclass);
+	this->BCD = this->arena.template column < real_t >(Nclass);
+
+	// histograms of the confusion matrix for any number of chunks
+	if ( dense )
+		this->workspace.reserve(column_arena :: bytes < uint32_t >(confusion_matrix_cells(Nclass, num_workers())));
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: set_classes (const int32_t * classes, const int32_t & Nclass)
+{
+	this->classes.assign(classes, classes + Nclass);
+
+	std :: sort(this->classes.begin(), this->classes.end());
+	this->classes.erase(std :: unique(this->classes.begin(), this->classes.end()), this->classes.end());
+
+	this->Nclass = static_cast < int32_t >(this->classes.size());
+	this->fixed_classes = this->Nclass > 0;
+
+	// the dense confusion matrix is allocated by the first dense evaluation
+	this->reserve(this->Nclass, false);
+	this->lut.build(this->classes.data(), this->Nclass);
+	this->stream.reset(this->classes.data(), this->Nclass);
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)
+{
+#ifdef _OPENMP
+#pragma omp single
+#endif
+	this->stream.update(lbl_true, lbl_pred, n_lbl);
 }
 
 
-void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)
+template < typename count_type >
+void basic_scorer < count_type > :: compute_score ()
+{
+	this->stream.finalize(*this);
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: compute_sparse (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)
 {
 #ifdef __pythonic__
 #ifdef _OPENMP
@@ -22,23 +712,16 @@ void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred
 #endif
 
 	assert (n_true == n_pred);
-	auto n_lbl = n_true;
-#ifdef _OPENMP
-#pragma omp sections
-	{
-#endif
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp single
 #endif
-		this->classes = get_classes ( lbl_true, lbl_pred, n_true, n_pred );
+	{
+		if ( !this->fixed_classes )
+			this->classes = get_classes ( lbl_true, lbl_pred, n_true, n_pred );
 
-#ifdef _OPENMP
+		this->Nclass = static_cast < int32_t >(this->classes.size());
 	}
-#endif
-
-
-	this->Nclass = static_cast < int32_t >(this->classes.size());
 
 	if ( this->Nclass <= 1 )
 	{
@@ -48,64 +731,125 @@ void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred
 		std :: cerr << "Nclass must be greater than 1" << std :: endl;
 		std :: exit(1);
 	}
+
 #ifdef _OPENMP
-#pragma omp sections
-	{
+#pragma omp single
 #endif
+	{
+		this->sparse_mode = true;
+		this->reserve(this->Nclass, false);
+		this->lut.build(this->classes.data(), this->Nclass);
+		this->sparse.build(lbl_true, lbl_pred, n_true, this->lut, this->Nclass);
+	}
 
+	this->compute_stats();
+
+#ifdef __pythonic__
 #ifdef _OPENMP
-#pragma omp section
+	} // end computation function
 #endif
-		this->DF = get_DF ( this->classes.data(), this->Nclass );
+#endif
+}
+
 
+template < typename count_type >
+void basic_scorer < count_type > :: compute_from_sparse_matrix (const sparse_matrix & confusion_matrix, const float * classes)
+{
+#ifdef __pythonic__
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp parallel
+	{
+#endif
 #endif
-		this->PC_S = get_PC_S ( this->classes.data(), this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp single
 #endif
-		this->confusion_matrix = get_confusion_matrix ( lbl_true, lbl_pred, n_lbl, this->classes.data(), this->Nclass );
+	{
+		this->Nclass = confusion_matrix.size();
+
+		if ( classes != nullptr )
+			this->classes.assign(classes, classes + this->Nclass);
+		else
+		{
+			this->classes.resize(this->Nclass);
+			std :: iota(this->classes.begin(), this->classes.end(), 0.f);
+		}
+	}
 
+	if ( this->Nclass <= 1 )
+	{
 #ifdef _OPENMP
-	}
+#pragma omp single
 #endif
+		std :: cerr << "Nclass must be greater than 1" << std :: endl;
+		std :: exit(1);
+	}
 
 #ifdef _OPENMP
-#pragma omp sections
+#pragma omp single
+#endif
 	{
+		this->sparse_mode = true;
+		this->reserve(this->Nclass, false);
+		this->sparse = confusion_matrix;
+	}
+
+	this->compute_stats();
+
+#ifdef __pythonic__
+#ifdef _OPENMP
+	} // end computation function
+#endif
 #endif
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: compute_stats ()
+{
+#ifdef __omp_depend__
+	this->compute_stats_tasks();
+#else
+	this->compute_stats_layers();
+#endif
+}
 
+
+template < typename count_type >
+void basic_scorer < count_type > :: compute_stats_layers ()
+{
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->MCEN = get_MCEN ( this->confusion_matrix.get(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->CEN = get_CEN ( this->confusion_matrix.get(), this->Nclass );
+		if ( this->required[idx_DF] )
+			this->DF = get_DF ( this->classes.data(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TN = get_TN ( this->confusion_matrix.get(), this->Nclass );
+		if ( this->required[idx_PC_S] )
+			this->PC_S = get_PC_S ( this->classes.data(), this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp section
+	}
 #endif
-		this->FP = get_FP ( this->confusion_matrix.get(), this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->FN = get_FN ( this->confusion_matrix.get(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TP = get_TP ( this->confusion_matrix.get(), this->Nclass );
+		if ( this->required[idx_marginals] )
+			this->sparse_mode ? get_marginals ( this->sparse, this->Nclass, this->marginals ) : get_marginals ( this->confusion_matrix, this->Nclass, this->marginals );
 
 #ifdef _OPENMP
 	}
@@ -119,341 +863,534 @@ void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TNR = get_TNR ( this->TN.get(), this->FP.get(), this->Nclass );
+		if ( this->required[idx_MCEN] )
+			this->sparse_mode ? get_MCEN ( this->sparse, this->marginals, this->Nclass, this->MCEN ) : get_MCEN ( this->confusion_matrix, this->marginals, this->Nclass, this->MCEN );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->N = get_N ( this->TN.get(), this->FP.get(), this->Nclass );
+		if ( this->required[idx_CEN] )
+			this->sparse_mode ? get_CEN ( this->sparse, this->marginals, this->Nclass, this->CEN ) : get_CEN ( this->confusion_matrix, this->marginals, this->Nclass, this->CEN );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->NPV = get_NPV ( this->TN.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_TN] )
+			get_TN ( this->marginals, this->Nclass, this->TN );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TON = get_TON ( this->TN.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_FP] )
+			get_FP ( this->marginals, this->Nclass, this->FP );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TPR_PPV_F1_micro = get_TPR_PPV_F1_micro ( this->TP.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_FN] )
+			get_FN ( this->marginals, this->Nclass, this->FN );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->AGF = get_AGF ( this->TP.get(), this->FP.get(), this->FN.get(), this->TN.get(), this->Nclass );
+		if ( this->required[idx_TP] )
+			get_TP ( this->marginals, this->Nclass, this->TP );
 
 #ifdef _OPENMP
-#pragma omp section
+	}
 #endif
-		this->Q = get_Q ( this->TP.get(), this->TN.get(), this->FP.get(), this->FN.get(), this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->MCC = get_MCC ( this->TP.get(), this->TN.get(), this->FP.get(), this->FN.get(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->F2_SCORE = get_F2_SCORE ( this->TP.get(), this->FP.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_TPR_PPV_F1_micro] )
+			this->TPR_PPV_F1_micro = get_TPR_PPV_F1_micro ( this->TP, this->FN, this->Nclass );
+
+#ifdef _OPENMP
+#pragma omp section
+#endif
+		if ( (this->required & class_stats_mask).any() )
+		{
+			// class stats fused in a single loop over the classes
+			constexpr int64_t class_grain = 1 << 10; // min number of classes for each chunk
+			const int32_t nchunks = num_chunks(this->Nclass, class_grain);
+
+			parallel_chunks(nchunks, [&] (const int32_t & c)
+			{
+				const int64_t end = chunk_begin(this->Nclass, c + 1, nchunks);
+
+				for (int64_t i = chunk_begin(this->Nclass, c, nchunks); i < end; ++i)
+				{
+					const count_type TP = this->TP[i];
+					const count_type TN = this->TN[i];
+					const count_type FP = this->FP[i];
+					const count_type FN = this->FN[i];
+
+					const count_type POP = get_POP ( TP, TN, FP, FN );
+					this->POP[i] = POP;
+					const count_type P = get_P ( TP, FN );
+					this->P[i] = P;
+					const count_type N = get_N ( TN, FP );
+					this->N[i] = N;
+					const count_type TOP = get_TOP ( TP, FP );
+					this->TOP[i] = TOP;
+					const count_type TON = get_TON ( TN, FN );
+					this->TON[i] = TON;
+					const real_t TPR = get_TPR ( TP, FN );
+					this->TPR[i] = TPR;
+					const real_t TNR = get_TNR ( TN, FP );
+					this->TNR[i] = TNR;
+					const real_t PPV = get_PPV ( TP, FP );
+					this->PPV[i] = PPV;
+					const real_t NPV = get_NPV ( TN, FN );
+					this->NPV[i] = NPV;
+					const real_t FNR = get_FNR ( TPR );
+					this->FNR[i] = FNR;
+					const real_t FPR = get_FPR ( TNR );
+					this->FPR[i] = FPR;
+					const real_t FDR = get_FDR ( PPV );
+					this->FDR[i] = FDR;
+					const real_t FOR = get_FOR ( NPV );
+					this->FOR[i] = FOR;
+					const real_t ACC = get_ACC ( TP, FP, FN, TN );
+					this->ACC[i] = ACC;
+					const real_t F1_SCORE = get_F1_SCORE ( TP, FP, FN );
+					this->F1_SCORE[i] = F1_SCORE;
+					const real_t F05_SCORE = get_F05_SCORE ( TP, FP, FN );
+					this->F05_SCORE[i] = F05_SCORE;
+					const real_t F2_SCORE = get_F2_SCORE ( TP, FP, FN );
+					this->F2_SCORE[i] = F2_SCORE;
+					const real_t MCC = get_MCC ( TP, TN, FP, FN );
+					this->MCC[i] = MCC;
+					const real_t BM = get_BM ( TPR, TNR );
+					this->BM[i] = BM;
+					const real_t MK = get_MK ( PPV, NPV );
+					this->MK[i] = MK;
+					const real_t ICSI = get_ICSI ( PPV, TPR );
+					this->ICSI[i] = ICSI;
+					const real_t PLR = get_PLR ( TPR, FPR );
+					this->PLR[i] = PLR;
+					const real_t NLR = get_NLR ( FNR, TNR );
+					this->NLR[i] = NLR;
+					const real_t DOR = get_DOR ( PLR, NLR );
+					this->DOR[i] = DOR;
+					const real_t PRE = get_PRE ( P, POP );
+					this->PRE[i] = PRE;
+					const real_t G = get_G ( PPV, TPR );
+					this->G[i] = G;
+					const real_t RACC = get_RACC ( TOP, P, POP );
+					this->RACC[i] = RACC;
+					const real_t ERR_ACC = get_ERR_ACC ( ACC );
+					this->ERR_ACC[i] = ERR_ACC;
+					const real_t RACCU = get_RACCU ( TOP, P, POP );
+					this->RACCU[i] = RACCU;
+					const real_t jaccard_index = get_jaccard_index ( TP, TOP, P );
+					this->jaccard_index[i] = jaccard_index;
+					const real_t IS = get_IS ( TP, FP, FN, POP );
+					this->IS[i] = IS;
+					const real_t AUC = get_AUC ( TNR, TPR );
+					this->AUC[i] = AUC;
+					const real_t dIND = get_dIND ( TNR, TPR );
+					this->dIND[i] = dIND;
+					const real_t sIND = get_sIND ( dIND );
+					this->sIND[i] = sIND;
+					const real_t DP = get_DP ( TPR, TNR );
+					this->DP[i] = DP;
+					const real_t Y = get_Y ( BM );
+					this->Y[i] = Y;
+					const real_t PLRI = get_PLRI ( PLR );
+					this->PLRI[i] = PLRI;
+					const real_t NLRI = get_NLRI ( NLR );
+					this->NLRI[i] = NLRI;
+					const real_t DPI = get_DPI ( DP );
+					this->DPI[i] = DPI;
+					const real_t AUCI = get_AUCI ( AUC );
+					this->AUCI[i] = AUCI;
+					const real_t GI = get_GI ( AUC );
+					this->GI[i] = GI;
+					const real_t LS = get_LS ( PPV, PRE );
+					this->LS[i] = LS;
+					const real_t AM = get_AM ( TOP, P );
+					this->AM[i] = AM;
+					const real_t OP = get_OP ( ACC, TPR, TNR );
+					this->OP[i] = OP;
+					const real_t IBA = get_IBA ( TPR, TNR );
+					this->IBA[i] = IBA;
+					const real_t GM = get_GM ( TNR, TPR );
+					this->GM[i] = GM;
+					const real_t Q = get_Q ( TP, TN, FP, FN );
+					this->Q[i] = Q;
+					const real_t AGM = get_AGM ( TPR, TNR, GM, N, POP );
+					this->AGM[i] = AGM;
+					const real_t MCCI = get_MCCI ( MCC );
+					this->MCCI[i] = MCCI;
+					const real_t AGF = get_AGF ( TP, FP, FN, TN );
+					this->AGF[i] = AGF;
+					const real_t OC = get_OC ( TP, TOP, P );
+					this->OC[i] = OC;
+					const real_t OOC = get_OOC ( TP, TOP, P );
+					this->OOC[i] = OOC;
+					const real_t AUPR = get_AUPR ( PPV, TPR );
+					this->AUPR[i] = AUPR;
+				}
+			});
+		}
 
 #ifdef _OPENMP
-#pragma omp section
+	}
 #endif
-		this->F05_SCORE = get_F05_SCORE ( this->TP.get(), this->FP.get(), this->FN.get(), this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->F1_SCORE = get_F1_SCORE ( this->TP.get(), this->FP.get(), this->FN.get(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->ACC = get_ACC ( this->TP.get(), this->FP.get(), this->FN.get(), this->TN.get(), this->Nclass );
+		if ( this->required[idx_F1_macro] )
+			this->F1_macro = get_F1_macro ( this->F1_SCORE, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->PPV = get_PPV ( this->TP.get(), this->FP.get(), this->Nclass );
+		if ( this->required[idx_ACC_macro] )
+			this->ACC_macro = get_ACC_macro ( this->ACC, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TPR = get_TPR ( this->TP.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_PPV_macro] )
+			this->PPV_macro = get_PPV_macro ( this->PPV, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TOP = get_TOP ( this->TP.get(), this->FP.get(), this->Nclass );
+		if ( this->required[idx_TPR_macro] )
+			this->TPR_macro = get_TPR_macro ( this->TPR, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->P = get_P ( this->TP.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_CSI] )
+			this->CSI = get_CSI ( this->ICSI, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->POP = get_POP ( this->TP.get(), this->TN.get(), this->FP.get(), this->FN.get(), this->Nclass );
+		if ( this->required[idx_AUNP] )
+			this->AUNP = get_AUNP ( this->P, this->POP, this->AUC, this->Nclass );
 
 #ifdef _OPENMP
-	}
+#pragma omp section
 #endif
+		if ( this->required[idx_AUNU] )
+			this->AUNU = get_AUNU ( this->AUC, this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp sections
-	{
+#pragma omp section
 #endif
+		if ( this->required[idx_CBA] )
+			this->CBA = this->sparse_mode ? get_CBA ( this->sparse, this->TOP, this->P, this->Nclass ) : get_CBA ( this->confusion_matrix, this->TOP, this->P, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->FPR = get_FPR ( this->TNR.get(), this->Nclass );
+		if ( this->required[idx_RR] )
+			this->RR = get_RR ( this->TOP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->FOR = get_FOR ( this->NPV.get(), this->Nclass );
+		if ( this->required[idx_overall_MCC] )
+			this->overall_MCC = this->sparse_mode ? get_overall_MCC ( this->sparse, this->TOP, this->P, this->Nclass ) : get_overall_MCC ( this->confusion_matrix, this->TOP, this->P, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->MCCI = get_MCCI ( this->MCC.get(), this->Nclass );
+		if ( this->required[idx_overall_MCEN] )
+			this->overall_MCEN = get_overall_MCEN ( this->TP, this->TOP, this->P, this->MCEN, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->F1_macro = get_F1_macro ( this->F1_SCORE.get(), this->Nclass );
+		if ( this->required[idx_overall_CEN] )
+			this->overall_CEN = get_overall_CEN ( this->TOP, this->P, this->CEN, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->ACC_macro = get_ACC_macro ( this->ACC.get(), this->Nclass );
+		if ( this->required[idx_NIR] )
+			this->NIR = get_NIR ( this->P, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->ERR_ACC = get_ERR_ACC ( this->ACC.get(), this->Nclass );
+		if ( this->required[idx_zero_one_loss] )
+			this->zero_one_loss = get_zero_one_loss ( this->TP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->PPV_macro = get_PPV_macro ( this->PPV.get(), this->Nclass );
+		if ( this->required[idx_hamming_loss] )
+			this->hamming_loss = get_hamming_loss ( this->TP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->MK = get_MK ( this->PPV.get(), this->NPV.get(), this->Nclass );
+		if ( this->required[idx_overall_jaccard_index] )
+			this->overall_jaccard_index = get_overall_jaccard_index ( this->jaccard_index, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->FDR = get_FDR ( this->PPV.get(), this->Nclass );
+		if ( this->required[idx_lambda_A] )
+			this->lambda_A = this->sparse_mode ? get_lambda_A ( this->sparse, this->P, this->POP, this->Nclass ) : get_lambda_A ( this->confusion_matrix, this->P, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->TPR_macro = get_TPR_macro ( this->TPR.get(), this->Nclass );
+		if ( this->required[idx_lambda_B] )
+			this->lambda_B = this->sparse_mode ? get_lambda_B ( this->sparse, this->TOP, this->POP, this->Nclass ) : get_lambda_B ( this->confusion_matrix, this->TOP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->AUPR = get_AUPR ( this->PPV.get(), this->TPR.get(), this->Nclass );
+		if ( this->required[idx_kl_divergence] )
+			this->kl_divergence = get_kl_divergence ( this->P, this->TOP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->GM = get_GM ( this->TNR.get(), this->TPR.get(), this->Nclass );
+		if ( this->required[idx_conditional_entropy] )
+			this->conditional_entropy = this->sparse_mode ? get_conditional_entropy ( this->sparse, this->P, this->POP, this->Nclass ) : get_conditional_entropy ( this->confusion_matrix, this->P, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->IBA = get_IBA ( this->TPR.get(), this->TNR.get(), this->Nclass );
+		if ( this->required[idx_join_entropy] )
+			this->join_entropy = this->sparse_mode ? get_join_entropy ( this->sparse, this->POP, this->Nclass ) : get_join_entropy ( this->confusion_matrix, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->OP = get_OP ( this->ACC.get(), this->TPR.get(), this->TNR.get(), this->Nclass );
+		if ( this->required[idx_cross_entropy] )
+			this->cross_entropy = get_cross_entropy ( this->TOP, this->P, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->DP = get_DP ( this->TPR.get(), this->TNR.get(), this->Nclass );
+		if ( this->required[idx_reference_entropy] )
+			this->reference_entropy = get_reference_entropy ( this->P, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->dIND = get_dIND ( this->TNR.get(), this->TPR.get(), this->Nclass );
+		if ( this->required[idx_response_entropy] )
+			this->response_entropy = get_response_entropy ( this->TOP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->AUC = get_AUC ( this->TNR.get(), this->TPR.get(), this->Nclass );
+		if ( this->required[idx_chi_square] )
+			this->chi_square = this->sparse_mode ? get_chi_square ( this->sparse, this->TOP, this->P, this->POP, this->Nclass ) : get_chi_square ( this->confusion_matrix, this->TOP, this->P, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->G = get_G ( this->PPV.get(), this->TPR.get(), this->Nclass );
+		if ( this->required[idx_PC_AC1] )
+			this->PC_AC1 = get_PC_AC1 ( this->P, this->TOP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->ICSI = get_ICSI ( this->PPV.get(), this->TPR.get(), this->Nclass );
+		if ( this->required[idx_PC_PI] )
+			this->PC_PI = get_PC_PI ( this->P, this->TOP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->BM = get_BM ( this->TPR.get(), this->TNR.get(), this->Nclass );
+		if ( this->required[idx_overall_random_accuracy] )
+			this->overall_random_accuracy = get_overall_random_accuracy ( this->RACC, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->FNR = get_FNR ( this->TPR.get(), this->Nclass );
+		if ( this->required[idx_overall_random_accuracy_unbiased] )
+			this->overall_random_accuracy_unbiased = get_overall_random_accuracy_unbiased ( this->RACCU, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->RR = get_RR ( this->TOP.get(), this->Nclass );
+		if ( this->required[idx_overall_accuracy] )
+			this->overall_accuracy = get_overall_accuracy ( this->TP, this->POP, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->CBA = get_CBA ( this->confusion_matrix.get(), this->TOP.get(), this->P.get(), this->Nclass );
+		if ( this->required[idx_BCD] )
+			get_BCD ( this->TOP, this->P, this->AM, this->Nclass, this->BCD );
 
 #ifdef _OPENMP
-#pragma omp section
+	}
 #endif
-		this->overall_MCC = get_overall_MCC ( this->confusion_matrix.get(), this->TOP.get(), this->P.get(), this->Nclass );
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->overall_MCEN = get_overall_MCEN ( this->TP.get(), this->TOP.get(), this->P.get(), this->MCEN.get(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->overall_CEN = get_overall_CEN ( this->TOP.get(), this->P.get(), this->CEN.get(), this->Nclass );
+		if ( this->required[idx_MCC_analysis] )
+			this->MCC_analysis = get_MCC_analysis ( this->overall_MCC );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->OOC = get_OOC ( this->TP.get(), this->TOP.get(), this->P.get(), this->Nclass );
+		if ( this->required[idx_p_value] )
+			this->p_value = get_p_value ( this->TP, this->POP, this->Nclass, this->NIR );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->OC = get_OC ( this->TP.get(), this->TOP.get(), this->P.get(), this->Nclass );
+		if ( this->required[idx_mutual_information] )
+			this->mutual_information = get_mutual_information ( this->response_entropy, this->conditional_entropy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->AM = get_AM ( this->TOP.get(), this->P.get(), this->Nclass );
+		if ( this->required[idx_overall_pearson_C] )
+			this->overall_pearson_C = get_overall_pearson_C ( this->chi_square, this->POP );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->jaccard_index = get_jaccard_index ( this->TP.get(), this->TOP.get(), this->P.get(), this->Nclass );
+		if ( this->required[idx_phi_square] )
+			this->phi_square = get_phi_square ( this->chi_square, this->POP );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->NIR = get_NIR ( this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_overall_accuracy_se] )
+			this->overall_accuracy_se = get_overall_accuracy_se ( this->overall_accuracy, this->POP );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->zero_one_loss = get_zero_one_loss ( this->TP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_no_prevalence] )
+			this->kappa_no_prevalence = get_kappa_no_prevalence ( this->overall_accuracy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->hamming_loss = get_hamming_loss ( this->TP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_unbiased] )
+			this->kappa_unbiased = get_kappa_unbiased ( this->overall_random_accuracy_unbiased, this->overall_accuracy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->lambda_A = get_lambda_A ( this->confusion_matrix.get(), this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_SE] )
+			this->kappa_SE = get_kappa_SE ( this->overall_accuracy, this->overall_random_accuracy, this->POP );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->lambda_B = get_lambda_B ( this->confusion_matrix.get(), this->TOP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_S] )
+			this->S = get_S ( this->PC_S, this->overall_accuracy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->kl_divergence = get_kl_divergence ( this->P.get(), this->TOP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_AC1] )
+			this->AC1 = get_AC1 ( this->PC_AC1, this->overall_accuracy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->conditional_entropy = get_conditional_entropy ( this->confusion_matrix.get(), this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_PI] )
+			this->PI = get_PI ( this->PC_PI, this->overall_accuracy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->join_entropy = get_join_entropy ( this->confusion_matrix.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_overall_kappa] )
+			this->overall_kappa = get_overall_kappa ( this->overall_random_accuracy, this->overall_accuracy );
 
 #ifdef _OPENMP
-#pragma omp section
+	}
+#endif
+
+#ifdef _OPENMP
+#pragma omp sections
+	{
 #endif
-		this->cross_entropy = get_cross_entropy ( this->TOP.get(), this->P.get(), this->POP.get(), this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->reference_entropy = get_reference_entropy ( this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_RCI] )
+			this->RCI = get_RCI ( this->mutual_information, this->reference_entropy );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->response_entropy = get_response_entropy ( this->TOP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_cramer_V] )
+			this->cramer_V = get_cramer_V ( this->phi_square, this->Nclass );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->chi_square = get_chi_square ( this->confusion_matrix.get(), this->TOP.get(), this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_overall_accuracy_ci_down] )
+			this->overall_accuracy_ci_down = get_overall_accuracy_ci_down ( this->overall_accuracy, this->overall_accuracy_se );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->PC_AC1 = get_PC_AC1 ( this->P.get(), this->TOP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_overall_accuracy_ci_up] )
+			this->overall_accuracy_ci_up = get_overall_accuracy_ci_up ( this->overall_accuracy, this->overall_accuracy_se );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->PC_PI = get_PC_PI ( this->P.get(), this->TOP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_analysis_altman] )
+			this->kappa_analysis_altman = get_kappa_analysis_altman ( this->overall_kappa );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->overall_accuracy = get_overall_accuracy ( this->TP.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_analysis_fleiss] )
+			this->kappa_analysis_fleiss = get_kappa_analysis_fleiss ( this->overall_kappa );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->IS = get_IS ( this->TP.get(), this->FP.get(), this->FN.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_analysis_koch] )
+			this->kappa_analysis_koch = get_kappa_analysis_koch ( this->overall_kappa );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->RACCU = get_RACCU ( this->TOP.get(), this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_analysis_cicchetti] )
+			this->kappa_analysis_cicchetti = get_kappa_analysis_cicchetti ( this->overall_kappa );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->RACC = get_RACC ( this->TOP.get(), this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_CI_down] )
+			this->kappa_CI_down = get_kappa_CI_down ( this->overall_kappa, this->kappa_SE );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->PRE = get_PRE ( this->P.get(), this->POP.get(), this->Nclass );
+		if ( this->required[idx_kappa_CI_up] )
+			this->kappa_CI_up = get_kappa_CI_up ( this->overall_kappa, this->kappa_SE );
 
 #ifdef _OPENMP
 	}
@@ -467,241 +1404,752 @@ void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->DPI = get_DPI ( this->DP.get(), this->Nclass );
+		if ( this->required[idx_V_analysis] )
+			this->V_analysis = get_V_analysis ( this->cramer_V );
 
 #ifdef _OPENMP
-#pragma omp section
+	}
 #endif
-		this->sIND = get_sIND ( this->dIND.get(), this->Nclass );
 
+
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: compute_stats_tasks ()
+{
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp single
 #endif
-		this->AUNU = get_AUNU ( this->AUC.get(), this->Nclass );
+	{
+#ifdef __omp_depend__
+		char ready[n_stats]; // dependency token of each statistic (only its address is used)
+		(void) ready;
+#endif
+
+		if ( this->required[idx_DF] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (out: ready[idx_DF])
+#endif
+			this->DF = get_DF ( this->classes.data(), this->Nclass );
+		}
+
+		if ( this->required[idx_PC_S] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (out: ready[idx_PC_S])
+#endif
+			this->PC_S = get_PC_S ( this->classes.data(), this->Nclass );
+		}
+
+		if ( this->required[idx_marginals] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (out: ready[idx_marginals])
+#endif
+			this->sparse_mode ? get_marginals ( this->sparse, this->Nclass, this->marginals ) : get_marginals ( this->confusion_matrix, this->Nclass, this->marginals );
+		}
+
+		if ( this->required[idx_MCEN] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_marginals]) depend (out: ready[idx_MCEN])
+#endif
+			this->sparse_mode ? get_MCEN ( this->sparse, this->marginals, this->Nclass, this->MCEN ) : get_MCEN ( this->confusion_matrix, this->marginals, this->Nclass, this->MCEN );
+		}
+
+		if ( this->required[idx_CEN] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_marginals]) depend (out: ready[idx_CEN])
+#endif
+			this->sparse_mode ? get_CEN ( this->sparse, this->marginals, this->Nclass, this->CEN ) : get_CEN ( this->confusion_matrix, this->marginals, this->Nclass, this->CEN );
+		}
+
+		if ( this->required[idx_TN] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_marginals]) depend (out: ready[idx_TN])
+#endif
+			get_TN ( this->marginals, this->Nclass, this->TN );
+		}
+
+		if ( this->required[idx_FP] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_marginals]) depend (out: ready[idx_FP])
+#endif
+			get_FP ( this->marginals, this->Nclass, this->FP );
+		}
+
+		if ( this->required[idx_FN] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_marginals]) depend (out: ready[idx_FN])
+#endif
+			get_FN ( this->marginals, this->Nclass, this->FN );
+		}
+
+		if ( this->required[idx_TP] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_marginals]) depend (out: ready[idx_TP])
+#endif
+			get_TP ( this->marginals, this->Nclass, this->TP );
+		}
+
+		if ( this->required[idx_TPR_PPV_F1_micro] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_FN]) depend (out: ready[idx_TPR_PPV_F1_micro])
+#endif
+			this->TPR_PPV_F1_micro = get_TPR_PPV_F1_micro ( this->TP, this->FN, this->Nclass );
+		}
+
+		if ( (this->required & class_stats_mask).any() )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_TN], ready[idx_FP], ready[idx_FN]) depend (out: ready[idx_POP], ready[idx_P], ready[idx_N], ready[idx_TOP], ready[idx_TON], ready[idx_TPR], ready[idx_TNR], ready[idx_PPV], ready[idx_NPV], ready[idx_FNR], ready[idx_FPR], ready[idx_FDR], ready[idx_FOR], ready[idx_ACC], ready[idx_F1_SCORE], ready[idx_F05_SCORE], ready[idx_F2_SCORE], ready[idx_MCC], ready[idx_BM], ready[idx_MK], ready[idx_ICSI], ready[idx_PLR], ready[idx_NLR], ready[idx_DOR], ready[idx_PRE], ready[idx_G], ready[idx_RACC], ready[idx_ERR_ACC], ready[idx_RACCU], ready[idx_jaccard_index], ready[idx_IS], ready[idx_AUC], ready[idx_dIND], ready[idx_sIND], ready[idx_DP], ready[idx_Y], ready[idx_PLRI], ready[idx_NLRI], ready[idx_DPI], ready[idx_AUCI], ready[idx_GI], ready[idx_LS], ready[idx_AM], ready[idx_OP], ready[idx_IBA], ready[idx_GM], ready[idx_Q], ready[idx_AGM], ready[idx_MCCI], ready[idx_AGF], ready[idx_OC], ready[idx_OOC], ready[idx_AUPR])
+#endif
+			{
+				// class stats fused in a single loop over the classes
+				constexpr int64_t class_grain = 1 << 10; // min number of classes for each chunk
+				const int32_t nchunks = num_chunks(this->Nclass, class_grain);
+
+				parallel_chunks(nchunks, [&] (const int32_t & c)
+				{
+					const int64_t end = chunk_begin(this->Nclass, c + 1, nchunks);
+
+					for (int64_t i = chunk_begin(this->Nclass, c, nchunks); i < end; ++i)
+					{
+						const count_type TP = this->TP[i];
+						const count_type TN = this->TN[i];
+						const count_type FP = this->FP[i];
+						const count_type FN = this->FN[i];
+
+						const count_type POP = get_POP ( TP, TN, FP, FN );
+						this->POP[i] = POP;
+						const count_type P = get_P ( TP, FN );
+						this->P[i] = P;
+						const count_type N = get_N ( TN, FP );
+						this->N[i] = N;
+						const count_type TOP = get_TOP ( TP, FP );
+						this->TOP[i] = TOP;
+						const count_type TON = get_TON ( TN, FN );
+						this->TON[i] = TON;
+						const real_t TPR = get_TPR ( TP, FN );
+						this->TPR[i] = TPR;
+						const real_t TNR = get_TNR ( TN, FP );
+						this->TNR[i] = TNR;
+						const real_t PPV = get_PPV ( TP, FP );
+						this->PPV[i] = PPV;
+						const real_t NPV = get_NPV ( TN, FN );
+						this->NPV[i] = NPV;
+						const real_t FNR = get_FNR ( TPR );
+						this->FNR[i] = FNR;
+						const real_t FPR = get_FPR ( TNR );
+						this->FPR[i] = FPR;
+						const real_t FDR = get_FDR ( PPV );
+						this->FDR[i] = FDR;
+						const real_t FOR = get_FOR ( NPV );
+						this->FOR[i] = FOR;
+						const real_t ACC = get_ACC ( TP, FP, FN, TN );
+						this->ACC[i] = ACC;
+						const real_t F1_SCORE = get_F1_SCORE ( TP, FP, FN );
+						this->F1_SCORE[i] = F1_SCORE;
+						const real_t F05_SCORE = get_F05_SCORE ( TP, FP, FN );
+						this->F05_SCORE[i] = F05_SCORE;
+						const real_t F2_SCORE = get_F2_SCORE ( TP, FP, FN );
+						this->F2_SCORE[i] = F2_SCORE;
+						const real_t MCC = get_MCC ( TP, TN, FP, FN );
+						this->MCC[i] = MCC;
+						const real_t BM = get_BM ( TPR, TNR );
+						this->BM[i] = BM;
+						const real_t MK = get_MK ( PPV, NPV );
+						this->MK[i] = MK;
+						const real_t ICSI = get_ICSI ( PPV, TPR );
+						this->ICSI[i] = ICSI;
+						const real_t PLR = get_PLR ( TPR, FPR );
+						this->PLR[i] = PLR;
+						const real_t NLR = get_NLR ( FNR, TNR );
+						this->NLR[i] = NLR;
+						const real_t DOR = get_DOR ( PLR, NLR );
+						this->DOR[i] = DOR;
+						const real_t PRE = get_PRE ( P, POP );
+						this->PRE[i] = PRE;
+						const real_t G = get_G ( PPV, TPR );
+						this->G[i] = G;
+						const real_t RACC = get_RACC ( TOP, P, POP );
+						this->RACC[i] = RACC;
+						const real_t ERR_ACC = get_ERR_ACC ( ACC );
+						this->ERR_ACC[i] = ERR_ACC;
+						const real_t RACCU = get_RACCU ( TOP, P, POP );
+						this->RACCU[i] = RACCU;
+						const real_t jaccard_index = get_jaccard_index ( TP, TOP, P );
+						this->jaccard_index[i] = jaccard_index;
+						const real_t IS = get_IS ( TP, FP, FN, POP );
+						this->IS[i] = IS;
+						const real_t AUC = get_AUC ( TNR, TPR );
+						this->AUC[i] = AUC;
+						const real_t dIND = get_dIND ( TNR, TPR );
+						this->dIND[i] = dIND;
+						const real_t sIND = get_sIND ( dIND );
+						this->sIND[i] = sIND;
+						const real_t DP = get_DP ( TPR, TNR );
+						this->DP[i] = DP;
+						const real_t Y = get_Y ( BM );
+						this->Y[i] = Y;
+						const real_t PLRI = get_PLRI ( PLR );
+						this->PLRI[i] = PLRI;
+						const real_t NLRI = get_NLRI ( NLR );
+						this->NLRI[i] = NLRI;
+						const real_t DPI = get_DPI ( DP );
+						this->DPI[i] = DPI;
+						const real_t AUCI = get_AUCI ( AUC );
+						this->AUCI[i] = AUCI;
+						const real_t GI = get_GI ( AUC );
+						this->GI[i] = GI;
+						const real_t LS = get_LS ( PPV, PRE );
+						this->LS[i] = LS;
+						const real_t AM = get_AM ( TOP, P );
+						this->AM[i] = AM;
+						const real_t OP = get_OP ( ACC, TPR, TNR );
+						this->OP[i] = OP;
+						const real_t IBA = get_IBA ( TPR, TNR );
+						this->IBA[i] = IBA;
+						const real_t GM = get_GM ( TNR, TPR );
+						this->GM[i] = GM;
+						const real_t Q = get_Q ( TP, TN, FP, FN );
+						this->Q[i] = Q;
+						const real_t AGM = get_AGM ( TPR, TNR, GM, N, POP );
+						this->AGM[i] = AGM;
+						const real_t MCCI = get_MCCI ( MCC );
+						this->MCCI[i] = MCCI;
+						const real_t AGF = get_AGF ( TP, FP, FN, TN );
+						this->AGF[i] = AGF;
+						const real_t OC = get_OC ( TP, TOP, P );
+						this->OC[i] = OC;
+						const real_t OOC = get_OOC ( TP, TOP, P );
+						this->OOC[i] = OOC;
+						const real_t AUPR = get_AUPR ( PPV, TPR );
+						this->AUPR[i] = AUPR;
+					}
+				});
+			}
+		}
+
+		if ( this->required[idx_F1_macro] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_F1_SCORE]) depend (out: ready[idx_F1_macro])
+#endif
+			this->F1_macro = get_F1_macro ( this->F1_SCORE, this->Nclass );
+		}
+
+		if ( this->required[idx_ACC_macro] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_ACC]) depend (out: ready[idx_ACC_macro])
+#endif
+			this->ACC_macro = get_ACC_macro ( this->ACC, this->Nclass );
+		}
+
+		if ( this->required[idx_PPV_macro] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_PPV]) depend (out: ready[idx_PPV_macro])
+#endif
+			this->PPV_macro = get_PPV_macro ( this->PPV, this->Nclass );
+		}
+
+		if ( this->required[idx_TPR_macro] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TPR]) depend (out: ready[idx_TPR_macro])
+#endif
+			this->TPR_macro = get_TPR_macro ( this->TPR, this->Nclass );
+		}
+
+		if ( this->required[idx_CSI] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_ICSI]) depend (out: ready[idx_CSI])
+#endif
+			this->CSI = get_CSI ( this->ICSI, this->Nclass );
+		}
+
+		if ( this->required[idx_AUNP] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_POP], ready[idx_AUC]) depend (out: ready[idx_AUNP])
+#endif
+			this->AUNP = get_AUNP ( this->P, this->POP, this->AUC, this->Nclass );
+		}
+
+		if ( this->required[idx_AUNU] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_AUC]) depend (out: ready[idx_AUNU])
+#endif
+			this->AUNU = get_AUNU ( this->AUC, this->Nclass );
+		}
+
+		if ( this->required[idx_CBA] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_P]) depend (out: ready[idx_CBA])
+#endif
+			this->CBA = this->sparse_mode ? get_CBA ( this->sparse, this->TOP, this->P, this->Nclass ) : get_CBA ( this->confusion_matrix, this->TOP, this->P, this->Nclass );
+		}
+
+		if ( this->required[idx_RR] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP]) depend (out: ready[idx_RR])
+#endif
+			this->RR = get_RR ( this->TOP, this->Nclass );
+		}
+
+		if ( this->required[idx_overall_MCC] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_P]) depend (out: ready[idx_overall_MCC])
+#endif
+			this->overall_MCC = this->sparse_mode ? get_overall_MCC ( this->sparse, this->TOP, this->P, this->Nclass ) : get_overall_MCC ( this->confusion_matrix, this->TOP, this->P, this->Nclass );
+		}
+
+		if ( this->required[idx_overall_MCEN] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_TOP], ready[idx_P], ready[idx_MCEN]) depend (out: ready[idx_overall_MCEN])
+#endif
+			this->overall_MCEN = get_overall_MCEN ( this->TP, this->TOP, this->P, this->MCEN, this->Nclass );
+		}
+
+		if ( this->required[idx_overall_CEN] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_P], ready[idx_CEN]) depend (out: ready[idx_overall_CEN])
+#endif
+			this->overall_CEN = get_overall_CEN ( this->TOP, this->P, this->CEN, this->Nclass );
+		}
+
+		if ( this->required[idx_NIR] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_POP]) depend (out: ready[idx_NIR])
+#endif
+			this->NIR = get_NIR ( this->P, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_zero_one_loss] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_POP]) depend (out: ready[idx_zero_one_loss])
 #endif
-		this->GI = get_GI ( this->AUC.get(), this->Nclass );
+			this->zero_one_loss = get_zero_one_loss ( this->TP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_hamming_loss] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_POP]) depend (out: ready[idx_hamming_loss])
 #endif
-		this->AUCI = get_AUCI ( this->AUC.get(), this->Nclass );
+			this->hamming_loss = get_hamming_loss ( this->TP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_jaccard_index] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_jaccard_index]) depend (out: ready[idx_overall_jaccard_index])
 #endif
-		this->PLR = get_PLR ( this->TPR.get(), this->FPR.get(), this->Nclass );
+			this->overall_jaccard_index = get_overall_jaccard_index ( this->jaccard_index, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_lambda_A] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_POP]) depend (out: ready[idx_lambda_A])
 #endif
-		this->CSI = get_CSI ( this->ICSI.get(), this->Nclass );
+			this->lambda_A = this->sparse_mode ? get_lambda_A ( this->sparse, this->P, this->POP, this->Nclass ) : get_lambda_A ( this->confusion_matrix, this->P, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_lambda_B] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_POP]) depend (out: ready[idx_lambda_B])
 #endif
-		this->Y = get_Y ( this->BM.get(), this->Nclass );
+			this->lambda_B = this->sparse_mode ? get_lambda_B ( this->sparse, this->TOP, this->POP, this->Nclass ) : get_lambda_B ( this->confusion_matrix, this->TOP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_kl_divergence] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_TOP], ready[idx_POP]) depend (out: ready[idx_kl_divergence])
 #endif
-		this->NLR = get_NLR ( this->FNR.get(), this->TNR.get(), this->Nclass );
+			this->kl_divergence = get_kl_divergence ( this->P, this->TOP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_conditional_entropy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_POP]) depend (out: ready[idx_conditional_entropy])
 #endif
-		this->MCC_analysis = get_MCC_analysis ( this->overall_MCC );
+			this->conditional_entropy = this->sparse_mode ? get_conditional_entropy ( this->sparse, this->P, this->POP, this->Nclass ) : get_conditional_entropy ( this->confusion_matrix, this->P, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_join_entropy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_POP]) depend (out: ready[idx_join_entropy])
 #endif
-		this->BCD = get_BCD ( this->TOP.get(), this->P.get(), this->AM.get(), this->Nclass );
+			this->join_entropy = this->sparse_mode ? get_join_entropy ( this->sparse, this->POP, this->Nclass ) : get_join_entropy ( this->confusion_matrix, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_cross_entropy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_P], ready[idx_POP]) depend (out: ready[idx_cross_entropy])
 #endif
-		this->overall_jaccard_index = get_overall_jaccard_index ( this->jaccard_index.get(), this->Nclass );
+			this->cross_entropy = get_cross_entropy ( this->TOP, this->P, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_reference_entropy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_POP]) depend (out: ready[idx_reference_entropy])
 #endif
-		this->AUNP = get_AUNP ( this->P.get(), this->POP.get(), this->AUC.get(), this->Nclass );
+			this->reference_entropy = get_reference_entropy ( this->P, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_response_entropy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_POP]) depend (out: ready[idx_response_entropy])
 #endif
-		this->p_value = get_p_value ( this->TP.get(), this->POP.get(), this->Nclass, this->NIR );
+			this->response_entropy = get_response_entropy ( this->TOP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_chi_square] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_P], ready[idx_POP]) depend (out: ready[idx_chi_square])
 #endif
-		this->mutual_information = get_mutual_information ( this->response_entropy, this->conditional_entropy );
+			this->chi_square = this->sparse_mode ? get_chi_square ( this->sparse, this->TOP, this->P, this->POP, this->Nclass ) : get_chi_square ( this->confusion_matrix, this->TOP, this->P, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_PC_AC1] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_TOP], ready[idx_POP]) depend (out: ready[idx_PC_AC1])
 #endif
-		this->overall_pearson_C = get_overall_pearson_C ( this->chi_square, this->POP.get() );
+			this->PC_AC1 = get_PC_AC1 ( this->P, this->TOP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_PC_PI] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_P], ready[idx_TOP], ready[idx_POP]) depend (out: ready[idx_PC_PI])
 #endif
-		this->phi_square = get_phi_square ( this->chi_square, this->POP.get() );
+			this->PC_PI = get_PC_PI ( this->P, this->TOP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_random_accuracy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_RACC]) depend (out: ready[idx_overall_random_accuracy])
 #endif
-		this->overall_accuracy_se = get_overall_accuracy_se ( this->overall_accuracy, this->POP.get() );
+			this->overall_random_accuracy = get_overall_random_accuracy ( this->RACC, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_random_accuracy_unbiased] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_RACCU]) depend (out: ready[idx_overall_random_accuracy_unbiased])
 #endif
-		this->kappa_no_prevalence = get_kappa_no_prevalence ( this->overall_accuracy );
+			this->overall_random_accuracy_unbiased = get_overall_random_accuracy_unbiased ( this->RACCU, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_accuracy] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_POP]) depend (out: ready[idx_overall_accuracy])
 #endif
-		this->S = get_S ( this->PC_S, this->overall_accuracy );
+			this->overall_accuracy = get_overall_accuracy ( this->TP, this->POP, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_BCD] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TOP], ready[idx_P], ready[idx_AM]) depend (out: ready[idx_BCD])
 #endif
-		this->AC1 = get_AC1 ( this->PC_AC1, this->overall_accuracy );
+			get_BCD ( this->TOP, this->P, this->AM, this->Nclass, this->BCD );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_MCC_analysis] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_MCC]) depend (out: ready[idx_MCC_analysis])
 #endif
-		this->PI = get_PI ( this->PC_PI, this->overall_accuracy );
+			this->MCC_analysis = get_MCC_analysis ( this->overall_MCC );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_p_value] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_TP], ready[idx_POP], ready[idx_NIR]) depend (out: ready[idx_p_value])
 #endif
-		this->AGM = get_AGM ( this->TPR.get(), this->TNR.get(), this->GM.get(), this->N.get(), this->POP.get(), this->Nclass );
+			this->p_value = get_p_value ( this->TP, this->POP, this->Nclass, this->NIR );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_mutual_information] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_response_entropy], ready[idx_conditional_entropy]) depend (out: ready[idx_mutual_information])
 #endif
-		this->overall_random_accuracy_unbiased = get_overall_random_accuracy_unbiased ( this->RACCU.get(), this->Nclass );
+			this->mutual_information = get_mutual_information ( this->response_entropy, this->conditional_entropy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_pearson_C] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_chi_square], ready[idx_POP]) depend (out: ready[idx_overall_pearson_C])
 #endif
-		this->overall_random_accuracy = get_overall_random_accuracy ( this->RACC.get(), this->Nclass );
+			this->overall_pearson_C = get_overall_pearson_C ( this->chi_square, this->POP );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_phi_square] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_chi_square], ready[idx_POP]) depend (out: ready[idx_phi_square])
 #endif
-		this->LS = get_LS ( this->PPV.get(), this->PRE.get(), this->Nclass );
+			this->phi_square = get_phi_square ( this->chi_square, this->POP );
+		}
 
-#ifdef _OPENMP
-	}
+		if ( this->required[idx_overall_accuracy_se] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_accuracy], ready[idx_POP]) depend (out: ready[idx_overall_accuracy_se])
 #endif
+			this->overall_accuracy_se = get_overall_accuracy_se ( this->overall_accuracy, this->POP );
+		}
 
-#ifdef _OPENMP
-#pragma omp sections
-	{
+		if ( this->required[idx_kappa_no_prevalence] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_accuracy]) depend (out: ready[idx_kappa_no_prevalence])
 #endif
+			this->kappa_no_prevalence = get_kappa_no_prevalence ( this->overall_accuracy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_kappa_unbiased] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_random_accuracy_unbiased], ready[idx_overall_accuracy]) depend (out: ready[idx_kappa_unbiased])
 #endif
-		this->PLRI = get_PLRI ( this->PLR.get(), this->Nclass );
+			this->kappa_unbiased = get_kappa_unbiased ( this->overall_random_accuracy_unbiased, this->overall_accuracy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_kappa_SE] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_accuracy], ready[idx_overall_random_accuracy], ready[idx_POP]) depend (out: ready[idx_kappa_SE])
 #endif
-		this->NLRI = get_NLRI ( this->NLR.get(), this->Nclass );
+			this->kappa_SE = get_kappa_SE ( this->overall_accuracy, this->overall_random_accuracy, this->POP );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_S] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_PC_S], ready[idx_overall_accuracy]) depend (out: ready[idx_S])
 #endif
-		this->DOR = get_DOR ( this->PLR.get(), this->NLR.get(), this->Nclass );
+			this->S = get_S ( this->PC_S, this->overall_accuracy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_AC1] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_PC_AC1], ready[idx_overall_accuracy]) depend (out: ready[idx_AC1])
 #endif
-		this->RCI = get_RCI ( this->mutual_information, this->reference_entropy );
+			this->AC1 = get_AC1 ( this->PC_AC1, this->overall_accuracy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_PI] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_PC_PI], ready[idx_overall_accuracy]) depend (out: ready[idx_PI])
 #endif
-		this->cramer_V = get_cramer_V ( this->phi_square, this->Nclass );
+			this->PI = get_PI ( this->PC_PI, this->overall_accuracy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_kappa] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_random_accuracy], ready[idx_overall_accuracy]) depend (out: ready[idx_overall_kappa])
 #endif
-		this->overall_accuracy_ci_down = get_overall_accuracy_ci_down ( this->overall_accuracy, this->overall_accuracy_se );
+			this->overall_kappa = get_overall_kappa ( this->overall_random_accuracy, this->overall_accuracy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_RCI] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_mutual_information], ready[idx_reference_entropy]) depend (out: ready[idx_RCI])
 #endif
-		this->overall_accuracy_ci_up = get_overall_accuracy_ci_up ( this->overall_accuracy, this->overall_accuracy_se );
+			this->RCI = get_RCI ( this->mutual_information, this->reference_entropy );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_cramer_V] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_phi_square]) depend (out: ready[idx_cramer_V])
 #endif
-		this->kappa_unbiased = get_kappa_unbiased ( this->overall_random_accuracy_unbiased, this->overall_accuracy );
+			this->cramer_V = get_cramer_V ( this->phi_square, this->Nclass );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_accuracy_ci_down] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_accuracy], ready[idx_overall_accuracy_se]) depend (out: ready[idx_overall_accuracy_ci_down])
 #endif
-		this->kappa_SE = get_kappa_SE ( this->overall_accuracy, this->overall_random_accuracy, this->POP.get() );
+			this->overall_accuracy_ci_down = get_overall_accuracy_ci_down ( this->overall_accuracy, this->overall_accuracy_se );
+		}
 
-#ifdef _OPENMP
-#pragma omp section
+		if ( this->required[idx_overall_accuracy_ci_up] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_accuracy], ready[idx_overall_accuracy_se]) depend (out: ready[idx_overall_accuracy_ci_up])
 #endif
-		this->overall_kappa = get_overall_kappa ( this->overall_random_accuracy, this->overall_accuracy );
+			this->overall_accuracy_ci_up = get_overall_accuracy_ci_up ( this->overall_accuracy, this->overall_accuracy_se );
+		}
 
-#ifdef _OPENMP
-	}
+		if ( this->required[idx_kappa_analysis_altman] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_kappa]) depend (out: ready[idx_kappa_analysis_altman])
+#endif
+			this->kappa_analysis_altman = get_kappa_analysis_altman ( this->overall_kappa );
+		}
+
+		if ( this->required[idx_kappa_analysis_fleiss] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_kappa]) depend (out: ready[idx_kappa_analysis_fleiss])
+#endif
+			this->kappa_analysis_fleiss = get_kappa_analysis_fleiss ( this->overall_kappa );
+		}
+
+		if ( this->required[idx_kappa_analysis_koch] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_kappa]) depend (out: ready[idx_kappa_analysis_koch])
 #endif
+			this->kappa_analysis_koch = get_kappa_analysis_koch ( this->overall_kappa );
+		}
 
+		if ( this->required[idx_kappa_analysis_cicchetti] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_kappa]) depend (out: ready[idx_kappa_analysis_cicchetti])
+#endif
+			this->kappa_analysis_cicchetti = get_kappa_analysis_cicchetti ( this->overall_kappa );
+		}
+
+		if ( this->required[idx_kappa_CI_down] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_kappa], ready[idx_kappa_SE]) depend (out: ready[idx_kappa_CI_down])
+#endif
+			this->kappa_CI_down = get_kappa_CI_down ( this->overall_kappa, this->kappa_SE );
+		}
+
+		if ( this->required[idx_kappa_CI_up] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_overall_kappa], ready[idx_kappa_SE]) depend (out: ready[idx_kappa_CI_up])
+#endif
+			this->kappa_CI_up = get_kappa_CI_up ( this->overall_kappa, this->kappa_SE );
+		}
+
+		if ( this->required[idx_V_analysis] )
+		{
+#ifdef __omp_depend__
+#pragma omp task depend (in: ready[idx_cramer_V]) depend (out: ready[idx_V_analysis])
+#endif
+			this->V_analysis = get_V_analysis ( this->cramer_V );
+		}
+
+#ifdef __omp_depend__
+#pragma omp taskwait
+#endif
+	}
+}
+
+
+template < typename count_type >
+void basic_scorer < count_type > :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)
+{
+#ifdef __pythonic__
 #ifdef _OPENMP
-#pragma omp sections
+#pragma omp parallel
 	{
+#endif
 #endif
 
+	assert (n_true == n_pred);
+	auto n_lbl = n_true;
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->V_analysis = get_V_analysis ( this->cramer_V );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->kappa_analysis_altman = get_kappa_analysis_altman ( this->overall_kappa );
+		if ( !this->fixed_classes )
+			this->classes = get_classes ( lbl_true, lbl_pred, n_true, n_pred );
 
 #ifdef _OPENMP
-#pragma omp section
+	}
 #endif
-		this->kappa_analysis_fleiss = get_kappa_analysis_fleiss ( this->overall_kappa );
 
+
+	this->Nclass = static_cast < int32_t >(this->classes.size());
+
+	if ( this->Nclass <= 1 )
+	{
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp single
 #endif
-		this->kappa_analysis_koch = get_kappa_analysis_koch ( this->overall_kappa );
+		std :: cerr << "Nclass must be greater than 1" << std :: endl;
+		std :: exit(1);
+	}
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp single
 #endif
-		this->kappa_analysis_cicchetti = get_kappa_analysis_cicchetti ( this->overall_kappa );
+	{
+		this->sparse_mode = false;
+		this->reserve(this->Nclass, true);
+	}
 
 #ifdef _OPENMP
-#pragma omp section
+#pragma omp sections
+	{
 #endif
-		this->kappa_CI_down = get_kappa_CI_down ( this->overall_kappa, this->kappa_SE );
 
 #ifdef _OPENMP
 #pragma omp section
 #endif
-		this->kappa_CI_up = get_kappa_CI_up ( this->overall_kappa, this->kappa_SE );
+		get_confusion_matrix ( lbl_true, lbl_pred, n_lbl, this->classes.data(), this->Nclass, this->lut, this->workspace, this->confusion_matrix );
 
 #ifdef _OPENMP
 	}
 #endif
 
 
+	this->compute_stats();
+
 #ifdef __pythonic__
 #ifdef _OPENMP
 	} // end computation function
@@ -712,3 +2160,15 @@ void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred
 }
 
 
+// explicit instantiation of the scorers and of the supported data types of the confusion matrix
+template struct basic_scorer < count_t >;
+template struct basic_scorer < double >;
+template void scorer :: compute_from_confusion_matrix < count_t >(const count_t * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void scorer :: compute_from_confusion_matrix < int32_t >(const int32_t * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void scorer :: compute_from_confusion_matrix < int64_t >(const int64_t * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void weighted_scorer :: compute_from_confusion_matrix < count_t >(const count_t * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void weighted_scorer :: compute_from_confusion_matrix < int32_t >(const int32_t * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void weighted_scorer :: compute_from_confusion_matrix < int64_t >(const int64_t * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void weighted_scorer :: compute_from_confusion_matrix < float >(const float * confusion_matrix, const int32_t & Nclass, const float * classes);
+template void weighted_scorer :: compute_from_confusion_matrix < double >(const double * confusion_matrix, const int32_t & Nclass, const float * classes);
+
@@ -0,0 +1,228 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <new>          // std :: bad_alloc
+#include <cstdlib>      // std :: malloc
+#include <atomic>       // std :: atomic
+#include <random>       // std :: mt19937
+#include <vector>       // std :: vector
+#include <iostream>     // std :: cerr
+#include <algorithm>    // std :: equal
+
+#ifdef _OPENMP
+  #include <omp.h>      // omp_set_num_threads
+#endif
+
+#include <scorer.h>     // scorer object
+
+/// @cond DEF
+#if defined(__GNUC__) && !defined(__clang__)
+  // the replaced operator delete releases the memory given by the replaced operator new
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static std :: atomic < int64_t > allocations (0); ///< number of calls to operator new
+
+void * operator new (std :: size_t size)
+{
+  ++ allocations;
+
+  if ( void * ptr = std :: malloc(size ? size : 1) )
+    return ptr;
+
+  throw std :: bad_alloc();
+}
+
+void * operator new[] (std :: size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete (void * ptr) noexcept
+{
+  std :: free(ptr);
+}
+
+void operator delete[] (void * ptr) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void operator delete (void * ptr, std :: size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+
+void operator delete[] (void * ptr, std :: size_t) noexcept
+{
+  ::operator delete(ptr);
+}
+/// @endcond
+
+/**
+* @brief Generate random labels in [0, Nclass) with all the classes represented.
+*
+*/
+void random_labels (std :: mt19937 & engine, const int32_t & Nclass, std :: vector < int32_t > & lbl_true, std :: vector < int32_t > & lbl_pred)
+{
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  for (std :: size_t i = 0; i < lbl_true.size(); ++i)
+  {
+    lbl_true[i] = i < static_cast < std :: size_t >(Nclass) ? static_cast < int32_t >(i) : dist(engine);
+    lbl_pred[i] = i < static_cast < std :: size_t >(Nclass) ? static_cast < int32_t >(i) : dist(engine);
+  }
+}
+
+/**
+* @brief Check that compute_score does not allocate with a fixed set of classes.
+*
+* @details The dense confusion matrix is reserved by the first evaluation, so the
+* following ones must not allocate. The results are compared with the ones of a scorer
+* which discovers the classes from the labels and the labels out of the set must be ignored.
+* The large batches are split in chunks, which are accumulated by a new parallel
+* region (outside any parallel region) or by the tasks of the team (inside it).
+*
+*/
+int main ()
+{
+  constexpr int32_t Nclass = 3;
+  constexpr int32_t n_lbl = 1000;
+  constexpr int32_t n_large = 1 << 17;
+  constexpr int32_t n_iter = 10;
+
+  const int32_t classes[Nclass] = {0, 1, 2};
+
+#ifdef _OPENMP
+  // more than one chunk also on a single core
+  omp_set_num_threads(4);
+#endif
+
+  std :: mt19937 engine (123);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  scorer fixed;
+  fixed.set_classes(classes, Nclass);
+
+  scorer automatic;
+
+  // the first dense evaluation reserves the confusion matrix and its workspace
+  random_labels(engine, Nclass, lbl_true, lbl_pred);
+  fixed.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  for (int32_t it = 0; it < n_iter; ++it)
+  {
+    random_labels(engine, Nclass, lbl_true, lbl_pred);
+
+    const int64_t before = allocations;
+    fixed.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+    const int64_t count = allocations - before;
+
+    if ( count != 0 )
+    {
+      std :: cerr << "compute_score performed " << count << " allocations (iteration " << it << ")" << std :: endl;
+      return 1;
+    }
+
+    automatic.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+    if ( !std :: equal(fixed.confusion_matrix, fixed.confusion_matrix + Nclass * Nclass, automatic.confusion_matrix) ||
+         !std :: equal(fixed.F1_SCORE, fixed.F1_SCORE + Nclass, automatic.F1_SCORE) ||
+         fixed.overall_accuracy != automatic.overall_accuracy ||
+         fixed.overall_kappa != automatic.overall_kappa )
+    {
+      std :: cerr << "Mismatch between fixed and discovered classes (iteration " << it << ")" << std :: endl;
+      return 1;
+    }
+  }
+
+  // labels out of the set of classes are ignored
+  lbl_true[0] = 7;
+  lbl_pred[1] = -4;
+
+  const int64_t before = allocations;
+  fixed.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  if ( allocations != before )
+  {
+    std :: cerr << "compute_score performed " << allocations - before << " allocations with unknown labels" << std :: endl;
+    return 1;
+  }
+
+  int64_t total = 0;
+  for (int32_t i = 0; i < Nclass * Nclass; ++i)
+    total += static_cast < int64_t >(fixed.confusion_matrix[i]);
+
+  if ( total != n_lbl - 2 )
+  {
+    std :: cerr << "Unknown labels are counted into the confusion matrix" << std :: endl;
+    return 1;
+  }
+
+  // large batches, outside and inside a parallel region
+  std :: vector < int32_t > large_true (n_large);
+  std :: vector < int32_t > large_pred (n_large);
+  random_labels(engine, Nclass, large_true, large_pred);
+
+  automatic.compute_score(large_true.data(), large_pred.data(), n_large, n_large);
+
+  for (const bool team : {false, true})
+  {
+    const int64_t start = allocations;
+
+    if ( team )
+    {
+#ifdef _OPENMP
+#pragma omp parallel shared (fixed, large_true, large_pred)
+#endif
+      fixed.compute_score(large_true.data(), large_pred.data(), n_large, n_large);
+    }
+    else
+      fixed.compute_score(large_true.data(), large_pred.data(), n_large, n_large);
+
+    if ( allocations != start )
+    {
+      std :: cerr << "compute_score performed " << allocations - start << " allocations with " << n_large << " labels"
+                  << (team ? " inside a parallel region" : "") << std :: endl;
+      return 1;
+    }
+
+    if ( !std :: equal(fixed.confusion_matrix, fixed.confusion_matrix + Nclass * Nclass, automatic.confusion_matrix) ||
+         fixed.overall_accuracy != automatic.overall_accuracy )
+    {
+      std :: cerr << "Mismatch between fixed and discovered classes with " << n_large << " labels"
+                  << (team ? " inside a parallel region" : "") << std :: endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
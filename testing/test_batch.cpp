@@ -0,0 +1,129 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>         // std :: mt19937
+#include <vector>         // std :: vector
+#include <iostream>       // std :: cerr
+#include <algorithm>      // std :: equal
+
+#include <batch_scorer.h> // batch_scorer
+
+/**
+* @brief Check if the batch evaluation matches the single evaluations.
+*
+*/
+bool check_scores (const scorer & batch, const scorer & single)
+{
+  return batch.Nclass == single.Nclass &&
+         std :: equal(single.classes.begin(), single.classes.end(), batch.classes.begin()) &&
+         std :: equal(single.confusion_matrix, single.confusion_matrix + single.Nclass * single.Nclass, batch.confusion_matrix) &&
+         std :: equal(single.ACC, single.ACC + single.Nclass, batch.ACC) &&
+         std :: equal(single.F1_SCORE, single.F1_SCORE + single.Nclass, batch.F1_SCORE) &&
+         batch.overall_accuracy == single.overall_accuracy &&
+         batch.overall_kappa == single.overall_kappa;
+}
+
+/**
+* @brief Check the batch evaluation of many small label arrays.
+*
+*/
+int main ()
+{
+  constexpr int32_t K = 37;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (11);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  std :: vector < std :: vector < int32_t > > lbl_true (K);
+  std :: vector < std :: vector < int32_t > > lbl_pred (K);
+  std :: vector < const int32_t * > true_ptr (K);
+  std :: vector < const int32_t * > pred_ptr (K);
+  std :: vector < int32_t > sizes (K);
+
+  for (int32_t k = 0; k < K; ++k)
+  {
+    sizes[k] = 50 + 10 * k;
+
+    for (int32_t i = 0; i < sizes[k]; ++i)
+    {
+      lbl_true[k].push_back(i < Nclass ? i : dist(engine));
+      lbl_pred[k].push_back(i < Nclass ? i : dist(engine));
+    }
+
+    true_ptr[k] = lbl_true[k].data();
+    pred_ptr[k] = lbl_pred[k].data();
+  }
+
+  batch_scorer batch;
+  batch.compute_score(true_ptr.data(), pred_ptr.data(), sizes.data(), K);
+
+  if ( batch.size() != K )
+  {
+    std :: cerr << "Wrong number of evaluations" << std :: endl;
+    return 1;
+  }
+
+  for (int32_t k = 0; k < K; ++k)
+  {
+    scorer single;
+    single.compute_score(lbl_true[k].data(), lbl_pred[k].data(), sizes[k], sizes[k]);
+
+    if ( !check_scores(batch[k], single) )
+    {
+      std :: cerr << "Mismatch between batch and single evaluation (pairs, k = " << k << ")" << std :: endl;
+      return 1;
+    }
+  }
+
+  // K predictions of the same true labels
+  const int32_t n_lbl = sizes[0];
+  std :: vector < int32_t > columns;
+
+  for (int32_t k = 0; k < K; ++k)
+    columns.insert(columns.end(), lbl_pred[k].begin(), lbl_pred[k].begin() + n_lbl);
+
+  // the selection is applied to all the evaluations
+  batch.select({"ACC", "F1_SCORE", "overall_accuracy", "overall_kappa"});
+  batch.compute_score(lbl_true[0].data(), columns.data(), n_lbl, K);
+
+  for (int32_t k = 0; k < K; ++k)
+  {
+    scorer single;
+    single.compute_score(lbl_true[0].data(), lbl_pred[k].data(), n_lbl, n_lbl);
+
+    if ( !check_scores(batch[k], single) )
+    {
+      std :: cerr << "Mismatch between batch and single evaluation (columns, k = " << k << ")" << std :: endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
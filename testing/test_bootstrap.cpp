@@ -0,0 +1,104 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <vector>         // std :: vector
+#include <iostream>       // std :: cerr
+#include <algorithm>      // std :: equal
+
+#include <bootstrap.h>    // bootstrap
+
+/**
+* @brief Check the bootstrap intervals of the statistics.
+*
+* @details The intervals must contain the observed value of the statistics and
+* they must be reproducible, independently by the number of threads.
+*
+*/
+int main ()
+{
+  constexpr int32_t Nclass = 3;
+
+  const std :: vector < count_t > confusion_matrix = { 50,  5,  3,
+                                                        4, 40,  6,
+                                                        2,  7, 60 };
+
+  scorer score;
+  score.compute_from_confusion_matrix(confusion_matrix.data(), Nclass);
+
+  bootstrap engine (500, 7);
+
+  if ( engine.select({"confusion_matrix"}) || engine.select({"unknown_metric"}) )
+  {
+    std :: cerr << "Wrong statistics accepted by select" << std :: endl;
+    return 1;
+  }
+
+  engine.select({"overall_accuracy", "ACC"});
+  engine.compute(confusion_matrix.data(), Nclass);
+
+  if ( engine.size("overall_accuracy") != 1 || engine.size("ACC") != Nclass || engine.ci_up("F1_SCORE") != nullptr )
+  {
+    std :: cerr << "Wrong layout of the intervals" << std :: endl;
+    return 1;
+  }
+
+  if ( *engine.ci_down("overall_accuracy") > score.overall_accuracy || *engine.ci_up("overall_accuracy") < score.overall_accuracy )
+  {
+    std :: cerr << "The interval does not contain the observed overall accuracy" << std :: endl;
+    return 1;
+  }
+
+  for (int32_t i = 0; i < Nclass; ++i)
+  {
+    if ( engine.ci_down("ACC")[i] > score.ACC[i] || engine.ci_up("ACC")[i] < score.ACC[i] )
+    {
+      std :: cerr << "The interval does not contain the observed accuracy of class " << i << std :: endl;
+      return 1;
+    }
+  }
+
+  const std :: vector < real_t > down (engine.ci_down("ACC"), engine.ci_down("ACC") + Nclass);
+  const std :: vector < real_t > up (engine.ci_up("ACC"), engine.ci_up("ACC") + Nclass);
+
+#ifdef _OPENMP
+  omp_set_num_threads(1);
+#endif
+
+  bootstrap serial (500, 7);
+  serial.select({"ACC"});
+  serial.compute(confusion_matrix.data(), Nclass);
+
+  if ( !std :: equal(down.begin(), down.end(), serial.ci_down("ACC")) || !std :: equal(up.begin(), up.end(), serial.ci_up("ACC")) )
+  {
+    std :: cerr << "The intervals depend on the number of threads" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>          // std :: mt19937
+#include <vector>          // std :: vector
+#include <string>          // std :: string
+#include <set>             // std :: set
+#include <iostream>        // std :: cerr
+#include <cmath>           // std :: nan
+
+#include <label_encoder.h> // label_encoder
+#include <scorer.h>        // scorer object
+
+/**
+* @brief Check the codes of the label encoder against a sort-based encoding.
+*
+* @details The codes must be the position of each label in the sorted set of
+* the labels of both arrays, i.e the encoding of np.unique over the two arrays.
+*
+*/
+template < typename T, typename Key >
+bool check_codes (const std :: vector < T > & lbl_true, const std :: vector < T > & lbl_pred, const std :: vector < int32_t > & code_true, const std :: vector < int32_t > & code_pred, const int32_t & Nclass, Key && key)
+{
+  std :: set < decltype(key(lbl_true[0])) > labels;
+  for (std :: size_t i = 0; i < lbl_true.size(); ++i)
+  {
+    labels.insert(key(lbl_true[i]));
+    labels.insert(key(lbl_pred[i]));
+  }
+
+  if ( static_cast < int32_t >(labels.size()) != Nclass )
+    return false;
+
+  const std :: vector < decltype(key(lbl_true[0])) > classes (labels.begin(), labels.end());
+
+  for (std :: size_t i = 0; i < lbl_true.size(); ++i)
+    if ( classes[code_true[i]] != key(lbl_true[i]) || classes[code_pred[i]] != key(lbl_pred[i]) )
+      return false;
+
+  return true;
+}
+
+
+int main ()
+{
+  constexpr int32_t n_lbl = 200000;
+
+  std :: mt19937 engine (42);
+  std :: uniform_int_distribution < int32_t > dist (0, 999);
+
+  std :: vector < int32_t > code_true (n_lbl);
+  std :: vector < int32_t > code_pred (n_lbl);
+
+  label_encoder encoder;
+
+  // integer labels: the codes are fixed classes of the scorer
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = dist(engine) * 7919 - 3000000;
+    lbl_pred[i] = dist(engine) < 700 ? lbl_true[i] : dist(engine) * 7919 - 3000000;
+  }
+
+  int32_t Nclass = encoder.encode(lbl_true.data(), lbl_pred.data(), n_lbl, code_true.data(), code_pred.data());
+
+  if ( !check_codes(lbl_true, lbl_pred, code_true, code_pred, Nclass, [] (const int32_t & x) { return x; }) )
+  {
+    std :: cerr << "Wrong codes of the integer labels" << std :: endl;
+    return 1;
+  }
+
+  for (int32_t k = 0; k < Nclass; ++k)
+  {
+    const int64_t p = encoder.index()[k];
+    const int32_t label = p < n_lbl ? lbl_true[p] : lbl_pred[p - n_lbl];
+    const int32_t code = p < n_lbl ? code_true[p] : code_pred[p - n_lbl];
+
+    if ( code != k )
+    {
+      std :: cerr << "Wrong position of the class " << label << std :: endl;
+      return 1;
+    }
+  }
+
+  std :: vector < int32_t > codes (Nclass);
+  for (int32_t k = 0; k < Nclass; ++k)
+    codes[k] = k;
+
+  scorer raw;
+  raw.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  scorer encoded;
+  encoded.set_classes(codes.data(), Nclass);
+  encoded.compute_score(code_true.data(), code_pred.data(), n_lbl, n_lbl);
+
+  if ( raw.Nclass != encoded.Nclass || !std :: equal(raw.confusion_matrix, raw.confusion_matrix + Nclass * Nclass, encoded.confusion_matrix) || raw.overall_MCC != encoded.overall_MCC )
+  {
+    std :: cerr << "Mismatch between the scores of the raw and the encoded labels" << std :: endl;
+    return 1;
+  }
+
+  // floating point labels: the zeros and the NaNs are single classes
+
+  std :: vector < double > real_true (n_lbl);
+  std :: vector < double > real_pred (n_lbl);
+
+  const double values[] = {-1.5, -0., 0., 2.25, std :: nan(""), -std :: nan("")};
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    real_true[i] = values[dist(engine) % 6];
+    real_pred[i] = values[dist(engine) % 6];
+  }
+
+  Nclass = encoder.encode(real_true.data(), real_pred.data(), n_lbl, code_true.data(), code_pred.data());
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    const int32_t expected = real_true[i] != real_true[i] ? 3 : real_true[i] < 0 ? 0 : real_true[i] == 0 ? 1 : 2;
+
+    if ( Nclass != 4 || code_true[i] != expected )
+    {
+      std :: cerr << "Wrong codes of the floating point labels" << std :: endl;
+      return 1;
+    }
+  }
+
+  // string labels: fixed-width (with different widths) and variable-length
+
+  const std :: vector < std :: string > words = {"dog", "cat", "caterpillar", "", "ant", "Zebra", "\xc3\xa9t\xc3\xa9"};
+  constexpr int32_t width_true = 12;
+  constexpr int32_t width_pred = 16;
+
+  std :: vector < std :: string > str_true (n_lbl);
+  std :: vector < std :: string > str_pred (n_lbl);
+  std :: vector < uint8_t > fixed_true (n_lbl * width_true, 0);
+  std :: vector < uint8_t > fixed_pred (n_lbl * width_pred, 0);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    str_true[i] = words[dist(engine) % words.size()];
+    str_pred[i] = words[dist(engine) % words.size()];
+    std :: copy(str_true[i].begin(), str_true[i].end(), fixed_true.begin() + i * width_true);
+    std :: copy(str_pred[i].begin(), str_pred[i].end(), fixed_pred.begin() + i * width_pred);
+  }
+
+  Nclass = encoder.encode_fixed(fixed_true.data(), width_true, fixed_pred.data(), width_pred, n_lbl, code_true.data(), code_pred.data());
+
+  // std :: string compares the characters as char, the encoder as unsigned characters
+  auto key = [] (const std :: string & x) { return std :: vector < uint8_t >(x.begin(), x.end()); };
+
+  if ( !check_codes(str_true, str_pred, code_true, code_pred, Nclass, key) )
+  {
+    std :: cerr << "Wrong codes of the fixed-width string labels" << std :: endl;
+    return 1;
+  }
+
+  std :: vector < const uint8_t * > ptr_true (n_lbl);
+  std :: vector < const uint8_t * > ptr_pred (n_lbl);
+  std :: vector < int64_t > size_true (n_lbl);
+  std :: vector < int64_t > size_pred (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    ptr_true[i] = reinterpret_cast < const uint8_t * >(str_true[i].data());
+    ptr_pred[i] = reinterpret_cast < const uint8_t * >(str_pred[i].data());
+    size_true[i] = str_true[i].size();
+    size_pred[i] = str_pred[i].size();
+  }
+
+  Nclass = encoder.encode_strings(ptr_true.data(), size_true.data(), ptr_pred.data(), size_pred.data(), n_lbl, code_true.data(), code_pred.data());
+
+  if ( !check_codes(str_true, str_pred, code_true, code_pred, Nclass, key) )
+  {
+    std :: cerr << "Wrong codes of the variable-length string labels" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
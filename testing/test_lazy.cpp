@@ -0,0 +1,134 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>       // std :: mt19937
+#include <vector>       // std :: vector
+#include <string>       // std :: string
+#include <sstream>      // std :: ostringstream
+#include <iostream>     // std :: cerr
+#include <algorithm>    // std :: equal
+
+#include <scorer.h>     // scorer object
+
+/**
+* @brief Check the lazy evaluation of a subset of statistics.
+*
+* @details The required statistics must match the full evaluation, while the
+* statistics out of the dependency closure must not be evaluated nor printed.
+*
+*/
+int main ()
+{
+  constexpr int32_t n_lbl = 1000;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (7);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = dist(engine);
+    lbl_pred[i] = dist(engine);
+  }
+
+  scorer full;
+  full.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  scorer lazy;
+
+  if ( lazy.select({"unknown_metric"}) )
+  {
+    std :: cerr << "Unknown metric accepted by select" << std :: endl;
+    return 1;
+  }
+
+  if ( !lazy.select({"ACC", "F1_SCORE", "overall_accuracy", "overall_kappa"}) )
+  {
+    std :: cerr << "Valid metrics rejected by select" << std :: endl;
+    return 1;
+  }
+
+  // the dependencies are included in the closure while the other statistics are not
+  if ( !lazy.required[scorer :: idx_TP] || !lazy.required[scorer :: idx_overall_random_accuracy] ||
+       lazy.required[scorer :: idx_CEN] || lazy.required[scorer :: idx_p_value] )
+  {
+    std :: cerr << "Wrong closure of the required statistics" << std :: endl;
+    return 1;
+  }
+
+  constexpr float sentinel = -42.f;
+  lazy.p_value = sentinel;
+  lazy.overall_CEN = sentinel;
+
+  lazy.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  if ( !std :: equal(lazy.ACC, lazy.ACC + Nclass, full.ACC) ||
+       !std :: equal(lazy.F1_SCORE, lazy.F1_SCORE + Nclass, full.F1_SCORE) ||
+       lazy.overall_accuracy != full.overall_accuracy ||
+       lazy.overall_kappa != full.overall_kappa )
+  {
+    std :: cerr << "Mismatch between the lazy and the full evaluation" << std :: endl;
+    return 1;
+  }
+
+  if ( lazy.p_value != sentinel || lazy.overall_CEN != sentinel )
+  {
+    std :: cerr << "Statistics out of the selection have been evaluated" << std :: endl;
+    return 1;
+  }
+
+  // the statistics out of the selection are not printed
+  std :: ostringstream os;
+  lazy.print_class_stats < std :: ostream >(os);
+  lazy.print_overall_stats < std :: ostream >(os);
+
+  const std :: string table = os.str();
+
+  if ( table.find("ACC(Accuracy)") == std :: string :: npos || table.find("Overall ACC") == std :: string :: npos ||
+       table.find("CEN(Confusion entropy)") != std :: string :: npos || table.find("Overall CEN") != std :: string :: npos )
+  {
+    std :: cerr << "Wrong statistics printed after select" << std :: endl;
+    return 1;
+  }
+
+  // an empty selection restores the full evaluation
+  lazy.select({});
+  lazy.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  if ( lazy.p_value != full.p_value || lazy.overall_CEN != full.overall_CEN )
+  {
+    std :: cerr << "Empty selection does not evaluate all the statistics" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>       // std :: mt19937
+#include <vector>       // std :: vector
+#include <iostream>     // std :: cerr
+
+#include <scorer.h>     // scorer object
+
+/**
+* @brief Check that TP, FN, FP and TN derived from the marginals match the definitions.
+*
+* @details The number of classes is larger than a tile of columns of get_marginals,
+* so the partial row sums of different tiles are combined.
+*
+*/
+int main ()
+{
+  constexpr int32_t Nclass = 2100;
+  constexpr int32_t n_lbl = 20 * Nclass;
+
+  std :: mt19937 engine (42);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = i < Nclass ? i : dist(engine);
+    lbl_pred[i] = i % 3 ? lbl_true[i] : dist(engine);
+  }
+
+  scorer score;
+  score.select({"TP", "FN", "FP", "TN", "POP"});
+  score.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  if ( score.Nclass != Nclass )
+  {
+    std :: cerr << "Wrong number of classes" << std :: endl;
+    return 1;
+  }
+
+  for (int32_t c = 0; c < Nclass; ++c)
+  {
+    count_t TP = 0, FN = 0, FP = 0, TN = 0;
+
+    for (int32_t i = 0; i < n_lbl; ++i)
+    {
+      const bool t = lbl_true[i] == c;
+      const bool p = lbl_pred[i] == c;
+
+      TP += t && p;
+      FN += t && !p;
+      FP += !t && p;
+      TN += !t && !p;
+    }
+
+    if ( score.TP[c] != TP || score.FN[c] != FN || score.FP[c] != FP || score.TN[c] != TN )
+    {
+      std :: cerr << "Mismatch of the counters of the class " << c << std :: endl;
+      return 1;
+    }
+  }
+
+  if ( score.POP[0] != n_lbl )
+  {
+    std :: cerr << "Wrong population" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
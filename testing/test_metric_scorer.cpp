@@ -0,0 +1,103 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>         // std :: mt19937
+#include <vector>         // std :: vector
+#include <iostream>       // std :: cerr
+#include <algorithm>      // std :: equal
+
+#include <scorer.h>        // scorer object
+#include <metric_scorer.h> // metric_scorer object
+
+/**
+* @brief Check the scorer specialized at compile time on a set of statistics.
+*
+* @details The selected statistics must match the full evaluation, while the
+* memory must be reserved only for the dependency closure of the selection.
+*
+*/
+int main ()
+{
+  constexpr int32_t n_lbl = 1000;
+  constexpr int32_t Nclass = 5;
+
+  std :: mt19937 engine (7);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = dist(engine);
+    lbl_pred[i] = dist(engine);
+  }
+
+  scorer full;
+  full.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  using evaluator = metric_scorer < metrics :: F1_SCORE, metrics :: MCC, metrics :: overall_kappa, metrics :: overall_MCC >;
+
+  // the dependencies are included in the closure while the other statistics are not
+  static_assert (evaluator :: layout.required[metrics :: TP] && evaluator :: layout.required[metrics :: overall_random_accuracy],
+                 "Missing dependencies in the closure");
+  static_assert (!evaluator :: layout.required[metrics :: CEN] && !evaluator :: layout.required[metrics :: p_value],
+                 "Statistics out of the closure are required");
+
+  evaluator score;
+  score.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  if ( score.classes != full.classes ||
+       !std :: equal(full.F1_SCORE, full.F1_SCORE + Nclass, score.at < metrics :: F1_SCORE >()) ||
+       !std :: equal(full.MCC, full.MCC + Nclass, score.at < metrics :: MCC >()) ||
+       score.at < metrics :: overall_kappa >() != full.overall_kappa ||
+       score.at < metrics :: overall_MCC >() != full.overall_MCC )
+  {
+    std :: cerr << "Mismatch between the metric scorer and the full evaluation" << std :: endl;
+    return 1;
+  }
+
+  if ( score.arena.size() >= full.arena.size() / 4 )
+  {
+    std :: cerr << "The metric scorer reserves the memory of unselected statistics" << std :: endl;
+    return 1;
+  }
+
+  // the same statistics from the confusion matrix
+  evaluator from_matrix;
+  from_matrix.compute_from_confusion_matrix(full.confusion_matrix, Nclass, full.classes.data());
+
+  if ( from_matrix.at < metrics :: overall_MCC >() != full.overall_MCC )
+  {
+    std :: cerr << "Mismatch of the scores from the confusion matrix" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
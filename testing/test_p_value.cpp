@@ -0,0 +1,98 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <cmath>        // std :: fabs, std :: pow
+#include <iostream>     // std :: cerr
+
+#include <overall_stats.h> // regularized_beta
+
+/**
+* @brief Check the evaluation of the p-value.
+*
+* @details The small population is compared with the direct binomial sum, while
+* for large shape parameters the asymptotic expansion must agree with the
+* continued fraction just below the switching size and it must satisfy the
+* symmetry I_x(a, b) = 1 - I_{1-x}(b, a).
+*
+*/
+int main ()
+{
+  // P(X >= x) for X ~ Binomial(n, p) by the direct sum
+  constexpr int32_t n = 30;
+  constexpr int32_t x = 14;
+  constexpr double p = .3;
+
+  double tail = 0.;
+  double binom = 1.;
+
+  for (int32_t i = 0; i <= n; ++i)
+  {
+    if ( i >= x )
+      tail += binom * std :: pow(p, i) * std :: pow(1. - p, n - i);
+
+    binom = binom * (n - i) / (i + 1);
+  }
+
+  const double small = regularized_beta(x, n - x + 1, p);
+
+  if ( std :: fabs(small - tail) > 1e-12 * tail )
+  {
+    std :: cerr << "Wrong p-value of a small population: " << small << " instead of " << tail << std :: endl;
+    return 1;
+  }
+
+  // below the switching size the continued fraction is used
+  constexpr double a = 9e5;
+  constexpr double b = 6e5 + 1;
+
+  for (const double & z : {-8., -3., -1., 0., 1e-7, 1., 3., 8.})
+  {
+    const double xz = a / (a + b) + z * std :: sqrt(a * b) / ((a + b) * std :: sqrt(a + b));
+
+    const double fraction = regularized_beta(a, b, xz);
+    const double asymptotic = regularized_beta_asymptotic(a, b, xz);
+
+    if ( std :: fabs(asymptotic - fraction) > 1e-8 * fraction )
+    {
+      std :: cerr << "Mismatch between the asymptotic expansion and the continued fraction at z = " << z << ": "
+                  << asymptotic << " vs " << fraction << std :: endl;
+      return 1;
+    }
+
+    const double symmetric = regularized_beta_asymptotic(b, a, 1. - xz);
+
+    if ( std :: fabs(asymptotic + symmetric - 1.) > 1e-12 )
+    {
+      std :: cerr << "The asymptotic expansion breaks the symmetry at z = " << z << std :: endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
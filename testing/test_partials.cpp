@@ -0,0 +1,217 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>       // std :: mt19937
+#include <vector>       // std :: vector
+#include <string>       // std :: string
+#include <fstream>      // std :: ofstream
+#include <sstream>      // std :: stringstream
+#include <iostream>     // std :: cerr
+#include <algorithm>    // std :: equal
+#include <numeric>      // std :: iota
+#include <cstdlib>      // std :: system
+#include <cstdio>       // std :: remove
+
+#include <scorer.h>     // scorer object
+
+/// @cond DEF
+constexpr int32_t n_shards = 4;
+constexpr int32_t n_lbl = 500;
+/// @endcond
+
+/**
+* @brief Labels of the given shard.
+*
+* @details Each shard uses a different subset of the classes, so the
+* partials must be merged with the union of the classes.
+*
+*/
+void shard_labels (const int32_t & shard, std :: vector < int32_t > & lbl_true, std :: vector < int32_t > & lbl_pred)
+{
+  std :: mt19937 engine (shard);
+  std :: uniform_int_distribution < int32_t > dist (shard, shard + 2);
+
+  lbl_true.resize(n_lbl);
+  lbl_pred.resize(n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = dist(engine) * 10;
+    lbl_pred[i] = dist(engine) * 10;
+  }
+}
+
+/**
+* @brief Filename of the partial of the given shard.
+*
+*/
+std :: string shard_file (const int32_t & shard)
+{
+  return "partial_" + std :: to_string(shard) + ".sccm";
+}
+
+/**
+* @brief Check the map/reduce evaluation with partials written by different processes.
+*
+* @details The executable is run by itself (with the shard index as argument)
+* to write the partial of each shard; then the partials are read, merged and
+* the scores are compared with the ones computed on the concatenated labels.
+*
+*/
+int main (int argc, char ** argv)
+{
+  std :: vector < int32_t > lbl_true;
+  std :: vector < int32_t > lbl_pred;
+
+  // map step: evaluation of a single shard
+  if ( argc > 1 )
+  {
+    const int32_t shard = std :: stoi(argv[1]);
+    shard_labels(shard, lbl_true, lbl_pred);
+
+    scorer score;
+    score.update(lbl_true.data(), lbl_pred.data(), n_lbl);
+
+    std :: ofstream os (shard_file(shard), std :: ios :: binary);
+    return score.stream.save(os) ? 0 : 1;
+  }
+
+  for (int32_t shard = 0; shard < n_shards; ++shard)
+  {
+    const std :: string cmd = "\"" + std :: string(argv[0]) + "\" " + std :: to_string(shard);
+
+    if ( std :: system(cmd.c_str()) != 0 )
+    {
+      std :: cerr << "Shard " << shard << " failed" << std :: endl;
+      return 1;
+    }
+  }
+
+  // reduce step
+  confusion_accumulator total;
+
+  for (int32_t shard = 0; shard < n_shards; ++shard)
+  {
+    confusion_accumulator partial;
+    std :: ifstream is (shard_file(shard), std :: ios :: binary);
+
+    if ( !partial.load(is) )
+    {
+      std :: cerr << "Invalid partial of shard " << shard << std :: endl;
+      return 1;
+    }
+
+    is.close();
+    std :: remove(shard_file(shard).c_str());
+
+    total.merge(partial);
+  }
+
+  scorer merged;
+  total.finalize(merged);
+
+  // reference: scores of the concatenated labels
+  std :: vector < int32_t > all_true;
+  std :: vector < int32_t > all_pred;
+
+  for (int32_t shard = 0; shard < n_shards; ++shard)
+  {
+    shard_labels(shard, lbl_true, lbl_pred);
+    all_true.insert(all_true.end(), lbl_true.begin(), lbl_true.end());
+    all_pred.insert(all_pred.end(), lbl_pred.begin(), lbl_pred.end());
+  }
+
+  const int32_t n_all = static_cast < int32_t >(all_true.size());
+
+  scorer full;
+  full.compute_score(all_true.data(), all_pred.data(), n_all, n_all);
+
+  const int32_t Ncell = full.Nclass * full.Nclass;
+
+  if ( merged.classes != full.classes ||
+       !std :: equal(merged.confusion_matrix, merged.confusion_matrix + Ncell, full.confusion_matrix) ||
+       !std :: equal(merged.F1_SCORE, merged.F1_SCORE + full.Nclass, full.F1_SCORE) ||
+       merged.overall_accuracy != full.overall_accuracy )
+  {
+    std :: cerr << "Mismatch between the merged partials and the concatenated labels" << std :: endl;
+    return 1;
+  }
+
+  // a round trip must preserve the partial and a truncated one must be rejected
+  std :: stringstream buffer;
+  total.save(buffer);
+  const std :: string bytes = buffer.str();
+
+  confusion_accumulator copy;
+  std :: stringstream round (bytes);
+
+  if ( !copy.load(round) || copy.classes() != total.classes() || !std :: equal(copy.data(), copy.data() + Ncell, total.data()) )
+  {
+    std :: cerr << "Wrong round trip of the binary format" << std :: endl;
+    return 1;
+  }
+
+  std :: stringstream truncated (bytes.substr(0, bytes.size() - 1));
+
+  if ( copy.load(truncated) )
+  {
+    std :: cerr << "Truncated partial not detected" << std :: endl;
+    return 1;
+  }
+
+  // a header with many classes and no counts must be rejected before the allocation of the matrix
+  std :: string header ("SCCM\x01\x00", 6);
+  header += std :: string("\x84\xEA\x02", 3); // 46340 classes
+  header += std :: string(46340, '\x02');       // consecutive labels (zig-zag of +1)
+
+  std :: stringstream forged (header);
+
+  if ( copy.load(forged) || copy.classes() != total.classes() )
+  {
+    std :: cerr << "Forged partial not detected" << std :: endl;
+    return 1;
+  }
+
+  // a set of classes larger than 46340 (i.e. more than 2^31 cells) is accepted
+  // and its matrix is not allocated before the first accumulation
+  constexpr int32_t Nlarge = 50000;
+  std :: vector < float > large_classes (Nlarge);
+  std :: iota(large_classes.begin(), large_classes.end(), 0.f);
+
+  confusion_accumulator large;
+  large.reset(large_classes.data(), Nlarge);
+
+  if ( large.size() != Nlarge || large.data() != nullptr )
+  {
+    std :: cerr << "Wrong reset of a large set of classes" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
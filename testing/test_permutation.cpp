@@ -0,0 +1,113 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <vector>             // std :: vector
+#include <random>             // std :: mt19937
+#include <iostream>           // std :: cerr
+#include <algorithm>          // std :: equal
+
+#include <permutation_test.h> // permutation_test
+
+/**
+* @brief Check the paired permutation test between two predictions.
+*
+* @details Identical predictions must not be distinguished, a clearly better
+* prediction must be significant and the p-values must be reproducible,
+* independently by the number of threads.
+*
+*/
+int main ()
+{
+  constexpr int32_t n_lbl = 600;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (123);
+  std :: uniform_int_distribution < int32_t > label (0, Nclass - 1);
+  std :: uniform_real_distribution < float > noise (0.f, 1.f);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_good (n_lbl);
+  std :: vector < int32_t > lbl_bad (n_lbl);
+
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = label(engine);
+    lbl_good[i] = noise(engine) < .9f ? lbl_true[i] : label(engine);
+    lbl_bad[i]  = noise(engine) < .5f ? lbl_true[i] : label(engine);
+  }
+
+  permutation_test test (500, 7);
+
+  if ( test.select({"classes"}) || test.select({"unknown_metric"}) )
+  {
+    std :: cerr << "Wrong statistics accepted by select" << std :: endl;
+    return 1;
+  }
+
+  test.select({"overall_accuracy", "PPV"});
+  test.compute(lbl_true.data(), lbl_good.data(), lbl_good.data(), n_lbl);
+
+  if ( test.size("overall_accuracy") != 1 || test.size("PPV") != Nclass || test.p_value("TPR") != nullptr )
+  {
+    std :: cerr << "Wrong layout of the p-values" << std :: endl;
+    return 1;
+  }
+
+  if ( *test.difference("overall_accuracy") != 0. || *test.p_value("overall_accuracy") != 1.f )
+  {
+    std :: cerr << "Identical predictions are distinguished" << std :: endl;
+    return 1;
+  }
+
+  test.compute(lbl_true.data(), lbl_bad.data(), lbl_good.data(), n_lbl);
+
+  if ( *test.difference("overall_accuracy") <= 0. || *test.p_value("overall_accuracy") > .01f )
+  {
+    std :: cerr << "The better prediction is not significant" << std :: endl;
+    return 1;
+  }
+
+  const std :: vector < real_t > pvalues (test.p_value("PPV"), test.p_value("PPV") + Nclass);
+
+#ifdef _OPENMP
+  omp_set_num_threads(1);
+#endif
+
+  permutation_test serial (500, 7);
+  serial.select({"PPV"});
+  serial.compute(lbl_true.data(), lbl_bad.data(), lbl_good.data(), n_lbl);
+
+  if ( !std :: equal(pvalues.begin(), pvalues.end(), serial.p_value("PPV")) )
+  {
+    std :: cerr << "The p-values depend on the number of threads" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -2,10 +2,14 @@
 # -*- coding: utf-8 -*-
 
 import sys
+import time
+import threading
 from io import StringIO
+from concurrent.futures import ThreadPoolExecutor
 
 import numpy as np
 from scorer import Scorer
+from scorer.lib.scorer import _scorer
 
 import pytest
 from hypothesis import strategies as st
@@ -234,3 +238,285 @@ class TestScorer:
 
     with pytest.raises(KeyError):
       scorer['dummy']
+
+  @given(size = st.integers(min_value=5, max_value=50))
+  @settings(max_examples=10, deadline=None)
+  def test_confusion_matrix (self, size):
+
+    y_true = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(size, ))
+    y_pred = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(size, ))
+
+    y_true[:3] = y_pred[:3] = [0, 1, 2]
+
+    scorer = Scorer()
+    scorer.evaluate(y_true, y_pred)
+
+    from_cm = Scorer()
+    from_cm.evaluate_confusion_matrix(scorer['Confusion Matrix'], classes=scorer['Classes'])
+
+    np.testing.assert_array_equal(from_cm['Confusion Matrix'], scorer['Confusion Matrix'])
+    np.testing.assert_array_equal(from_cm['Classes'], scorer['Classes'])
+
+    for stat in ('ACC', 'TP', 'FP', 'F1', 'Overall ACC', 'Kappa'):
+      np.testing.assert_allclose(getattr(from_cm, stat), getattr(scorer, stat))
+
+  def test_confusion_matrix_wrong_shape (self):
+
+    scorer = Scorer()
+
+    with pytest.raises(ValueError):
+      scorer.evaluate_confusion_matrix([[1, 2, 3], [4, 5, 6]])
+
+    with pytest.raises(ValueError):
+      scorer.evaluate_confusion_matrix([[1, 2], [3, 4]], classes=['a', 'b', 'c'])
+
+  @given(size = st.integers(min_value=5, max_value=50))
+  @settings(max_examples=10, deadline=None)
+  def test_lazy_metrics (self, size):
+
+    y_true = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(size, ))
+    y_pred = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(size, ))
+
+    y_true[:3] = y_pred[:3] = [0, 1, 2]
+
+    scorer = Scorer()
+    scorer.evaluate(y_true, y_pred)
+
+    metrics = ['accuracy_score', 'F1(F1 score - harmonic mean of precision and sensitivity)', 'Overall MCC']
+
+    lazy = Scorer()
+    lazy.evaluate(y_true, y_pred, metrics=metrics)
+
+    assert set(lazy.keys()) == {'Classes', 'Confusion Matrix', 'Overall ACC', 'Overall MCC',
+                                'F1(F1 score - harmonic mean of precision and sensitivity)'}
+
+    for stat in ('Overall ACC', 'Overall MCC', 'F1(F1 score - harmonic mean of precision and sensitivity)'):
+      np.testing.assert_allclose(lazy[stat], scorer[stat])
+
+    # a new evaluation without metrics restores all the scores
+    lazy.evaluate(y_true, y_pred)
+    assert set(lazy.keys()) == set(scorer.keys())
+
+  def test_lazy_metrics_error (self):
+
+    scorer = Scorer()
+
+    with pytest.raises(ValueError):
+      scorer.evaluate([0, 1, 1, 0], [0, 1, 0, 0], metrics=['dummy'])
+
+  @given(size = st.integers(min_value=5, max_value=50))
+  @settings(max_examples=10, deadline=None)
+  def test_batch (self, size):
+
+    y_true = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(size, ))
+    y_pred = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(size, 5))
+
+    y_true[:3] = y_pred[:3, 0] = [0, 1, 2]
+    y_pred[:3, 1:] = [[0], [1], [2]]
+
+    scorer = Scorer()
+    columns = scorer.evaluate_batch(y_true, y_pred)
+    pairs = scorer.evaluate_batch([y_true] * 5, list(y_pred.T))
+
+    assert len(columns) == len(pairs) == 5
+
+    for k in range(5):
+      single = Scorer()
+      single.evaluate(y_true, y_pred[:, k])
+
+      for stat in ('Confusion Matrix', 'Classes', 'ACC', 'F1', 'Overall ACC', 'Kappa'):
+        np.testing.assert_allclose(getattr(columns[k], stat), getattr(single, stat))
+        np.testing.assert_allclose(getattr(pairs[k], stat), getattr(single, stat))
+
+  def test_batch_wrong_shape (self):
+
+    scorer = Scorer()
+
+    with pytest.raises(ValueError):
+      scorer.evaluate_batch([0, 1, 1, 0], [0, 1, 0, 0])
+
+    with pytest.raises(ValueError):
+      scorer.evaluate_batch([[0, 1, 1, 0]] * 2, [[0, 1, 0, 0]] * 3)
+
+  def test_bootstrap (self):
+
+    y_true = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(200, ))
+    y_pred = np.where(np.random.uniform(size=(200, )) < .7, y_true, np.random.choice([0, 1, 2], size=(200, )))
+
+    scorer = Scorer()
+    scorer.evaluate(y_true, y_pred)
+
+    ci = scorer.bootstrap(n_reps=200, metrics=['accuracy_score', 'class_f1score'], seed=7)
+
+    low, up = ci['Overall ACC']
+    assert low <= scorer['Overall ACC'] <= up
+
+    low, up = ci['F1(F1 score - harmonic mean of precision and sensitivity)']
+    assert low.shape == up.shape == (3, )
+    assert np.all(low <= up)
+
+    # the same seed gives the same intervals
+    again = scorer.bootstrap(n_reps=200, metrics=['accuracy_score'], seed=7)
+    assert again['Overall ACC'] == ci['Overall ACC']
+
+    full = scorer.bootstrap(n_reps=20)
+    assert 'Kappa' in full
+
+    with pytest.raises(ValueError):
+      scorer.bootstrap(metrics=['Classes'])
+
+  def test_permutation_test (self):
+
+    y_true = np.random.choice([0, 1, 2], p=[.3, .3, .4], size=(300, ))
+    y_good = np.where(np.random.uniform(size=(300, )) < .9, y_true, np.random.choice([0, 1, 2], size=(300, )))
+    y_bad = np.where(np.random.uniform(size=(300, )) < .4, y_true, np.random.choice([0, 1, 2], size=(300, )))
+
+    scorer = Scorer()
+
+    pvalues = scorer.permutation_test(y_true, y_bad, y_good, n_perm=200, metrics=['accuracy_score', 'class_f1score'], seed=7)
+    assert pvalues['Overall ACC'] < .05
+    assert pvalues['F1(F1 score - harmonic mean of precision and sensitivity)'].shape == (3, )
+
+    # the scores of the first classifier are stored
+    assert np.isclose(scorer['Overall ACC'], np.mean(y_true == y_bad))
+
+    # identical predictions are not distinguished
+    same = scorer.permutation_test(y_true, y_good, y_good, n_perm=50, metrics='accuracy_score')
+    assert same['Overall ACC'] == 1.
+
+    full = scorer.permutation_test(y_true, y_bad, y_good, n_perm=20)
+    assert 'Kappa' in full
+
+    with pytest.raises(ValueError):
+      scorer.permutation_test(y_true, y_bad, y_good, metrics=['Classes'])
+
+    with pytest.raises(ValueError):
+      scorer.permutation_test(y_true, y_bad, y_good[:10])
+
+  def test_zero_copy_results (self):
+
+    y_true = np.random.choice([0, 1, 2], size=(100, ))
+    y_pred = np.random.choice([0, 1, 2], size=(100, ))
+
+    scorer = Scorer()
+    scorer.evaluate(y_true, y_pred)
+
+    # the class statistics are views of the C++ buffers
+    TP = scorer['TP(True positive/hit)']
+    ACC = scorer['ACC(Accuracy)']
+    assert isinstance(TP, np.ndarray) and TP.dtype == np.uint64
+    assert isinstance(ACC, np.ndarray) and not ACC.flags.owndata
+    assert TP.sum() == np.sum(y_true == y_pred)
+
+    expected = ACC.copy()
+
+    # a new evaluation does not overwrite the previous arrays
+    scorer.evaluate(y_pred, y_pred)
+    np.testing.assert_allclose(ACC, expected)
+
+    # the arrays keep the results alive after the scorer is destroyed
+    del scorer
+    np.testing.assert_allclose(ACC, expected)
+    assert TP.sum() == np.sum(y_true == y_pred)
+
+  def test_concurrent_threads (self):
+
+    y_true = np.random.choice([0, 1, 2], size=(1000, ))
+    y_pred = [np.random.choice([0, 1, 2], size=(1000, )) for _ in range(16)]
+
+    def evaluate (y):
+      return Scorer().evaluate(y_true, y)
+
+    serial = [evaluate(y) for y in y_pred]
+
+    # the C++ evaluation releases the GIL, the results of the threads must be the same
+    with ThreadPoolExecutor(max_workers=4) as pool:
+      threaded = list(pool.map(evaluate, y_pred))
+
+    for a, b in zip(serial, threaded):
+      assert a['Overall ACC'] == b['Overall ACC']
+      np.testing.assert_array_equal(a['Confusion Matrix'], b['Confusion Matrix'])
+      np.testing.assert_allclose(a['F1(F1 score - harmonic mean of precision and sensitivity)'],
+                                 b['F1(F1 score - harmonic mean of precision and sensitivity)'])
+
+    # a shared _scorer stores the classes and the selection of each call with its result
+    shared = _scorer()
+    f1 = 'F1(F1 score - harmonic mean of precision and sensitivity)'
+
+    def evaluate_shared (k):
+      shared.select([f1] if k % 2 else [])
+      return shared.evaluate(np.arange(k + 2, dtype=np.int32), np.arange(k + 2, dtype=np.int32), k + 2)
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+      results = list(pool.map(evaluate_shared, range(16)))
+
+    for k, score in enumerate(results):
+      assert len(score['Classes']) == k + 2
+      np.testing.assert_array_equal(score[f1], np.ones(shape=(k + 2, )))
+
+  def test_gil_release (self):
+
+    Nclass = 2000
+    n_lbl = 4000000
+
+    rng = np.random.default_rng(42)
+    y_true = rng.integers(0, Nclass, size=(n_lbl, ), dtype=np.int32)
+    y_pred = rng.integers(0, Nclass, size=(n_lbl, ), dtype=np.int32)
+
+    scorer = _scorer()
+
+    tic = time.perf_counter()
+    scorer.evaluate(y_true, y_pred, n_lbl, Nclass)
+    duration = time.perf_counter() - tic
+
+    # the main thread must keep running while the worker is inside the C++ evaluation:
+    # if the GIL was held, the longest pause between two steps would be as long as the evaluation
+    worker = threading.Thread(target=scorer.evaluate, args=(y_true, y_pred, n_lbl, Nclass))
+    steps = [time.perf_counter()]
+    worker.start()
+
+    while worker.is_alive():
+      steps.append(time.perf_counter())
+
+    steps.append(time.perf_counter())
+    worker.join()
+
+    assert len(steps) > 2
+    assert max(np.diff(steps)) < .5 * duration
+
+  def test_label_encoder (self):
+
+    words = np.array(['dog', 'cat', 'caterpillar', 'ant', 'Zebra'])
+    y_true = np.random.choice(5, size=(1000, ))
+    y_pred = np.random.choice(5, size=(1000, ))
+
+    inputs = [(y_true, y_pred),
+              (y_true.astype(np.int8), y_pred.astype(np.int64)),
+              (y_true * .5, y_pred.astype(np.float32) * .5),
+              (words[y_true], words[y_pred].astype('U16')),
+              (words[y_true].astype('S'), words[y_pred].astype('S12')),
+              (words[y_true].astype(object), words[y_pred].astype(object)),
+              (words[y_true].tolist(), words[y_pred].tolist()),
+              (np.array([1, 2] * 500, dtype=object), np.array([2, 3] * 500, dtype=object)),
+             ]
+
+    scorer = Scorer()
+
+    for lbl_true, lbl_pred in inputs:
+
+      # the codes are the indexes of the labels in the sorted classes of both arrays
+      num_true, num_pred, classes = scorer._label2numbers(lbl_true, lbl_pred)
+      np.testing.assert_array_equal(classes[num_true], np.asarray(lbl_true))
+      np.testing.assert_array_equal(classes[num_pred], np.asarray(lbl_pred))
+      assert np.all(classes[:-1] < classes[1:])
+
+    # a class which is never predicted is still a class of both arrays
+    y_miss = np.where(y_pred == 0, 1, y_pred)
+
+    numeric = Scorer().evaluate(y_true, y_miss)
+    encoded = Scorer().evaluate(words[y_true], words[y_miss])
+
+    assert encoded.num_classes == 5
+    np.testing.assert_array_equal(encoded['Classes'], np.sort(words))
+    np.testing.assert_allclose(numeric['Overall ACC'], encoded['Overall ACC'])
+    np.testing.assert_allclose(numeric['Overall MCC'], encoded['Overall MCC'])
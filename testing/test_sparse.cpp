@@ -0,0 +1,149 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>       // std :: mt19937
+#include <vector>       // std :: vector
+#include <iostream>     // std :: cerr
+#include <cmath>        // std :: abs
+#include <numeric>      // std :: iota
+
+#include <scorer.h>     // scorer object
+
+/**
+* @brief Check that the sparse confusion matrix gives the same scores of the dense one.
+*
+* @details All the statistics are compared on a small problem (some cells of the
+* matrix are empty) and a problem with many classes is evaluated only in sparse mode.
+*
+*/
+int main ()
+{
+  constexpr int32_t n_lbl = 5000;
+  constexpr int32_t Nclass = 3;
+
+  std :: mt19937 engine (42);
+  std :: uniform_int_distribution < int32_t > dist (0, Nclass - 1);
+  std :: uniform_real_distribution < float > noise (0.f, 1.f);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  // the class 2 is never predicted as 0, so the matrix has empty cells
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    lbl_true[i] = dist(engine) * 5 - 2;
+    lbl_pred[i] = noise(engine) < .7f ? lbl_true[i] : dist(engine) * 5 - 2;
+    if ( lbl_true[i] == 8 && lbl_pred[i] == -2 )
+      lbl_pred[i] = 3;
+  }
+
+  scorer dense;
+  dense.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  scorer sparse;
+  sparse.compute_sparse(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  if ( sparse.classes != dense.classes || sparse.sparse.nnz() != Nclass * Nclass - 1 )
+  {
+    std :: cerr << "Wrong classes or non-zero cells of the sparse matrix" << std :: endl;
+    return 1;
+  }
+
+  for (int32_t k = 0; k < scorer :: n_stats; ++k)
+    for (int32_t i = 0; i < dense.stat_size(k); ++i)
+    {
+      const double x = dense.stat_value(k, i);
+      const double y = sparse.stat_value(k, i);
+
+      if ( std :: isnan(x) != std :: isnan(y) || std :: abs(x - y) > 1e-4 * (1. + std :: abs(x)) )
+      {
+        std :: cerr << "Mismatch between the dense and the sparse statistic " << k << " (class " << i << "): " << x << " != " << y << std :: endl;
+        return 1;
+      }
+    }
+
+  // the same matrix given as sparse input
+  sparse_matrix cm;
+  cm.assign(dense.confusion_matrix, Nclass);
+
+  scorer from_matrix;
+  from_matrix.compute_from_sparse_matrix(cm, dense.classes.data());
+
+  if ( from_matrix.overall_MCC != sparse.overall_MCC || from_matrix.chi_square != sparse.chi_square )
+  {
+    std :: cerr << "Mismatch between the scores of compute_sparse and compute_from_sparse_matrix" << std :: endl;
+    return 1;
+  }
+
+  // many classes: the dense matrix would take Nclass^2 cells
+  constexpr int32_t Nlarge = 50000;
+  std :: uniform_int_distribution < int32_t > large (0, Nlarge - 1);
+
+  std :: vector < int32_t > lbl_large (4 * Nlarge);
+  std :: vector < int32_t > pred_large (4 * Nlarge);
+
+  int64_t correct = 0;
+  for (std :: size_t i = 0; i < lbl_large.size(); ++i)
+  {
+    lbl_large[i] = i < static_cast < std :: size_t >(Nlarge) ? static_cast < int32_t >(i) : large(engine);
+    pred_large[i] = noise(engine) < .9f ? lbl_large[i] : large(engine);
+    correct += lbl_large[i] == pred_large[i];
+  }
+
+  scorer huge;
+  huge.compute_sparse(lbl_large.data(), pred_large.data(), 4 * Nlarge, 4 * Nlarge);
+
+  if ( huge.Nclass != Nlarge || huge.sparse.nnz() > 4 * Nlarge || huge.confusion_matrix != nullptr ||
+       std :: abs(huge.overall_accuracy - static_cast < float >(correct) / (4 * Nlarge)) > 1e-5f )
+  {
+    std :: cerr << "Wrong scores of the sparse evaluation with many classes" << std :: endl;
+    return 1;
+  }
+
+  // a large fixed set of classes (also not found in the labels) does not reserve the dense matrix
+  constexpr int32_t Nfixed = 2 * Nlarge;
+  std :: vector < int32_t > fixed_classes (Nfixed);
+  std :: iota(fixed_classes.begin(), fixed_classes.end(), 0);
+
+  scorer fixed;
+  fixed.set_classes(fixed_classes.data(), Nfixed);
+  fixed.compute_sparse(lbl_large.data(), pred_large.data(), 4 * Nlarge, 4 * Nlarge);
+
+  const std :: size_t dense_bytes = static_cast < std :: size_t >(Nfixed) * Nfixed * sizeof(count_t);
+
+  if ( fixed.Nclass != Nfixed || fixed.confusion_matrix != nullptr || fixed.stream.data() != nullptr ||
+       fixed.arena.size() + fixed.workspace.size() >= dense_bytes / 1000 ||
+       std :: abs(fixed.overall_accuracy - huge.overall_accuracy) > 1e-5f )
+  {
+    std :: cerr << "Wrong sparse evaluation with a large set of fixed classes" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
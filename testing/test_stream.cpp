@@ -0,0 +1,98 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>       // std :: mt19937
+#include <vector>       // std :: vector
+#include <iostream>     // std :: cerr
+#include <algorithm>    // std :: equal
+
+#include <scorer.h>     // scorer object
+
+/**
+* @brief Check that the streaming update gives the same scores of compute_score on the full arrays.
+*
+* @details The labels are split in batches of different sizes and the classes
+* appear in different batches, so the accumulated matrix must be extended.
+*
+*/
+int main ()
+{
+  constexpr int32_t n_lbl = 2000;
+  constexpr int32_t Nclass = 5;
+
+  std :: mt19937 engine (42);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  // spaced labels with increasing range, so new classes appear along the stream
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, std :: min(Nclass - 1, 1 + i / 400));
+    lbl_true[i] = dist(engine) * 7 - 3;
+    lbl_pred[i] = dist(engine) * 7 - 3;
+  }
+
+  scorer full;
+  full.compute_score(lbl_true.data(), lbl_pred.data(), n_lbl, n_lbl);
+
+  scorer stream;
+  for (int32_t begin = 0, batch = 1; begin < n_lbl; begin += batch, batch *= 2)
+    stream.update(lbl_true.data() + begin, lbl_pred.data() + begin, std :: min(batch, n_lbl - begin));
+
+  stream.compute_score();
+
+  if ( stream.Nclass != full.Nclass || stream.classes != full.classes )
+  {
+    std :: cerr << "Mismatch between the classes of the stream and of the full arrays" << std :: endl;
+    return 1;
+  }
+
+  if ( !std :: equal(stream.confusion_matrix, stream.confusion_matrix + Nclass * Nclass, full.confusion_matrix) ||
+       !std :: equal(stream.F1_SCORE, stream.F1_SCORE + Nclass, full.F1_SCORE) ||
+       stream.overall_accuracy != full.overall_accuracy ||
+       stream.overall_kappa != full.overall_kappa )
+  {
+    std :: cerr << "Mismatch between the scores of the stream and of the full arrays" << std :: endl;
+    return 1;
+  }
+
+  // the scores can be recomputed after further batches
+  stream.update(lbl_true.data(), lbl_pred.data(), n_lbl);
+  stream.compute_score();
+
+  for (int32_t i = 0; i < Nclass * Nclass; ++i)
+    if ( stream.confusion_matrix[i] != 2 * full.confusion_matrix[i] )
+    {
+      std :: cerr << "Wrong confusion matrix after a second pass of the stream" << std :: endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  The OpenHiP package is licensed under the MIT "Expat" License:
+//
+//  Copyright (c) 2022: Nico Curti.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  the software is provided "as is", without warranty of any kind, express or
+//  implied, including but not limited to the warranties of merchantability,
+//  fitness for a particular purpose and noninfringement. in no event shall the
+//  authors or copyright holders be liable for any claim, damages or other
+//  liability, whether in an action of contract, tort or otherwise, arising from,
+//  out of or in connection with the software or the use or other dealings in the
+//  software.
+//
+//M*/
+
+
+#include <random>                  // std :: mt19937
+#include <vector>                  // std :: vector
+#include <iostream>                // std :: cerr
+#include <algorithm>               // std :: equal
+#include <numeric>                 // std :: accumulate
+#include <cmath>                   // std :: abs
+
+#include <scorer.h>                // scorer, weighted_scorer
+#include <window_accumulator.h>    // window_accumulator
+#include <decayed_accumulator.h>   // decayed_accumulator
+
+/**
+* @brief Check the sliding-window and the decayed confusion matrices against a full recomputation.
+*
+* @details The labels are pushed in batches of different sizes (also larger than
+* the window) and the classes appear along the stream, so the matrices must be extended.
+*
+*/
+int main ()
+{
+  constexpr int32_t n_lbl = 2000;
+  constexpr int32_t Nclass = 5;
+  constexpr int32_t capacity = 300;
+
+  std :: mt19937 engine (42);
+
+  std :: vector < int32_t > lbl_true (n_lbl);
+  std :: vector < int32_t > lbl_pred (n_lbl);
+
+  // spaced labels with increasing range, so new classes appear along the stream
+  for (int32_t i = 0; i < n_lbl; ++i)
+  {
+    std :: uniform_int_distribution < int32_t > dist (0, std :: min(Nclass - 1, 1 + i / 400));
+    lbl_true[i] = dist(engine) * 7 - 3;
+    lbl_pred[i] = dist(engine) * 7 - 3;
+  }
+
+  window_accumulator window (capacity);
+  decayed_accumulator plain (1.);
+  decayed_accumulator recent (.5);
+
+  int32_t end = 0;
+
+  for (const int32_t batch : {1, 7, 150, 299, 1, 500, 42, 1000})
+  {
+    window.update(lbl_true.data() + end, lbl_pred.data() + end, batch);
+    plain.update(lbl_true.data() + end, lbl_pred.data() + end, batch);
+    recent.update(lbl_true.data() + end, lbl_pred.data() + end, batch);
+    end += batch;
+
+    const int32_t begin = std :: max(0, end - capacity);
+
+    // full recomputation of the window with the same classes
+    confusion_accumulator full;
+    full.reset(window.confusion_matrix().classes().data(), window.confusion_matrix().size());
+    full.update(lbl_true.data() + begin, lbl_pred.data() + begin, end - begin);
+
+    const int32_t Ncell = full.size() * full.size();
+
+    if ( window.size() != end - begin || !std :: equal(full.data(), full.data() + Ncell, window.confusion_matrix().data()) )
+    {
+      std :: cerr << "Mismatch between the window and the full recomputation (end = " << end << ")" << std :: endl;
+      return 1;
+    }
+
+    // exact counts without decay
+    confusion_accumulator counts;
+    counts.update(lbl_true.data(), lbl_pred.data(), end);
+
+    const std :: vector < double > weights = plain.weights();
+
+    if ( plain.classes() != counts.classes() || !std :: equal(weights.begin(), weights.end(), counts.data()) )
+    {
+      std :: cerr << "The decayed matrix without decay does not match the counts (end = " << end << ")" << std :: endl;
+      return 1;
+    }
+
+    // brute force decayed weights (the unit of the matrix overflows and it is rescaled)
+    const int32_t Nrecent = recent.size();
+    const label_map lut (recent.classes().data(), Nrecent);
+
+    std :: vector < double > expected (Nrecent * Nrecent, 0.);
+
+    for (int32_t i = 0; i < end; ++i)
+      expected[lut[lbl_true[i]] * Nrecent + lut[lbl_pred[i]]] += std :: pow(.5, end - 1 - i);
+
+    const std :: vector < double > decayed = recent.weights();
+
+    for (int32_t i = 0; i < Nrecent * Nrecent; ++i)
+      if ( std :: abs(decayed[i] - expected[i]) > 1e-12 * (1. + expected[i]) )
+      {
+        std :: cerr << "Mismatch between the decayed matrix and the brute force weights (end = " << end << ")" << std :: endl;
+        return 1;
+      }
+  }
+
+  // the scores are computed on read
+  scorer last;
+  last.compute_score(lbl_true.data() + n_lbl - capacity, lbl_pred.data() + n_lbl - capacity, capacity, capacity);
+
+  scorer score;
+  window.finalize(score);
+
+  if ( score.Nclass != last.Nclass || score.overall_accuracy != last.overall_accuracy || score.overall_kappa != last.overall_kappa )
+  {
+    std :: cerr << "Mismatch between the scores of the window and of the last labels" << std :: endl;
+    return 1;
+  }
+
+  // the decayed weights are scored without rounding
+  weighted_scorer weighted;
+  recent.finalize(weighted);
+
+  const std :: vector < double > decayed = recent.weights();
+  const double total = std :: accumulate(decayed.begin(), decayed.end(), 0.);
+
+  if ( weighted.Nclass != recent.size() || std :: abs(weighted.POP[0] - total) > 1e-12 * total )
+  {
+    std :: cerr << "The weighted scorer does not preserve the decayed weights" << std :: endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -12,6 +12,8 @@ __author__  = ['Nico Curti']
 __email__   = ['nico.curti2@unibo.it']
 __all__ = ['functions_script',
            'dependency_net',
+           'fused_kernel',
+           'topological_order',
            'graph_layering',
            'workflow_net',
            'layering_layout',
@@ -29,6 +31,17 @@ def functions_script (script_name : str) -> dict:
       names (see next point).
     - the struct name must be 'get_' + name of variable
       which returns.
+    - array outputs must be declared as last parameter
+      'dtype * name' (where name is the variable name):
+      the functor fills the output array in place (the
+      memory is provided by the caller) and the parameter
+      is not considered as a dependency.
+    - elementwise class statistics can provide a scalar
+      overload 'dtype operator () (...) const' with the
+      same parameters (without Nclass) which evaluates a
+      single class: these functors are marked as
+      'elementwise' and they can be fused in a single loop
+      (see fused_kernel).
   The return dictionary has as key the function name
   (equal to the return name) and as value the list of variable
   needed to compute it.
@@ -47,24 +60,32 @@ def functions_script (script_name : str) -> dict:
   filename = os.path.basename(script_name)
 
   op = re.compile(r'auto operator\(\)\s+\((.*)')
-  name = re.compile(r'\}[\s+]get_(.*);')
+  name = re.compile(r'\}[\s+]get_(\w+).*;')
   deps = re.compile(r'[&*]\s+(\w+)[,\)]')
   types = re.compile(r'[&*]')
   tags = re.compile(r'struct // (.*)')
+  output = re.compile(r'(\w+) \* (\w+)\)')
+  elem = re.compile(r'\w+ operator\(\)\s+\((.*)\) const')
+  blocks = re.compile(r'struct // .*?\}[\s+]get_\w+[^;\n]*;', re.DOTALL)
 
   with open(script_name, 'r', encoding='utf-8') as fp:
     code = fp.read()
 
   operations = op.findall(code)
   names = name.findall(code)
+  elementwise = [elem.search(block) is not None for block in blocks.findall(code)]
 
   graph = dict()
-  for name, op, tag in zip(names, operations, tags.findall(code)):
+  for name, op, tag, is_elem in zip(names, operations, tags.findall(code), elementwise):
     dep = deps.findall(op)
     type = types.findall(op)
-    graph[name] = {'dependency': list(zip(dep, type)),
+    out = [dtype for dtype, var in output.findall(op) if var == name]
+    graph[name] = {'dependency': [(d, t) for d, t in zip(dep, type) if d != name],
                    'label': tag,
-                   'file': filename
+                   'file': filename,
+                   'dtype': out[0] if out else 'real_t',
+                   'inplace': len(out) != 0,
+                   'elementwise': is_elem,
                    }
 
   return graph
@@ -96,6 +117,103 @@ def dependency_net (dependency : dict) -> nx.DiGraph:
   return dependency_graph
 
 
+def fused_kernel (dependency : dict, kernel : str = 'class_stats') -> dict:
+  '''
+  Collapse the elementwise functors into a single node
+  of the dependency graph.
+  The new node stores the list of fused functors
+  (sorted according to their dependencies) as 'members'
+  and its dependencies are given by the arrays required
+  by the members which are not computed inside the kernel.
+  The dependencies of the other functors on the fused
+  ones are redirected to the new node, while their
+  original parameters are kept as 'arguments'.
+
+  Parameters
+  ----------
+    dependency: dict
+      Dependencies dictionary (see functions_script)
+
+    kernel: str
+      Name of the fused node
+
+  Returns
+  -------
+    fused: dict
+      Dependencies dictionary with the fused node
+  '''
+  order = list(dependency.keys())
+  members = [name for name, var in dependency.items() if var.get('elementwise', False)]
+
+  # sort the members according to their dependencies
+  # preserving as much as possible the declaration order
+  inner = nx.DiGraph()
+  inner.add_nodes_from(members)
+  inner.add_edges_from(((dep, name) for name in members
+                                    for dep, _ in dependency[name]['dependency']
+                                    if dep in members))
+  members = list(nx.lexicographical_topological_sort(inner, key=order.index))
+
+  external = []
+  for name in members:
+    for dep, type in dependency[name]['dependency']:
+      if dep not in members and (dep, type) not in external:
+        external.append((dep, type))
+
+  fused = {kernel : {'dependency': external,
+                     'label': 'Fused class statistics',
+                     'file': 'class_stats.h',
+                     'dtype': 'float',
+                     'members': members,
+                     }
+          }
+
+  for name, var in dependency.items():
+    if name in members:
+      continue
+
+    deps = []
+    for dep, type in var['dependency']:
+      dep = kernel if dep in members else dep
+      if (dep, type) not in deps:
+        deps.append((dep, type))
+
+    fused[name] = dict(var, dependency=deps, arguments=var['dependency'])
+
+  return fused
+
+
+def topological_order (dependency : dict) -> list:
+  '''
+  Sort the functors so that each one follows all its
+  dependencies, preserving as much as possible the
+  declaration order.
+  The position in the list is the index of the functor
+  used by the lazy evaluation: the closure of a set of
+  functors is obtained by a single backward scan of the
+  list which marks the dependencies of the marked ones.
+
+  Parameters
+  ----------
+    dependency: dict
+      Dependencies dictionary (see functions_script)
+
+  Returns
+  -------
+    order: list
+      List of functor names in topological order
+  '''
+  order = list(dependency.keys())
+
+  graph = nx.DiGraph()
+  graph.add_nodes_from(order)
+  graph.add_edges_from(((dep, name) for name, var in dependency.items()
+                                    for dep, _ in var['dependency']
+                                    if dep in dependency))
+
+  return list(nx.lexicographical_topological_sort(graph, key=order.index))
+
+
 def graph_layering (G : nx.DiGraph) -> dict:
   '''
   Associate each node of the graph G to a layer
@@ -23,23 +23,386 @@ def make_base_pyx_script ():
 
 from cython.operator cimport dereference as deref
 from libcpp.memory cimport unique_ptr
+from cpython.buffer cimport PyBUF_FORMAT
+
+from libcpp.vector cimport vector
+from libcpp.string cimport string
 
 from scorer cimport scorer
+from scorer cimport batch_scorer
+from scorer cimport bootstrap
+from scorer cimport permutation_test
+from scorer cimport label_encoder
+from libc.stdint cimport uint64_t
+from libc.stdint cimport int64_t
+from libc.stdint cimport uint8_t
+from libc.stdint cimport uint32_t
+from scorer cimport count_t
+from scorer cimport real_t
+
+cdef extern from "Python.h":
+  const char * PyUnicode_AsUTF8AndSize (object, Py_ssize_t *) except NULL
+
+import numpy as np
+
+
+# Owner of the C++ objects which store the results of an evaluation
+# (with the metrics selected at the call): the arrays returned by the
+# _scorer keep a reference to it.
+cdef class _score_owner:
+  pass
+
+
+# Buffer protocol exporter of an array stored in a _score_owner
+cdef class _score_buffer:
+
+  def __getbuffer__ (self, Py_buffer * buffer, int flags):
+    buffer.buf = self.data
+    buffer.obj = self
+    buffer.len = self.shape[0] * self.strides[0]
+    buffer.readonly = 0
+    buffer.itemsize = self.strides[0]
+    buffer.format = <char *> self.fmt if flags & PyBUF_FORMAT else NULL
+    buffer.ndim = 1
+    buffer.shape = self.shape
+    buffer.strides = self.strides
+    buffer.suboffsets = NULL
+    buffer.internal = NULL
+
+  def __releasebuffer__ (self, Py_buffer * buffer):
+    pass
+
+
+cdef object _as_array (_score_owner owner, void * data, Py_ssize_t size, Py_ssize_t itemsize, bytes fmt):
+  # the numpy array shares the memory of the C++ object without any copy
+  cdef _score_buffer view = _score_buffer.__new__(_score_buffer)
+  view.owner = owner
+  view.data = <char *> data
+  view.shape[0] = size
+  view.strides[0] = itemsize
+  view.fmt = fmt
+  return np.asarray(view)
+
+cdef object _count_array (_score_owner owner, count_t * data, Py_ssize_t size):
+  return _as_array(owner, data, size, sizeof(count_t), b'Q')
+
+cdef object _real_array (_score_owner owner, real_t * data, Py_ssize_t size):
+  return _as_array(owner, data, size, sizeof(real_t), b'd' if sizeof(real_t) == sizeof(double) else b'f')
+
+cdef object _float_array (_score_owner owner, float * data, Py_ssize_t size):
+  return _as_array(owner, data, size, sizeof(float), b'f')
+
+
+def _encode_labels (lbl_true, lbl_pred):
+  # Encode the labels of the two arrays into the indexes of their sorted classes
+  # with the hash-based label_encoder (a single parallel pass without GIL).
+  # Supported labels are numbers, fixed-width strings and str objects:
+  # the function returns None for the other dtypes.
+
+  cdef int n_lbl = lbl_true.shape[0]
+
+  if n_lbl == 0:
+    return None
+
+  kind_true, kind_pred = lbl_true.dtype.kind, lbl_pred.dtype.kind
+
+  code_true = np.empty(shape=(n_lbl, ), dtype=np.int32)
+  code_pred = np.empty(shape=(n_lbl, ), dtype=np.int32)
+
+  cdef int[::1] c_true = code_true
+  cdef int[::1] c_pred = code_pred
+  cdef int * y_true = &c_true[0]
+  cdef int * y_pred = &c_pred[0]
+
+  cdef label_encoder encoder
+  cdef int Nclass
+
+  cdef int[::1] i32_true, i32_pred
+  cdef int64_t[::1] i64_true, i64_pred
+  cdef float[::1] f32_true, f32_pred
+  cdef double[::1] f64_true, f64_pred
+  cdef uint8_t[::1] s_true, s_pred
+  cdef uint32_t[::1] u_true, u_pred
+  cdef int * pi32_true
+  cdef int * pi32_pred
+  cdef int64_t * pi64_true
+  cdef int64_t * pi64_pred
+  cdef float * pf32_true
+  cdef float * pf32_pred
+  cdef double * pf64_true
+  cdef double * pf64_pred
+  cdef uint8_t * ps_true
+  cdef uint8_t * ps_pred
+  cdef uint32_t * pu_true
+  cdef uint32_t * pu_pred
+  cdef int w_true, w_pred
+  cdef vector[const uint8_t *] p_true, p_pred
+  cdef vector[int64_t] l_true, l_pred
+  cdef Py_ssize_t size
+  cdef int i
+
+  if kind_true in 'biuf' and kind_pred in 'biuf':
+
+    dtype = np.result_type(lbl_true.dtype, lbl_pred.dtype)
+
+    if dtype == np.int32:
+      i32_true = np.ascontiguousarray(lbl_true, dtype=np.int32)
+      i32_pred = np.ascontiguousarray(lbl_pred, dtype=np.int32)
+      pi32_true, pi32_pred = &i32_true[0], &i32_pred[0]
+      with nogil:
+        Nclass = encoder.encode[int](pi32_true, pi32_pred, n_lbl, y_true, y_pred)
+
+    elif dtype.kind in 'biu':
+      i64_true = np.ascontiguousarray(lbl_true, dtype=np.int64)
+      i64_pred = np.ascontiguousarray(lbl_pred, dtype=np.int64)
+      pi64_true, pi64_pred = &i64_true[0], &i64_pred[0]
+      with nogil:
+        Nclass = encoder.encode[int64_t](pi64_true, pi64_pred, n_lbl, y_true, y_pred)
+
+    elif dtype == np.float32:
+      f32_true = np.ascontiguousarray(lbl_true, dtype=np.float32)
+      f32_pred = np.ascontiguousarray(lbl_pred, dtype=np.float32)
+      pf32_true, pf32_pred = &f32_true[0], &f32_pred[0]
+      with nogil:
+        Nclass = encoder.encode[float](pf32_true, pf32_pred, n_lbl, y_true, y_pred)
+
+    else:
+      f64_true = np.ascontiguousarray(lbl_true, dtype=np.float64)
+      f64_pred = np.ascontiguousarray(lbl_pred, dtype=np.float64)
+      pf64_true, pf64_pred = &f64_true[0], &f64_pred[0]
+      with nogil:
+        Nclass = encoder.encode[double](pf64_true, pf64_pred, n_lbl, y_true, y_pred)
+
+  elif kind_true == kind_pred == 'S':
+
+    # the strings of the two arrays can have different widths
+    w_true, w_pred = lbl_true.dtype.itemsize, lbl_pred.dtype.itemsize
+    s_true = np.ascontiguousarray(lbl_true).view(np.uint8)
+    s_pred = np.ascontiguousarray(lbl_pred).view(np.uint8)
+    ps_true, ps_pred = &s_true[0], &s_pred[0]
+    with nogil:
+      Nclass = encoder.encode_fixed[uint8_t](ps_true, w_true, ps_pred, w_pred, n_lbl, y_true, y_pred)
+
+  elif kind_true == kind_pred == 'U':
+
+    w_true, w_pred = lbl_true.dtype.itemsize // 4, lbl_pred.dtype.itemsize // 4
+    u_true = np.ascontiguousarray(lbl_true, dtype=lbl_true.dtype.newbyteorder('=')).view(np.uint32)
+    u_pred = np.ascontiguousarray(lbl_pred, dtype=lbl_pred.dtype.newbyteorder('=')).view(np.uint32)
+    pu_true, pu_pred = &u_true[0], &u_pred[0]
+    with nogil:
+      Nclass = encoder.encode_fixed[uint32_t](pu_true, w_true, pu_pred, w_pred, n_lbl, y_true, y_pred)
+
+  elif kind_true == kind_pred == 'O':
+
+    # views of the UTF-8 buffers cached by the str objects
+    p_true.resize(n_lbl)
+    p_pred.resize(n_lbl)
+    l_true.resize(n_lbl)
+    l_pred.resize(n_lbl)
+
+    for i, (t, p) in enumerate(zip(lbl_true, lbl_pred)):
+      if type(t) is not str or type(p) is not str:
+        return None
+
+      p_true[i] = <const uint8_t *> PyUnicode_AsUTF8AndSize(t, &size)
+      l_true[i] = size
+      p_pred[i] = <const uint8_t *> PyUnicode_AsUTF8AndSize(p, &size)
+      l_pred[i] = size
+
+    with nogil:
+      Nclass = encoder.encode_strings(p_true.data(), l_true.data(), p_pred.data(), l_pred.data(), n_lbl, y_true, y_pred)
+
+  else:
+    return None
+
+  # names of the classes from a position of each of them
+  index = np.asarray(<int64_t[:Nclass]> encoder.index()).copy()
+  from_true = index < n_lbl
+
+  names = np.empty(shape=(Nclass, ), dtype=np.result_type(lbl_true.dtype, lbl_pred.dtype))
+  names[from_true] = lbl_true[index[from_true]]
+  names[~from_true] = lbl_pred[index[~from_true] - n_lbl]
+
+  return code_true, code_pred, names
+
 
 cdef class _scorer:
 
   def __init__ (self):
-    self.thisptr.reset(new scorer())
+    self._selected = None
+
+
+  # The C++ computations release the GIL: each call evaluates a new scorer object
+  # and keeps the selected metrics and the classes in its owner, so the same _scorer
+  # can be used by concurrent Python threads (select affects only the following calls)
+
+  def evaluate (self, int[::1] lbl_true, int[::1] lbl_pred, int n_lbl, int Nclass=0):
+    # Nclass > 0 if the labels are already encoded in [0, Nclass): the classes are not discovered
+    cdef _score_owner owner = self._new_scorer()
+    cdef scorer * obj = owner.thisptr.get()
+    cdef int * y_true = &lbl_true[0]
+    cdef int * y_pred = &lbl_pred[0]
+    cdef int[::1] classes = np.arange(Nclass, dtype=np.int32)
+    cdef int * codes = &classes[0] if Nclass > 0 else NULL
+
+    with nogil:
+      if Nclass > 0:
+        obj.set_classes(codes, Nclass)
+      obj.compute_score(y_true, y_pred, n_lbl, n_lbl)
+
+    return self._score(obj, owner)
+
+  def evaluate_confusion_matrix (self, count_t[::1] confusion_matrix, float[::1] classes, int Nclass):
+    cdef _score_owner owner = self._new_scorer()
+    cdef scorer * obj = owner.thisptr.get()
+    cdef count_t * cm = &confusion_matrix[0]
+    cdef float * names = &classes[0]
+
+    with nogil:
+      obj.compute_from_confusion_matrix[count_t](cm, Nclass, names)
+
+    return self._score(obj, owner)
+
+  def evaluate_batch (self, list lbl_true, list lbl_pred):
+
+    cdef int K = len(lbl_pred)
+    cdef vector[int *] true_ptr
+    cdef vector[int *] pred_ptr
+    cdef vector[int] sizes
+    cdef int[::1] y_true
+    cdef int[::1] y_pred
+
+    for k in range(K):
+      y_true = lbl_true[k]
+      y_pred = lbl_pred[k]
+      true_ptr.push_back(&y_true[0])
+      pred_ptr.push_back(&y_pred[0])
+      sizes.push_back(y_true.shape[0])
+
+    cdef _score_owner owner = self._new_batch_scorer()
+    cdef batch_scorer * obj = owner.batchptr.get()
+
+    with nogil:
+      obj.compute_score(true_ptr.data(), pred_ptr.data(), sizes.data(), K)
+
+    return self._get_batch_score(owner)
+
+  def evaluate_columns (self, int[::1] lbl_true, int[:, ::1] lbl_pred):
+    cdef _score_owner owner = self._new_batch_scorer()
+    cdef batch_scorer * obj = owner.batchptr.get()
+    cdef int * y_true = &lbl_true[0]
+    cdef int * y_pred = &lbl_pred[0, 0]
+    cdef int n_lbl = lbl_pred.shape[0]
+    cdef int K = lbl_pred.shape[1]
+
+    with nogil:
+      obj.compute_score(y_true, y_pred, K, n_lbl)
+
+    return self._get_batch_score(owner)
+
+  def compute_bootstrap (self, count_t[::1] confusion_matrix, float[::1] classes, int Nclass, list stats, int n_reps, uint64_t seed, float alpha):
+
+    cdef unique_ptr[bootstrap] engine
+    engine.reset(new bootstrap(n_reps, seed))
+
+    cdef vector[string] names
+    for stat in stats:
+      names.push_back(stat.encode('utf-8'))
+
+    if not deref(engine).select(names):
+      raise ValueError('Unknown statistics: {{0}}'.format(', '.join(stats)))
+
+    cdef count_t * cm = &confusion_matrix[0]
+    cdef float * names_ptr = &classes[0]
+
+    with nogil:
+      deref(engine).compute(cm, Nclass, names_ptr, alpha)
+
+    intervals = {{}}
+    for stat, name in zip(stats, names):
+      intervals[stat] = ([deref(engine).ci_down(name)[i] for i in range(deref(engine).size(name))],
+                         [deref(engine).ci_up(name)[i] for i in range(deref(engine).size(name))])
+
+    return intervals
+
+  def compute_permutation_test (self, int[::1] lbl_true, int[::1] lbl_pred_a, int[::1] lbl_pred_b, int n_lbl, list stats, int n_perm, uint64_t seed):
+
+    cdef unique_ptr[permutation_test] engine
+    engine.reset(new permutation_test(n_perm, seed))
+
+    cdef vector[string] names
+    for stat in stats:
+      names.push_back(stat.encode('utf-8'))
+
+    if not deref(engine).select(names):
+      raise ValueError('Unknown statistics: {{0}}'.format(', '.join(stats)))
+
+    cdef int * y_true = &lbl_true[0]
+    cdef int * y_pred_a = &lbl_pred_a[0]
+    cdef int * y_pred_b = &lbl_pred_b[0]
+
+    with nogil:
+      deref(engine).compute(y_true, y_pred_a, y_pred_b, n_lbl)
+
+    pvalues = {{}}
+    for stat, name in zip(stats, names):
+      pvalues[stat] = [deref(engine).p_value(name)[i] for i in range(deref(engine).size(name))]
+
+    return pvalues
+
+  def select (self, metrics):
+    # the new selection is swapped in at the end, so the concurrent calls see either the old or the new one
+    cdef vector[string] stats
+
+    if not metrics:
+      self._stats.swap(stats)
+      self._selected = None
+      return
+
+    selected = set(metrics)
+    unknown = selected.difference(self._members)
+
+    if unknown:
+      raise ValueError('Unknown metrics: {{0}}'.format(', '.join(sorted(unknown))))
+
+    for metric in selected:
+      for stat in self._members[metric]:
+        stats.push_back(stat.encode('utf-8'))
+
+    self._stats.swap(stats)
+    self._selected = selected
+
+  cdef _score_owner _new_scorer (self):
+    # each evaluation is stored in a new object, so the arrays of the previous results stay valid
+    cdef _score_owner owner = _score_owner.__new__(_score_owner)
+    owner.thisptr.reset(new scorer())
+    owner.selected = self._selected
+
+    if not self._stats.empty():
+      deref(owner.thisptr).select(self._stats)
 
+    return owner
 
-  def evaluate (self, int[::1] lbl_true, int[::1] lbl_pred, int n_lbl):
-    deref(self.thisptr).compute_score(&lbl_true[0], &lbl_pred[0], n_lbl, n_lbl)
+  cdef _score_owner _new_batch_scorer (self):
+    cdef _score_owner owner = _score_owner.__new__(_score_owner)
+    owner.batchptr.reset(new batch_scorer())
+    owner.selected = self._selected
 
-    self.Nclass = deref(self.thisptr).classes.size()
+    if not self._stats.empty():
+      deref(owner.batchptr).select(self._stats)
 
-    score = {{
+    return owner
+
+  def _get_batch_score (self, _score_owner owner):
+    return [self._score(&deref(owner.batchptr)[k], owner) for k in range(deref(owner.batchptr).size())]
+
+  cdef dict _score (self, scorer * obj, _score_owner owner):
+
+    cdef int Nclass = deref(obj).classes.size()
+    selected = owner.selected
+
+    score = {{}}
 {0}
-            }}
 
     _mcc_analysis = ['Negligible', 'Weak', 'Moderate', 'Strong', 'Very Strong', 'None']
     _nlr_analysis = ['Good', 'Fair', 'Poor', 'Negligible', 'None']
@@ -52,18 +415,28 @@ cdef class _scorer:
     _kfleiss_analysis    = ['Poor', 'Intermediate to Good', 'Excellent', 'None']
     _kaltman_analysis    = ['Poor', 'Fair', 'Moderate', 'Good', 'Very Good', 'None']
 
-    score['SOA1(Landis & Koch)'] = _kkoch_analysis[     int(score['SOA1(Landis & Koch)'])]
-    score['SOA2(Fleiss)'       ] = _kfleiss_analysis[   int(score['SOA2(Fleiss)'])]
-    score['SOA3(Altman)'       ] = _kaltman_analysis[   int(score['SOA3(Altman)'])]
-    score['SOA4(Cicchetti)'    ] = _kcicchetti_analysis[int(score['SOA4(Cicchetti)'])]
-    score['SOA5(Cramer)'       ] = _V_analysis[         int(score['SOA5(Cramer)'])]
-    score['SOA6(Matthews)'     ] = _mcc_analysis[       int(score['SOA6(Matthews)'])]
-
-    score['NLRI(Negative likelihood ratio interpretation)'] = [_nlr_analysis[int(item)] for item in score['NLRI(Negative likelihood ratio interpretation)']]
-    score['PLRI(Positive likelihood ratio interpretation)'] = [_plr_analysis[int(item)] for item in score['PLRI(Positive likelihood ratio interpretation)']]
-    score['AUCI(AUC value interpretation)'] = [_auc_analysis[int(item)] for item in score['AUCI(AUC value interpretation)']]
-    score['DPI(Discriminant power interpretation)' ] = [_dp_analysis[int(item)] for item in score['DPI(Discriminant power interpretation)' ]]
-    score['MCCI(Matthews correlation coefficient interpretation)'] = [_mcc_analysis[int(item)] for item in score['MCCI(Matthews correlation coefficient interpretation)']]
+    _soa = (('SOA1(Landis & Koch)', _kkoch_analysis),
+            ('SOA2(Fleiss)', _kfleiss_analysis),
+            ('SOA3(Altman)', _kaltman_analysis),
+            ('SOA4(Cicchetti)', _kcicchetti_analysis),
+            ('SOA5(Cramer)', _V_analysis),
+            ('SOA6(Matthews)', _mcc_analysis),
+           )
+
+    _interpretation = (('NLRI(Negative likelihood ratio interpretation)', _nlr_analysis),
+                       ('PLRI(Positive likelihood ratio interpretation)', _plr_analysis),
+                       ('AUCI(AUC value interpretation)', _auc_analysis),
+                       ('DPI(Discriminant power interpretation)', _dp_analysis),
+                       ('MCCI(Matthews correlation coefficient interpretation)', _mcc_analysis),
+                      )
+
+    for key, analysis in _soa:
+      if key in score:
+        score[key] = analysis[int(score[key])]
+
+    for key, analysis in _interpretation:
+      if key in score:
+        score[key] = [analysis[int(item)] for item in score[key]]
 
     return score
 
@@ -74,11 +447,11 @@ cdef class _scorer:
            }}
 
   @property
-  def num_classes (self):
-    return deref(self.thisptr).classes.size()
+  def _members (self):
+    return {{
+{2}
+           }}
 
-  def __repr__ (self):
-    return '<Scorer (classes: {{0}})>'.format(self.num_classes)
   '''
 
   return body
@@ -94,9 +467,20 @@ def make_base_pxd_script ():
 # ***************************************************
 
 from libcpp.vector cimport vector
+from libcpp.string cimport string
+from libcpp cimport bool
 from libcpp.memory cimport unique_ptr
+from libc.stdint cimport uint64_t
+from libc.stdint cimport int64_t
+from libc.stdint cimport uint8_t
+
+ctypedef uint64_t count_t
+
+cdef extern from "stats_types.h":
+  # float or double according to the DOUBLE build option
+  ctypedef float real_t
 
-cdef extern from "scorer.h":
+cdef extern from "scorer.h" nogil:
 
   cppclass scorer:
 
@@ -108,21 +492,94 @@ cdef extern from "scorer.h":
 
     # Methods
     void compute_score(int *, int *, int, int)
+    void compute_from_confusion_matrix[T](T *, int, float *)
+    void set_classes(int *, int)
+    bool select(vector[string])
     void print_class_stats[T](T&)
     void print_overall_stats[T](T&)
 
 
+cdef extern from "batch_scorer.h" nogil:
+
+  cppclass batch_scorer:
+
+    batch_scorer() except +
+
+    void compute_score(int **, int **, int *, int)
+    void compute_score(int *, int *, int, int)
+    bool select(vector[string])
+    int size()
+    scorer & operator[](int)
+
+
+cdef extern from "bootstrap.h" nogil:
+
+  cppclass bootstrap:
+
+    bootstrap(int, uint64_t) except +
+
+    bool select(vector[string])
+    void compute(count_t *, int, float *, float)
+    const real_t * ci_down(string)
+    const real_t * ci_up(string)
+    int size(string)
+
+
+cdef extern from "permutation_test.h" nogil:
+
+  cppclass permutation_test:
+
+    permutation_test(int, uint64_t) except +
+
+    bool select(vector[string])
+    void compute(int *, int *, int *, int)
+    const real_t * p_value(string)
+    const double * difference(string)
+    int size(string)
+
+
+cdef extern from "label_encoder.h" nogil:
+
+  cppclass label_encoder:
+
+    label_encoder() except +
+
+    int encode[T](T *, T *, int, int *, int *)
+    int encode_fixed[T](T *, int, T *, int, int, int *, int *)
+    int encode_strings(const uint8_t **, int64_t *, const uint8_t **, int64_t *, int, int *, int *)
+    int size()
+    const int64_t * index()
+
+
 cdef extern from "<utility>" namespace "std" nogil:
 
   cdef unique_ptr[scorer] move(unique_ptr[scorer])
 
 
-cdef class _scorer:
+cdef class _score_owner:
 
   cdef unique_ptr[scorer] thisptr
+  cdef unique_ptr[batch_scorer] batchptr
+  cdef object selected
+
+
+cdef class _score_buffer:
 
-  cdef public:
-    int Nclass
+  cdef _score_owner owner
+  cdef char * data
+  cdef Py_ssize_t shape[1]
+  cdef Py_ssize_t strides[1]
+  cdef bytes fmt
+
+
+cdef class _scorer:
+
+  cdef vector[string] _stats
+  cdef object _selected
+
+  cdef _score_owner _new_scorer (self)
+  cdef _score_owner _new_batch_scorer (self)
+  cdef dict _score (self, scorer * obj, _score_owner owner)
   '''
   return body
 
@@ -155,11 +612,16 @@ if __name__ == '__main__':
     dep = functions_script(include_dir + hpp)
     dependency.update(dep)
 
+  # the wrapper binds the scorer of the labels, i.e. the counters are count_t
+  for cppvar in dependency.values():
+    cppvar['dtype'] = cppvar['dtype'].replace('count_type', 'count_t')
+
   pyx_variables = []
   pxd_variables = []
+  members = []
 
-  row_array    = '              \'{1}\' : [(deref(self.thisptr).{0}.get())[i] for i in range(self.Nclass)],'
-  row_variable = '              \'{1}\' : deref(self.thisptr).{0},'
+  row_array    = '_{1}_array(owner, deref(obj).{0}, Nclass)'
+  row_variable = 'deref(obj).{0}'
 
   for variable, labels in dependency.items():
     long_name_description = labels['label']
@@ -167,35 +629,32 @@ if __name__ == '__main__':
 
     # Special cases
     if variable == 'classes':
-      pyx_row = '              \'{1}\': deref(self.thisptr).{0},'.format(variable, long_name_description)
+      pyx_rows = [(long_name_description, '_float_array(owner, deref(obj).{0}.data(), Nclass)'.format(variable), [])]
       pxd_row = '    vector[float] {0}'.format(variable)
 
     elif variable == 'confusion_matrix':
-      pyx_row = '              \'{1}\': [int((deref(self.thisptr).{0}.get())[i]) for i in range(self.Nclass * self.Nclass)],'.format(variable, long_name_description)
-      pxd_row = '    unique_ptr[float] {0}'.format(variable)
+      pyx_rows = [(long_name_description, '_count_array(owner, deref(obj).{0}, Nclass * Nclass)'.format(variable), [])]
+      pxd_row = '    {1} * {0}'.format(variable, labels['dtype'])
 
     # Special multiple cases
 
     elif variable == 'TPR_PPV_F1_micro':
-      pyx_row = '\n'.join(['              \'TPR Micro\' : deref(self.thisptr).TPR_PPV_F1_micro,',
-                           '              \'PPV Micro\' : deref(self.thisptr).TPR_PPV_F1_micro,',
-                           '              \'F1 Micro\' : deref(self.thisptr).TPR_PPV_F1_micro,',
-                           ])
-      pxd_row = '    float TPR_PPV_F1_micro'
+      pyx_rows = [(name, row_variable.format(variable), [variable]) for name in ('TPR Micro', 'PPV Micro', 'F1 Micro')]
+      pxd_row = '    real_t TPR_PPV_F1_micro'
 
     # Special Tuple cases
 
     elif variable == 'kappa_CI_up':
-      pyx_row = '              \'Kappa 95% CI\': (deref(self.thisptr).kappa_CI_up, deref(self.thisptr).kappa_CI_down),'
-      pxd_row = '\n'.join(['    float kappa_CI_up', '    float kappa_CI_down'])
+      pyx_rows = [('Kappa 95% CI', '(deref(obj).kappa_CI_up, deref(obj).kappa_CI_down)', ['kappa_CI_up', 'kappa_CI_down'])]
+      pxd_row = '\n'.join(['    real_t kappa_CI_up', '    real_t kappa_CI_down'])
 
     elif variable == 'overall_accuracy_ci_up':
-      pyx_row = '              \'95% CI\': (deref(self.thisptr).overall_accuracy_ci_up, deref(self.thisptr).overall_accuracy_ci_down),'
-      pxd_row = '\n'.join(['    float overall_accuracy_ci_up', '    float overall_accuracy_ci_down'])
+      pyx_rows = [('95% CI', '(deref(obj).overall_accuracy_ci_up, deref(obj).overall_accuracy_ci_down)', ['overall_accuracy_ci_up', 'overall_accuracy_ci_down'])]
+      pxd_row = '\n'.join(['    real_t overall_accuracy_ci_up', '    real_t overall_accuracy_ci_down'])
 
     elif variable == 'overall_jaccard_index':
-      pyx_row = '              \'Overall J\': (deref(self.thisptr).overall_jaccard_index, deref(self.thisptr).overall_jaccard_index / self.Nclass),'
-      pxd_row = '    float overall_jaccard_index'
+      pyx_rows = [('Overall J', '(deref(obj).overall_jaccard_index, deref(obj).overall_jaccard_index / Nclass)', [variable])]
+      pxd_row = '    real_t overall_jaccard_index'
 
     # Skip duplicates (due to tuple)
 
@@ -207,17 +666,28 @@ if __name__ == '__main__':
     elif variable in ('PC_PI', 'PC_AC1', 'PC_S'):
       continue
 
+    elif variable == 'marginals': # internal column of the class statistics
+      continue
+
     # Standard cases
 
     elif script == 'overall_stats.h': # it is an overall score and thus a single variable
-      pyx_row = row_variable.format(variable, long_name_description)
-      pxd_row = '    float {0}'.format(variable)
+      pyx_rows = [(long_name_description, row_variable.format(variable), [variable])]
+      pxd_row = '    real_t {0}'.format(variable)
 
     elif script in ('class_stats.h', 'common_stats.h'): # it is a class score and thus an array variable
-      pyx_row = row_array.format(variable, long_name_description)
-      pxd_row = '    unique_ptr[float] {0}'.format(variable)
+      pyx_rows = [(long_name_description, row_array.format(variable, labels['dtype'].split('_')[0]), [variable])]
+      pxd_row = '    {1} * {0}'.format(variable, labels['dtype'])
+
+    for name, value, stats in pyx_rows:
+      # classes and confusion matrix are always returned
+      if stats:
+        pyx_variables.append('    if selected is None or \'{0}\' in selected:\n      score[\'{0}\'] = {1}'.format(name, value))
+      else:
+        pyx_variables.append('    score[\'{0}\'] = {1}'.format(name, value))
+
+      members.append('             \'{0}\' : {1},'.format(name, stats))
 
-    pyx_variables.append(pyx_row)
     pxd_variables.append(pxd_row)
 
 
@@ -230,7 +700,7 @@ if __name__ == '__main__':
 
   with open(cython_pyx_file, 'w') as pyx:
     body = make_base_pyx_script()
-    pyx.write(body.format('\n'.join(pyx_variables), sklearn_lut))
+    pyx.write(body.format('\n'.join(pyx_variables), sklearn_lut, '\n'.join(members)))
 
   with open(cython_pxd_file, 'w') as pxd:
     body = make_base_pxd_script()
@@ -7,6 +7,26 @@ from __future__ import print_function
 __author__  = ['Nico Curti']
 __email__   = ['nico.curti2@unibo.it']
 
+# functors which process the labels: the other statistics depend only on their outputs
+labels_stage = ('classes', 'confusion_matrix')
+
+# columns shared by the functors which are not scores (e.g. the marginals of the confusion matrix)
+internal_stats = ('marginals',)
+
+# size of the columns which are not Nclass long
+column_sizes = {'confusion_matrix' : 'Ncell', 'marginals' : '3 * Nclass'}
+
+# count types of the scorer template (see basic_scorer) and the name of their aliases
+scorer_types = (('count_t', 'scorer'), ('double', 'weighted_scorer'))
+
+# data types of the confusion matrix accepted by compute_from_confusion_matrix
+# (the real-valued matrices only by the scorer with real-valued counts)
+confusion_matrix_types = ('count_t', 'int32_t', 'int64_t')
+weighted_matrix_types = ('float', 'double')
+
+# a real-valued confusion matrix requires real-valued counts (see weighted_scorer)
+from_matrix_requires = 'typename std :: enable_if < std :: is_integral < T > :: value || std :: is_floating_point < count_type > :: value, int > :: type'
+
 def header ():
   return '\n'.join(('/* This file was automatically generated */',
                     '/* Any change will be lost in the next build */',
@@ -18,34 +38,69 @@ def header ():
 def include_lib (libs):
   return '\n'.join(('#include <{}>'.format(lib) for lib in libs))
 
-def header_file (dependency):
+def member (signature, templates=()):
+  # definition of a member of the scorer template (see basic_scorer)
+  ret, name = signature.split('scorer :: ')
+  return '\n'.join(['template < typename count_type >'] +
+                   ['template < {} >'.format(t) for t in templates] +
+                   ['{}basic_scorer < count_type > :: {}'.format(ret, name)])
+
+def header_file (dependency, order):
 
   deps = dependency.copy()
   deps.pop('classes')
 
   class_description = '/**\n\
-* @class scorer\n\
+* @class basic_scorer\n\
 * @brief Abstract type which stores the full list of scores and allows their evaluation using parallel environment\n\
 *\n\
 * @details Each member of the class represents a different score (class statistics and overall statistics).\n\
+* The counters (confusion matrix, TP, FN, FP, TN, ...) are stored as count_type: the scorer of the labels\n\
+* (scorer) uses exact integer counts, while the weighted_scorer uses real-valued counts, i.e. the\n\
+* confusion matrices of weighted samples (e.g. see decayed_accumulator).\n\
+*\n\
+* @tparam count_type data type of the counters\n\
 *\n\
 */'
 
-  obj = '\n'.join(('', '{}\nstruct scorer'.format(class_description), '{', ''))
+  # the namespace is tagged by the precision of real_t (see stats_types.h), so a program built
+  # with a precision different from the one of the library fails to link
+  abi = '\n'.join(('/// @cond DEF', 'inline namespace __scorer_abi__', '{', '/// @endcond', ''))
 
-  variables = '\n'.join(('\tstd :: unique_ptr < float[] > {}; ///< {} array'.format(name, name)
+  obj = '\n'.join(('', abi, '{}\ntemplate < typename count_type >\nstruct basic_scorer'.format(class_description), '{', ''))
+
+  variables = '\n'.join(('\t{} * {} = nullptr; ///< {} array (view of the arena)'.format(cppvar['dtype'], name, name)
                           if cppvar['file'] in ('common_stats.h', 'class_stats.h')
-                          else '\tfloat {}; ///< {} value'.format(name, name)
+                          else '\treal_t {}; ///< {} value'.format(name, name)
                           for name, cppvar in deps.items()))
 
   variables = '\n'.join((variables, '',
                          '\tstd :: vector < float > classes; ///< array of classes', '',
-                         '\tint32_t Nclass; ///< number of classes', ''))
+                         '\tint32_t Nclass; ///< number of classes', '',
+                         '\tcolumn_arena arena; ///< contiguous memory of the arrays (one column for each statistic)', '',
+                         '\tcolumn_arena workspace; ///< scratch memory of the functors (e.g. the histograms of the confusion matrix)', '',
+                         '\tlabel_map lut; ///< lookup table from labels to class indexes', '',
+                         '\tbool fixed_classes; ///< true if the classes are given by set_classes (no class discovery)', '',
+                         '\tconfusion_accumulator stream; ///< confusion matrix accumulated by update', '',
+                         '\tsparse_matrix sparse; ///< sparse confusion matrix (see compute_sparse)', '',
+                         '\tbool sparse_mode; ///< true if the statistics are computed from the sparse confusion matrix', ''))
+
+  # index of each statistic in topological order (see select)
+  indexes = ',\n'.join(('\t\tidx_{}'.format(name) for name in order))
 
+  variables = '\n'.join((variables,
+                         '\t/// index of the statistics in topological order (each statistic follows its dependencies)',
+                         '\tenum stat_index : int32_t',
+                         '\t{',
+                         indexes + ',',
+                         '\t\tn_stats',
+                         '\t};', '',
+                         '\tstd :: bitset < n_stats > required; ///< statistics evaluated by compute_stats (see select)', ''))
 
 
-  constructor = '\n'.join(('', '\t/**\n\t* @brief Default constructor.\n\t*\n\t*/\n\tscorer ();', '',
-                               '\t/**\n\t* @brief Default destructor.\n\t*\n\t*/\n\t~scorer () = default;', '',
+
+  constructor = '\n'.join(('', '\t/**\n\t* @brief Default constructor.\n\t*\n\t*/\n\tbasic_scorer ();', '',
+                               '\t/**\n\t* @brief Default destructor.\n\t*\n\t*/\n\t~basic_scorer () = default;', '',
                                '\t// Members', ''))
 
   description_compute_score = '\t/**\n\
@@ -61,6 +116,8 @@ def header_file (dependency):
   description_print_class_stats = '\t/**\n\
 \t* @brief Print the scores related to class statistics, i.e a score for each class. The output is a table in which each score is represented by a row.\n\
 \t*\n\
+\t* @details The statistics out of the selection (see select) are not evaluated, so their rows are skipped.\n\
+\t*\n\
 \t* @tparam Os output stream data type\n\
 \t* @param os ostream (es. std :: cout)\n\
 \t*\n\
@@ -69,6 +126,8 @@ def header_file (dependency):
   description_print_overall_stats = '\t/**\n\
 \t* @brief Print the scores related to overall statistics, i.e a global score among classes. The output is a table in which each score is represented by a row.\n\
 \t*\n\
+\t* @details As in print_class_stats, only the selected statistics are printed.\n\
+\t*\n\
 \t* @tparam Os output stream data type\n\
 \t* @param os ostream (es. std :: cout)\n\
 \t*\n\
@@ -93,9 +152,195 @@ def header_file (dependency):
 \t* @param arr Array of input labels.\n\
 \t* @param size Lenght of the input array.\n\
 \t*\n\
+\t*/\n'
+
+  description_reserve = '\t/**\n\
+\t* @brief Set the arrays of the statistics as views of the arena for the given number of classes.\n\
+\t*\n\
+\t* @details The arena is reallocated only if its capacity is not enough,\n\
+\t* so repeated calls with the same number of classes reuse the same memory.\n\
+\t* The dense confusion matrix and the workspace of its histograms take O(Nclass^2)\n\
+\t* memory, so they are reserved only for the dense evaluations.\n\
+\t*\n\
+\t* @param Nclass number of classes\n\
+\t* @param dense true if the dense confusion matrix is required (false in sparse mode)\n\
+\t*\n\
+\t*/\n'
+
+  description_set_classes = '\t/**\n\
+\t* @brief Fix the array of classes used by the next evaluations.\n\
+\t*\n\
+\t* @details The classes are not discovered from the labels anymore and the labels which\n\
+\t* are not in the given set are ignored. The memory of the statistics is reserved here,\n\
+\t* while the dense confusion matrix and its workspace (O(Nclass^2) memory) are reserved by\n\
+\t* the first dense evaluation, so the following calls to compute_score do not perform any\n\
+\t* allocation and a large set of classes can be fixed for compute_sparse.\n\
+\t* The streaming confusion matrix (see update) is cleared and it takes the same classes.\n\
+\t* An empty set (Nclass = 0) restores the discovery of the classes from the labels.\n\
+\t*\n\
+\t* @param classes array of classes (duplicates are removed)\n\
+\t* @param Nclass size of the array of classes\n\
+\t*\n\
+\t*/\n'
+
+  description_update = '\t/**\n\
+\t* @brief Accumulate a batch of labels into the streaming confusion matrix.\n\
+\t*\n\
+\t* @details Only the confusion matrix is updated (the batch is not stored): the statistics\n\
+\t* are evaluated by compute_score () when they are required. New classes are added to the\n\
+\t* set found so far, unless the classes are fixed by set_classes.\n\
+\t*\n\
+\t* @param lbl_true array of true labels\n\
+\t* @param lbl_pred array of predicted labels\n\
+\t* @param n_lbl size of the label arrays\n\
+\t*\n\
+\t*/\n'
+
+  description_compute_stream = '\t/**\n\
+\t* @brief Compute the available scores related to the labels accumulated by update.\n\
+\t*\n\
+\t* @details The accumulated confusion matrix is not modified, so further batches can be\n\
+\t* added and the scores recomputed at any time.\n\
+\t*\n\
+\t*/\n'
+
+  description_compute_stats = '\t/**\n\
+\t* @brief Compute the statistics from the confusion matrix and the array of classes.\n\
+\t*\n\
+\t* @details The arrays of the statistics must be already reserved (see reserve) and the\n\
+\t* confusion matrix filled. As compute_score it can be called by all the threads of a\n\
+\t* parallel region. With OpenMP >= 4.0 the functors are scheduled as a task graph\n\
+\t* (see compute_stats_tasks), otherwise by the layers of omp sections (see compute_stats_layers).\n\
+\t*\n\
+\t*/\n'
+
+  description_compute_layers = '\t/**\n\
+\t* @brief Compute the statistics by layers of omp sections.\n\
+\t*\n\
+\t* @details Each layer contains the functors which depend only by the previous layers\n\
+\t* and it ends with an implicit barrier, so the slowest functor of a layer delays all\n\
+\t* the following ones.\n\
+\t*\n\
+\t*/\n'
+
+  description_compute_tasks = '\t/**\n\
+\t* @brief Compute the statistics as a graph of omp tasks.\n\
+\t*\n\
+\t* @details Each functor is a task with depend clauses on its inputs and outputs, so it\n\
+\t* starts as soon as its inputs are ready, without barriers between the layers.\n\
+\t* Without OpenMP >= 4.0 the functors are evaluated serially in topological order.\n\
+\t*\n\
+\t*/\n'
+
+  description_from_confusion_matrix = '\t/**\n\
+\t* @brief Compute the available scores from a confusion matrix, skipping the processing of the labels.\n\
+\t*\n\
+\t* @details The cost is O(Nclass^2), independently by the number of samples which were\n\
+\t* accumulated into the matrix. The function is instantiated for count_t, int32_t and int64_t\n\
+\t* matrices, and also for float and double matrices if the counters are real-valued\n\
+\t* (weighted_scorer): a real-valued matrix is rejected at compile time by the scorer with integer\n\
+\t* counts, instead of being truncated.\n\
+\t*\n\
+\t* @tparam T data type of the confusion matrix\n\
+\t* @param confusion_matrix confusion matrix as ravel array (Nclass * Nclass) with true labels along the rows\n\
+\t* @param Nclass number of classes\n\
+\t* @param classes array of classes in the order of the rows (if nullptr the classes are 0, ..., Nclass - 1)\n\
+\t*\n\
+\t*/\n'
+
+  description_compute_sparse = '\t/**\n\
+\t* @brief Compute the available scores using a sparse confusion matrix.\n\
+\t*\n\
+\t* @details The confusion matrix is stored in CSR format (see sparse_matrix) and the\n\
+\t* functors which read it iterate only the non-zero cells, so the memory and the cost\n\
+\t* scale with the number of distinct (true, pred) pairs instead of Nclass^2.\n\
+\t* This is the evaluation for very large numbers of classes: the dense confusion matrix\n\
+\t* is not allocated and the confusion_matrix member is not valid.\n\
+\t*\n\
+\t* @param lbl_true array of true labels\n\
+\t* @param lbl_pred array of predicted labels\n\
+\t* @param n_true size of the array lbl_true (aka number of true labels)\n\
+\t* @param n_pred size of the array lbl_pred (aka number of predicted labels)\n\
+\t*\n\
+\t*/\n'
+
+  description_from_sparse_matrix = '\t/**\n\
+\t* @brief Compute the available scores from a sparse confusion matrix (see compute_sparse).\n\
+\t*\n\
+\t* @param confusion_matrix sparse confusion matrix with true labels along the rows\n\
+\t* @param classes array of classes in the order of the rows (if nullptr the classes are 0, ..., Nclass - 1)\n\
+\t*\n\
+\t*/\n'
+
+  description_select = '\t/**\n\
+\t* @brief Select the statistics to evaluate (lazy evaluation).\n\
+\t*\n\
+\t* @details The next evaluations compute only the given statistics and their dependencies\n\
+\t* (the transitive closure in the dependency graph), while the other members are left\n\
+\t* untouched. The fused class statistics are evaluated together if any of them is required.\n\
+\t* An empty list restores the evaluation of all the statistics.\n\
+\t*\n\
+\t* @param metrics names of the statistics (as the members of the class, e.g. ACC or overall_accuracy)\n\
+\t*\n\
+\t* @return False if some name is not a statistic (the selection is not modified).\n\
+\t*/\n'
+
+  description_stat_id = '\t/**\n\
+\t* @brief Index of a statistic from its name.\n\
+\t*\n\
+\t* @param name name of the statistic (as the member of the class)\n\
+\t*\n\
+\t* @return The index of the statistic (see stat_index) or -1 if it is not found.\n\
+\t*/\n'
+
+  description_stat_size = '\t/**\n\
+\t* @brief Number of values of a statistic.\n\
+\t*\n\
+\t* @param stat index of the statistic (see stat_index)\n\
+\t*\n\
+\t* @return Nclass for the class statistics, 1 for the overall ones and 0 for\n\
+\t* the classes and the confusion matrix (which are not scores).\n\
+\t*/\n'
+
+  description_stat_value = '\t/**\n\
+\t* @brief Value of a statistic by index.\n\
+\t*\n\
+\t* @param stat index of the statistic (see stat_index)\n\
+\t* @param i index of the class (ignored by the overall statistics)\n\
+\t*\n\
+\t* @return The value of the statistic as double.\n\
 \t*/\n'
 
   members = '\n'.join(('', '{}\tvoid compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred);'.format(description_compute_score),
+                       '',
+                       '', '{}\tvoid update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl);'.format(description_update),
+                       '',
+                       '', '{}\tvoid compute_score ();'.format(description_compute_stream),
+                       '',
+                       '', '{}\ttemplate < typename T, {} = 0 >'.format(description_from_confusion_matrix, from_matrix_requires),
+                       '\tvoid compute_from_confusion_matrix (const T * confusion_matrix, const int32_t & Nclass, const float * classes = nullptr);',
+                       '',
+                       '', '{}\tvoid compute_sparse (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred);'.format(description_compute_sparse),
+                       '',
+                       '', '{}\tvoid compute_from_sparse_matrix (const sparse_matrix & confusion_matrix, const float * classes = nullptr);'.format(description_from_sparse_matrix),
+                       '',
+                       '', '{}\tbool select (const std :: vector < std :: string > & metrics);'.format(description_select),
+                       '',
+                       '', '{}\tstatic int32_t stat_id (const std :: string & name);'.format(description_stat_id),
+                       '',
+                       '', '{}\tint32_t stat_size (const int32_t & stat) const;'.format(description_stat_size),
+                       '',
+                       '', '{}\tdouble stat_value (const int32_t & stat, const int32_t & i) const;'.format(description_stat_value),
+                       '',
+                       '', '{}\tvoid compute_stats ();'.format(description_compute_stats),
+                       '',
+                       '', '{}\tvoid compute_stats_layers ();'.format(description_compute_layers),
+                       '',
+                       '', '{}\tvoid compute_stats_tasks ();'.format(description_compute_tasks),
+                       '',
+                       '', '{}\tvoid reserve (const int32_t & Nclass, const bool & dense);'.format(description_reserve),
+                       '',
+                       '', '{}\tvoid set_classes (const int32_t * classes, const int32_t & Nclass);'.format(description_set_classes),
                        '',
                        '', '{}\ttemplate < typename Os >'.format(description_print_class_stats), '\tvoid print_class_stats (Os & os);',
                        '',
@@ -108,7 +353,14 @@ def header_file (dependency):
                        '', '{}\ttemplate < typename dtype >'.format(description_encoder), '\tint32_t * encoder (dtype * arr, const int32_t & size);',
                        ''))
 
-  tail = '\n'.join(('', '};', '', '', '#endif // __scorer_h__', '', ''))
+  aliases = '\n'.join(('/// {}'.format(description) + '\nusing {} = basic_scorer < {} >;\n'.format(alias, count_type)
+                       for (count_type, alias), description in zip(scorer_types, ('Scorer of the labels (exact integer counts).',
+                                                                                  'Scorer of weighted samples (real-valued counts).'))))
+
+  # the members are instantiated once in scorer.cpp
+  instances = '\n'.join(('extern template struct basic_scorer < {} >;'.format(count_type) for count_type, _ in scorer_types))
+
+  tail = '\n'.join(('', '};', '', '/// @cond DEF', '} // end namespace __scorer_abi__', '/// @endcond', '', aliases, '/// @cond DEF', instances, '/// @endcond', '', '', '#endif // __scorer_h__', '', ''))
 
   libs = include_lib(('memory',
                       'iostream',
@@ -116,9 +368,18 @@ def header_file (dependency):
                       'fstream',
                       'cassert',
                       'vector',
+                      'string',
+                      'bitset',
                       'algorithm',
                       'iterator',
+                      'numeric',
                       'unordered_set',
+                      'type_traits',
+                      'stats_types.h',
+                      'column_arena.h',
+                      'label_map.h',
+                      'confusion_accumulator.h',
+                      'sparse_matrix.h',
                       ))
 
   scripts = ''.join((header(), libs,
@@ -160,24 +421,286 @@ def stop_omp_section():
                     '\n'
                     ))
 
-def parallel_func(output, params):
-  params = ', '.join(('this->{}.get()'.format(x)
-                      if t == '*'
-                      else 'this->{}'.format(x)
-                      for x, t in params))
-  params = params.replace('this->classes.get()', 'this->classes.data()')
-  params = params.replace('this->lbl_true.get()', 'lbl_true')
-  params = params.replace('this->lbl_pred.get()', 'lbl_pred')
+def func_call(output, params, inplace):
+  params = ', '.join(('this->{}'.format(x) for x, t in params))
+  params = params.replace('this->classes', 'this->classes.data()')
+  params = params.replace('this->lbl_true', 'lbl_true')
+  params = params.replace('this->lbl_pred', 'lbl_pred')
   params = params.replace('this->n_true', 'n_true')
   params = params.replace('this->n_pred', 'n_pred')
   params = params.replace('this->n_lbl', 'n_lbl')
+
+  if 'this->confusion_matrix' in params.split(', ') and output != 'confusion_matrix':
+    # the sparse overload of the functor reads the sparse confusion matrix
+    sparse = params.replace('this->confusion_matrix', 'this->sparse')
+
+    if inplace:
+      call = '\t\tthis->sparse_mode ? get_{0} ( {1}, this->{0} ) : get_{0} ( {2}, this->{0} );'.format(output, sparse, params)
+    else:
+      call = '\t\tthis->{0} = this->sparse_mode ? get_{0} ( {1} ) : get_{0} ( {2} );'.format(output, sparse, params)
+
+  elif output == 'classes':
+    call = '\n'.join(('\t\tif ( !this->fixed_classes )',
+                      '\t\t\tthis->classes = get_classes ( {} );'.format(params)))
+  elif inplace:
+    call = ' '.join(('\t\tget_{0} ('.format(output), params + ',', 'this->{}'.format(output), ');'))
+  else:
+    call = ' '.join(('\t\tthis->{0} = get_{0} ('.format(output), params, ');'))
+
+  return call
+
+def parallel_func(output, params, inplace, lazy=False):
+  call = func_call(output, params, inplace)
+
+  if lazy:
+    call = '\n'.join(('\t\tif ( this->required[idx_{}] )'.format(output),
+                      '\t' + call))
+
+  return '\n'.join(('#ifdef _OPENMP',
+                    '#pragma omp section',
+                    '#endif',
+                    call,
+                    '\n'
+                    ))
+
+def fused_loop(output, cppvar, dependency, depth):
+  members = cppvar['members']
+  inputs = [x for x, t in cppvar['dependency'] if t == '*']
+
+  tab = '\t' * depth
+
+  loads = ['{3}\t\tconst {1} {0} = this->{0}[i];'.format(name, dependency[name]['dtype'], None, tab)
+           for name in inputs]
+  evals = ['{3}\t\tconst {1} {0} = get_{0} ( {2} );\n{3}\t\tthis->{0}[i] = {0};'.format(name,
+                                                                                      dependency[name]['dtype'],
+                                                                                      ', '.join((x for x, t in dependency[name]['dependency'] if t == '*')),
+                                                                                      tab)
+           for name in members]
+
+  return '\n'.join(['{}// {} fused in a single loop over the classes'.format(tab, output.replace('_', ' ')),
+                     '{}constexpr int64_t class_grain = 1 << 10; // min number of classes for each chunk'.format(tab),
+                     '{}const int32_t nchunks = num_chunks(this->Nclass, class_grain);'.format(tab),
+                     '',
+                     '{}parallel_chunks(nchunks, [&] (const int32_t & c)'.format(tab),
+                     '{}{{'.format(tab),
+                     '{}\tconst int64_t end = chunk_begin(this->Nclass, c + 1, nchunks);'.format(tab),
+                     '',
+                     '{}\tfor (int64_t i = chunk_begin(this->Nclass, c, nchunks); i < end; ++i)'.format(tab),
+                     '{}\t{{'.format(tab)] +
+                     loads + [''] + evals +
+                    ['{}\t}}'.format(tab),
+                     '{}}});'.format(tab)])
+
+def fused_func(output, cppvar, dependency):
   return '\n'.join(('#ifdef _OPENMP',
                     '#pragma omp section',
                     '#endif',
-                    ' '.join(('\t\tthis->{0} = get_{0} ('.format(output), params, ');')),
+                    '\t\tif ( (this->required & {}_mask).any() )'.format(output),
+                    '\t\t{',
+                    fused_loop(output, cppvar, dependency, 3),
+                    '\t\t}',
                     '\n'
                     ))
 
+def task_func(output, cppvar, dependency):
+
+  if 'members' in cppvar:
+    outputs = cppvar['members']
+    params = cppvar['dependency']
+    guard = '(this->required & {}_mask).any()'.format(output)
+  else:
+    outputs = [output]
+    params = cppvar.get('arguments', cppvar['dependency'])
+    guard = 'this->required[idx_{}]'.format(output)
+
+  inputs = [x for x, t in params if x in dependency and x not in labels_stage]
+  depend = ''.join((' depend (in: {})'.format(', '.join(('ready[idx_{}]'.format(x) for x in inputs))) if inputs else '',
+                    ' depend (out: {})'.format(', '.join(('ready[idx_{}]'.format(x) for x in outputs)))))
+
+  if 'members' in cppvar:
+    body = '\n'.join(('\t\t\t{', fused_loop(output, cppvar, dependency, 4), '\t\t\t}'))
+  else:
+    body = '\t' + func_call(output, params, cppvar['inplace'])
+
+  return '\n'.join(('\t\tif ( {} )'.format(guard),
+                    '\t\t{',
+                    '#ifdef __omp_depend__',
+                    '#pragma omp task{}'.format(depend),
+                    '#endif',
+                    body,
+                    '\t\t}',
+                    '', ''
+                    ))
+
+def reserve_arena():
+  return '\n'.join(('#ifdef _OPENMP',
+                    '#pragma omp single',
+                    '#endif',
+                    '\t{',
+                    '\t\tthis->sparse_mode = false;',
+                    '\t\tthis->reserve(this->Nclass, true);',
+                    '\t}',
+                    '', ''))
+
+def reserve_func (dependency):
+
+  arrays = [(name, cppvar['dtype']) for name, cppvar in dependency.items()
+            if cppvar['file'] in ('common_stats.h', 'class_stats.h') and name != 'classes']
+
+  sizes = {name : column_sizes.get(name, 'Nclass') for name, _ in arrays}
+
+  # group the columns with the same size and data type
+  groups = []
+  for name, dtype in arrays:
+    key = (dtype, sizes[name])
+    if key not in [k for k, _ in groups]:
+      groups.append((key, [n for n, d in arrays if (d, sizes[n]) == key]))
+
+  space = ' +\n\t                    '.join(('column_arena :: bytes < {} >({}){}'.format(dtype, size, ' * {}'.format(len(names)) if len(names) > 1 else '')
+                                          for (dtype, size), names in groups))
+
+  # the dense confusion matrix is a view of the arena only if it is required
+  views = '\n'.join(('\tthis->{0} = {3}this->arena.template column < {1} >({2}){4};'.format(name, dtype, sizes[name],
+                                                                                    *(('dense ? ', ' : nullptr') if name == 'confusion_matrix' else ('', '')))
+                     for name, dtype in arrays))
+
+  return '\n'.join((member('void scorer :: reserve (const int32_t & Nclass, const bool & dense)'),
+                    '{',
+                    '\t// the dense confusion matrix is allocated only if required (otherwise confusion_matrix is nullptr)',
+                    '\tconst int64_t Ncell = dense ? static_cast < int64_t >(Nclass) * Nclass : 0;',
+                    '',
+                    '\tthis->arena.reserve({});'.format(space),
+                    '',
+                    views,
+                    '',
+                    '\t// histograms of the confusion matrix for any number of chunks',
+                    '\tif ( dense )',
+                    '\t\tthis->workspace.reserve(column_arena :: bytes < uint32_t >(confusion_matrix_cells(Nclass, num_workers())));',
+                    '}', '', ''))
+
+def set_classes_func ():
+  return '\n'.join((member('void scorer :: set_classes (const int32_t * classes, const int32_t & Nclass)'),
+                    '{',
+                    '\tthis->classes.assign(classes, classes + Nclass);',
+                    '',
+                    '\tstd :: sort(this->classes.begin(), this->classes.end());',
+                    '\tthis->classes.erase(std :: unique(this->classes.begin(), this->classes.end()), this->classes.end());',
+                    '',
+                    '\tthis->Nclass = static_cast < int32_t >(this->classes.size());',
+                    '\tthis->fixed_classes = this->Nclass > 0;',
+                    '',
+                    '\t// the dense confusion matrix is allocated by the first dense evaluation',
+                    '\tthis->reserve(this->Nclass, false);',
+                    '\tthis->lut.build(this->classes.data(), this->Nclass);',
+                    '\tthis->stream.reset(this->classes.data(), this->Nclass);',
+                    '}', '', ''))
+
+def update_func ():
+  return '\n'.join((member('void scorer :: update (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_lbl)'),
+                    '{',
+                    '#ifdef _OPENMP',
+                    '#pragma omp single',
+                    '#endif',
+                    '\tthis->stream.update(lbl_true, lbl_pred, n_lbl);',
+                    '}', '', ''))
+
+def stream_func ():
+  return '\n'.join((member('void scorer :: compute_score ()'),
+                    '{',
+                    '\tthis->stream.finalize(*this);',
+                    '}', '', ''))
+
+def sparse_func ():
+  return '\n'.join((member('void scorer :: compute_sparse (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)'),
+                    '{',
+                    '#ifdef __pythonic__',
+                    '#ifdef _OPENMP',
+                    '#pragma omp parallel',
+                    '\t{',
+                    '#endif',
+                    '#endif',
+                    '',
+                    '\tassert (n_true == n_pred);',
+                    '',
+                    '#ifdef _OPENMP',
+                    '#pragma omp single',
+                    '#endif',
+                    '\t{',
+                    '\t\tif ( !this->fixed_classes )',
+                    '\t\t\tthis->classes = get_classes ( lbl_true, lbl_pred, n_true, n_pred );',
+                    '',
+                    '\t\tthis->Nclass = static_cast < int32_t >(this->classes.size());',
+                    '\t}',
+                    '',
+                    check_dimension(),
+                    '#ifdef _OPENMP',
+                    '#pragma omp single',
+                    '#endif',
+                    '\t{',
+                    '\t\tthis->sparse_mode = true;',
+                    '\t\tthis->reserve(this->Nclass, false);',
+                    '\t\tthis->lut.build(this->classes.data(), this->Nclass);',
+                    '\t\tthis->sparse.build(lbl_true, lbl_pred, n_true, this->lut, this->Nclass);',
+                    '\t}',
+                    '',
+                    '\tthis->compute_stats();',
+                    '',
+                    '#ifdef __pythonic__',
+                    '#ifdef _OPENMP',
+                    '\t} // end computation function',
+                    '#endif',
+                    '#endif',
+                    '}', '', '',
+                    member('void scorer :: compute_from_sparse_matrix (const sparse_matrix & confusion_matrix, const float * classes)'),
+                    '{',
+                    '#ifdef __pythonic__',
+                    '#ifdef _OPENMP',
+                    '#pragma omp parallel',
+                    '\t{',
+                    '#endif',
+                    '#endif',
+                    '',
+                    '#ifdef _OPENMP',
+                    '#pragma omp single',
+                    '#endif',
+                    '\t{',
+                    '\t\tthis->Nclass = confusion_matrix.size();',
+                    '',
+                    '\t\tif ( classes != nullptr )',
+                    '\t\t\tthis->classes.assign(classes, classes + this->Nclass);',
+                    '\t\telse',
+                    '\t\t{',
+                    '\t\t\tthis->classes.resize(this->Nclass);',
+                    '\t\t\tstd :: iota(this->classes.begin(), this->classes.end(), 0.f);',
+                    '\t\t}',
+                    '\t}',
+                    '',
+                    check_dimension(),
+                    '#ifdef _OPENMP',
+                    '#pragma omp single',
+                    '#endif',
+                    '\t{',
+                    '\t\tthis->sparse_mode = true;',
+                    '\t\tthis->reserve(this->Nclass, false);',
+                    '\t\tthis->sparse = confusion_matrix;',
+                    '\t}',
+                    '',
+                    '\tthis->compute_stats();',
+                    '',
+                    '#ifdef __pythonic__',
+                    '#ifdef _OPENMP',
+                    '\t} // end computation function',
+                    '#endif',
+                    '#endif',
+                    '}', '', ''))
+
+def instance_func ():
+  return '\n'.join(['// explicit instantiation of the scorers and of the supported data types of the confusion matrix'] +
+                    ['template struct basic_scorer < {} >;'.format(count_type) for count_type, _ in scorer_types] +
+                    ['template void {0} :: compute_from_confusion_matrix < {1} >(const {1} * confusion_matrix, const int32_t & Nclass, const float * classes);'.format(alias, dtype)
+                     for count_type, alias in scorer_types
+                     for dtype in confusion_matrix_types + (weighted_matrix_types if count_type != 'count_t' else ())] + ['', ''])
+
 def check_dimension():
   return '\n'.join(('\tif ( this->Nclass <= 1 )',
                     '\t{',
@@ -188,17 +711,198 @@ def check_dimension():
                     '\t' * 2 + 'std :: exit(1);',
                     '\t}', ''))
 
-def cpp_file (workflow):
+def stats_func (workflow, dependency):
+
+  members = '\n'.join((member('void scorer :: compute_stats ()'),
+                       '{',
+                       '#ifdef __omp_depend__',
+                       '\tthis->compute_stats_tasks();',
+                       '#else',
+                       '\tthis->compute_stats_layers();',
+                       '#endif',
+                       '}', '', '',
+                       member('void scorer :: compute_stats_layers ()'),
+                       '{',
+                       ''))
+
+  for level, deps in workflow.items():
+    deps = [(name, cppvar) for name, cppvar in deps if name not in labels_stage]
+    if not deps:
+      continue
+
+    members = ''.join((members,
+                       start_omp_section(),
+                       ''.join((fused_func(name, cppvar, dependency)
+                                if 'members' in cppvar
+                                else parallel_func(name, cppvar.get('arguments', cppvar['dependency']), cppvar['inplace'], lazy=True)
+                                for name, cppvar in deps)),
+                       stop_omp_section()
+                       ))
+
+  # the levels of the workflow are a topological order, so each task
+  # is created after the tasks which produce its inputs
+  tasks = ''.join((task_func(name, cppvar, dependency)
+                   for level, deps in workflow.items()
+                   for name, cppvar in deps if name not in labels_stage))
+
+  members = '\n'.join((members, '}', '', '',
+                       member('void scorer :: compute_stats_tasks ()'),
+                       '{',
+                       '#ifdef _OPENMP',
+                       '#pragma omp single',
+                       '#endif',
+                       '\t{',
+                       '#ifdef __omp_depend__',
+                       '\t\tchar ready[n_stats]; // dependency token of each statistic (only its address is used)',
+                       '\t\t(void) ready;',
+                       '#endif',
+                       '',
+                       tasks + '#ifdef __omp_depend__',
+                       '#pragma omp taskwait',
+                       '#endif',
+                       '\t}',
+                       ))
+
+  return '\n'.join((members, '}', '', ''))
+
+def lazy_tables (workflow, dependency, order):
+
+  deps = [[dep for dep, _ in dependency[name]['dependency'] if dep in dependency] for name in order]
+
+  offsets = [0]
+  for d in deps:
+    offsets.append(offsets[-1] + len(d))
+
+  names = '\n'.join(('\t"{}",'.format(name) for name in order))
+  offsets = ', '.join((str(x) for x in offsets))
+  links = '\n'.join(('\t{} // {}'.format(' '.join(('scorer :: idx_{},'.format(x) for x in d)), name)
+                     for name, d in zip(order, deps) if d))
+
+  masks = '\n'.join(('static const std :: bitset < scorer :: n_stats > {}_mask = stats_mask({{\n\t{}\n}});'.format(name, ',\n\t'.join((', '.join(('scorer :: idx_{}'.format(x) for x in cppvar['members'][i : i + 6]))
+                                                                                                                                       for i in range(0, len(cppvar['members']), 6))))
+                     for level in workflow.values()
+                     for name, cppvar in level
+                     if 'members' in cppvar))
+
+  return '\n'.join(('/// @cond DEF',
+                    '// names of the statistics (in the order of scorer :: stat_index)',
+                    'static const char * stat_names[scorer :: n_stats] = {',
+                    names,
+                    '};',
+                    '',
+                    '// dependencies of the k-th statistic are stat_deps[stat_offset[k] : stat_offset[k + 1]]',
+                    'static const int32_t stat_offset[scorer :: n_stats + 1] = {{ {} }};'.format(offsets),
+                    '',
+                    'static const int32_t stat_deps[] = {',
+                    links,
+                    '};',
+                    '',
+                    'static std :: bitset < scorer :: n_stats > stats_mask (std :: initializer_list < int32_t > stats)',
+                    '{',
+                    '\tstd :: bitset < scorer :: n_stats > mask;',
+                    '\tfor (const auto & k : stats)',
+                    '\t\tmask.set(k);',
+                    '\treturn mask;',
+                    '}',
+                    '',
+                    '// statistics evaluated by the fused kernels',
+                    masks,
+                    '/// @endcond',
+                    '', ''))
+
+def select_func ():
+  return '\n'.join((member('bool scorer :: select (const std :: vector < std :: string > & metrics)'),
+                    '{',
+                    '\tstd :: bitset < n_stats > required;',
+                    '',
+                    '\tfor (const auto & name : metrics)',
+                    '\t{',
+                    '\t\tconst int32_t k = stat_id(name);',
+                    '',
+                    '\t\tif ( k < 0 )',
+                    '\t\t\treturn false;',
+                    '',
+                    '\t\trequired.set(k);',
+                    '\t}',
+                    '',
+                    '\tif ( required.none() )',
+                    '\t{',
+                    '\t\tthis->required.set();',
+                    '\t\treturn true;',
+                    '\t}',
+                    '',
+                    '\t// the statistics are in topological order, so a single backward scan',
+                    '\t// propagates the requests to all the (transitive) dependencies',
+                    '\tfor (int32_t k = n_stats - 1; k >= 0; --k)',
+                    '\t\tif ( required[k] )',
+                    '\t\t\tfor (int32_t d = stat_offset[k]; d < stat_offset[k + 1]; ++d)',
+                    '\t\t\t\trequired.set(stat_deps[d]);',
+                    '',
+                    '\tthis->required = required;',
+                    '',
+                    '\treturn true;',
+                    '}', '', ''))
+
+def access_func (dependency, order):
+
+  def is_class (name):
+    return dependency[name]['file'] in ('common_stats.h', 'class_stats.h') and name not in labels_stage + internal_stats
+
+  class_stats = [name for name in order if is_class(name)]
+  overall_stats = [name for name in order if dependency[name]['file'] == 'overall_stats.h']
+
+  sizes = '\n'.join(['\t\tcase idx_{}:'.format(name) for name in class_stats] +
+                    ['\t\t\treturn this->Nclass;'] +
+                    ['\t\tcase idx_{}:'.format(name) for name in overall_stats] +
+                    ['\t\t\treturn 1;'])
+
+  values = '\n'.join(['\t\tcase idx_{0}: return static_cast < double >(this->{0}[i]);'.format(name) for name in class_stats] +
+                     ['\t\tcase idx_{0}: return static_cast < double >(this->{0});'.format(name) for name in overall_stats])
+
+  return '\n'.join((member('int32_t scorer :: stat_id (const std :: string & name)'),
+                    '{',
+                    '\tconst auto it = std :: find(stat_names, stat_names + n_stats, name);',
+                    '',
+                    '\treturn it == stat_names + n_stats ? -1 : static_cast < int32_t >(std :: distance(stat_names, it));',
+                    '}', '', '',
+                    member('int32_t scorer :: stat_size (const int32_t & stat) const'),
+                    '{',
+                    '\tswitch (stat)',
+                    '\t{',
+                    sizes,
+                    '\t\tdefault: return 0;',
+                    '\t}',
+                    '}', '', '',
+                    member('double scorer :: stat_value (const int32_t & stat, const int32_t & i) const'),
+                    '{',
+                    '\tswitch (stat)',
+                    '\t{',
+                    values,
+                    '\t\tdefault: return 0.;',
+                    '\t}',
+                    '}', '', ''))
+
+def cpp_file (workflow, dependency, order):
 
   libs = include_lib(('scorer.hpp',
                       'common_stats.h',
                       'class_stats.h',
                       'overall_stats.h'))
 
-  members = '\n'.join(('scorer :: scorer ()',
+  members = '\n'.join((lazy_tables(workflow, dependency, order),
+                       member('scorer :: basic_scorer () : Nclass (0), fixed_classes (false), sparse_mode (false)'),
                        '{',
+                       '\tthis->required.set();',
                        '}', '', '',
-                       'void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)',
+                       select_func(),
+                       access_func(dependency, order),
+                       reserve_func(dependency),
+                       set_classes_func(),
+                       update_func(),
+                       stream_func(),
+                       sparse_func(),
+                       stats_func(workflow, dependency),
+                       member('void scorer :: compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)'),
                        '{',
                        '#ifdef __pythonic__',
                        '#ifdef _OPENMP',
@@ -212,26 +916,34 @@ def cpp_file (workflow):
                        ''))
 
   for level, deps in workflow.items():
+    deps = [(name, cppvar) for name, cppvar in deps if name in labels_stage]
+    if not deps:
+      continue
+
     members = ''.join((members,
                        start_omp_section(),
-                       ''.join((parallel_func(name, cppvar['dependency'])
+                       ''.join((parallel_func(name, cppvar['dependency'], cppvar['inplace'])
                                 for name, cppvar in deps)),
                        stop_omp_section()
                        ))
     if level == 0:
       members = '\n'.join((members,
                            '\tthis->Nclass = static_cast < int32_t >(this->classes.size());\n',
-                           check_dimension()
+                           check_dimension(),
+                           reserve_arena()
                            ))
 
   members = '\n'.join((members,
+                       '\tthis->compute_stats();',
+                       '',
                        '#ifdef __pythonic__',
                        '#ifdef _OPENMP',
                        '\t} // end computation function',
                        '#endif',
                        '#endif',
                        '', '',
-                       '}', '', '', ''))
+                       '}', '', '',
+                       instance_func()))
 
   return ''.join(('/* This file was automatically generated */',
                   '\n',
@@ -245,6 +957,8 @@ def hpp_file (dependency):
 
   deps = dependency.copy()
   deps.pop('confusion_matrix')
+  for name in internal_stats:
+    deps.pop(name)
 
   header = '\n'.join(['/* This file was automatically generated */',
                       '/* Any change will be lost in the next build */',
@@ -255,26 +969,79 @@ def hpp_file (dependency):
 
   libs = include_lib(['scorer.h'])
 
-  regex_dump_array = '\n'.join(('\tos << std :: left << std :: setw(40) << "{tag}";',
-                                '\tfor (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << {name}[i] << " ";',
-                                '\tos << std :: endl;',
+  # the statistics out of the selection (see select) are not evaluated, so they are skipped
+  regex_dump_array = '\n'.join(('\tif ( this->required[idx_{name}] )',
+                                '\t{{',
+                                '\t\tos << std :: left << std :: setw(40) << "{tag}";',
+                                '\t\tfor (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << {name}[i] << " ";',
+                                '\t\tos << std :: endl;',
+                                '\t}}',
+                                ''
+                                ))
+  regex_dump_value = '\n'.join(('\tif ( this->required[idx_{name}] )',
+                                '\t\tos << std :: left << std :: setw(40) << "{tag}" << std :: setw(20) << {name} << std :: endl;',
                                 ''
                                 ))
-  regex_dump_value = '\tos << std :: left << std :: setw(40) << "{tag}" << std :: setw(20) << {name} << std :: endl;\n'
+  regex_dump_classes = '\n'.join(('\tos << std :: left << std :: setw(40) << "{tag}";',
+                                  '\tfor (int32_t i = 0; i < this->Nclass; ++i) os << std :: setw(20) << {name}[i] << " ";',
+                                  '\tos << std :: endl;',
+                                  ''
+                                  ))
 
 
-  members = '\n'.join(('template < typename Os >',
-                       'void scorer :: print_class_stats (Os & os)',
+  members = '\n'.join((member('void scorer :: compute_from_confusion_matrix (const T * confusion_matrix, const int32_t & Nclass, const float * classes)', ('typename T, {}'.format(from_matrix_requires), )),
+                       '{',
+                       '#ifdef __pythonic__',
+                       '#ifdef _OPENMP',
+                       '#pragma omp parallel',
+                       '\t{',
+                       '#endif',
+                       '#endif',
+                       '',
+                       '#ifdef _OPENMP',
+                       '#pragma omp single',
+                       '#endif',
+                       '\t{',
+                       '\t\tif ( classes != nullptr )',
+                       '\t\t\tthis->classes.assign(classes, classes + Nclass);',
+                       '\t\telse',
+                       '\t\t{',
+                       '\t\t\tthis->classes.resize(Nclass);',
+                       '\t\t\tstd :: iota(this->classes.begin(), this->classes.end(), 0.f);',
+                       '\t\t}',
+                       '',
+                       '\t\tthis->Nclass = Nclass;',
+                       '\t}',
+                       '',
+                       check_dimension(),
+                       '#ifdef _OPENMP',
+                       '#pragma omp single',
+                       '#endif',
+                       '\t{',
+                       '\t\tthis->sparse_mode = false;',
+                       '\t\tthis->reserve(this->Nclass, true);',
+                       '\t\tstd :: transform(confusion_matrix, confusion_matrix + static_cast < int64_t >(Nclass) * Nclass, this->confusion_matrix,',
+                       '\t\t                [] (const T & x) { return static_cast < count_type >(x); });',
+                       '\t}',
+                       '',
+                       '\tthis->compute_stats();',
+                       '',
+                       '#ifdef __pythonic__',
+                       '#ifdef _OPENMP',
+                       '\t} // end computation function',
+                       '#endif',
+                       '#endif',
+                       '}', '', '', '',
+                       member('void scorer :: print_class_stats (Os & os)', ('typename Os',)),
                        '{', ''))
 
-  printers = '\n'.join((regex_dump_array.format(name=name, tag=cppvar['label'])
+  printers = '\n'.join(((regex_dump_classes if name == 'classes' else regex_dump_array).format(name=name, tag=cppvar['label'])
                        for name, cppvar in deps.items()
                        if cppvar['file'] in ('common_stats.h', 'class_stats.h')))
 
   members = '\n'.join((members, printers,
                        '}', '', '', '',
-                       'template < typename Os >',
-                       'void scorer :: print_overall_stats (Os & os)',
+                       member('void scorer :: print_overall_stats (Os & os)', ('typename Os',)),
                        '{',
                        ''))
 
@@ -284,13 +1051,13 @@ def hpp_file (dependency):
 
   members = '\n'.join((members, overall,
                        '}', '', '', '',
-                       'void scorer :: print ()',
+                       member('void scorer :: print ()'),
                        '{',
                        '\tthis->print_class_stats < std :: ostream >(std :: cout);',
                        '\tstd :: cout << std :: endl;',
                        '\tthis->print_overall_stats < std :: ostream >(std :: cout);',
                        '}', '',
-                       'void scorer :: dump (const std :: string & filename)',
+                       member('void scorer :: dump (const std :: string & filename)'),
                        '{',
                        '\tstd :: ofstream os (filename + ".cl_stats");',
                        '\tos << "stats," << std :: endl;',
@@ -302,9 +1069,7 @@ def hpp_file (dependency):
                        '\tthis->print_overall_stats < std :: ofstream >(os);',
                        '\tos.close();',
                        '}', '',
-                       ''
-                       'template < typename dtype >',
-                       'int32_t * scorer :: encoder (dtype * arr, const int32_t & size)',
+                       member('int32_t * scorer :: encoder (dtype * arr, const int32_t & size)', ('typename dtype',)),
                        '{', '',
                        '\tint32_t * encode = new int32_t [size];',
                        '',
@@ -325,6 +1090,400 @@ def hpp_file (dependency):
 
 
 
+def metric_scorer_file (dependency, order):
+
+  # storage of each statistic: 0 = count_t column, 1 = real_t column, 2 = real_t value, 3 = classes vector
+  def kind (name):
+    if name == 'classes':
+      return 3
+    if dependency[name]['file'] == 'overall_stats.h':
+      return 2
+    return 0 if dependency[name]['dtype'] == 'count_type' else 1
+
+  def argument (name):
+    if name == 'classes':
+      return 'this->classes.data()'
+    if name in dependency:
+      return 'this->template at < metrics :: {} >()'.format(name)
+    return 'this->{}'.format(name)
+
+  deps = [[dep for dep, _ in dependency[name]['dependency'] if dep in dependency] for name in order]
+
+  offsets = [0]
+  for d in deps:
+    offsets.append(offsets[-1] + len(d))
+
+  indexes = ',\n'.join(('\t\t{}'.format(name) for name in order))
+  links = '\n'.join(('\t\t{} // {}'.format(' '.join(('{},'.format(x) for x in d)), name)
+                     for name, d in zip(order, deps) if d))
+  kinds = ', '.join((str(kind(name)) for name in order))
+
+  sizes = '\n'.join(['\t\t\tcase {}: return {};'.format(name, size.replace('Ncell', 'static_cast < int64_t >(Nclass) * Nclass'))
+                     for name, size in column_sizes.items()] +
+                    ['\t\t\tdefault: return Nclass;'])
+
+  evaluations = []
+  for name in order:
+    if name in labels_stage:
+      continue
+
+    cppvar = dependency[name]
+    params = ', '.join((argument(x) for x, _ in cppvar['dependency']))
+
+    if cppvar['inplace']:
+      call = '\t\tget_{0} ( {1}, this->template at < metrics :: {0} >() );'.format(name, params)
+    else:
+      call = '\t\tthis->template at < metrics :: {0} >() = get_{0} ( {1} );'.format(name, params)
+
+    evaluations.append('\n'.join(('\tvoid evaluate (metric < metrics :: {} >, std :: true_type)'.format(name),
+                                  '\t{',
+                                  call,
+                                  '\t}', '')))
+
+  pipeline = '\n'.join(('\t\tthis->evaluate(metric < metrics :: {0} >(), std :: integral_constant < bool, layout.required[metrics :: {0}] >());'.format(name)
+                        for name in order if name not in labels_stage))
+
+  namespace = '\n'.join(('/**',
+                         '* @brief Identifiers of the statistics which can be selected by metric_scorer',
+                         '* and compile-time tables of their dependencies.',
+                         '*',
+                         '*/',
+                         'namespace metrics',
+                         '{',
+                         '\t/**',
+                         '\t* @brief Index of each statistic (in topological order of the dependencies).',
+                         '\t*',
+                         '\t*/',
+                         '\tenum id : int32_t',
+                         '\t{',
+                         indexes + ',',
+                         '\t\tn_stats',
+                         '\t};',
+                         '',
+                         '\t/// @cond DEF',
+                         '\t// dependencies of the k-th statistic are deps[offset[k] : offset[k + 1]]',
+                         '\tconstexpr int32_t offset[n_stats + 1] = {{ {} }};'.format(', '.join((str(x) for x in offsets))),
+                         '',
+                         '\tconstexpr int32_t deps[] = {',
+                         links,
+                         '\t};',
+                         '',
+                         '\t// storage of each statistic: 0 = count_t column, 1 = real_t column, 2 = real_t value, 3 = classes',
+                         '\tconstexpr int32_t kind[n_stats] = {{ {} }};'.format(kinds),
+                         '\t/// @endcond',
+                         '',
+                         '\t/**',
+                         '\t* @brief Compile-time layout of a set of statistics.',
+                         '\t*',
+                         '\t*/',
+                         '\tstruct selection',
+                         '\t{',
+                         '\t\tbool required[n_stats]; ///< true if the statistic is selected or it is a dependency of a selected one',
+                         '\t\tint32_t slot[n_stats]; ///< position of the statistic in the storage of its kind',
+                         '\t\tint32_t size[3]; ///< number of required statistics of each kind',
+                         '\t};',
+                         '',
+                         '\t/**',
+                         '\t* @brief Close a set of statistics over their dependencies.',
+                         '\t*',
+                         '\t* @tparam Ms selected statistics',
+                         '\t*',
+                         '\t* @return The layout of the required statistics.',
+                         '\t*/',
+                         '\ttemplate < int32_t ... Ms >',
+                         '\tconstexpr selection closure ()',
+                         '\t{',
+                         '\t\tselection layout = {};',
+                         '\t\tconst int32_t selected[] = { Ms ... };',
+                         '',
+                         '\t\tfor (const auto & k : selected)',
+                         '\t\t\tlayout.required[k] = true;',
+                         '',
+                         '\t\t// the dependencies of a statistic always precede it',
+                         '\t\tfor (int32_t k = n_stats - 1; k >= 0; --k)',
+                         '\t\t\tif ( layout.required[k] )',
+                         '\t\t\t\tfor (int32_t d = offset[k]; d < offset[k + 1]; ++d)',
+                         '\t\t\t\t\tlayout.required[deps[d]] = true;',
+                         '',
+                         '\t\tfor (int32_t k = 0; k < n_stats; ++k)',
+                         '\t\t\tif ( layout.required[k] && kind[k] < 3 )',
+                         '\t\t\t\tlayout.slot[k] = layout.size[kind[k]]++;',
+                         '',
+                         '\t\treturn layout;',
+                         '\t}',
+                         '',
+                         '\t/**',
+                         '\t* @brief Number of elements of the column of a statistic.',
+                         '\t*',
+                         '\t* @param stat index of the statistic',
+                         '\t* @param Nclass number of classes',
+                         '\t*',
+                         '\t*/',
+                         '\tinline int64_t column_size (const int32_t & stat, const int32_t & Nclass)',
+                         '\t{',
+                         '\t\tswitch (stat)',
+                         '\t\t{',
+                         sizes,
+                         '\t\t}',
+                         '\t}',
+                         '}', '', ''))
+
+  class_description = '/**\n\
+* @class metric_scorer\n\
+* @brief Scorer specialized at compile time on a set of statistics\n\
+*\n\
+* @details Only the selected statistics and their dependencies are stored and evaluated:\n\
+* the layout of the storage is computed at compile time and the functors of the other\n\
+* statistics are never instantiated. The statistics are evaluated serially in\n\
+* topological order and the memory is reused by the following evaluations.\n\
+*\n\
+* @tparam Ms selected statistics (as metrics :: id)\n\
+*\n\
+*/'
+
+  obj = '\n'.join(('template < int32_t ... Ms >',
+                   'class metric_scorer',
+                   '{',
+                   '\tstatic_assert (sizeof ... (Ms) > 0, "At least one statistic must be selected");',
+                   '',
+                   'public:',
+                   '',
+                   '\tstatic constexpr metrics :: selection layout = metrics :: closure < Ms ... >(); ///< compile-time layout of the statistics',
+                   '',
+                   '\tstd :: vector < float > classes; ///< array of classes',
+                   '',
+                   '\tint32_t Nclass; ///< number of classes',
+                   '',
+                   '\tcolumn_arena arena; ///< contiguous memory of the columns of the required statistics',
+                   '',
+                   '\tcolumn_arena workspace; ///< scratch memory of the functors (e.g. the histograms of the confusion matrix)',
+                   '',
+                   '\tlabel_map lut; ///< lookup table from labels to class indexes',
+                   '',
+                   '\tbool fixed_classes; ///< true if the classes are given by set_classes (no class discovery)',
+                   '',
+                   'private:',
+                   '',
+                   '\t/// @cond DEF',
+                   '\ttemplate < int32_t k >',
+                   '\tstruct metric {};',
+                   '\t/// @endcond',
+                   '',
+                   '\tstd :: tuple < std :: array < count_t *, layout.size[0] >,',
+                   '\t              std :: array < real_t *, layout.size[1] >,',
+                   '\t              std :: array < real_t, layout.size[2] > > storage; ///< columns and values of the required statistics',
+                   '',
+                   'public:',
+                   '',
+                   '\t/**',
+                   '\t* @brief Default constructor.',
+                   '\t*',
+                   '\t*/',
+                   '\tmetric_scorer () : Nclass (0), fixed_classes (false)',
+                   '\t{',
+                   '\t}',
+                   '',
+                   '\t/**',
+                   '\t* @brief Column (pointer) or value of a required statistic.',
+                   '\t*',
+                   '\t* @tparam k index of the statistic (as metrics :: id)',
+                   '\t*',
+                   '\t*/',
+                   '\ttemplate < int32_t k >',
+                   '\tauto & at ()',
+                   '\t{',
+                   '\t\tstatic_assert (layout.required[k] && metrics :: kind[k] < 3, "The statistic is not evaluated by this scorer");',
+                   '\t\treturn std :: get < layout.slot[k] >(std :: get < metrics :: kind[k] >(this->storage));',
+                   '\t}',
+                   '',
+                   '\t/**',
+                   '\t* @brief Column (pointer) or value of a required statistic.',
+                   '\t*',
+                   '\t* @tparam k index of the statistic (as metrics :: id)',
+                   '\t*',
+                   '\t*/',
+                   '\ttemplate < int32_t k >',
+                   '\tconst auto & at () const',
+                   '\t{',
+                   '\t\tstatic_assert (layout.required[k] && metrics :: kind[k] < 3, "The statistic is not evaluated by this scorer");',
+                   '\t\treturn std :: get < layout.slot[k] >(std :: get < metrics :: kind[k] >(this->storage));',
+                   '\t}',
+                   '',
+                   '\t/**',
+                   '\t* @brief Set the classes of the labels.',
+                   '\t*',
+                   '\t* @details The classes are not computed by the following calls to',
+                   '\t* compute_score and the memory is reserved once.',
+                   '\t*',
+                   '\t* @param classes array of class labels',
+                   '\t* @param Nclass number of classes',
+                   '\t*',
+                   '\t*/',
+                   '\tvoid set_classes (const int32_t * classes, const int32_t & Nclass)',
+                   '\t{',
+                   '\t\tthis->classes.assign(classes, classes + Nclass);',
+                   '',
+                   '\t\tstd :: sort(this->classes.begin(), this->classes.end());',
+                   '\t\tthis->classes.erase(std :: unique(this->classes.begin(), this->classes.end()), this->classes.end());',
+                   '',
+                   '\t\tthis->Nclass = static_cast < int32_t >(this->classes.size());',
+                   '\t\tthis->fixed_classes = this->Nclass > 0;',
+                   '',
+                   '\t\tthis->reserve(this->Nclass);',
+                   '\t\tthis->lut.build(this->classes.data(), this->Nclass);',
+                   '\t}',
+                   '',
+                   '\t/**',
+                   '\t* @brief Compute the selected statistics.',
+                   '\t*',
+                   '\t* @param lbl_true array of true labels',
+                   '\t* @param lbl_pred array of predicted labels',
+                   '\t* @param n_true number of true labels',
+                   '\t* @param n_pred number of predicted labels',
+                   '\t*',
+                   '\t*/',
+                   '\tvoid compute_score (const int32_t * lbl_true, const int32_t * lbl_pred, const int32_t & n_true, const int32_t & n_pred)',
+                   '\t{',
+                   '\t\tassert (n_true == n_pred);',
+                   '',
+                   '\t\tif ( !this->fixed_classes )',
+                   '\t\t\tthis->classes = get_classes ( lbl_true, lbl_pred, n_true, n_pred );',
+                   '',
+                   '\t\tthis->Nclass = static_cast < int32_t >(this->classes.size());',
+                   '',
+                   '\t\tif ( this->Nclass <= 1 )',
+                   '\t\t{',
+                   '\t\t\tstd :: cerr << "Nclass must be greater than 1" << std :: endl;',
+                   '\t\t\tstd :: exit(1);',
+                   '\t\t}',
+                   '',
+                   '\t\tthis->reserve(this->Nclass);',
+                   '',
+                   '\t\tget_confusion_matrix ( lbl_true, lbl_pred, n_true, this->classes.data(), this->Nclass, this->lut, this->workspace, this->template at < metrics :: confusion_matrix >() );',
+                   '',
+                   '\t\tthis->compute_stats();',
+                   '\t}',
+                   '',
+                   '\t/**',
+                   '\t* @brief Compute the selected statistics from an existing confusion matrix.',
+                   '\t*',
+                   '\t* @tparam T integer data type of the confusion matrix (the counts are stored as count_t)',
+                   '\t* @param confusion_matrix ravel array of the confusion matrix (Nclass x Nclass, rows are true labels)',
+                   '\t* @param Nclass number of classes',
+                   '\t* @param classes array of class labels (if nullptr the classes are 0, ..., Nclass - 1)',
+                   '\t*',
+                   '\t*/',
+                   '\ttemplate < typename T >',
+                   '\tvoid compute_from_confusion_matrix (const T * confusion_matrix, const int32_t & Nclass, const float * classes = nullptr)',
+                   '\t{',
+                   '\t\tstatic_assert (std :: is_integral < T > :: value, "The counts of the confusion matrix must be integers");',
+                   '',
+                   '\t\tif ( classes != nullptr )',
+                   '\t\t\tthis->classes.assign(classes, classes + Nclass);',
+                   '\t\telse',
+                   '\t\t{',
+                   '\t\t\tthis->classes.resize(Nclass);',
+                   '\t\t\tstd :: iota(this->classes.begin(), this->classes.end(), 0.f);',
+                   '\t\t}',
+                   '',
+                   '\t\tthis->Nclass = Nclass;',
+                   '',
+                   '\t\tif ( this->Nclass <= 1 )',
+                   '\t\t{',
+                   '\t\t\tstd :: cerr << "Nclass must be greater than 1" << std :: endl;',
+                   '\t\t\tstd :: exit(1);',
+                   '\t\t}',
+                   '',
+                   '\t\tthis->reserve(this->Nclass);',
+                   '',
+                   '\t\tstd :: transform(confusion_matrix, confusion_matrix + static_cast < int64_t >(Nclass) * Nclass,',
+                   '\t\t                this->template at < metrics :: confusion_matrix >(),',
+                   '\t\t                [] (const T & x) { return static_cast < count_t >(x); });',
+                   '',
+                   '\t\tthis->compute_stats();',
+                   '\t}',
+                   '',
+                   'private:',
+                   '',
+                   '\t/**',
+                   '\t* @brief Carve the columns of the required statistics.',
+                   '\t*',
+                   '\t* @param Nclass number of classes',
+                   '\t*',
+                   '\t*/',
+                   '\tvoid reserve (const int32_t & Nclass)',
+                   '\t{',
+                   '\t\tstd :: size_t size = 0;',
+                   '',
+                   '\t\tfor (int32_t k = 0; k < metrics :: n_stats; ++k)',
+                   '\t\t{',
+                   '\t\t\tif ( layout.required[k] && metrics :: kind[k] == 0 )',
+                   '\t\t\t\tsize += column_arena :: bytes < count_t >(metrics :: column_size(k, Nclass));',
+                   '\t\t\telse if ( layout.required[k] && metrics :: kind[k] == 1 )',
+                   '\t\t\t\tsize += column_arena :: bytes < real_t >(metrics :: column_size(k, Nclass));',
+                   '\t\t}',
+                   '',
+                   '\t\tthis->arena.reserve(size);',
+                   '',
+                   '\t\tfor (int32_t k = 0; k < metrics :: n_stats; ++k)',
+                   '\t\t{',
+                   '\t\t\tif ( layout.required[k] && metrics :: kind[k] == 0 )',
+                   '\t\t\t\tstd :: get < 0 >(this->storage)[layout.slot[k]] = this->arena.template column < count_t >(metrics :: column_size(k, Nclass));',
+                   '\t\t\telse if ( layout.required[k] && metrics :: kind[k] == 1 )',
+                   '\t\t\t\tstd :: get < 1 >(this->storage)[layout.slot[k]] = this->arena.template column < real_t >(metrics :: column_size(k, Nclass));',
+                   '\t\t}',
+                   '',
+                   '\t\t// histograms of the confusion matrix for any number of chunks',
+                   '\t\tthis->workspace.reserve(column_arena :: bytes < uint32_t >(confusion_matrix_cells(Nclass, num_workers())));',
+                   '\t}',
+                   '',
+                   '\t/**',
+                   '\t* @brief Evaluate the required statistics (in topological order).',
+                   '\t*',
+                   '\t*/',
+                   '\tvoid compute_stats ()',
+                   '\t{',
+                   pipeline,
+                   '\t}',
+                   '',
+                   '\t/// @cond DEF',
+                   '\t// statistics out of the selection are not evaluated (and their functors are not instantiated)',
+                   '\ttemplate < int32_t k >',
+                   '\tvoid evaluate (metric < k >, std :: false_type)',
+                   '\t{',
+                   '\t}',
+                   '',
+                   '\n'.join(evaluations) +
+                   '\t/// @endcond',
+                   '};',
+                   '',
+                   '/// @cond DEF',
+                   'template < int32_t ... Ms >',
+                   'constexpr metrics :: selection metric_scorer < Ms ... > :: layout;',
+                   '/// @endcond',
+                   ''))
+
+  header = '\n'.join(('/* This file was automatically generated */',
+                      '/* Any change will be lost in the next build */',
+                      '',
+                      '#ifndef __metric_scorer_h__',
+                      '#define __metric_scorer_h__',
+                      '', ''))
+
+  libs = include_lib(('vector',
+                      'array',
+                      'tuple',
+                      'type_traits',
+                      'iostream',
+                      'cassert',
+                      'numeric',
+                      'algorithm',
+                      'common_stats.h',
+                      'class_stats.h',
+                      'overall_stats.h'))
+
+  return ''.join((header, libs, '\n\n\n', namespace, class_description, '\n', obj, '\n#endif // __metric_scorer_h__\n'))
+
 if __name__ == '__main__':
 
   import os
@@ -332,6 +1491,8 @@ if __name__ == '__main__':
   from dependency_graph import functions_script
   from dependency_graph import dependency_net
   from dependency_graph import workflow_net
+  from dependency_graph import fused_kernel
+  from dependency_graph import topological_order
 
   include_dir = os.path.join(os.path.dirname(__file__), '..', 'include/')
   src_dir     = os.path.join(os.path.dirname(__file__), '..', 'src/')
@@ -341,16 +1502,24 @@ if __name__ == '__main__':
     dep = functions_script(include_dir + hpp)
     dependency.update(dep)
 
-  dep_net = dependency_net(dependency)
-  workflow = workflow_net(dep_net, dependency)
+  # the elementwise class statistics are evaluated by a single fused loop
+  fused = fused_kernel(dependency)
+
+  dep_net = dependency_net(fused)
+  workflow = workflow_net(dep_net, fused)
 
-  header_script = header_file(dependency)
+  # index of the functors for the lazy evaluation
+  order = topological_order(dependency)
+
+  header_script = header_file(dependency, order)
   hpp_script = hpp_file(dependency)
-  cpp_script = cpp_file(workflow)
+  cpp_script = cpp_file(workflow, dependency, order)
+  metric_script = metric_scorer_file(dependency, order)
 
   header_file = os.path.join(include_dir, 'scorer.h')
   hpp_file = os.path.join(include_dir, 'scorer.hpp')
   cpp_file = os.path.join(src_dir, 'scorer.cpp')
+  metric_file = os.path.join(include_dir, 'metric_scorer.h')
 
   with open(header_file, 'w') as cpp:
     cpp.write(header_script)
@@ -360,3 +1529,6 @@ if __name__ == '__main__':
 
   with open(cpp_file, 'w') as cpp:
     cpp.write(cpp_script)
+
+  with open(metric_file, 'w') as cpp:
+    cpp.write(metric_script)